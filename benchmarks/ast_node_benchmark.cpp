@@ -0,0 +1,334 @@
+// Memory and time per AST node, comparing nodes owned by `std::shared_ptr`s with their types stored inline (what the AST used to do) against the flat
+//  `ast::node_pools_t` AST.
+// Usage: `ast_node_benchmark [files or directories...]`. Directories are searched (non recursively) for `.c` files.
+//  Synthetic programs of increasing size are always benchmarked as well.
+//
+// Sections:
+//  - `nodes`: builds the same expression trees in both layouts, and times building, walking and destroying them. Also reports the heap bytes per node.
+//     The `std::shared_ptr` trees are a copy of the old node layout.
+//  - everything else: parses a whole program, then times walking every node of the resulting `ast::validated_program_t` and destroying it.
+// Every measurement is repeated and the fastest repetition is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <frontend/ast/ast.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <io/source_buffer.hpp>
+#include <utils/common.hpp>
+
+
+namespace {
+std::size_t current_heap_bytes = 0u;
+
+// every allocation is prefixed with its size so that unsized `operator delete` can account for it too
+constexpr std::size_t allocation_header_size = alignof(std::max_align_t);
+}
+
+void* operator new(const std::size_t size) {
+    void *const block = std::malloc(size + allocation_header_size);
+    if(block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    current_heap_bytes += size;
+    return static_cast<unsigned char*>(block) + allocation_header_size;
+}
+void operator delete(void *const pointer) noexcept {
+    if(pointer == nullptr) {
+        return;
+    }
+    void *const block = static_cast<unsigned char*>(pointer) - allocation_header_size;
+    current_heap_bytes -= *static_cast<std::size_t*>(block);
+    std::free(block);
+}
+void operator delete(void *const pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+
+namespace {
+// the old `std::shared_ptr` based layout of `ast::expression_t` and `ast::binary_expression_t`
+struct shared_binary_expression_t;
+struct shared_expression_t {
+    std::variant<std::shared_ptr<shared_binary_expression_t>, ast::constant_t> expr;
+    std::optional<ast::type_t> type;
+};
+struct shared_binary_expression_t {
+    ast::binary_operator_token_t op;
+    shared_expression_t left;
+    shared_expression_t right;
+};
+
+// Each tree is a left leaning chain of `tree_depth` additions, like `((1 + 1) + 1) + ...`.
+// Kept shallow enough that destroying a `std::shared_ptr` chain recursively doesn't overflow the stack.
+constexpr std::uint32_t tree_depth = 64u;
+
+shared_expression_t make_shared_tree() {
+    shared_expression_t tree{ast::constant_t{1}, std::nullopt};
+    for(std::uint32_t i = 0u; i < tree_depth; ++i) {
+        tree = shared_expression_t{std::make_shared<shared_binary_expression_t>(shared_binary_expression_t{ast::binary_operator_token_t::PLUS, std::move(tree), shared_expression_t{ast::constant_t{1}, std::nullopt}}), std::nullopt};
+    }
+    return tree;
+}
+ast::expression_t make_flat_tree() {
+    ast::expression_t tree{ast::constant_t{1}, std::nullopt};
+    for(std::uint32_t i = 0u; i < tree_depth; ++i) {
+        tree = ast::expression_t{ast::make_node<ast::binary_expression_t>(ast::binary_expression_t{ast::binary_operator_token_t::PLUS, std::move(tree), ast::expression_t{ast::constant_t{1}, std::nullopt}}), std::nullopt};
+    }
+    return tree;
+}
+
+std::uint64_t count_shared_nodes(const shared_expression_t& expression) {
+    if(const auto *const binary = std::get_if<std::shared_ptr<shared_binary_expression_t>>(&expression.expr)) {
+        return 1u + count_shared_nodes((*binary)->left) + count_shared_nodes((*binary)->right);
+    }
+    return 1u;
+}
+
+
+std::uint64_t count_nodes(const ast::expression_t& expression);
+std::uint64_t count_nodes(const ast::statement_t& statement);
+std::uint64_t count_nodes(const ast::compound_statement_t& compound_statement);
+
+std::uint64_t count_nodes(const ast::expression_t& expression) {
+    return 1u + std::visit(overloaded{
+        [](const ast::node_handle_t<ast::grouping_t>& grouping) { return count_nodes(grouping->expr); },
+        [](const ast::node_handle_t<ast::convert_t>& convert) { return count_nodes(convert->expr); },
+        [](const ast::node_handle_t<ast::unary_expression_t>& unary) { return count_nodes(unary->exp); },
+        [](const ast::node_handle_t<ast::binary_expression_t>& binary) { return count_nodes(binary->left) + count_nodes(binary->right); },
+        [](const ast::node_handle_t<ast::ternary_expression_t>& ternary) {
+            return count_nodes(ternary->condition) + count_nodes(ternary->if_true) + count_nodes(ternary->if_false);
+        },
+        [](const ast::node_handle_t<ast::function_call_t>& function_call) {
+            std::uint64_t count = 0u;
+            for(const auto& param : function_call->params) {
+                count += count_nodes(param);
+            }
+            return count;
+        },
+        [](const ast::variable_access_t&) { return std::uint64_t{0u}; },
+        [](const ast::constant_t&) { return std::uint64_t{0u}; },
+    }, expression.expr);
+}
+std::uint64_t count_nodes(const ast::declaration_t& declaration) {
+    return 1u + (declaration.value.has_value() ? count_nodes(declaration.value.value()) : 0u);
+}
+std::uint64_t count_nodes(const ast::statement_t& statement) {
+    return 1u + std::visit(overloaded{
+        [](const ast::return_statement_t& return_statement) { return count_nodes(return_statement.expr); },
+        [](const ast::expression_statement_t& expression_statement) {
+            return expression_statement.expr.has_value() ? count_nodes(expression_statement.expr.value()) : std::uint64_t{0u};
+        },
+        [](const ast::node_handle_t<ast::if_statement_t>& if_statement) {
+            return count_nodes(if_statement->if_exp) + count_nodes(if_statement->if_body)
+                 + (if_statement->else_body.has_value() ? count_nodes(if_statement->else_body.value()) : 0u);
+        },
+        [](const ast::node_handle_t<ast::compound_statement_t>& compound_statement) { return count_nodes(*compound_statement); },
+    }, statement);
+}
+std::uint64_t count_nodes(const ast::compound_statement_t& compound_statement) {
+    std::uint64_t count = 0u;
+    for(const auto& statement_or_declaration : compound_statement.stmts) {
+        count += std::visit([](const auto& node) { return count_nodes(node); }, statement_or_declaration);
+    }
+    return count;
+}
+std::uint64_t count_nodes(const ast::validated_program_t& program) {
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    std::uint64_t count = 1u;
+    for(const auto& top_level_declaration : program.top_level_declarations) {
+        count += std::visit(overloaded{
+            [](const ast::function_definition_t& function_definition) { return 1u + count_nodes(function_definition.statements); },
+            [](const ast::global_variable_declaration_t& global_variable) { return count_nodes(global_variable); },
+        }, top_level_declaration);
+    }
+    return count;
+}
+
+
+using steady_clock_t = std::chrono::steady_clock;
+double elapsed_ns(const steady_clock_t::time_point start, const steady_clock_t::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+constexpr std::uint32_t repetitions = 5u;
+
+struct measurements_t {
+    double build_ns = 0.0;
+    double walk_ns = 0.0;
+    double teardown_ns = 0.0;
+    std::size_t heap_bytes = 0u; // held by what was built
+    std::uint64_t node_count = 0u;
+};
+// `build` returns whatever has to be kept alive, `walk` counts its nodes and destroying it is the teardown
+template<typename B, typename W>
+measurements_t measure(B&& build, W&& walk) {
+    measurements_t fastest;
+    for(std::uint32_t repetition = 0u; repetition < repetitions; ++repetition) {
+        const std::size_t starting_heap_bytes = current_heap_bytes;
+        const auto build_start = steady_clock_t::now();
+        auto built = std::make_optional(build());
+        const auto build_end = steady_clock_t::now();
+        const std::size_t heap_bytes = current_heap_bytes - starting_heap_bytes;
+        const std::uint64_t node_count = walk(*built);
+        const auto walk_end = steady_clock_t::now();
+        built.reset();
+        const auto teardown_end = steady_clock_t::now();
+
+        const measurements_t current{elapsed_ns(build_start, build_end), elapsed_ns(build_end, walk_end), elapsed_ns(walk_end, teardown_end), heap_bytes, node_count};
+        fastest = (repetition == 0u) ? current : measurements_t{
+            std::min(fastest.build_ns, current.build_ns), std::min(fastest.walk_ns, current.walk_ns), std::min(fastest.teardown_ns, current.teardown_ns), heap_bytes, node_count
+        };
+    }
+    return fastest;
+}
+void print_per_node(const char *const name, const measurements_t& measurements) {
+    const auto node_count = static_cast<double>(measurements.node_count);
+    std::cout << name << " build: " << measurements.build_ns / node_count << " ns/node"
+              << ", walk: " << measurements.walk_ns / node_count << " ns/node"
+              << ", teardown: " << measurements.teardown_ns / node_count << " ns/node"
+              << ", heap: " << static_cast<double>(measurements.heap_bytes) / node_count << " bytes/node";
+}
+
+void run_node_benchmark(const std::uint32_t tree_count) {
+    const auto shared = measure([tree_count]() {
+        std::vector<shared_expression_t> trees;
+        trees.reserve(tree_count);
+        for(std::uint32_t i = 0u; i < tree_count; ++i) {
+            trees.push_back(make_shared_tree());
+        }
+        return trees;
+    }, [](const std::vector<shared_expression_t>& trees) {
+        std::uint64_t count = 0u;
+        for(const auto& tree : trees) {
+            count += count_shared_nodes(tree);
+        }
+        return count;
+    });
+
+    struct flat_trees_t {
+        std::unique_ptr<ast::node_pools_t> nodes = std::make_unique<ast::node_pools_t>();
+        std::vector<ast::expression_t> trees;
+    };
+    const auto flat = measure([tree_count]() {
+        flat_trees_t flat_trees;
+        const ast::node_pools_scope_t node_pools_scope(*flat_trees.nodes);
+        flat_trees.trees.reserve(tree_count);
+        for(std::uint32_t i = 0u; i < tree_count; ++i) {
+            flat_trees.trees.push_back(make_flat_tree());
+        }
+        return flat_trees;
+    }, [](const flat_trees_t& flat_trees) {
+        const ast::node_pools_scope_t node_pools_scope(*flat_trees.nodes);
+        std::uint64_t count = 0u;
+        for(const auto& tree : flat_trees.trees) {
+            count += count_nodes(tree);
+        }
+        return count;
+    });
+
+    std::cout << "nodes (" << tree_count << " trees, " << flat.node_count << " nodes): ";
+    print_per_node("std::shared_ptr", shared);
+    std::cout << "; ";
+    print_per_node("flat", flat);
+    std::cout << '\n';
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+
+void run_program_benchmark(const std::string& name, const std::string_view text) {
+    // the parser prints diagnostics, keep them out of the results
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+    std::optional<measurements_t> measurements;
+    parser_t validating_parser(token_stream_t{lexer_t(text)});
+    if(parse(validating_parser).has_value()) {
+        measurements = measure([text]() {
+            parser_t parser(token_stream_t{lexer_t(text)});
+            return parse(parser).value();
+        }, [](const ast::validated_program_t& program) {
+            return count_nodes(program);
+        });
+    }
+    std::cout.rdbuf(cout_buffer);
+
+    std::cout << name << ": " << text.size() << " bytes, ";
+    if(measurements.has_value()) {
+        std::cout << measurements->node_count << " nodes, ";
+        print_per_node("parse", measurements.value());
+        std::cout << '\n';
+    } else {
+        std::cout << "invalid program\n";
+    }
+}
+
+std::string make_synthetic_program(const std::uint32_t function_count) {
+    std::string text;
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        text += "unsigned long " + name + "(long a, unsigned int b) {\n"
+                "    long c = a * 3 + (b >> 2) - (a << 1) * (b | 7);\n"
+                "    if(c > 100) { c = c - a; } else { c += 1; }\n"
+                "    return c ? c : " + std::to_string(i) + ";\n"
+                "}\n";
+    }
+    text += "int main() {\n    return 0;\n}\n";
+    return text;
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::cout << "bytes: ast::expression_t: " << sizeof(ast::expression_t) << ", ast::binary_expression_t: " << sizeof(ast::binary_expression_t)
+              << " (old layout: " << sizeof(shared_expression_t) << ", " << sizeof(shared_binary_expression_t) << ")\n";
+    for(const std::uint32_t tree_count : {1000u, 10000u, 100000u}) {
+        run_node_benchmark(tree_count);
+    }
+
+    std::vector<std::string> input_paths;
+    for(int i = 1; i < argc; ++i) {
+        if(std::filesystem::is_directory(argv[i])) {
+            std::vector<std::string> directory_paths;
+            for(const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+                if(entry.is_regular_file() && entry.path().extension() == ".c") {
+                    directory_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(std::begin(directory_paths), std::end(directory_paths));
+            input_paths.insert(std::end(input_paths), std::begin(directory_paths), std::end(directory_paths));
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+    for(const auto& input_path : input_paths) {
+        const source_buffer_t source = load_source_file(input_path.c_str());
+        run_program_benchmark(input_path, source.view());
+    }
+    for(const std::uint32_t function_count : {100u, 1000u, 10000u}) {
+        const std::string text = make_synthetic_program(function_count);
+        run_program_benchmark("synthetic (" + std::to_string(function_count) + " functions)", text);
+    }
+    return 0;
+}
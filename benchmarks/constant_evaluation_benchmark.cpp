@@ -0,0 +1,136 @@
+// Time per operator, in ns, of evaluating constant expression trees at compile time (see `compile_time_evaluator.hpp`):
+//  - `global initializer`: `evaluate_expression()` of a global's initializer, as the type checker does it (before it replaces the initializer with its
+//     value), per operator of the initializer.
+//  - `folding`: `fold_constants()` of function bodies that are made of constant expressions, per operator folded.
+// The expressions are balanced trees of `+`, `-`, `*`, `<`, `==` and `!=` over `int`, `long`, `unsigned` and `double` literals.
+// Usage: `constant_evaluation_benchmark`.
+// Every way is repeated until it has run for a while and the fastest repetition is reported, which is the least noisy number on a busy machine.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <backend/interpreter/compile_time_evaluator.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/optimization/fold_constants.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <utils/result.hpp>
+
+
+namespace {
+// Returns the fastest time in ns of running `function`, which is given the `prepare()`d input of each repetition. Only `function` is timed.
+template<typename P, typename F>
+double time_fastest_run_ns(P&& prepare, F&& function) {
+    constexpr auto min_total_time = std::chrono::milliseconds(200);
+    constexpr std::uint32_t min_repetitions = 5u;
+
+    double fastest_ns = 0.0;
+    std::chrono::steady_clock::duration total_time{};
+    for(std::uint32_t repetition = 0u; repetition < min_repetitions || total_time < min_total_time; ++repetition) {
+        auto input = prepare();
+        const auto start = std::chrono::steady_clock::now();
+        function(input);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        total_time += elapsed;
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        fastest_ns = (repetition == 0u) ? elapsed_ns : std::min(fastest_ns, elapsed_ns);
+    }
+    return fastest_ns;
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+
+ast::validated_program_t parse_program(const std::string_view text, const bool is_type_checked) {
+    // the parser prints debug output
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    utils::diagnostics_t diagnostics;
+    const bool is_valid = program.has_value() && (!is_type_checked || type_check(program.value(), diagnostics).has_value());
+    std::cout.rdbuf(cout_buffer);
+    if(!is_valid) {
+        throw std::runtime_error("The benchmark's program doesn't compile.");
+    }
+    return std::move(program).value();
+}
+
+// a balanced tree of `2^depth - 1` operators
+std::string make_expression(const std::uint32_t depth, std::uint32_t& leaf_index) {
+    static constexpr std::array<std::string_view, 6u> LEAVES{{"3", "7L", "5u", "2.5", "11", "4L"}};
+    static constexpr std::array<std::string_view, 6u> OPERATORS{{" + ", " * ", " - ", " < ", " == ", " != "}};
+    if(depth == 0u) {
+        return std::string(LEAVES[leaf_index++ % LEAVES.size()]);
+    }
+    const std::string left = make_expression(depth - 1u, leaf_index);
+    const std::string right = make_expression(depth - 1u, leaf_index);
+    return "(" + left + std::string(OPERATORS[(depth + leaf_index) % OPERATORS.size()]) + right + ")";
+}
+constexpr std::uint32_t EXPRESSION_DEPTH = 8u;
+constexpr std::uint32_t OPERATORS_PER_EXPRESSION = (1u << EXPRESSION_DEPTH) - 1u;
+constexpr std::uint32_t EXPRESSION_COUNT = 64u;
+
+
+void run_global_initializer_benchmark() {
+    std::string text;
+    std::uint32_t leaf_index = 0u;
+    for(std::uint32_t i = 0u; i < EXPRESSION_COUNT; ++i) {
+        text += "double g" + std::to_string(i) + " = " + make_expression(EXPRESSION_DEPTH, leaf_index) + ";\n";
+    }
+    text += "int main() { return 0; }\n";
+    const ast::validated_program_t program = parse_program(text, false);
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    std::vector<const ast::expression_t*> initializers;
+    for(const auto& top_level_declaration : program.top_level_declarations) {
+        if(const auto *const global = std::get_if<ast::global_variable_declaration_t>(&top_level_declaration); global != nullptr && global->value.has_value()) {
+            initializers.push_back(&global->value.value());
+        }
+    }
+    utils::diagnostics_t diagnostics;
+    double checksum = 0.0;
+    const double ns = time_fastest_run_ns([]() { return 0; }, [&](int) {
+        for(const ast::expression_t *const initializer : initializers) {
+            const auto result = evaluate_expression(*initializer, diagnostics);
+            checksum += std::visit([](const auto value) { return static_cast<double>(value); }, result.value().value);
+        }
+    });
+    std::cout << "global initializer: " << ns / (initializers.size() * OPERATORS_PER_EXPRESSION) << " ns (checksum " << checksum << ")\n";
+}
+
+void run_folding_benchmark() {
+    std::string text = "int main() {\n";
+    std::uint32_t leaf_index = 0u;
+    for(std::uint32_t i = 0u; i < EXPRESSION_COUNT; ++i) {
+        text += "    double x" + std::to_string(i) + " = " + make_expression(EXPRESSION_DEPTH, leaf_index) + ";\n";
+    }
+    text += "    return 0;\n}\n";
+    const double ns = time_fastest_run_ns([&text]() { return parse_program(text, true); }, [](ast::validated_program_t& program) {
+        fold_constants(program);
+    });
+    std::cout << "folding: " << ns / (EXPRESSION_COUNT * OPERATORS_PER_EXPRESSION) << " ns\n";
+}
+}
+
+
+int main() {
+    run_global_initializer_benchmark();
+    run_folding_benchmark();
+    return 0;
+}
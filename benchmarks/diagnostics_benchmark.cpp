@@ -0,0 +1,187 @@
+// Throughput of rejecting invalid programs: the time from source text to the first error, in µs per program.
+// Usage: `diagnostics_benchmark [files or directories...]`. Directories are searched (non recursively) for `.c` files.
+//
+// Corpora:
+//  - `mutated`: every input cut off at, and with a stray `)` inserted at, a number of evenly spaced places. Most of these fail to parse early on,
+//     which is the common case when fuzzing.
+//  - `synthetic parse error`: synthetic programs of increasing size whose last function uses an undeclared variable.
+//  - `synthetic type error`: the same, but the last function assigns a struct to an `int`, which only the type checker rejects.
+//  - `synthetic evaluation error`: the same, but the last global divides by zero, which only the compile time evaluator rejects.
+// Each program is parsed and, if it parses, type checked, as `foo_cc` does. Every corpus is repeated until it has run for a while and the fastest
+//  repetition is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <frontend/ast/ast.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <io/source_buffer.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <utils/result.hpp>
+
+
+namespace {
+enum class rejected_by_t : std::uint8_t {
+    NOTHING, // the program is valid after all
+    PARSER,
+    TYPE_CHECKER,
+};
+
+rejected_by_t compile_until_first_error(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    if(!program.has_value()) {
+        return rejected_by_t::PARSER;
+    }
+    utils::diagnostics_t diagnostics;
+    if(!type_check(program.value(), diagnostics).has_value()) {
+        return rejected_by_t::TYPE_CHECKER;
+    }
+    return rejected_by_t::NOTHING;
+}
+
+
+struct corpus_result_t {
+    double us_per_program = 0.0;
+    std::uint32_t rejected_by_parser = 0u;
+    std::uint32_t rejected_by_type_checker = 0u;
+    std::uint32_t accepted = 0u;
+};
+
+corpus_result_t run_corpus(const std::vector<std::string>& programs) {
+    constexpr auto min_total_time = std::chrono::milliseconds(200);
+    constexpr std::uint32_t min_repetitions = 5u;
+
+    corpus_result_t result;
+    double fastest_ns = 0.0;
+    std::chrono::steady_clock::duration total_time{};
+    for(std::uint32_t repetition = 0u; repetition < min_repetitions || total_time < min_total_time; ++repetition) {
+        corpus_result_t counts;
+        const auto start = std::chrono::steady_clock::now();
+        for(const auto& program : programs) {
+            switch(compile_until_first_error(program)) {
+                case rejected_by_t::NOTHING:
+                    ++counts.accepted;
+                    break;
+                case rejected_by_t::PARSER:
+                    ++counts.rejected_by_parser;
+                    break;
+                case rejected_by_t::TYPE_CHECKER:
+                    ++counts.rejected_by_type_checker;
+                    break;
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        total_time += elapsed;
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        fastest_ns = (repetition == 0u) ? elapsed_ns : std::min(fastest_ns, elapsed_ns);
+        result = counts;
+    }
+    result.us_per_program = fastest_ns / 1000.0 / static_cast<double>(std::max<std::size_t>(programs.size(), 1u));
+    return result;
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+
+void run_benchmark(const std::string& name, const std::vector<std::string>& programs) {
+    // the lexer and the parser print diagnostics, keep them out of the results
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+    const corpus_result_t result = run_corpus(programs);
+    std::cout.rdbuf(cout_buffer);
+
+    std::cout << name << ": " << programs.size() << " programs, " << result.us_per_program << " us/program (" << (1e6 / result.us_per_program) << " programs/s)"
+              << ", rejected by the parser: " << result.rejected_by_parser
+              << ", rejected by the type checker: " << result.rejected_by_type_checker
+              << ", accepted: " << result.accepted << '\n';
+}
+
+
+constexpr std::uint32_t mutations_per_input = 32u;
+
+void add_mutations(std::vector<std::string>& programs, const std::string_view text) {
+    for(std::uint32_t i = 0u; i < mutations_per_input; ++i) {
+        std::size_t position = text.size() * i / mutations_per_input;
+        // move to the next whitespace so that tokens aren't split, which would mostly just make for lexer errors
+        while(position < text.size() && text[position] != ' ' && text[position] != '\n') {
+            ++position;
+        }
+        programs.emplace_back(text.substr(0u, position));
+        programs.push_back(std::string(text.substr(0u, position)) + " )" + std::string(text.substr(position)));
+    }
+}
+
+std::string make_valid_functions(const std::uint32_t function_count) {
+    std::string text = "typedef struct point_t { int x; long y; } point_t;\n";
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        text += "long g" + std::to_string(i) + " = " + std::to_string(i) + ";\n"
+                "unsigned long " + name + "(long a, unsigned int b) {\n"
+                "    long c = a * 3 + (b >> 2);\n"
+                "    if(c > 100) { c = c - a; } else { c += 1; }\n"
+                "    return c ? c : " + std::to_string(i) + ";\n"
+                "}\n";
+    }
+    return text;
+}
+std::string make_program_with_parse_error(const std::uint32_t function_count) {
+    return make_valid_functions(function_count) + "int main() {\n    return undeclared;\n}\n";
+}
+std::string make_program_with_type_error(const std::uint32_t function_count) {
+    return make_valid_functions(function_count) + "int main() {\n    point_t p;\n    int a = p;\n    return a;\n}\n";
+}
+std::string make_program_with_evaluation_error(const std::uint32_t function_count) {
+    return make_valid_functions(function_count) + "long h = 1 / 0;\nint main() {\n    return 0;\n}\n";
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::vector<std::string> input_paths;
+    for(int i = 1; i < argc; ++i) {
+        if(std::filesystem::is_directory(argv[i])) {
+            std::vector<std::string> directory_paths;
+            for(const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+                if(entry.is_regular_file() && entry.path().extension() == ".c") {
+                    directory_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(std::begin(directory_paths), std::end(directory_paths));
+            input_paths.insert(std::end(input_paths), std::begin(directory_paths), std::end(directory_paths));
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+
+    std::vector<std::string> mutated_programs;
+    for(const auto& input_path : input_paths) {
+        const source_buffer_t source = load_source_file(input_path.c_str());
+        add_mutations(mutated_programs, source.view());
+    }
+    add_mutations(mutated_programs, make_program_with_parse_error(10u));
+    run_benchmark("mutated", mutated_programs);
+
+    for(const std::uint32_t function_count : {0u, 10u, 100u}) {
+        const std::string suffix = " (" + std::to_string(function_count) + " valid functions first)";
+        run_benchmark("synthetic parse error" + suffix, {make_program_with_parse_error(function_count)});
+        run_benchmark("synthetic type error" + suffix, {make_program_with_type_error(function_count)});
+        run_benchmark("synthetic evaluation error" + suffix, {make_program_with_evaluation_error(function_count)});
+    }
+    return 0;
+}
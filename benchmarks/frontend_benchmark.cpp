@@ -0,0 +1,344 @@
+// Front end throughput: ns/token for the lexer stages and ns/node for the parser.
+// Usage: `frontend_benchmark [--json <output path>] [files or directories...]`. Directories are searched (non recursively) for `.c` files.
+//  Synthetic programs of increasing size are always benchmarked as well, so that runs can be compared even when the corpus changes.
+//
+// Stages:
+//  - `scan_token`: raw tokens straight out of the lexer, before type specifier merging.
+//  - `scan_all_tokens`: tokens materialized into a `token_table_t` (scanning and merging).
+//  - `scan_all_tokens_parallel`: the same, but lexed in chunks on a thread pool with one thread per hardware thread. Small inputs are lexed serially.
+//  - `scan_merged_token`: tokens out of the lexer with type specifier runs merged into single tokens as they are scanned, in the same single pass.
+//  - `merge_tokens`: the type specifier merging alone, as the difference between `scan_merged_token` and `scan_token`.
+//  - `parse`: parsing the whole file, lexing included since tokens are pulled on demand. Reported per AST node.
+//  - `parse_in_parallel`: the same, but with the function bodies parsed concurrently on the thread pool after a brace matching pass over the top level declarations.
+//  - `parse_lazily`: the same, but only parsing the function bodies that `main` needs, as for a whole program (see `--run`). Reported per node of the whole program, to compare with `parse`.
+//     The synthetic programs' `main` doesn't call anything, so this is the cost of skipping over the unused functions.
+// Every stage is repeated until it has run for a while and the fastest repetition is reported, which is the least noisy number on a busy machine.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <frontend/ast/ast.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/parallel_lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <io/source_buffer.hpp>
+#include <utils/common.hpp>
+#include <utils/thread_pool.hpp>
+
+
+namespace {
+struct stage_result_t {
+    double ns_per_item = 0.0;
+    std::uint64_t item_count = 0u;
+};
+struct input_result_t {
+    std::string name;
+    std::size_t byte_count = 0u;
+    stage_result_t scan_token;
+    stage_result_t scan_merged_token;
+    stage_result_t scan_all_tokens;
+    stage_result_t scan_all_tokens_parallel;
+    stage_result_t merge_tokens;
+    std::optional<stage_result_t> parse; // `std::nullopt` if the input doesn't parse
+    std::optional<stage_result_t> parse_in_parallel;
+    std::optional<stage_result_t> parse_lazily;
+};
+
+// Returns the fastest time in ns of running `function`. `function` returns the number of items it processed.
+template<typename F>
+std::pair<double, std::uint64_t> time_fastest_run_ns(F&& function) {
+    constexpr auto min_total_time = std::chrono::milliseconds(100);
+    constexpr std::uint32_t min_repetitions = 5u;
+
+    double fastest_ns = 0.0;
+    std::uint64_t item_count = 0u;
+    std::chrono::steady_clock::duration total_time{};
+    for(std::uint32_t repetition = 0u; repetition < min_repetitions || total_time < min_total_time; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        item_count = function();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        total_time += elapsed;
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        fastest_ns = (repetition == 0u) ? elapsed_ns : std::min(fastest_ns, elapsed_ns);
+    }
+    return {fastest_ns, item_count};
+}
+
+
+std::uint64_t scan_raw_tokens(const std::string_view text) {
+    lexer_t lexer(text);
+    std::uint64_t token_count = 1u;
+    for(; scan_token(lexer).token_type != token_type_t::EOF_TOK; ++token_count);
+    return token_count;
+}
+std::uint64_t materialize_token_table(const std::string_view text) {
+    return scan_all_tokens(lexer_t{text}).size();
+}
+std::uint64_t materialize_token_table_in_parallel(const std::string_view text, utils::thread_pool_t& thread_pool) {
+    return scan_all_tokens_parallel(text.data(), text.data() + text.size(), thread_pool).size();
+}
+std::uint64_t scan_merged_tokens(const std::string_view text) {
+    lexer_t lexer(text);
+    std::uint64_t token_count = 1u;
+    for(; scan_merged_token(lexer).token_type != token_type_t::EOF_TOK; ++token_count);
+    return token_count;
+}
+
+
+std::uint64_t count_nodes(const ast::expression_t& expression);
+std::uint64_t count_nodes(const ast::statement_t& statement);
+std::uint64_t count_nodes(const ast::compound_statement_t& compound_statement);
+
+std::uint64_t count_nodes(const ast::expression_t& expression) {
+    return 1u + std::visit(overloaded{
+        [](const ast::node_handle_t<ast::grouping_t>& grouping) { return count_nodes(grouping->expr); },
+        [](const ast::node_handle_t<ast::convert_t>& convert) { return count_nodes(convert->expr); },
+        [](const ast::node_handle_t<ast::unary_expression_t>& unary) { return count_nodes(unary->exp); },
+        [](const ast::node_handle_t<ast::binary_expression_t>& binary) { return count_nodes(binary->left) + count_nodes(binary->right); },
+        [](const ast::node_handle_t<ast::ternary_expression_t>& ternary) {
+            return count_nodes(ternary->condition) + count_nodes(ternary->if_true) + count_nodes(ternary->if_false);
+        },
+        [](const ast::node_handle_t<ast::function_call_t>& function_call) {
+            std::uint64_t count = 0u;
+            for(const auto& param : function_call->params) {
+                count += count_nodes(param);
+            }
+            return count;
+        },
+        [](const ast::variable_access_t&) { return std::uint64_t{0u}; },
+        [](const ast::constant_t&) { return std::uint64_t{0u}; },
+    }, expression.expr);
+}
+std::uint64_t count_nodes(const ast::declaration_t& declaration) {
+    return 1u + (declaration.value.has_value() ? count_nodes(declaration.value.value()) : 0u);
+}
+std::uint64_t count_nodes(const ast::statement_t& statement) {
+    return 1u + std::visit(overloaded{
+        [](const ast::return_statement_t& return_statement) { return count_nodes(return_statement.expr); },
+        [](const ast::expression_statement_t& expression_statement) {
+            return expression_statement.expr.has_value() ? count_nodes(expression_statement.expr.value()) : std::uint64_t{0u};
+        },
+        [](const ast::node_handle_t<ast::if_statement_t>& if_statement) {
+            return count_nodes(if_statement->if_exp) + count_nodes(if_statement->if_body)
+                 + (if_statement->else_body.has_value() ? count_nodes(if_statement->else_body.value()) : 0u);
+        },
+        [](const ast::node_handle_t<ast::compound_statement_t>& compound_statement) { return count_nodes(*compound_statement); },
+    }, statement);
+}
+std::uint64_t count_nodes(const ast::compound_statement_t& compound_statement) {
+    std::uint64_t count = 0u;
+    for(const auto& statement_or_declaration : compound_statement.stmts) {
+        count += std::visit([](const auto& node) { return count_nodes(node); }, statement_or_declaration);
+    }
+    return count;
+}
+std::uint64_t count_nodes(const ast::validated_program_t& program) {
+    std::uint64_t count = 1u;
+    for(const auto& top_level_declaration : program.top_level_declarations) {
+        count += std::visit(overloaded{
+            [](const ast::function_definition_t& function_definition) { return 1u + count_nodes(function_definition.statements); },
+            [](const ast::global_variable_declaration_t& global_variable) { return count_nodes(global_variable); },
+        }, top_level_declaration);
+    }
+    return count;
+}
+
+std::uint64_t parse_program(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    const ast::validated_program_t program = parse(parser).value();
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    return count_nodes(program);
+}
+// returns the number of nodes that were parsed
+std::uint64_t parse_program_lazily(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    const ast::validated_program_t program = parse_lazily(parser, true).value();
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    return count_nodes(program);
+}
+std::uint64_t parse_program_in_parallel(const std::string_view text, utils::thread_pool_t& thread_pool) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    const ast::validated_program_t program = parse_in_parallel(parser, thread_pool).value();
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    return count_nodes(program);
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+
+input_result_t run_benchmark(const std::string& name, const std::string_view text, utils::thread_pool_t& thread_pool) {
+    input_result_t result;
+    result.name = name;
+    result.byte_count = text.size();
+
+    // the lexer and the parser print diagnostics, keep them out of the results
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+
+    const auto [scan_token_ns, raw_token_count] = time_fastest_run_ns([text]() { return scan_raw_tokens(text); });
+    result.scan_token = stage_result_t{scan_token_ns / static_cast<double>(raw_token_count), raw_token_count};
+
+    const auto [scan_merged_token_ns, merged_token_count] = time_fastest_run_ns([text]() { return scan_merged_tokens(text); });
+    result.scan_merged_token = stage_result_t{scan_merged_token_ns / static_cast<double>(merged_token_count), merged_token_count};
+    result.merge_tokens = stage_result_t{std::max(0.0, scan_merged_token_ns - scan_token_ns) / static_cast<double>(merged_token_count), merged_token_count};
+
+    const auto [scan_all_tokens_ns, token_count] = time_fastest_run_ns([text]() { return materialize_token_table(text); });
+    result.scan_all_tokens = stage_result_t{scan_all_tokens_ns / static_cast<double>(token_count), token_count};
+
+    const auto [parallel_ns, parallel_token_count] = time_fastest_run_ns([text, &thread_pool]() { return materialize_token_table_in_parallel(text, thread_pool); });
+    result.scan_all_tokens_parallel = stage_result_t{parallel_ns / static_cast<double>(parallel_token_count), parallel_token_count};
+
+    parser_t validating_parser(token_stream_t{lexer_t(text)});
+    if(parse(validating_parser).has_value()) {
+        const auto [parse_ns, node_count] = time_fastest_run_ns([text]() { return parse_program(text); });
+        result.parse = stage_result_t{parse_ns / static_cast<double>(node_count), node_count};
+
+        const auto [parallel_parse_ns, parallel_node_count] = time_fastest_run_ns([text, &thread_pool]() { return parse_program_in_parallel(text, thread_pool); });
+        result.parse_in_parallel = stage_result_t{parallel_parse_ns / static_cast<double>(parallel_node_count), parallel_node_count};
+
+        const auto [lazy_parse_ns, lazy_node_count] = time_fastest_run_ns([text]() { return parse_program_lazily(text); });
+        result.parse_lazily = stage_result_t{lazy_parse_ns / static_cast<double>(node_count), lazy_node_count};
+    } else {
+        result.parse = std::nullopt;
+        result.parse_in_parallel = std::nullopt;
+        result.parse_lazily = std::nullopt;
+    }
+    std::cout.rdbuf(cout_buffer);
+
+    std::cout << name << ": " << text.size() << " bytes"
+              << ", scan_token: " << result.scan_token.ns_per_item << " ns/token"
+              << ", scan_merged_token: " << result.scan_merged_token.ns_per_item << " ns/token"
+              << ", scan_all_tokens: " << result.scan_all_tokens.ns_per_item << " ns/token"
+              << ", scan_all_tokens_parallel: " << result.scan_all_tokens_parallel.ns_per_item << " ns/token"
+              << ", merge_tokens: " << result.merge_tokens.ns_per_item << " ns/token";
+    if(result.parse.has_value()) {
+        std::cout << ", parse: " << result.parse->ns_per_item << " ns/node (" << result.parse->item_count << " nodes)"
+                  << ", parse_in_parallel: " << result.parse_in_parallel->ns_per_item << " ns/node"
+                  << ", parse_lazily: " << result.parse_lazily->ns_per_item << " ns/node (" << result.parse_lazily->item_count << " nodes parsed)\n";
+    } else {
+        std::cout << ", parse: invalid program\n";
+    }
+    return result;
+}
+
+
+std::string make_synthetic_program(const std::uint32_t function_count) {
+    std::string text = "typedef struct point_t { int x; long y; } point_t;\n";
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        text += "long g" + std::to_string(i) + " = " + std::to_string(i) + ";\n"
+                "unsigned long " + name + "(long a, unsigned int b) {\n"
+                "    long c = a * 3 + (b >> 2); // keep the comments in too\n"
+                "    if(c > 100) { c = c - a; } else { c += 1; }\n"
+                "    c = " + name + "(c, b) + -c;\n"
+                "    return c ? c : " + std::to_string(i) + ";\n"
+                "}\n";
+    }
+    text += "int main() {\n    return 0;\n}\n";
+    return text;
+}
+
+std::string escape_json_string(const std::string_view text) {
+    std::string escaped;
+    for(const char c : text) {
+        if(c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+void write_stage_json(std::ostream& out, const char *const name, const char *const item_name, const stage_result_t& stage) {
+    out << "\"" << name << "\": {\"ns_per_" << item_name << "\": " << stage.ns_per_item << ", \"" << item_name << "_count\": " << stage.item_count << "}";
+}
+void write_json(std::ostream& out, const std::uint32_t thread_count, const std::vector<input_result_t>& results) {
+    out << "{\n  \"benchmark\": \"frontend\",\n  \"threads\": " << thread_count << ",\n  \"results\": [\n";
+    for(std::size_t i = 0u; i < results.size(); ++i) {
+        const auto& result = results[i];
+        out << "    {\"input\": \"" << escape_json_string(result.name) << "\", \"bytes\": " << result.byte_count << ", ";
+        write_stage_json(out, "scan_token", "token", result.scan_token);
+        out << ", ";
+        write_stage_json(out, "scan_merged_token", "token", result.scan_merged_token);
+        out << ", ";
+        write_stage_json(out, "scan_all_tokens", "token", result.scan_all_tokens);
+        out << ", ";
+        write_stage_json(out, "scan_all_tokens_parallel", "token", result.scan_all_tokens_parallel);
+        out << ", ";
+        write_stage_json(out, "merge_tokens", "token", result.merge_tokens);
+        out << ", ";
+        if(result.parse.has_value()) {
+            write_stage_json(out, "parse", "node", result.parse.value());
+            out << ", ";
+            write_stage_json(out, "parse_in_parallel", "node", result.parse_in_parallel.value());
+            out << ", ";
+            write_stage_json(out, "parse_lazily", "node", result.parse_lazily.value());
+        } else {
+            out << "\"parse\": null, \"parse_in_parallel\": null, \"parse_lazily\": null";
+        }
+        out << ((i + 1u < results.size()) ? "},\n" : "}\n");
+    }
+    out << "  ]\n}\n";
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::string json_path;
+    std::vector<std::string> input_paths;
+    for(int i = 1; i < argc; ++i) {
+        if(std::string_view(argv[i]) == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if(std::filesystem::is_directory(argv[i])) {
+            std::vector<std::string> directory_paths;
+            for(const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+                if(entry.is_regular_file() && entry.path().extension() == ".c") {
+                    directory_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(std::begin(directory_paths), std::end(directory_paths));
+            input_paths.insert(std::end(input_paths), std::begin(directory_paths), std::end(directory_paths));
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+
+    utils::thread_pool_t thread_pool;
+    std::vector<input_result_t> results;
+    for(const auto& input_path : input_paths) {
+        const source_buffer_t source = load_source_file(input_path.c_str());
+        results.push_back(run_benchmark(input_path, source.view(), thread_pool));
+    }
+    for(const std::uint32_t function_count : {100u, 1000u, 10000u}) {
+        const std::string text = make_synthetic_program(function_count);
+        results.push_back(run_benchmark("synthetic (" + std::to_string(function_count) + " functions)", text, thread_pool));
+    }
+
+    if(!json_path.empty()) {
+        std::ofstream json_file(json_path);
+        if(!json_file) {
+            std::cerr << "Could not open " << json_path << " for writing\n";
+            return 1;
+        }
+        write_json(json_file, thread_pool.thread_count(), results);
+    }
+    return 0;
+}
@@ -0,0 +1,218 @@
+// Wall time from source text to exit code, in µs per program, of the three ways `foo_cc` has of running a program:
+//  - `jit`: compiled into executable memory and `main()` called in process (`--jit`, see `jit.hpp`).
+//  - `run`: compiled to bytecode and interpreted in process (`--run`, see `virtual_machine.hpp`).
+//  - `gcc`: the assembly written to a file, assembled and linked by `gcc`, and the binary run, as is done without either flag.
+// Every way includes the front end (parsing, type checking, folding and lowering to IR), which is the same for all of them.
+// Usage: `jit_benchmark [files or directories...]`. Directories are searched (non recursively) for `.c` files. Inputs that don't compile are skipped,
+//  as are all `gcc` timings if there is no `gcc` on the `PATH`. What the programs print is thrown away.
+// Every way is repeated until it has run for a while and the fastest repetition is reported, which is the least noisy number on a busy machine.
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <backend/interpreter/virtual_machine.hpp>
+#include <backend/x86_64/generate_from_ir.hpp>
+#include <backend/x86_64/jit.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <io/source_buffer.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <middle_end/optimization/fold_constants.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <utils/result.hpp>
+
+
+namespace {
+// Returns the fastest time in ns of running `function`, and what it returned the last time.
+template<typename F>
+std::pair<double, int> time_fastest_run_ns(F&& function) {
+    constexpr auto min_total_time = std::chrono::milliseconds(100);
+    constexpr std::uint32_t min_repetitions = 5u;
+
+    double fastest_ns = 0.0;
+    int exit_code = 0;
+    std::chrono::steady_clock::duration total_time{};
+    for(std::uint32_t repetition = 0u; repetition < min_repetitions || total_time < min_total_time; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        exit_code = function();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        total_time += elapsed;
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        fastest_ns = (repetition == 0u) ? elapsed_ns : std::min(fastest_ns, elapsed_ns);
+    }
+    return {fastest_ns, exit_code};
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+// Sends what the programs print (through `stdout`) to `/dev/null` for the lifetime of the scope. The parser's debug output goes through `std::cout`,
+//  which is silenced separately.
+class silenced_stdout_t {
+    int saved_stdout;
+
+public:
+    silenced_stdout_t() : saved_stdout(dup(STDOUT_FILENO)) {
+        std::fflush(stdout);
+        const int null_file = open("/dev/null", O_WRONLY);
+        dup2(null_file, STDOUT_FILENO);
+        close(null_file);
+    }
+    silenced_stdout_t(const silenced_stdout_t&) = delete;
+    silenced_stdout_t& operator=(const silenced_stdout_t&) = delete;
+    ~silenced_stdout_t() {
+        std::fflush(stdout);
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+    }
+};
+
+std::optional<ir::module_t> compile_to_ir(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    if(!program.has_value()) {
+        return std::nullopt;
+    }
+    utils::diagnostics_t diagnostics;
+    if(!type_check(program.value(), diagnostics).has_value()) {
+        return std::nullopt;
+    }
+    fold_constants(program.value());
+    return lower_to_ir(program.value());
+}
+
+int run_with_jit(const std::string_view text) {
+    utils::diagnostics_t diagnostics;
+    const auto program = compile_to_memory(compile_to_ir(text).value(), diagnostics);
+    return program.has_value() ? program.value().run_main() : -1;
+}
+int run_with_virtual_machine(const std::string_view text) {
+    utils::diagnostics_t diagnostics;
+    const auto program = compile_to_bytecode(compile_to_ir(text).value(), diagnostics);
+    const auto exit_code = program.has_value() ? run_program(program.value(), diagnostics) : utils::error;
+    return exit_code.has_value() ? exit_code.value() : -1;
+}
+int run_with_gcc(const std::string_view text, const std::filesystem::path& assembly_path, const std::filesystem::path& binary_path) {
+    std::ofstream(assembly_path) << generate_asm(compile_to_ir(text).value());
+    if(std::system(("gcc -o " + binary_path.string() + " " + assembly_path.string()).c_str()) != 0) {
+        return -1;
+    }
+    const int status = std::system(binary_path.string().c_str());
+    return WIFEXITED(status) ? static_cast<std::int8_t>(WEXITSTATUS(status)) : -1; // an exit status is only the low 8 bits of what `main()` returned
+}
+
+struct times_t {
+    double jit_ns = 0.0;
+    double run_ns = 0.0;
+    std::optional<double> gcc_ns;
+};
+
+std::optional<times_t> run_benchmark(const std::string& name, const std::string_view text, const bool has_gcc) {
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+    if(!compile_to_ir(text).has_value()) {
+        std::cout.rdbuf(cout_buffer);
+        std::cout << name << ": doesn't compile\n";
+        return std::nullopt;
+    }
+
+    const std::filesystem::path temporary_directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path assembly_path = temporary_directory / ("jit_benchmark_" + std::to_string(getpid()) + ".s");
+    const std::filesystem::path binary_path = temporary_directory / ("jit_benchmark_" + std::to_string(getpid()));
+    times_t times;
+    int jit_exit_code = 0;
+    int run_exit_code = 0;
+    std::optional<int> gcc_exit_code;
+    {
+        const silenced_stdout_t silenced_stdout;
+        std::tie(times.jit_ns, jit_exit_code) = time_fastest_run_ns([text]() { return run_with_jit(text); });
+        std::tie(times.run_ns, run_exit_code) = time_fastest_run_ns([text]() { return run_with_virtual_machine(text); });
+        if(has_gcc) {
+            const auto [gcc_ns, exit_code] = time_fastest_run_ns([&]() { return run_with_gcc(text, assembly_path, binary_path); });
+            times.gcc_ns = gcc_ns;
+            gcc_exit_code = exit_code;
+        }
+    }
+    std::filesystem::remove(assembly_path);
+    std::filesystem::remove(binary_path);
+    std::cout.rdbuf(cout_buffer);
+
+    const auto same_exit_code = [jit_exit_code](const int exit_code) {
+        return static_cast<std::int8_t>(exit_code) == static_cast<std::int8_t>(jit_exit_code);
+    };
+    std::cout << name << ": jit: " << times.jit_ns / 1000.0 << " us, run: " << times.run_ns / 1000.0 << " us";
+    if(times.gcc_ns.has_value()) {
+        std::cout << ", gcc: " << times.gcc_ns.value() / 1000.0 << " us";
+    }
+    std::cout << " (exit code " << jit_exit_code << ")";
+    if(!same_exit_code(run_exit_code) || (gcc_exit_code.has_value() && !same_exit_code(gcc_exit_code.value()))) {
+        std::cout << ", but exit codes differ: run " << run_exit_code << ", gcc " << gcc_exit_code.value_or(0);
+    }
+    std::cout << '\n';
+    return times;
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::vector<std::string> input_paths;
+    for(int i = 1; i < argc; ++i) {
+        if(std::filesystem::is_directory(argv[i])) {
+            std::vector<std::string> directory_paths;
+            for(const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+                if(entry.is_regular_file() && entry.path().extension() == ".c") {
+                    directory_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(std::begin(directory_paths), std::end(directory_paths));
+            input_paths.insert(std::end(input_paths), std::begin(directory_paths), std::end(directory_paths));
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+
+    const bool has_gcc = (std::system("gcc --version > /dev/null 2>&1") == 0);
+    times_t total;
+    std::size_t program_count = 0u;
+    for(const auto& input_path : input_paths) {
+        const source_buffer_t source = load_source_file(input_path.c_str());
+        const auto times = run_benchmark(input_path, source.view(), has_gcc);
+        if(!times.has_value()) {
+            continue;
+        }
+        ++program_count;
+        total.jit_ns += times->jit_ns;
+        total.run_ns += times->run_ns;
+        if(has_gcc) {
+            total.gcc_ns = total.gcc_ns.value_or(0.0) + times->gcc_ns.value();
+        }
+    }
+    std::cout << "total (" << program_count << " programs): jit: " << total.jit_ns / 1000.0 << " us, run: " << total.run_ns / 1000.0 << " us";
+    if(total.gcc_ns.has_value()) {
+        std::cout << ", gcc: " << total.gcc_ns.value() / 1000.0 << " us";
+    }
+    std::cout << '\n';
+    return 0;
+}
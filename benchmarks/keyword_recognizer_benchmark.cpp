@@ -0,0 +1,257 @@
+// Compares the table generated keyword perfect hash and punctuator DFA in `lexeme_tables.hpp` against the hand written switch trees they replaced,
+//  on a keyword and operator heavy corpus.
+// Usage: `keyword_recognizer_benchmark [files...]`. Without any files, a synthetic corpus is used.
+// Only the classification step is timed: the identifiers and punctuators are split out of the text up front, so that scanning them doesn't drown out the difference.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <frontend/lexing/lexeme_tables.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <io/source_buffer.hpp>
+#include <utils/common.hpp>
+
+
+namespace {
+// The switch based recognizers, as they were in `lexer.cpp` before the tables:
+
+token_type_t match_keyword_switch(const std::string_view text, const std::uint32_t start_index, const std::string_view expected, const token_type_t expected_type) {
+    if(text.size() == (start_index + expected.length())
+    && std::memcmp(expected.data(), text.data() + start_index, expected.length()) == 0) {
+        return expected_type;
+    }
+    return token_type_t::IDENTIFIER;
+}
+token_type_t classify_identifier_switch(const std::string_view text) {
+    switch(text[0]) {
+        case 'c':
+            return match_keyword_switch(text, 1, "har", token_type_t::CHAR_KEYWORD);
+        case 'd':
+            return match_keyword_switch(text, 1, "ouble", token_type_t::DOUBLE_KEYWORD);
+        case 'e':
+            return match_keyword_switch(text, 1, "lse", token_type_t::ELSE_KEYWORD);
+        case 'f':
+            return match_keyword_switch(text, 1, "loat", token_type_t::FLOAT_KEYWORD);
+        case 'i':
+            if(text.size() > 1) {
+                switch(text[1]) {
+                    case 'f':
+                        return match_keyword_switch(text, 2, "", token_type_t::IF_KEYWORD);
+                    case 'n':
+                        return match_keyword_switch(text, 2, "t", token_type_t::INT_KEYWORD);
+                }
+            }
+            break;
+        case 'l':
+            return match_keyword_switch(text, 1, "ong", token_type_t::LONG_KEYWORD);
+        case 'r':
+            return match_keyword_switch(text, 1, "eturn", token_type_t::RETURN_KEYWORD);
+        case 's':
+            if(text.size() > 1) {
+                switch(text[1]) {
+                    case 'h':
+                        return match_keyword_switch(text, 2, "ort", token_type_t::SHORT_KEYWORD);
+                    case 'i':
+                        return match_keyword_switch(text, 2, "gned", token_type_t::SIGNED_KEYWORD);
+                    case 't':
+                        return match_keyword_switch(text, 2, "ruct", token_type_t::STRUCT_KEYWORD);
+                }
+            }
+            break;
+        case 't':
+            return match_keyword_switch(text, 1, "ypedef", token_type_t::TYPEDEF_KEYWORD);
+        case 'u':
+            return match_keyword_switch(text, 1, "nsigned", token_type_t::UNSIGNED_KEYWORD);
+    }
+    return token_type_t::IDENTIFIER;
+}
+
+punctuator_match_t match_punctuator_switch(const char *const begin, const char *const end) {
+    const auto next_is = [begin, end](const std::uint32_t index, const char expected) {
+        return begin + index < end && begin[index] == expected;
+    };
+    switch(*begin) {
+        case '(': return {token_type_t::LEFT_PAREN, 1u};
+        case ')': return {token_type_t::RIGHT_PAREN, 1u};
+        case '{': return {token_type_t::LEFT_CURLY, 1u};
+        case '}': return {token_type_t::RIGHT_CURLY, 1u};
+        case ';': return {token_type_t::SEMICOLON, 1u};
+        case '-':
+            if(next_is(1u, '=')) return {token_type_t::MINUS_EQUALS, 2u};
+            if(next_is(1u, '-')) return {token_type_t::DASH_DASH, 2u};
+            return {token_type_t::DASH, 1u};
+        case '~': return {token_type_t::TILDE, 1u};
+        case '!':
+            if(next_is(1u, '=')) return {token_type_t::NOT_EQUAL, 2u};
+            return {token_type_t::BANG, 1u};
+        case '+':
+            if(next_is(1u, '=')) return {token_type_t::PLUS_EQUALS, 2u};
+            if(next_is(1u, '+')) return {token_type_t::PLUS_PLUS, 2u};
+            return {token_type_t::PLUS, 1u};
+        case '*':
+            if(next_is(1u, '=')) return {token_type_t::TIMES_EQUALS, 2u};
+            return {token_type_t::ASTERISK, 1u};
+        case '/':
+            if(next_is(1u, '=')) return {token_type_t::DIVIDE_EQUALS, 2u};
+            return {token_type_t::SLASH, 1u};
+        case '&':
+            if(next_is(1u, '&')) return {token_type_t::LOGIC_AND, 2u};
+            if(next_is(1u, '=')) return {token_type_t::AND_EQUALS, 2u};
+            return {token_type_t::BITWISE_AND, 1u};
+        case '|':
+            if(next_is(1u, '|')) return {token_type_t::LOGIC_OR, 2u};
+            if(next_is(1u, '=')) return {token_type_t::OR_EQUALS, 2u};
+            return {token_type_t::BITWISE_OR, 1u};
+        case '<':
+            if(next_is(1u, '=')) return {token_type_t::LESS_THAN_EQUAL, 2u};
+            if(next_is(1u, '<')) {
+                if(next_is(2u, '=')) return {token_type_t::LEFT_SHIFT_EQUALS, 3u};
+                return {token_type_t::BITWISE_LEFT_SHIFT, 2u};
+            }
+            return {token_type_t::LESS_THAN, 1u};
+        case '>':
+            if(next_is(1u, '=')) return {token_type_t::GREATER_THAN_EQUAL, 2u};
+            if(next_is(1u, '>')) {
+                if(next_is(2u, '=')) return {token_type_t::RIGHT_SHIFT_EQUALS, 3u};
+                return {token_type_t::BITWISE_RIGHT_SHIFT, 2u};
+            }
+            return {token_type_t::GREATER_THAN, 1u};
+        case '=':
+            if(next_is(1u, '=')) return {token_type_t::EQUAL_EQUAL, 2u};
+            return {token_type_t::EQUALS, 1u};
+        case '%':
+            if(next_is(1u, '=')) return {token_type_t::MODULO_EQUALS, 2u};
+            return {token_type_t::MODULO, 1u};
+        case '^':
+            if(next_is(1u, '=')) return {token_type_t::XOR_EQUALS, 2u};
+            return {token_type_t::BITWISE_XOR, 1u};
+        case ',': return {token_type_t::COMMA, 1u};
+        case '?': return {token_type_t::QUESTION_MARK, 1u};
+        case ':': return {token_type_t::COLON, 1u};
+        case '.': return {token_type_t::DOT, 1u};
+    }
+    return {token_type_t::ERROR, 0u};
+}
+
+
+struct lexemes_t {
+    std::vector<std::string_view> identifiers;
+    std::vector<const char*> punctuators; // start of each punctuator, they all end at most 3 characters later (or at the end of the text)
+    const char* end;
+};
+// Splits `text` into identifiers and punctuators. Everything else (whitespace, numbers, comments are not expected) is skipped.
+lexemes_t split_lexemes(const std::string_view text) {
+    lexemes_t lexemes{{}, {}, text.data() + text.size()};
+    for(const char* current = text.data(); current != lexemes.end;) {
+        if(utils::is_alpha(*current)) {
+            const char *const start = current;
+            while(current != lexemes.end && utils::is_alpha_num(*current)) {
+                ++current;
+            }
+            lexemes.identifiers.emplace_back(start, static_cast<std::size_t>(current - start));
+        } else if(const auto match = match_punctuator(current, lexemes.end); match.token_type != token_type_t::ERROR) {
+            lexemes.punctuators.push_back(current);
+            current += match.length;
+        } else {
+            ++current;
+        }
+    }
+    return lexemes;
+}
+
+std::string make_keyword_heavy_corpus(const std::uint32_t function_count) {
+    std::string text;
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string suffix = std::to_string(i);
+        text += "typedef struct s" + suffix + " t" + suffix + ";\n"
+                "unsigned long f" + suffix + "(signed short a, unsigned char b, long double c, float d) {\n"
+                "    int integer = a <<= b >>= a; short shorts = a != b && a <= b || !a;\n"
+                "    if(a >= b) { return a++ ^ b--; } else { return (double)c ? d : a % b; }\n"
+                "    a += b; a -= b; a *= b; a /= b; a %= b; a &= b; a |= b; a ^= b; ifx = ~a, a == b, a.b, &a;\n"
+                "}\n";
+    }
+    return text;
+}
+
+// Runs `function` over the lexemes enough times to take a measurable amount of time and returns the average time per lexeme.
+template<typename F>
+double time_ns_per_lexeme(const std::size_t lexeme_count, F&& function) {
+    constexpr std::uint32_t repetitions = 50u;
+    std::uint64_t checksum = 0u;
+    const auto start = std::chrono::steady_clock::now();
+    for(std::uint32_t i = 0u; i < repetitions; ++i) {
+        checksum += function();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    static volatile std::uint64_t sink;
+    sink = checksum; // keep the work from being optimized away
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(repetitions * lexeme_count);
+}
+
+void run_benchmark(const std::string& name, const std::string_view text) {
+    const lexemes_t lexemes = split_lexemes(text);
+    std::size_t keyword_count = 0u;
+    for(const auto identifier : lexemes.identifiers) {
+        if(classify_identifier_switch(identifier) != classify_identifier(identifier)) {
+            std::cout << "Mismatch between the recognizers on identifier `" << identifier << "`\n";
+            return;
+        }
+        keyword_count += (classify_identifier(identifier) != token_type_t::IDENTIFIER);
+    }
+    for(const char *const punctuator : lexemes.punctuators) {
+        const auto switch_match = match_punctuator_switch(punctuator, lexemes.end);
+        const auto table_match = match_punctuator(punctuator, lexemes.end);
+        if(switch_match.token_type != table_match.token_type || switch_match.length != table_match.length) {
+            std::cout << "Mismatch between the recognizers on punctuator `" << std::string_view(punctuator, table_match.length) << "`\n";
+            return;
+        }
+    }
+
+    const auto classify_all = [&lexemes](auto classify) {
+        return [&lexemes, classify]() {
+            std::uint64_t checksum = 0u;
+            for(const auto identifier : lexemes.identifiers) {
+                checksum += static_cast<std::uint64_t>(classify(identifier));
+            }
+            return checksum;
+        };
+    };
+    const auto match_all = [&lexemes](auto match) {
+        return [&lexemes, match]() {
+            std::uint64_t checksum = 0u;
+            for(const char *const punctuator : lexemes.punctuators) {
+                checksum += match(punctuator, lexemes.end).length;
+            }
+            return checksum;
+        };
+    };
+
+    const std::size_t identifier_count = lexemes.identifiers.size();
+    const std::size_t punctuator_count = lexemes.punctuators.size();
+    std::cout << name << ": " << identifier_count << " identifiers (" << keyword_count << " keywords), " << punctuator_count << " punctuators\n"
+              << "    identifiers ns/lexeme: switch: " << time_ns_per_lexeme(identifier_count, classify_all([](const std::string_view text) { return classify_identifier_switch(text); }))
+              << ", perfect hash: " << time_ns_per_lexeme(identifier_count, classify_all([](const std::string_view text) { return classify_identifier(text); })) << '\n'
+              << "    punctuators ns/lexeme: switch: " << time_ns_per_lexeme(punctuator_count, match_all([](const char *const begin, const char *const end) { return match_punctuator_switch(begin, end); }))
+              << ", DFA: " << time_ns_per_lexeme(punctuator_count, match_all([](const char *const begin, const char *const end) { return match_punctuator(begin, end); })) << '\n';
+}
+}
+
+
+int main(int argc, char** argv) {
+    if(argc > 1) {
+        for(int i = 1; i < argc; ++i) {
+            const source_buffer_t source = load_source_file(argv[i]);
+            run_benchmark(argv[i], source.view());
+        }
+        return 0;
+    }
+
+    const std::string text = make_keyword_heavy_corpus(10000u);
+    run_benchmark("synthetic (keyword heavy)", text);
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Time from IR to an object file on disk, in ms per program, of the two ways `foo_cc` has of making one:
+//  - `assembly`: `generate_asm()`, written to a file that `gcc -c` assembles, which is what building without `-c` takes.
+//  - `object`: `generate_object()`, written to a file (`-c`, see `elf_writer.hpp`).
+// The front end and the lowering to IR are the same for both and aren't timed.
+// Usage: `object_benchmark [files or directories...]`. Directories are searched (non recursively) for `.c` files. Synthetic programs of increasing size are
+//  always benchmarked as well, as the difference is in the time per instruction. Inputs that don't compile are skipped, as are all `assembly` timings if
+//  there is no `gcc` on the `PATH`.
+// Every way is repeated until it has run for a while and the fastest repetition is reported, which is the least noisy number on a busy machine.
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <backend/x86_64/elf_writer.hpp>
+#include <backend/x86_64/generate_from_ir.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <io/source_buffer.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <middle_end/optimization/fold_constants.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <utils/result.hpp>
+
+
+namespace {
+// Returns the fastest time in ns of running `function`.
+template<typename F>
+double time_fastest_run_ns(F&& function) {
+    constexpr auto min_total_time = std::chrono::milliseconds(100);
+    constexpr std::uint32_t min_repetitions = 5u;
+
+    double fastest_ns = 0.0;
+    std::chrono::steady_clock::duration total_time{};
+    for(std::uint32_t repetition = 0u; repetition < min_repetitions || total_time < min_total_time; ++repetition) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        total_time += elapsed;
+        const double elapsed_ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        fastest_ns = (repetition == 0u) ? elapsed_ns : std::min(fastest_ns, elapsed_ns);
+    }
+    return fastest_ns;
+}
+
+
+class null_buffer_t : public std::streambuf {
+protected:
+    int overflow(const int c) override {
+        return c;
+    }
+};
+
+std::optional<ir::module_t> compile_to_ir(const std::string_view text) {
+    // the parser prints debug output
+    null_buffer_t null_buffer;
+    auto *const cout_buffer = std::cout.rdbuf(&null_buffer);
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    utils::diagnostics_t diagnostics;
+    const bool is_valid = program.has_value() && type_check(program.value(), diagnostics).has_value();
+    std::cout.rdbuf(cout_buffer);
+    if(!is_valid) {
+        return std::nullopt;
+    }
+    fold_constants(program.value());
+    return lower_to_ir(program.value());
+}
+
+void run_benchmark(const std::string& name, const std::string_view text, const bool has_gcc) {
+    const std::optional<ir::module_t> module = compile_to_ir(text);
+    if(!module.has_value()) {
+        std::cout << name << ": doesn't compile\n";
+        return;
+    }
+
+    const std::filesystem::path temporary_directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path assembly_path = temporary_directory / ("object_benchmark_" + std::to_string(getpid()) + ".s");
+    const std::filesystem::path object_path = temporary_directory / ("object_benchmark_" + std::to_string(getpid()) + ".o");
+    const std::string assemble_command = "gcc -c -o " + object_path.string() + " " + assembly_path.string();
+
+    std::size_t object_size = 0u;
+    const double object_ns = time_fastest_run_ns([&]() {
+        const std::string object = generate_object(module.value());
+        std::ofstream(object_path, std::ios::binary) << object;
+        object_size = object.size();
+    });
+    std::cout << name << ": object: " << object_ns / 1e6 << " ms (" << object_size << " bytes)";
+    if(has_gcc) {
+        const double assembly_ns = time_fastest_run_ns([&]() {
+            std::ofstream(assembly_path) << generate_asm(module.value());
+            std::system(assemble_command.c_str());
+        });
+        std::cout << ", assembly: " << assembly_ns / 1e6 << " ms (" << assembly_ns / object_ns << "x)";
+    }
+    std::cout << '\n';
+    std::filesystem::remove(assembly_path);
+    std::filesystem::remove(object_path);
+}
+
+
+std::string make_synthetic_program(const std::uint32_t function_count) {
+    std::string text;
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        text += "long g" + std::to_string(i) + " = " + std::to_string(i) + ";\n"
+                "unsigned long " + name + "(long a, unsigned int b, double d) {\n"
+                "    long c = a * 3 + (b >> 2) + d / 2.0;\n"
+                "    if(c > 100) { c = c - a; } else { c = c % 7; }\n"
+                "    c = " + name + "(c, b, d * c) + -c + g" + std::to_string(i) + ";\n"
+                "    return c ? c : " + std::to_string(i) + ";\n"
+                "}\n";
+    }
+    text += "int main() {\n    return 0;\n}\n";
+    return text;
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::vector<std::string> input_paths;
+    for(int i = 1; i < argc; ++i) {
+        if(std::filesystem::is_directory(argv[i])) {
+            std::vector<std::string> directory_paths;
+            for(const auto& entry : std::filesystem::directory_iterator(argv[i])) {
+                if(entry.is_regular_file() && entry.path().extension() == ".c") {
+                    directory_paths.push_back(entry.path().string());
+                }
+            }
+            std::sort(std::begin(directory_paths), std::end(directory_paths));
+            input_paths.insert(std::end(input_paths), std::begin(directory_paths), std::end(directory_paths));
+        } else {
+            input_paths.push_back(argv[i]);
+        }
+    }
+
+    const bool has_gcc = (std::system("gcc --version > /dev/null 2>&1") == 0);
+    for(const auto& input_path : input_paths) {
+        const source_buffer_t source = load_source_file(input_path.c_str());
+        run_benchmark(input_path, source.view(), has_gcc);
+    }
+    for(const std::uint32_t function_count : {100u, 1000u, 10000u}) {
+        run_benchmark("synthetic (" + std::to_string(function_count) + " functions)", make_synthetic_program(function_count), has_gcc);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Compares the peak heap usage of materializing every token of a file up front, either as an array of `token_t`s (what the front end used to do)
+//  or as a compact `token_table_t`, against pulling the tokens through `token_stream_t`.
+// Usage: `token_memory_benchmark [files...]`. Without any files, synthetic programs of increasing size are used.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/lexing/token_table.hpp>
+#include <io/source_buffer.hpp>
+
+
+namespace {
+std::size_t current_heap_bytes = 0u;
+std::size_t peak_heap_bytes = 0u;
+
+// every allocation is prefixed with its size so that unsized `operator delete` can account for it too
+constexpr std::size_t allocation_header_size = alignof(std::max_align_t);
+}
+
+void* operator new(const std::size_t size) {
+    void *const block = std::malloc(size + allocation_header_size);
+    if(block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    current_heap_bytes += size;
+    if(current_heap_bytes > peak_heap_bytes) {
+        peak_heap_bytes = current_heap_bytes;
+    }
+    return static_cast<unsigned char*>(block) + allocation_header_size;
+}
+void operator delete(void *const pointer) noexcept {
+    if(pointer == nullptr) {
+        return;
+    }
+    void *const block = static_cast<unsigned char*>(pointer) - allocation_header_size;
+    current_heap_bytes -= *static_cast<std::size_t*>(block);
+    std::free(block);
+}
+void operator delete(void *const pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+
+namespace {
+// returns the number of heap bytes allocated at the high water mark while running `function`, on top of what was already allocated before
+template<typename F>
+std::size_t measure_peak_heap_bytes(F&& function) {
+    const std::size_t starting_heap_bytes = current_heap_bytes;
+    peak_heap_bytes = current_heap_bytes;
+    std::forward<F>(function)();
+    return peak_heap_bytes - starting_heap_bytes;
+}
+
+std::size_t materialize_token_array(const std::string_view text) {
+    token_stream_t token_stream(lexer_t{text});
+    std::vector<token_t> tokens;
+    for(;;) {
+        const token_index_t token = token_stream.advance_token();
+        tokens.push_back(token_t{token_stream.token_type(token), token_stream.token_text(token)});
+        if(tokens.back().token_type == token_type_t::EOF_TOK) {
+            break;
+        }
+    }
+    return tokens.size();
+}
+std::size_t materialize_token_table(const std::string_view text) {
+    return scan_all_tokens(lexer_t{text}).size();
+}
+std::size_t stream_tokens(const std::string_view text) {
+    token_stream_t token_stream(lexer_t{text});
+    std::size_t token_count = 1u;
+    for(; token_stream.token_type(token_stream.advance_token()) != token_type_t::EOF_TOK; ++token_count);
+    return token_count;
+}
+
+std::string make_synthetic_program(const std::uint32_t function_count) {
+    std::string text;
+    for(std::uint32_t i = 0u; i < function_count; ++i) {
+        const std::string name = "f" + std::to_string(i);
+        text += "unsigned long " + name + "(long a, unsigned int b) {\n"
+                "    long c = a * 3 + (b >> 2);\n"
+                "    if(c > 100) { c = c - a; } // keep the comments in too\n"
+                "    return c ? c : " + std::to_string(i) + ";\n"
+                "}\n";
+    }
+    text += "int main() {\n    return 0;\n}\n";
+    return text;
+}
+
+void run_benchmark(const std::string& name, const std::string_view text) {
+    std::size_t token_count = 0u;
+    const std::size_t token_array_bytes = measure_peak_heap_bytes([&]() { token_count = materialize_token_array(text); });
+    const std::size_t token_table_bytes = measure_peak_heap_bytes([&]() { materialize_token_table(text); });
+    const std::size_t streamed_bytes = measure_peak_heap_bytes([&]() { stream_tokens(text); });
+
+    std::cout << name
+              << ": " << text.size() << " bytes, " << token_count << " tokens"
+              << ", token_t array peak heap: " << token_array_bytes << " bytes"
+              << ", token table peak heap: " << token_table_bytes << " bytes"
+              << ", streamed peak heap: " << streamed_bytes << " bytes\n";
+}
+}
+
+
+int main(int argc, char** argv) {
+    std::cout << "bytes/token: token_t: " << sizeof(token_t) << ", token table: " << token_table_t::bytes_per_token << '\n';
+
+    if(argc > 1) {
+        for(int i = 1; i < argc; ++i) {
+            const source_buffer_t source = load_source_file(argv[i]);
+            run_benchmark(argv[i], source.view());
+        }
+        return 0;
+    }
+
+    for(const std::uint32_t function_count : {100u, 1000u, 10000u}) {
+        const std::string text = make_synthetic_program(function_count);
+        run_benchmark("synthetic (" + std::to_string(function_count) + " functions)", text);
+    }
+    return 0;
+}
@@ -1,226 +1,414 @@
 #include "compile_time_evaluator.hpp"
 
+#include <array>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <type_traits>
 
-ast::constant_t evaluate_unary_expression(const ast::constant_t& operand, const ast::unary_operator_token_t operator_token) {
-    return std::visit(overloaded{
-        [operator_token](const int unwrapped_operand) {
-            switch(operator_token) {
-                case ast::unary_operator_token_t::PLUS:
-                    return ast::constant_t{unwrapped_operand};
-                case ast::unary_operator_token_t::MINUS:
-                    return  ast::constant_t{-unwrapped_operand};
-                case ast::unary_operator_token_t::LOGICAL_NOT:
-                    return  ast::constant_t{!unwrapped_operand};
-                case ast::unary_operator_token_t::BITWISE_NOT:
-                    return  ast::constant_t{~unwrapped_operand};
-            }
-            throw std::logic_error("Unsupported unary operator.");
-        },
-        [operator_token](const auto& unwrapped_operand) {
-            switch(operator_token) {
-                case ast::unary_operator_token_t::PLUS:
-                    return ast::constant_t{unwrapped_operand};
-                case ast::unary_operator_token_t::MINUS:
-                    return  ast::constant_t{-unwrapped_operand};
-                case ast::unary_operator_token_t::LOGICAL_NOT:
-                    return  ast::constant_t{!unwrapped_operand};
-
-                case ast::unary_operator_token_t::BITWISE_NOT:
-                    throw std::runtime_error("Unsupported unary operator.");
-            }
-            throw std::logic_error("Unsupported unary operator.");
+
+namespace {
+struct constant_kind_info_t {
+    std::uint8_t size;
+    bool is_signed;
+    bool is_floating;
+    std::uint8_t rank; // of the usual arithmetic conversions, the floating point kinds rank above every integer kind
+};
+// indexed by `constant_kind_t`
+constexpr std::array<constant_kind_info_t, 14u> CONSTANT_KIND_INFOS{{
+    {1u, true, false, 1u}, // `char` is signed on x86_64
+    {1u, true, false, 1u},
+    {1u, false, false, 1u},
+    {2u, true, false, 2u},
+    {2u, false, false, 2u},
+    {4u, true, false, 3u},
+    {4u, false, false, 3u},
+    {8u, true, false, 4u},
+    {8u, false, false, 4u},
+    {8u, true, false, 5u},
+    {8u, false, false, 5u},
+    {4u, true, true, 6u},
+    {8u, true, true, 7u},
+    {16u, true, true, 8u},
+}};
+constexpr const constant_kind_info_t& get_info(const constant_kind_t kind) {
+    return CONSTANT_KIND_INFOS[static_cast<std::size_t>(kind)];
+}
+constexpr bool is_floating(const constant_kind_t kind) {
+    return get_info(kind).is_floating;
+}
+constexpr bool is_signed(const constant_kind_t kind) {
+    return get_info(kind).is_signed;
+}
+
+// Truncates `bits` to the width of `kind`, an integer kind, and extends them back to 64 bits.
+constant_value_t make_integer(const constant_kind_t kind, const std::uint64_t bits) {
+    const unsigned unused_bits = 64u - get_info(kind).size * 8u;
+    constant_value_t value{kind, {}};
+    if(is_signed(kind)) {
+        value.signed_value = static_cast<std::int64_t>(bits << unused_bits) >> unused_bits;
+    } else {
+        value.unsigned_value = (bits << unused_bits) >> unused_bits;
+    }
+    return value;
+}
+constant_value_t make_floating(const constant_kind_t kind, const double floating_value) {
+    constant_value_t value{kind, {}};
+    value.floating_value = (kind == constant_kind_t::FLOAT) ? static_cast<double>(static_cast<float>(floating_value)) : floating_value;
+    return value;
+}
+// the two's complement bits of an integer
+std::uint64_t get_bits(const constant_value_t& value) {
+    return is_signed(value.kind) ? static_cast<std::uint64_t>(value.signed_value) : value.unsigned_value;
+}
+}
+bool is_nonzero(const constant_value_t& value) {
+    return is_floating(value.kind) ? (value.floating_value != 0.0) : (get_bits(value) != 0u);
+}
+namespace {
+
+// Doesn't check that floating point values are in range of the integer kinds they are converted to, see `convert_floating_to_integer()`.
+constant_value_t convert(const constant_value_t& value, const constant_kind_t kind) {
+    if(!is_floating(kind)) {
+        if(!is_floating(value.kind)) { // the most common conversion, so it is checked for first
+            return make_integer(kind, get_bits(value));
+        }
+        const std::uint64_t bits = is_signed(kind) ? static_cast<std::uint64_t>(static_cast<std::int64_t>(value.floating_value)) : static_cast<std::uint64_t>(value.floating_value);
+        return make_integer(kind, bits);
+    } else if(is_floating(value.kind)) {
+        return make_floating(kind, value.floating_value);
+    } else if(kind == constant_kind_t::FLOAT) { // rounded straight to `float`, rounding to `double` first could round differently
+        return make_floating(kind, is_signed(value.kind) ? static_cast<float>(value.signed_value) : static_cast<float>(value.unsigned_value));
+    }
+    return make_floating(kind, is_signed(value.kind) ? static_cast<double>(value.signed_value) : static_cast<double>(value.unsigned_value));
+}
+utils::result_t<constant_value_t> convert_floating_to_integer(const constant_value_t& value, const constant_kind_t kind, utils::diagnostics_t& diagnostics) {
+    // the bounds are exact in a `long double`, which has a 64 bit mantissa
+    const int bits = get_info(kind).size * 8;
+    const long double minimum = is_signed(kind) ? -std::ldexp(1.0L, bits - 1) : 0.0L;
+    const long double maximum = is_signed(kind) ? std::ldexp(1.0L, bits - 1) - 1.0L : std::ldexp(1.0L, bits) - 1.0L;
+    const long double floating_value = value.floating_value;
+    if(!(floating_value > minimum - 1.0L && floating_value < maximum + 1.0L)) {
+        return diagnostics.report("Floating point value out of range of the integer type it is converted to.");
+    }
+    return convert(value, kind);
+}
+
+constexpr constant_kind_t promote(const constant_kind_t kind) {
+    return (get_info(kind).rank < get_info(constant_kind_t::INT).rank) ? constant_kind_t::INT : kind;
+}
+// the usual arithmetic conversions
+constexpr constant_kind_t compute_common_kind(const constant_kind_t left, const constant_kind_t right) {
+    if(left == right) {
+        return promote(left);
+    }
+    const constant_kind_t promoted_left = promote(left);
+    const constant_kind_t promoted_right = promote(right);
+    const constant_kind_info_t& left_info = get_info(promoted_left);
+    const constant_kind_info_t& right_info = get_info(promoted_right);
+    if(left_info.is_floating || right_info.is_floating || left_info.is_signed == right_info.is_signed) {
+        return (left_info.rank >= right_info.rank) ? promoted_left : promoted_right;
+    }
+    const constant_kind_t signed_kind = left_info.is_signed ? promoted_left : promoted_right;
+    const constant_kind_t unsigned_kind = left_info.is_signed ? promoted_right : promoted_left;
+    if(get_info(unsigned_kind).rank >= get_info(signed_kind).rank) {
+        return unsigned_kind;
+    } else if(get_info(signed_kind).size > get_info(unsigned_kind).size) { // the signed kind can hold every value of the unsigned one
+        return signed_kind;
+    }
+    return static_cast<constant_kind_t>(static_cast<std::uint8_t>(signed_kind) + 1u); // the unsigned kind of the same rank
+}
+// `compute_common_kind()` of every pair of kinds, looked up instead of computed as operands of different kinds are common in constant expressions
+constexpr std::size_t NUMBER_OF_KINDS = CONSTANT_KIND_INFOS.size();
+constexpr std::array<std::array<constant_kind_t, NUMBER_OF_KINDS>, NUMBER_OF_KINDS> make_common_kinds() {
+    std::array<std::array<constant_kind_t, NUMBER_OF_KINDS>, NUMBER_OF_KINDS> common_kinds{};
+    for(std::size_t left = 0u; left < NUMBER_OF_KINDS; ++left) {
+        for(std::size_t right = 0u; right < NUMBER_OF_KINDS; ++right) {
+            common_kinds[left][right] = compute_common_kind(static_cast<constant_kind_t>(left), static_cast<constant_kind_t>(right));
+        }
+    }
+    return common_kinds;
+}
+constexpr auto COMMON_KINDS = make_common_kinds();
+constant_kind_t get_common_kind(const constant_kind_t left, const constant_kind_t right) {
+    return COMMON_KINDS[static_cast<std::size_t>(left)][static_cast<std::size_t>(right)];
+}
+
+
+// Integer operations take and return two's complement bits (see `get_bits()`), of operands that were converted to the same kind.
+using integer_operation_t = std::uint64_t (*)(std::uint64_t left, std::uint64_t right, bool is_signed);
+using floating_operation_t = double (*)(double left, double right);
+enum class binary_result_kind_t : std::uint8_t {
+    COMMON, // the operands are converted to their common kind, which is the kind of the result
+    INT, // the operands are converted to their common kind, the result is an `int`
+    PROMOTED_LEFT, // shifts: the result has the promoted kind of the left operand, the operands are promoted separately
+};
+struct binary_operation_t {
+    binary_result_kind_t result_kind;
+    bool is_division; // a zero right operand is reported
+    integer_operation_t integer_operation; // `nullptr` if the operator is not supported at compile time
+    floating_operation_t floating_operation; // `nullptr` if the operator doesn't apply to floating point operands
+};
+std::uint64_t divide(const std::uint64_t left, const std::uint64_t right, const bool is_signed) {
+    if(!is_signed) {
+        return left / right;
+    } else if(static_cast<std::int64_t>(right) == -1) { // `INT64_MIN / -1` overflows
+        return 0u - left;
+    }
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(left) / static_cast<std::int64_t>(right));
+}
+std::uint64_t modulo(const std::uint64_t left, const std::uint64_t right, const bool is_signed) {
+    if(!is_signed) {
+        return left % right;
+    } else if(static_cast<std::int64_t>(right) == -1) {
+        return 0u;
+    }
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(left) % static_cast<std::int64_t>(right));
+}
+template<typename Compare>
+std::uint64_t compare_integers(const std::uint64_t left, const std::uint64_t right, const bool is_signed) {
+    return is_signed ? Compare{}(static_cast<std::int64_t>(left), static_cast<std::int64_t>(right)) : Compare{}(left, right);
+}
+template<typename Compare>
+double compare_floating(const double left, const double right) {
+    return Compare{}(left, right) ? 1.0 : 0.0;
+}
+// indexed by `ast::binary_operator_token_t`
+constexpr std::array<binary_operation_t, 20u> BINARY_OPERATIONS{{
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l * r; }, [](double l, double r) { return l * r; }}, // MULTIPLY
+    {binary_result_kind_t::COMMON, true, divide, [](double l, double r) { return l / r; }}, // DIVIDE
+    {binary_result_kind_t::COMMON, true, modulo, nullptr}, // MODULO
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l + r; }, [](double l, double r) { return l + r; }}, // PLUS
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l - r; }, [](double l, double r) { return l - r; }}, // MINUS
+    {binary_result_kind_t::PROMOTED_LEFT, false, [](std::uint64_t l, std::uint64_t r, bool) { return l << r; }, nullptr}, // LEFT_BITSHIFT
+    {binary_result_kind_t::PROMOTED_LEFT, false, [](std::uint64_t l, std::uint64_t r, bool is_signed) {
+        return is_signed ? static_cast<std::uint64_t>(static_cast<std::int64_t>(l) >> r) : (l >> r);
+    }, nullptr}, // RIGHT_BITSHIFT
+    {binary_result_kind_t::INT, false, compare_integers<std::less<>>, compare_floating<std::less<>>}, // LESS_THAN
+    {binary_result_kind_t::INT, false, compare_integers<std::less_equal<>>, compare_floating<std::less_equal<>>}, // LESS_THAN_EQUAL
+    {binary_result_kind_t::INT, false, compare_integers<std::greater<>>, compare_floating<std::greater<>>}, // GREATER_THAN
+    {binary_result_kind_t::INT, false, compare_integers<std::greater_equal<>>, compare_floating<std::greater_equal<>>}, // GREATER_THAN_EQUAL
+    {binary_result_kind_t::INT, false, compare_integers<std::equal_to<>>, compare_floating<std::equal_to<>>}, // EQUAL
+    {binary_result_kind_t::INT, false, compare_integers<std::not_equal_to<>>, compare_floating<std::not_equal_to<>>}, // NOT_EQUAL
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l & r; }, nullptr}, // BITWISE_AND
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l ^ r; }, nullptr}, // BITWISE_XOR
+    {binary_result_kind_t::COMMON, false, [](std::uint64_t l, std::uint64_t r, bool) { return l | r; }, nullptr}, // BITWISE_OR
+    // We don't need to handle short circuiting for the subexpressions of logical and & or because assignment, function calls, and other side effect producing operators (e.g. `++`, `--`)
+    //  are disallowed at compile time. So it doesn't matter if we fully evaluate both subexpressions.
+    {binary_result_kind_t::INT, false, [](std::uint64_t l, std::uint64_t r, bool) -> std::uint64_t { return l != 0u && r != 0u; },
+        [](double l, double r) { return (l != 0.0 && r != 0.0) ? 1.0 : 0.0; }}, // LOGICAL_AND
+    {binary_result_kind_t::INT, false, [](std::uint64_t l, std::uint64_t r, bool) -> std::uint64_t { return l != 0u || r != 0u; },
+        [](double l, double r) { return (l != 0.0 || r != 0.0) ? 1.0 : 0.0; }}, // LOGICAL_OR
+    {binary_result_kind_t::COMMON, false, nullptr, nullptr}, // ASSIGNMENT
+    {binary_result_kind_t::COMMON, false, nullptr, nullptr}, // COMMA, which `evaluate_binary_operator()` handles on its own
+}};
+static_assert(static_cast<std::size_t>(ast::binary_operator_token_t::COMMA) + 1u == BINARY_OPERATIONS.size());
+}
+
+utils::result_t<constant_value_t> evaluate_binary_operator(const constant_value_t& left, const constant_value_t& right, const ast::binary_operator_token_t operator_token, utils::diagnostics_t& diagnostics) {
+    // Because of the aforementioned reasoning regarding short circuiting, using the comma operator at compile time is silly and has no purpose, but it is still valid and supported anyways.
+    if(operator_token == ast::binary_operator_token_t::COMMA) {
+        return right;
+    }
+    const binary_operation_t& operation = BINARY_OPERATIONS[static_cast<std::size_t>(operator_token)];
+    if(operation.integer_operation == nullptr) {
+        return diagnostics.report("Unsupported binary operator.");
+    }
+
+    if(operation.result_kind == binary_result_kind_t::PROMOTED_LEFT) {
+        const constant_kind_t kind = promote(left.kind);
+        if(is_floating(left.kind) || is_floating(right.kind)) {
+            return diagnostics.report("Unsupported binary operator.");
         }
-    }, operand.value);
+        const constant_value_t amount = convert(right, promote(right.kind));
+        const std::uint64_t width = get_info(kind).size * 8u;
+        if((is_signed(amount.kind) && amount.signed_value < 0) || get_bits(amount) >= width) {
+            return diagnostics.report("Shift amount out of range.");
+        }
+        return make_integer(kind, operation.integer_operation(get_bits(convert(left, kind)), get_bits(amount), is_signed(kind)));
+    }
+
+    const constant_kind_t common_kind = get_common_kind(left.kind, right.kind);
+    // most operands already have the common kind
+    const constant_value_t converted_left = (left.kind == common_kind) ? left : convert(left, common_kind);
+    const constant_value_t converted_right = (right.kind == common_kind) ? right : convert(right, common_kind);
+    if(operation.is_division && !is_nonzero(converted_right)) {
+        return diagnostics.report("Division by zero.");
+    }
+    const constant_kind_t result_kind = (operation.result_kind == binary_result_kind_t::INT) ? constant_kind_t::INT : common_kind;
+    if(is_floating(common_kind)) {
+        if(operation.floating_operation == nullptr) {
+            return diagnostics.report("Unsupported binary operator.");
+        }
+        const double result = operation.floating_operation(converted_left.floating_value, converted_right.floating_value);
+        // the result of a comparison or logical operator is 1.0 or 0.0
+        return (result_kind == constant_kind_t::INT) ? make_integer(result_kind, (result != 0.0) ? 1u : 0u) : make_floating(common_kind, result);
+    }
+    return make_integer(result_kind, operation.integer_operation(get_bits(converted_left), get_bits(converted_right), is_signed(common_kind)));
 }
-template<typename T, typename U>
-static ast::constant_t evaluate_floating_binary_expression(const T unwrapped_left, const U unwrapped_right, const ast::binary_operator_token_t operator_token) {
+
+utils::result_t<constant_value_t> evaluate_unary_operator(const constant_value_t& operand, const ast::unary_operator_token_t operator_token, utils::diagnostics_t& diagnostics) {
+    const constant_value_t promoted = convert(operand, promote(operand.kind));
     switch(operator_token) {
-        case ast::binary_operator_token_t::MULTIPLY:
-            return ast::constant_t{unwrapped_left * unwrapped_right};
-        case ast::binary_operator_token_t::DIVIDE:
-            if(unwrapped_right == 0) {
-                throw std::runtime_error("Division by zero.");
+        case ast::unary_operator_token_t::PLUS:
+            return promoted;
+        case ast::unary_operator_token_t::MINUS:
+            if(is_floating(promoted.kind)) {
+                return make_floating(promoted.kind, -promoted.floating_value);
             }
-            return ast::constant_t{unwrapped_left / unwrapped_right};
-        case ast::binary_operator_token_t::PLUS:
-            return ast::constant_t{unwrapped_left + unwrapped_right};
-        case ast::binary_operator_token_t::MINUS:
-            return ast::constant_t{unwrapped_left - unwrapped_right};
-        case ast::binary_operator_token_t::LESS_THAN:
-            return ast::constant_t{unwrapped_left < unwrapped_right};
-        case ast::binary_operator_token_t::LESS_THAN_EQUAL:
-            return ast::constant_t{unwrapped_left <= unwrapped_right};
-        case ast::binary_operator_token_t::GREATER_THAN:
-            return ast::constant_t{unwrapped_left > unwrapped_right};
-        case ast::binary_operator_token_t::GREATER_THAN_EQUAL:
-            return ast::constant_t{unwrapped_left >= unwrapped_right};
-        case ast::binary_operator_token_t::EQUAL:
-            return ast::constant_t{unwrapped_left == unwrapped_right};
-        case ast::binary_operator_token_t::NOT_EQUAL:
-            return ast::constant_t{unwrapped_left != unwrapped_right};
-        // We don't need to handle short circuiting for the subexpressions of logical and & or because assignment, function calls, and other side effect producing operators (e.g. `++`, `--`)
-        //  are disallowed at compile time. So it doesn't matter if we fully evaluate both subexpressions.
-        case ast::binary_operator_token_t::LOGICAL_AND:
-            return ast::constant_t{unwrapped_left && unwrapped_right};
-        case ast::binary_operator_token_t::LOGICAL_OR:
-            return ast::constant_t{unwrapped_left || unwrapped_right};
-        // Because of the aforementioned reasoning regarding short circuiting, using the comma operator at compile time is silly and has no purpose, but it is still valid and supported anyways.
-        case ast::binary_operator_token_t::COMMA:
-            return ast::constant_t{unwrapped_right};
-
-        case ast::binary_operator_token_t::MODULO:
-        case ast::binary_operator_token_t::LEFT_BITSHIFT:
-        case ast::binary_operator_token_t::RIGHT_BITSHIFT:
-        case ast::binary_operator_token_t::BITWISE_AND:
-        case ast::binary_operator_token_t::BITWISE_OR:
-        case ast::binary_operator_token_t::BITWISE_XOR:
-            throw std::runtime_error("Unsupported binary operator.");
-    }
-    throw std::logic_error("Unsupported binary operator.");
-}
-ast::constant_t evaluate_binary_expression(const ast::constant_t& left, const ast::constant_t& right, const ast::binary_operator_token_t operator_token) {
-    // TODO: Implement long double support
-    return std::visit(overloaded{
-        [operator_token, right](const float unwrapped_left) -> ast::constant_t {
-            return std::visit(overloaded{
-                [operator_token, unwrapped_left](const auto unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                }
-            }, right.value);
-        },
-        [operator_token, right](const double unwrapped_left) -> ast::constant_t {
-            return std::visit(overloaded{
-                [operator_token, unwrapped_left](const auto unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                }
-            }, right.value);
-        },
-        [operator_token, right](const long double unwrapped_left) -> ast::constant_t {
-            return std::visit(overloaded{
-                [operator_token, unwrapped_left](const auto unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                }
-            }, right.value);
-        },
-        [operator_token, right](const auto unwrapped_left) {
-            return std::visit(overloaded{
-                [operator_token, unwrapped_left](const float unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                },
-                [operator_token, unwrapped_left](const double unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                },
-                [operator_token, unwrapped_left](const long double unwrapped_right) -> ast::constant_t {
-                    return evaluate_floating_binary_expression(unwrapped_left, unwrapped_right, operator_token);
-                },
-                [operator_token, unwrapped_left](const auto unwrapped_right) -> ast::constant_t {
-                    switch(operator_token) {
-                        case ast::binary_operator_token_t::MULTIPLY:
-                            return ast::constant_t{unwrapped_left * unwrapped_right};
-                        case ast::binary_operator_token_t::DIVIDE:
-                            if(unwrapped_right == 0) {
-                                throw std::runtime_error("Division by zero.");
-                            }
-                            return ast::constant_t{unwrapped_left / unwrapped_right};
-                        case ast::binary_operator_token_t::MODULO:
-                            if(unwrapped_right == 0) {
-                                throw std::runtime_error("Division by zero.");
-                            }
-                            return ast::constant_t{unwrapped_left % unwrapped_right};
-                        case ast::binary_operator_token_t::PLUS:
-                            return ast::constant_t{unwrapped_left + unwrapped_right};
-                        case ast::binary_operator_token_t::MINUS:
-                            return ast::constant_t{unwrapped_left - unwrapped_right};
-                        case ast::binary_operator_token_t::LEFT_BITSHIFT:
-                            return ast::constant_t{unwrapped_left << unwrapped_right};
-                        case ast::binary_operator_token_t::RIGHT_BITSHIFT:
-                            return ast::constant_t{unwrapped_left >> unwrapped_right};
-                        case ast::binary_operator_token_t::LESS_THAN:
-                            return ast::constant_t{unwrapped_left < unwrapped_right};
-                        case ast::binary_operator_token_t::LESS_THAN_EQUAL:
-                            return ast::constant_t{unwrapped_left <= unwrapped_right};
-                        case ast::binary_operator_token_t::GREATER_THAN:
-                            return ast::constant_t{unwrapped_left > unwrapped_right};
-                        case ast::binary_operator_token_t::GREATER_THAN_EQUAL:
-                            return ast::constant_t{unwrapped_left >= unwrapped_right};
-                        case ast::binary_operator_token_t::EQUAL:
-                            return ast::constant_t{unwrapped_left == unwrapped_right};
-                        case ast::binary_operator_token_t::NOT_EQUAL:
-                            return ast::constant_t{unwrapped_left != unwrapped_right};
-                        case ast::binary_operator_token_t::BITWISE_AND:
-                            return ast::constant_t{unwrapped_left & unwrapped_right};
-                        case ast::binary_operator_token_t::BITWISE_XOR:
-                            return ast::constant_t{unwrapped_left ^ unwrapped_right};
-                        case ast::binary_operator_token_t::BITWISE_OR:
-                            return ast::constant_t{unwrapped_left | unwrapped_right};
-                        // We don't need to handle short circuiting for the subexpressions of logical and & or because assignment, function calls, and other side effect producing operators (e.g. `++`, `--`)
-                        //  are disallowed at compile time. So it doesn't matter if we fully evaluate both subexpressions.
-                        case ast::binary_operator_token_t::LOGICAL_AND:
-                            return ast::constant_t{unwrapped_left && unwrapped_right};
-                        case ast::binary_operator_token_t::LOGICAL_OR:
-                            return ast::constant_t{unwrapped_left || unwrapped_right};
-                        // Because of the aforementioned reasoning regarding short circuiting, using the comma operator at compile time is silly and has no purpose, but it is still valid and supported anyways.
-                        case ast::binary_operator_token_t::COMMA:
-                            return ast::constant_t{unwrapped_right};
-                    }
-                    throw std::logic_error("Unsupported binary operator.");
-                }
-            }, right.value);
-        }
-    }, left.value);
+            return make_integer(promoted.kind, 0u - get_bits(promoted));
+        case ast::unary_operator_token_t::LOGICAL_NOT:
+            return make_integer(constant_kind_t::INT, is_nonzero(operand) ? 0u : 1u);
+        case ast::unary_operator_token_t::BITWISE_NOT:
+            if(is_floating(promoted.kind)) {
+                return diagnostics.report("Unsupported unary operator.");
+            }
+            return make_integer(promoted.kind, ~get_bits(promoted));
+        case ast::unary_operator_token_t::PLUS_PLUS:
+        case ast::unary_operator_token_t::MINUS_MINUS:
+            break;
+    }
+    throw std::logic_error("Unsupported unary operator.");
 }
-ast::constant_t evaluate_ternary_expression(const ast::constant_t& condition, const ast::constant_t& if_true, const ast::constant_t& if_false) {
-    return std::visit(overloaded{
-        [&if_true, &if_false](const auto& unwrapped_condition) {
-            return std::visit(overloaded{
-                [&unwrapped_condition, &if_false](const auto& unwrapped_if_true) {
-                    return std::visit(overloaded{
-                        [&unwrapped_condition, &unwrapped_if_true](const auto& unwrapped_if_false) {
-                            return ast::constant_t{unwrapped_condition ? unwrapped_if_true : unwrapped_if_false};
-                        }
-                    }, if_false.value);
-                }
-            }, if_true.value);
+
+constant_value_t evaluate_ternary_operator(const constant_value_t& condition, const constant_value_t& if_true, const constant_value_t& if_false) {
+    return convert(is_nonzero(condition) ? if_true : if_false, get_common_kind(if_true.kind, if_false.kind));
+}
+
+std::optional<constant_kind_t> get_constant_kind(const ast::type_t& type) {
+    static const std::array<ast::type_name_t, NUMBER_OF_KINDS> type_names{{ // indexed by `constant_kind_t`
+        ast::primitive_type_names::CHAR, ast::primitive_type_names::SIGNED_CHAR, ast::primitive_type_names::UNSIGNED_CHAR,
+        ast::primitive_type_names::SHORT, ast::primitive_type_names::UNSIGNED_SHORT, ast::primitive_type_names::INT, ast::primitive_type_names::UNSIGNED_INT,
+        ast::primitive_type_names::LONG, ast::primitive_type_names::UNSIGNED_LONG, ast::primitive_type_names::LONG_LONG, ast::primitive_type_names::UNSIGNED_LONG_LONG,
+        ast::primitive_type_names::FLOAT, ast::primitive_type_names::DOUBLE, ast::primitive_type_names::LONG_DOUBLE,
+    }};
+    for(std::size_t i = 0u; i < NUMBER_OF_KINDS; ++i) {
+        if(type_names[i] == type.type_name) {
+            return static_cast<constant_kind_t>(i);
         }
-    }, condition.value);
+    }
+    return std::nullopt;
+}
+utils::result_t<constant_value_t> convert_constant_value(const constant_value_t& value, const constant_kind_t kind, utils::diagnostics_t& diagnostics) {
+    if(is_floating(value.kind) && !is_floating(kind)) {
+        return convert_floating_to_integer(value, kind, diagnostics);
+    }
+    return convert(value, kind);
 }
 
-ast::constant_t evaluate_expression(const ast::expression_t& expression) {
+namespace {
+utils::result_t<constant_value_t> evaluate(const ast::expression_t& expression, utils::diagnostics_t& diagnostics) {
+    // each node is looked up in its pool once
     return std::visit(overloaded{
-        [](const std::shared_ptr<ast::grouping_t>& expression) -> ast::constant_t {
-            return evaluate_expression(expression->expr);
+        [&diagnostics](const ast::node_handle_t<ast::grouping_t>& expression) -> utils::result_t<constant_value_t> {
+            return evaluate(expression->expr, diagnostics);
         },
-        [](const std::shared_ptr<ast::unary_expression_t>& expression) -> ast::constant_t {
-            if(expression->op == ast::unary_operator_token_t::PLUS_PLUS || expression->op == ast::unary_operator_token_t::MINUS_MINUS) {
-                throw std::runtime_error("`++` and `--` not supported in compile time expressions.");
+        [&diagnostics](const ast::node_handle_t<ast::unary_expression_t>& handle) -> utils::result_t<constant_value_t> {
+            const ast::unary_expression_t& expression = *handle;
+            if(expression.op == ast::unary_operator_token_t::PLUS_PLUS || expression.op == ast::unary_operator_token_t::MINUS_MINUS) {
+                return diagnostics.report("`++` and `--` not supported in compile time expressions.");
             }
-            const ast::constant_t operand = evaluate_expression(expression->exp);
-            return evaluate_unary_expression(operand, expression->op);
+            TRY_ASSIGN(const constant_value_t operand, evaluate(expression.exp, diagnostics));
+            return evaluate_unary_operator(operand, expression.op, diagnostics);
         },
-        [](const std::shared_ptr<ast::binary_expression_t>& expression) -> ast::constant_t {
-            if(expression->op == ast::binary_operator_token_t::ASSIGNMENT) {
-                throw std::runtime_error("Assignment not supported in compile time expressions.");
+        [&diagnostics](const ast::node_handle_t<ast::binary_expression_t>& handle) -> utils::result_t<constant_value_t> {
+            const ast::binary_expression_t& expression = *handle;
+            if(expression.op == ast::binary_operator_token_t::ASSIGNMENT) {
+                return diagnostics.report("Assignment not supported in compile time expressions.");
             }
-            const ast::constant_t left = evaluate_expression(expression->left);
-            const ast::constant_t right = evaluate_expression(expression->right);
-            return evaluate_binary_expression(left, right, expression->op);
+            TRY_ASSIGN(const constant_value_t left, evaluate(expression.left, diagnostics));
+            TRY_ASSIGN(const constant_value_t right, evaluate(expression.right, diagnostics));
+            return evaluate_binary_operator(left, right, expression.op, diagnostics);
         },
-        [](const std::shared_ptr<ast::ternary_expression_t>& expression) -> ast::constant_t {
-            const ast::constant_t condition = evaluate_expression(expression->condition);
-            const ast::constant_t if_true = evaluate_expression(expression->if_true);
-            const ast::constant_t if_false = evaluate_expression(expression->if_false);
-            return evaluate_ternary_expression(condition, if_true, if_false);
+        [&diagnostics](const ast::node_handle_t<ast::ternary_expression_t>& handle) -> utils::result_t<constant_value_t> {
+            const ast::ternary_expression_t& expression = *handle;
+            TRY_ASSIGN(const constant_value_t condition, evaluate(expression.condition, diagnostics));
+            TRY_ASSIGN(const constant_value_t if_true, evaluate(expression.if_true, diagnostics));
+            TRY_ASSIGN(const constant_value_t if_false, evaluate(expression.if_false, diagnostics));
+            return evaluate_ternary_operator(condition, if_true, if_false);
         },
-        [](const ast::constant_t& expression) -> ast::constant_t {
-            return expression;
+        [](const ast::constant_t& expression) -> utils::result_t<constant_value_t> {
+            return to_constant_value(expression);
         },
-        [](const std::shared_ptr<ast::convert_t>& expression) -> ast::constant_t {
-            throw std::runtime_error("Casts not yet implemented at compile time.");
-            return {};
+        [&diagnostics](const ast::node_handle_t<ast::convert_t>&) -> utils::result_t<constant_value_t> {
+            return diagnostics.report("Casts not yet implemented at compile time.");
         },
-        [](const auto&) -> ast::constant_t {
-            throw std::runtime_error("Expression evaluation not supported at compile time.");
-            return {};
+        [&diagnostics](const auto&) -> utils::result_t<constant_value_t> {
+            return diagnostics.report("Expression evaluation not supported at compile time.");
         }
     }, expression.expr);
 }
+}
+
+
+constant_value_t to_constant_value(const ast::constant_t& constant) {
+    const constant_kind_t kind = static_cast<constant_kind_t>(constant.value.index());
+    return std::visit([kind](const auto value) {
+        using value_type_t = decltype(value);
+        if constexpr(std::is_floating_point_v<value_type_t>) {
+            return make_floating(kind, static_cast<double>(value));
+        } else if constexpr(std::is_signed_v<value_type_t>) {
+            return make_integer(kind, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        } else {
+            return make_integer(kind, static_cast<std::uint64_t>(value));
+        }
+    }, constant.value);
+}
+ast::constant_t to_constant(const constant_value_t& value) {
+    switch(value.kind) {
+        case constant_kind_t::CHAR:
+            return ast::constant_t{static_cast<char>(value.signed_value)};
+        case constant_kind_t::SIGNED_CHAR:
+            return ast::constant_t{static_cast<signed char>(value.signed_value)};
+        case constant_kind_t::UNSIGNED_CHAR:
+            return ast::constant_t{static_cast<unsigned char>(value.unsigned_value)};
+        case constant_kind_t::SHORT:
+            return ast::constant_t{static_cast<short>(value.signed_value)};
+        case constant_kind_t::UNSIGNED_SHORT:
+            return ast::constant_t{static_cast<unsigned short>(value.unsigned_value)};
+        case constant_kind_t::INT:
+            return ast::constant_t{static_cast<int>(value.signed_value)};
+        case constant_kind_t::UNSIGNED_INT:
+            return ast::constant_t{static_cast<unsigned int>(value.unsigned_value)};
+        case constant_kind_t::LONG:
+            return ast::constant_t{static_cast<long>(value.signed_value)};
+        case constant_kind_t::UNSIGNED_LONG:
+            return ast::constant_t{static_cast<unsigned long>(value.unsigned_value)};
+        case constant_kind_t::LONG_LONG:
+            return ast::constant_t{static_cast<long long>(value.signed_value)};
+        case constant_kind_t::UNSIGNED_LONG_LONG:
+            return ast::constant_t{static_cast<unsigned long long>(value.unsigned_value)};
+        case constant_kind_t::FLOAT:
+            return ast::constant_t{static_cast<float>(value.floating_value)};
+        case constant_kind_t::DOUBLE:
+            return ast::constant_t{value.floating_value};
+        case constant_kind_t::LONG_DOUBLE:
+            return ast::constant_t{static_cast<long double>(value.floating_value)};
+    }
+    throw std::logic_error("Invalid constant kind.");
+}
+
+utils::result_t<ast::constant_t> evaluate_unary_expression(const ast::constant_t& operand, const ast::unary_operator_token_t operator_token, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const constant_value_t result, evaluate_unary_operator(to_constant_value(operand), operator_token, diagnostics));
+    return to_constant(result);
+}
+utils::result_t<ast::constant_t> evaluate_binary_expression(const ast::constant_t& left, const ast::constant_t& right, const ast::binary_operator_token_t operator_token, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const constant_value_t result, evaluate_binary_operator(to_constant_value(left), to_constant_value(right), operator_token, diagnostics));
+    return to_constant(result);
+}
+ast::constant_t evaluate_ternary_expression(const ast::constant_t& condition, const ast::constant_t& if_true, const ast::constant_t& if_false) {
+    return to_constant(evaluate_ternary_operator(to_constant_value(condition), to_constant_value(if_true), to_constant_value(if_false)));
+}
+utils::result_t<ast::constant_t> evaluate_convert_expression(const ast::constant_t& operand, const ast::type_t& type, utils::diagnostics_t& diagnostics) {
+    const std::optional<constant_kind_t> kind = get_constant_kind(type);
+    if(!kind.has_value()) {
+        return diagnostics.report("Cannot convert a constant to type [" + type.type_name.str() + "].");
+    }
+    TRY_ASSIGN(const constant_value_t result, convert_constant_value(to_constant_value(operand), kind.value(), diagnostics));
+    return to_constant(result);
+}
+
+utils::result_t<ast::constant_t> evaluate_expression(const ast::expression_t& expression, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const constant_value_t result, evaluate(expression, diagnostics));
+    return to_constant(result);
+}
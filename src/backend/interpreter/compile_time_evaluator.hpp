@@ -1,15 +1,54 @@
 #pragma once
 
 
-#include <stack>
+#include <cstdint>
+#include <optional>
 #include <variant>
 #include <stdexcept>
 
 #include <frontend/ast/ast.hpp>
+#include <utils/result.hpp>
 
 
-ast::constant_t evaluate_unary_expression(const ast::constant_t& operand, const ast::unary_operator_token_t operator_token);
-ast::constant_t evaluate_binary_expression(const ast::constant_t& left, const ast::constant_t& right, const ast::binary_operator_token_t operator_token);
+// What the evaluator computes with instead of `ast::constant_t`, so that an operator is dispatched once on its operator and not once per operand on the
+//  14 alternatives of `ast::constant_t::value`.
+// The kinds are in the order of those alternatives.
+enum class constant_kind_t : std::uint8_t {
+    CHAR, SIGNED_CHAR, UNSIGNED_CHAR, SHORT, UNSIGNED_SHORT, INT, UNSIGNED_INT, LONG, UNSIGNED_LONG, LONG_LONG, UNSIGNED_LONG_LONG,
+    FLOAT, DOUBLE, LONG_DOUBLE,
+};
+// Integers are kept in 64 bits, in `signed_value` (sign extended from the width of their kind) or `unsigned_value` (zero extended), so that operators work on
+//  64 bits and truncate their result to the width of its kind, which is how it wraps around. Floating point values are kept in `floating_value`, rounded to
+//  `float` for `FLOAT`. `long double` is kept as a `double`, as that is what the backend lowers it to.
+struct constant_value_t {
+    constant_kind_t kind;
+    union {
+        std::int64_t signed_value;
+        std::uint64_t unsigned_value;
+        double floating_value;
+    };
+};
+constant_value_t to_constant_value(const ast::constant_t& constant);
+ast::constant_t to_constant(const constant_value_t& value);
+// `std::nullopt` unless `type` is a primitive type (with typedefs resolved)
+std::optional<constant_kind_t> get_constant_kind(const ast::type_t& type);
+bool is_nonzero(const constant_value_t& value);
+
+// The operators on `constant_value_t`s, which `evaluate_*_expression()` below convert from and to `ast::constant_t` around. Whatever evaluates a whole
+//  expression tree (e.g. `fold_constants()`) keeps its values in `constant_value_t`s and only converts at the leaves and the root.
+utils::result_t<constant_value_t> evaluate_unary_operator(const constant_value_t& operand, const ast::unary_operator_token_t operator_token, utils::diagnostics_t& diagnostics);
+utils::result_t<constant_value_t> evaluate_binary_operator(const constant_value_t& left, const constant_value_t& right, const ast::binary_operator_token_t operator_token, utils::diagnostics_t& diagnostics);
+constant_value_t evaluate_ternary_operator(const constant_value_t& condition, const constant_value_t& if_true, const constant_value_t& if_false);
+// as `evaluate_convert_expression()`
+utils::result_t<constant_value_t> convert_constant_value(const constant_value_t& value, const constant_kind_t kind, utils::diagnostics_t& diagnostics);
+
+// Errors (e.g. division by zero) are reported to `diagnostics`.
+// Operands are converted as in C: integers narrower than `int` are promoted to `int`, and the operands of arithmetic operators are converted to their common type.
+utils::result_t<ast::constant_t> evaluate_unary_expression(const ast::constant_t& operand, const ast::unary_operator_token_t operator_token, utils::diagnostics_t& diagnostics);
+utils::result_t<ast::constant_t> evaluate_binary_expression(const ast::constant_t& left, const ast::constant_t& right, const ast::binary_operator_token_t operator_token, utils::diagnostics_t& diagnostics);
 ast::constant_t evaluate_ternary_expression(const ast::constant_t& condition, const ast::constant_t& if_true, const ast::constant_t& if_false);
+// `type` has to be a primitive type, with typedefs resolved. Integers wrap around to the width of `type` (as they do on x86_64). Floating point values that
+//  are out of range of the integer type they are converted to (and NaNs) are reported, as the conversion is undefined.
+utils::result_t<ast::constant_t> evaluate_convert_expression(const ast::constant_t& operand, const ast::type_t& type, utils::diagnostics_t& diagnostics);
 
-ast::constant_t evaluate_expression(const ast::expression_t& expression);
+utils::result_t<ast::constant_t> evaluate_expression(const ast::expression_t& expression, utils::diagnostics_t& diagnostics);
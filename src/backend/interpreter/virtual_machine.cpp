@@ -0,0 +1,599 @@
+#include "virtual_machine.hpp"
+
+#include <middle_end/ir/lower_ast.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace {
+// What calls to functions that aren't in the program are bound to. Arguments and results are registers, i.e. only integers and pointers fit.
+using host_function_t = std::uint64_t (*)(const std::uint64_t* arguments);
+struct host_function_info_t {
+    std::string_view name;
+    std::uint32_t parameter_count;
+    host_function_t function;
+};
+constexpr std::uint32_t MAX_HOST_PARAMETER_COUNT = 1u;
+const std::array<host_function_info_t, 2u> HOST_FUNCTIONS{{
+    {"putchar", 1u, [](const std::uint64_t* arguments) { return static_cast<std::uint64_t>(std::putchar(static_cast<int>(arguments[0]))); }},
+    {"getchar", 0u, [](const std::uint64_t*) { return static_cast<std::uint64_t>(std::getchar()); }},
+}};
+
+// of the memory that the registers and the allocas of all active calls share
+constexpr std::size_t REGISTER_STACK_SIZE = 1u << 20u;
+constexpr std::size_t MEMORY_STACK_SIZE = 8u << 20u;
+
+
+std::uint64_t get_unused_bits(const ir::type_t type) {
+    return 64u - 8u * ir::get_size(type);
+}
+
+struct function_compiler_t {
+    const ir::function_t& function;
+    vm::function_t& output;
+    const std::unordered_map<utils::symbol_t, std::uint32_t>& function_indices;
+    const std::unordered_map<utils::symbol_t, std::uint64_t>& global_addresses;
+    utils::diagnostics_t& diagnostics;
+
+    std::vector<std::uint64_t> alloca_offsets; // into the memory of the frame, of each `ALLOCA`
+    // Jumps and branches are emitted with the IDs of their targets, which are the IDs of blocks or (from `function.blocks.size()` on) of the edges in
+    //  `edges`, and are patched to code offsets once everything was emitted.
+    std::vector<std::pair<ir::block_id_t, ir::block_id_t>> edges; // from, to, of the branches to blocks with phis
+    std::vector<std::uint32_t> offsets; // into the code, of each block and edge
+    std::vector<std::size_t> jumps; // indices of the jumps and branches in the code
+
+    function_compiler_t(const ir::function_t& function, vm::function_t& output, const std::unordered_map<utils::symbol_t, std::uint32_t>& function_indices,
+        const std::unordered_map<utils::symbol_t, std::uint64_t>& global_addresses, utils::diagnostics_t& diagnostics)
+        : function(function), output(output), function_indices(function_indices), global_addresses(global_addresses), diagnostics(diagnostics) {}
+
+    void emit(const vm::opcode_t opcode, const std::uint32_t destination, const std::uint32_t left = 0u, const std::uint32_t right = 0u, const std::uint64_t immediate = 0u) {
+        output.code.push_back(vm::instruction_t{opcode, destination, left, right, immediate});
+    }
+    void emit_jump(const std::uint64_t target) {
+        jumps.push_back(output.code.size());
+        emit(vm::opcode_t::JUMP, 0u, 0u, 0u, target);
+    }
+    ir::type_t operand_type(const ir::instruction_t& instruction, const std::size_t operand) const {
+        return function.get(instruction.operands[operand]).type;
+    }
+    bool has_phis(const ir::block_id_t block) const {
+        return function.get(function.blocks[block].instructions.front()).opcode == ir::opcode_t::PHI;
+    }
+
+    void lay_out_frame() {
+        alloca_offsets.assign(function.instructions.size(), 0u);
+        for(const ir::value_t value : function.blocks[0].instructions) {
+            const ir::instruction_t& instruction = function.get(value);
+            if(instruction.opcode == ir::opcode_t::ALLOCA) {
+                const std::uint64_t alignment = std::max<std::uint64_t>(instruction.alignment, 1u);
+                output.frame_size = (output.frame_size + alignment - 1u) / alignment * alignment;
+                alloca_offsets[value] = output.frame_size;
+                output.frame_size += instruction.immediate;
+            }
+        }
+        output.frame_size = (output.frame_size + 15u) / 16u * 16u;
+    }
+
+    // The moves that the phis of `to` need when control goes there from `from`. They happen all at once, so if a phi's incoming value is another phi of
+    //  `to` (which is being overwritten), every incoming value is moved to a temporary register first.
+    void emit_phi_moves(const ir::block_id_t from, const ir::block_id_t to) {
+        std::vector<std::pair<ir::value_t, ir::value_t>> moves; // phi, incoming value
+        for(const ir::value_t value : function.blocks[to].instructions) {
+            const ir::instruction_t& instruction = function.get(value);
+            if(instruction.opcode != ir::opcode_t::PHI) {
+                break;
+            }
+            for(std::size_t i = 0u; i < instruction.targets.size(); ++i) {
+                if(instruction.targets[i] == from) {
+                    moves.emplace_back(value, instruction.operands[i]);
+                }
+            }
+        }
+        const bool reads_phis = std::any_of(std::begin(moves), std::end(moves), [this, to](const auto& move) {
+            const ir::instruction_t& incoming = function.get(move.second);
+            return incoming.opcode == ir::opcode_t::PHI && move.first != move.second
+                && std::find(std::begin(function.blocks[to].instructions), std::end(function.blocks[to].instructions), move.second) != std::end(function.blocks[to].instructions);
+        });
+        if(!reads_phis) {
+            for(const auto& [phi, incoming] : moves) {
+                emit(vm::opcode_t::MOVE, phi, incoming);
+            }
+            return;
+        }
+        const auto first_temporary = static_cast<std::uint32_t>(function.instructions.size());
+        output.register_count = std::max(output.register_count, first_temporary + static_cast<std::uint32_t>(moves.size()));
+        for(std::uint32_t i = 0u; i < moves.size(); ++i) {
+            emit(vm::opcode_t::MOVE, first_temporary + i, moves[i].second);
+        }
+        for(std::uint32_t i = 0u; i < moves.size(); ++i) {
+            emit(vm::opcode_t::MOVE, moves[i].first, first_temporary + i);
+        }
+    }
+    // the ID of what a branch from `from` to `to` jumps to
+    std::uint64_t get_branch_target(const ir::block_id_t from, const ir::block_id_t to) {
+        if(!has_phis(to)) {
+            return to;
+        }
+        edges.emplace_back(from, to);
+        return function.blocks.size() + edges.size() - 1u;
+    }
+
+    utils::result_t<void> compile_call(const ir::value_t value, const ir::instruction_t& instruction) {
+        const auto arguments_begin = static_cast<std::uint32_t>(output.call_arguments.size());
+        const auto argument_count = static_cast<std::uint32_t>(instruction.operands.size());
+        output.call_arguments.insert(std::end(output.call_arguments), std::begin(instruction.operands), std::end(instruction.operands));
+        const auto function_iter = function_indices.find(instruction.symbol);
+        if(function_iter != std::end(function_indices)) {
+            emit(vm::opcode_t::CALL, value, arguments_begin, argument_count, function_iter->second);
+            return {};
+        }
+        const auto host_function_iter = std::find_if(std::begin(HOST_FUNCTIONS), std::end(HOST_FUNCTIONS), [&instruction](const host_function_info_t& host_function) {
+            return host_function.name == instruction.symbol.text();
+        });
+        if(host_function_iter == std::end(HOST_FUNCTIONS)) {
+            return diagnostics.report("In function [" + function.name.str() + "]: call to [" + instruction.symbol.str() + "], which is neither defined nor a host function.");
+        }
+        const bool has_floating_argument = std::any_of(std::begin(instruction.operands), std::end(instruction.operands), [this](const ir::value_t argument) {
+            return ir::is_floating(function.get(argument).type);
+        });
+        if(host_function_iter->parameter_count != argument_count || has_floating_argument || ir::is_floating(instruction.type)) {
+            return diagnostics.report("In function [" + function.name.str() + "]: call to host function [" + instruction.symbol.str() + "] with the wrong arguments.");
+        }
+        emit(vm::opcode_t::CALL_HOST, value, arguments_begin, argument_count, static_cast<std::uint64_t>(host_function_iter - std::begin(HOST_FUNCTIONS)));
+        return {};
+    }
+
+    utils::result_t<void> compile_instruction(const ir::block_id_t block, const ir::value_t value) {
+        const ir::instruction_t& instruction = function.get(value);
+        const ir::type_t type = instruction.type;
+        const std::uint32_t left = instruction.operands.empty() ? 0u : instruction.operands[0];
+        const std::uint32_t right = (instruction.operands.size() < 2u) ? 0u : instruction.operands[1];
+        // the opcode for the floating point type of the result or of the operands, e.g. `FADD32` or `FADD64`
+        const auto floating = [](const ir::type_t floating_type, const vm::opcode_t opcode32, const vm::opcode_t opcode64) {
+            return (floating_type == ir::type_t::F32) ? opcode32 : opcode64;
+        };
+        switch(instruction.opcode) {
+            case ir::opcode_t::PARAM:
+                output.parameters[instruction.immediate] = value;
+                return {};
+            case ir::opcode_t::PHI: // see `emit_phi_moves()`
+                return {};
+            case ir::opcode_t::CONST:
+                emit(vm::opcode_t::CONST, value, 0u, 0u, instruction.immediate);
+                return {};
+            case ir::opcode_t::ALLOCA:
+                emit(vm::opcode_t::FRAME_ADDRESS, value, 0u, 0u, alloca_offsets[value]);
+                return {};
+            case ir::opcode_t::GLOBAL_ADDRESS:
+                emit(vm::opcode_t::CONST, value, 0u, 0u, global_addresses.at(instruction.symbol));
+                return {};
+            case ir::opcode_t::PTR_OFFSET:
+                emit(vm::opcode_t::ADD_IMMEDIATE, value, left, 0u, instruction.immediate);
+                return {};
+            case ir::opcode_t::LOAD: {
+                constexpr std::array<vm::opcode_t, 4u> LOADS{vm::opcode_t::LOAD8, vm::opcode_t::LOAD16, vm::opcode_t::LOAD32, vm::opcode_t::LOAD64};
+                emit(LOADS[(ir::get_size(type) == 8u) ? 3u : ir::get_size(type) / 2u], value, left);
+                return {};
+            }
+            case ir::opcode_t::STORE: {
+                constexpr std::array<vm::opcode_t, 4u> STORES{vm::opcode_t::STORE8, vm::opcode_t::STORE16, vm::opcode_t::STORE32, vm::opcode_t::STORE64};
+                const std::size_t size = ir::get_size(operand_type(instruction, 0u));
+                emit(STORES[(size == 8u) ? 3u : size / 2u], value, right, left);
+                return {};
+            }
+            case ir::opcode_t::COPY:
+                emit(vm::opcode_t::COPY, value, left, right, instruction.immediate);
+                return {};
+
+            case ir::opcode_t::ADD: emit(vm::opcode_t::ADD, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::SUB: emit(vm::opcode_t::SUB, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::MUL: emit(vm::opcode_t::MUL, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::SDIV: emit(vm::opcode_t::SDIV, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::UDIV: emit(vm::opcode_t::UDIV, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::SREM: emit(vm::opcode_t::SREM, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::UREM: emit(vm::opcode_t::UREM, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::SHL: emit(vm::opcode_t::SHL, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::ASHR: emit(vm::opcode_t::ASHR, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::LSHR: emit(vm::opcode_t::LSHR, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::AND: emit(vm::opcode_t::AND, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::OR: emit(vm::opcode_t::OR, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::XOR: emit(vm::opcode_t::XOR, value, left, right, get_unused_bits(type)); return {};
+            case ir::opcode_t::NEG: emit(vm::opcode_t::NEG, value, left, 0u, get_unused_bits(type)); return {};
+            case ir::opcode_t::NOT: emit(vm::opcode_t::NOT, value, left, 0u, get_unused_bits(type)); return {};
+
+            case ir::opcode_t::FADD: emit(floating(type, vm::opcode_t::FADD32, vm::opcode_t::FADD64), value, left, right); return {};
+            case ir::opcode_t::FSUB: emit(floating(type, vm::opcode_t::FSUB32, vm::opcode_t::FSUB64), value, left, right); return {};
+            case ir::opcode_t::FMUL: emit(floating(type, vm::opcode_t::FMUL32, vm::opcode_t::FMUL64), value, left, right); return {};
+            case ir::opcode_t::FDIV: emit(floating(type, vm::opcode_t::FDIV32, vm::opcode_t::FDIV64), value, left, right); return {};
+            case ir::opcode_t::FNEG: emit(floating(type, vm::opcode_t::FNEG32, vm::opcode_t::FNEG64), value, left); return {};
+
+            // comparisons are of the width of their operands
+            case ir::opcode_t::EQ: emit(vm::opcode_t::EQ, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::NE: emit(vm::opcode_t::NE, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::SLT: emit(vm::opcode_t::SLT, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::SLE: emit(vm::opcode_t::SLE, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::SGT: emit(vm::opcode_t::SGT, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::SGE: emit(vm::opcode_t::SGE, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::ULT: emit(vm::opcode_t::ULT, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::ULE: emit(vm::opcode_t::ULE, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::UGT: emit(vm::opcode_t::UGT, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::UGE: emit(vm::opcode_t::UGE, value, left, right, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::FEQ: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FEQ32, vm::opcode_t::FEQ64), value, left, right); return {};
+            case ir::opcode_t::FNE: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FNE32, vm::opcode_t::FNE64), value, left, right); return {};
+            case ir::opcode_t::FLT: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FLT32, vm::opcode_t::FLT64), value, left, right); return {};
+            case ir::opcode_t::FLE: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FLE32, vm::opcode_t::FLE64), value, left, right); return {};
+            case ir::opcode_t::FGT: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FGT32, vm::opcode_t::FGT64), value, left, right); return {};
+            case ir::opcode_t::FGE: emit(floating(operand_type(instruction, 0u), vm::opcode_t::FGE32, vm::opcode_t::FGE64), value, left, right); return {};
+
+            case ir::opcode_t::SEXT: emit(vm::opcode_t::SEXT, value, left, 0u, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::ZEXT: emit(vm::opcode_t::ZEXT, value, left, 0u, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::TRUNC: // the low bits are already there
+                emit(vm::opcode_t::MOVE, value, left);
+                return {};
+            case ir::opcode_t::SITOFP: emit(floating(type, vm::opcode_t::SITOF32, vm::opcode_t::SITOF64), value, left, 0u, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::UITOFP: emit(floating(type, vm::opcode_t::UITOF32, vm::opcode_t::UITOF64), value, left, 0u, get_unused_bits(operand_type(instruction, 0u))); return {};
+            case ir::opcode_t::FPTOSI:
+                emit(floating(operand_type(instruction, 0u), vm::opcode_t::F32TOSI, vm::opcode_t::F64TOSI), value, left);
+                return {};
+            case ir::opcode_t::FPTOUI: // as in the x86_64 backend, only 64 bit results need more than a signed conversion
+                if(type == ir::type_t::I64) {
+                    emit(floating(operand_type(instruction, 0u), vm::opcode_t::F32TOUI64, vm::opcode_t::F64TOUI64), value, left);
+                } else {
+                    emit(floating(operand_type(instruction, 0u), vm::opcode_t::F32TOSI, vm::opcode_t::F64TOSI), value, left);
+                }
+                return {};
+            case ir::opcode_t::FPEXT: emit(vm::opcode_t::FPEXT, value, left); return {};
+            case ir::opcode_t::FPTRUNC: emit(vm::opcode_t::FPTRUNC, value, left); return {};
+
+            case ir::opcode_t::CALL:
+                return compile_call(value, instruction);
+
+            case ir::opcode_t::JUMP: {
+                const ir::block_id_t target = instruction.targets[0];
+                emit_phi_moves(block, target);
+                if(target != block + 1u) {
+                    emit_jump(target);
+                }
+                return {};
+            }
+            case ir::opcode_t::BRANCH: {
+                const std::uint64_t true_target = get_branch_target(block, instruction.targets[0]);
+                const std::uint64_t false_target = get_branch_target(block, instruction.targets[1]);
+                jumps.push_back(output.code.size());
+                emit(vm::opcode_t::BRANCH, static_cast<std::uint32_t>(false_target), left, static_cast<std::uint32_t>(get_unused_bits(operand_type(instruction, 0u))), true_target);
+                return {};
+            }
+            case ir::opcode_t::RET:
+                if(instruction.operands.empty()) { // the register is never read, it is only set so that nothing reads uninitialized memory
+                    emit(vm::opcode_t::CONST, value);
+                    emit(vm::opcode_t::RET, 0u, value);
+                } else {
+                    emit(vm::opcode_t::RET, 0u, left);
+                }
+                return {};
+        }
+        throw std::logic_error("Invalid IR opcode.");
+    }
+
+    utils::result_t<void> compile() {
+        output.name = function.name;
+        output.register_count = static_cast<std::uint32_t>(function.instructions.size());
+        output.parameters.assign(function.param_types.size(), 0u);
+        lay_out_frame();
+        for(ir::block_id_t block = 0u; block < function.blocks.size(); ++block) {
+            offsets.push_back(static_cast<std::uint32_t>(output.code.size()));
+            for(const ir::value_t value : function.blocks[block].instructions) {
+                TRY(compile_instruction(block, value));
+            }
+        }
+        for(std::size_t i = 0u; i < edges.size(); ++i) {
+            offsets.push_back(static_cast<std::uint32_t>(output.code.size()));
+            emit_phi_moves(edges[i].first, edges[i].second);
+            emit_jump(edges[i].second);
+        }
+        for(const std::size_t jump : jumps) {
+            vm::instruction_t& instruction = output.code[jump];
+            instruction.immediate = offsets[instruction.immediate];
+            if(instruction.opcode == vm::opcode_t::BRANCH) {
+                instruction.destination = offsets[instruction.destination];
+            }
+        }
+        return {};
+    }
+};
+
+
+std::int64_t sign_extend(const std::uint64_t value, const std::uint64_t unused_bits) {
+    return static_cast<std::int64_t>(value << unused_bits) >> unused_bits;
+}
+std::uint64_t zero_extend(const std::uint64_t value, const std::uint64_t unused_bits) {
+    return (value << unused_bits) >> unused_bits;
+}
+// x86_64 masks shift amounts to 6 bits for 64 bit shifts and to 5 bits for narrower ones
+std::uint64_t mask_shift_amount(const std::uint64_t amount, const std::uint64_t unused_bits) {
+    return amount & ((unused_bits == 0u) ? 63u : 31u);
+}
+
+float get_float(const std::uint64_t bits) {
+    const auto low_bits = static_cast<std::uint32_t>(bits);
+    float value;
+    std::memcpy(&value, &low_bits, sizeof(value));
+    return value;
+}
+double get_double(const std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+std::uint64_t from_float(const float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+std::uint64_t from_double(const double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+// as `cvttsd2si` does, values that don't fit (and NaNs) become the smallest `int64_t`
+std::uint64_t truncate_to_integer(const double value) {
+    constexpr double LIMIT = 9223372036854775808.0; // 2^63
+    if(!(value >= -LIMIT && value < LIMIT)) {
+        return std::uint64_t{1u} << 63u;
+    }
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+}
+// as the x86_64 backend does, values from 2^63 on are converted with 2^63 subtracted and have it added back as the top bit
+std::uint64_t truncate_to_unsigned_integer(const double value) {
+    constexpr double LIMIT = 9223372036854775808.0; // 2^63
+    return (value >= LIMIT) ? (truncate_to_integer(value - LIMIT) ^ (std::uint64_t{1u} << 63u)) : truncate_to_integer(value);
+}
+
+template<typename T>
+T load(const std::uint64_t address) {
+    T value;
+    std::memcpy(&value, reinterpret_cast<const void*>(address), sizeof(value));
+    return value;
+}
+template<typename T>
+void store(const std::uint64_t address, const std::uint64_t value) {
+    const auto truncated = static_cast<T>(value);
+    std::memcpy(reinterpret_cast<void*>(address), &truncated, sizeof(truncated));
+}
+
+// a call that is still running
+struct frame_t {
+    const vm::function_t* function;
+    std::size_t return_offset; // of the instruction after the call, in the code of `function`
+    std::uint64_t* registers;
+    std::byte* memory;
+    std::uint32_t result_register; // of the call
+};
+}
+
+
+utils::result_t<vm::program_t> compile_to_bytecode(const ir::module_t& module, utils::diagnostics_t& diagnostics) {
+    vm::program_t program;
+
+    std::unordered_map<utils::symbol_t, std::uint64_t> global_offsets;
+    std::size_t globals_size = 0u;
+    for(const auto& global : module.globals) {
+        const std::size_t alignment = std::max<std::size_t>(global.alignment, 1u); // at most 16, which is what `new` aligns to
+        globals_size = (globals_size + alignment - 1u) / alignment * alignment;
+        global_offsets[global.name] = globals_size;
+        globals_size += global.size;
+    }
+    program.globals = std::make_unique<std::byte[]>(std::max<std::size_t>(globals_size, 1u)); // zero initialized
+    std::unordered_map<utils::symbol_t, std::uint64_t> global_addresses;
+    for(const auto& global : module.globals) {
+        std::byte *const storage = program.globals.get() + global_offsets[global.name];
+        std::copy(std::begin(global.initializer), std::end(global.initializer), storage);
+        global_addresses[global.name] = reinterpret_cast<std::uint64_t>(storage);
+    }
+
+    std::unordered_map<utils::symbol_t, std::uint32_t> function_indices;
+    for(std::uint32_t i = 0u; i < module.functions.size(); ++i) {
+        function_indices[module.functions[i].name] = i;
+    }
+    const auto main_iter = function_indices.find(utils::symbol_t("main"));
+    if(main_iter == std::end(function_indices)) {
+        return diagnostics.report("No [main] function to run.");
+    }
+    program.main_function = main_iter->second;
+
+    program.functions.resize(module.functions.size());
+    for(std::size_t i = 0u; i < module.functions.size(); ++i) {
+        function_compiler_t compiler(module.functions[i], program.functions[i], function_indices, global_addresses, diagnostics);
+        TRY(compiler.compile());
+    }
+    return program;
+}
+
+utils::result_t<int> run_program(const vm::program_t& program, utils::diagnostics_t& diagnostics) {
+    // not zeroed, registers are always written before they are read and C doesn't initialize locals either
+    const std::unique_ptr<std::uint64_t[]> register_stack(new std::uint64_t[REGISTER_STACK_SIZE]);
+    const std::unique_ptr<std::byte[]> memory_stack(new std::byte[MEMORY_STACK_SIZE]);
+    std::uint64_t *const registers_end = register_stack.get() + REGISTER_STACK_SIZE;
+    std::byte *const memory_end = memory_stack.get() + MEMORY_STACK_SIZE;
+
+    const vm::function_t* function = &program.functions[program.main_function];
+    if(function->register_count > REGISTER_STACK_SIZE || function->frame_size > MEMORY_STACK_SIZE) {
+        return diagnostics.report("Stack overflow.");
+    }
+    const vm::instruction_t* code = function->code.data();
+    std::size_t offset = 0u;
+    std::uint64_t* registers = register_stack.get();
+    std::byte* memory = memory_stack.get();
+    std::vector<frame_t> calls;
+
+    const auto error = [&function, &diagnostics](const char *const message) {
+        return diagnostics.report("In function [" + function->name.str() + "]: " + message);
+    };
+
+    while(true) {
+        const vm::instruction_t& instruction = code[offset++];
+        // only read by the opcodes whose fields are registers
+        std::uint64_t& destination = registers[instruction.destination];
+        const std::uint64_t& left = registers[instruction.left];
+        const std::uint64_t& right = registers[instruction.right];
+        const std::uint64_t immediate = instruction.immediate;
+        switch(instruction.opcode) {
+            case vm::opcode_t::MOVE: destination = left; break;
+            case vm::opcode_t::CONST: destination = immediate; break;
+            case vm::opcode_t::FRAME_ADDRESS: destination = reinterpret_cast<std::uint64_t>(memory + immediate); break;
+            case vm::opcode_t::ADD_IMMEDIATE: destination = left + immediate; break;
+
+            case vm::opcode_t::LOAD8: destination = load<std::uint8_t>(left); break;
+            case vm::opcode_t::LOAD16: destination = load<std::uint16_t>(left); break;
+            case vm::opcode_t::LOAD32: destination = load<std::uint32_t>(left); break;
+            case vm::opcode_t::LOAD64: destination = load<std::uint64_t>(left); break;
+            case vm::opcode_t::STORE8: store<std::uint8_t>(left, right); break;
+            case vm::opcode_t::STORE16: store<std::uint16_t>(left, right); break;
+            case vm::opcode_t::STORE32: store<std::uint32_t>(left, right); break;
+            case vm::opcode_t::STORE64: store<std::uint64_t>(left, right); break;
+            case vm::opcode_t::COPY: std::memmove(reinterpret_cast<void*>(left), reinterpret_cast<const void*>(right), immediate); break;
+
+            // only the low bits of narrower integers are meaningful, so most operations work on all 64 bits
+            case vm::opcode_t::ADD: destination = left + right; break;
+            case vm::opcode_t::SUB: destination = left - right; break;
+            case vm::opcode_t::MUL: destination = left * right; break;
+            case vm::opcode_t::SDIV:
+            case vm::opcode_t::SREM: {
+                const std::int64_t dividend = sign_extend(left, immediate);
+                const std::int64_t divisor = sign_extend(right, immediate);
+                if(divisor == 0) {
+                    return error("Division by zero.");
+                } else if(divisor == -1 && dividend == sign_extend(std::uint64_t{1u} << (63u - immediate), immediate)) { // traps on x86_64
+                    return error("Signed division overflow.");
+                }
+                destination = static_cast<std::uint64_t>((instruction.opcode == vm::opcode_t::SDIV) ? (dividend / divisor) : (dividend % divisor));
+                break;
+            }
+            case vm::opcode_t::UDIV:
+            case vm::opcode_t::UREM: {
+                const std::uint64_t dividend = zero_extend(left, immediate);
+                const std::uint64_t divisor = zero_extend(right, immediate);
+                if(divisor == 0u) {
+                    return error("Division by zero.");
+                }
+                destination = (instruction.opcode == vm::opcode_t::UDIV) ? (dividend / divisor) : (dividend % divisor);
+                break;
+            }
+            case vm::opcode_t::SHL: destination = left << mask_shift_amount(right, immediate); break;
+            case vm::opcode_t::ASHR: destination = static_cast<std::uint64_t>(sign_extend(left, immediate) >> mask_shift_amount(right, immediate)); break;
+            case vm::opcode_t::LSHR: destination = zero_extend(left, immediate) >> mask_shift_amount(right, immediate); break;
+            case vm::opcode_t::AND: destination = left & right; break;
+            case vm::opcode_t::OR: destination = left | right; break;
+            case vm::opcode_t::XOR: destination = left ^ right; break;
+            case vm::opcode_t::NEG: destination = 0u - left; break;
+            case vm::opcode_t::NOT: destination = ~left; break;
+            case vm::opcode_t::EQ: destination = (zero_extend(left, immediate) == zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::NE: destination = (zero_extend(left, immediate) != zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::SLT: destination = (sign_extend(left, immediate) < sign_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::SLE: destination = (sign_extend(left, immediate) <= sign_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::SGT: destination = (sign_extend(left, immediate) > sign_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::SGE: destination = (sign_extend(left, immediate) >= sign_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::ULT: destination = (zero_extend(left, immediate) < zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::ULE: destination = (zero_extend(left, immediate) <= zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::UGT: destination = (zero_extend(left, immediate) > zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::UGE: destination = (zero_extend(left, immediate) >= zero_extend(right, immediate)) ? 1u : 0u; break;
+            case vm::opcode_t::SEXT: destination = static_cast<std::uint64_t>(sign_extend(left, immediate)); break;
+            case vm::opcode_t::ZEXT: destination = zero_extend(left, immediate); break;
+
+            case vm::opcode_t::FADD32: destination = from_float(get_float(left) + get_float(right)); break;
+            case vm::opcode_t::FSUB32: destination = from_float(get_float(left) - get_float(right)); break;
+            case vm::opcode_t::FMUL32: destination = from_float(get_float(left) * get_float(right)); break;
+            case vm::opcode_t::FDIV32: destination = from_float(get_float(left) / get_float(right)); break;
+            case vm::opcode_t::FNEG32: destination = left ^ (std::uint64_t{1u} << 31u); break;
+            case vm::opcode_t::FEQ32: destination = (get_float(left) == get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FNE32: destination = (get_float(left) != get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FLT32: destination = (get_float(left) < get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FLE32: destination = (get_float(left) <= get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FGT32: destination = (get_float(left) > get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FGE32: destination = (get_float(left) >= get_float(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FADD64: destination = from_double(get_double(left) + get_double(right)); break;
+            case vm::opcode_t::FSUB64: destination = from_double(get_double(left) - get_double(right)); break;
+            case vm::opcode_t::FMUL64: destination = from_double(get_double(left) * get_double(right)); break;
+            case vm::opcode_t::FDIV64: destination = from_double(get_double(left) / get_double(right)); break;
+            case vm::opcode_t::FNEG64: destination = left ^ (std::uint64_t{1u} << 63u); break;
+            case vm::opcode_t::FEQ64: destination = (get_double(left) == get_double(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FNE64: destination = (get_double(left) != get_double(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FLT64: destination = (get_double(left) < get_double(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FLE64: destination = (get_double(left) <= get_double(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FGT64: destination = (get_double(left) > get_double(right)) ? 1u : 0u; break;
+            case vm::opcode_t::FGE64: destination = (get_double(left) >= get_double(right)) ? 1u : 0u; break;
+
+            case vm::opcode_t::SITOF32: destination = from_float(static_cast<float>(sign_extend(left, immediate))); break;
+            case vm::opcode_t::SITOF64: destination = from_double(static_cast<double>(sign_extend(left, immediate))); break;
+            case vm::opcode_t::UITOF32: destination = from_float(static_cast<float>(zero_extend(left, immediate))); break;
+            case vm::opcode_t::UITOF64: destination = from_double(static_cast<double>(zero_extend(left, immediate))); break;
+            case vm::opcode_t::F32TOSI: destination = truncate_to_integer(get_float(left)); break;
+            case vm::opcode_t::F64TOSI: destination = truncate_to_integer(get_double(left)); break;
+            case vm::opcode_t::F32TOUI64: destination = truncate_to_unsigned_integer(get_float(left)); break;
+            case vm::opcode_t::F64TOUI64: destination = truncate_to_unsigned_integer(get_double(left)); break;
+            case vm::opcode_t::FPEXT: destination = from_double(get_float(left)); break;
+            case vm::opcode_t::FPTRUNC: destination = from_float(static_cast<float>(get_double(left))); break;
+
+            case vm::opcode_t::CALL: {
+                const vm::function_t& callee = program.functions[immediate];
+                std::uint64_t *const callee_registers = registers + function->register_count;
+                std::byte *const callee_memory = memory + function->frame_size;
+                if(callee.register_count > static_cast<std::size_t>(registers_end - callee_registers) || callee.frame_size > static_cast<std::size_t>(memory_end - callee_memory)) {
+                    return error("Stack overflow.");
+                }
+                for(std::uint32_t i = 0u; i < instruction.right; ++i) {
+                    callee_registers[callee.parameters[i]] = registers[function->call_arguments[instruction.left + i]];
+                }
+                calls.push_back(frame_t{function, offset, registers, memory, instruction.destination});
+                function = &callee;
+                code = callee.code.data();
+                offset = 0u;
+                registers = callee_registers;
+                memory = callee_memory;
+                break;
+            }
+            case vm::opcode_t::CALL_HOST: {
+                std::array<std::uint64_t, MAX_HOST_PARAMETER_COUNT> arguments{};
+                for(std::uint32_t i = 0u; i < instruction.right; ++i) {
+                    arguments[i] = registers[function->call_arguments[instruction.left + i]];
+                }
+                destination = HOST_FUNCTIONS[immediate].function(arguments.data());
+                break;
+            }
+
+            case vm::opcode_t::JUMP:
+                offset = immediate;
+                break;
+            case vm::opcode_t::BRANCH:
+                offset = ((left << instruction.right) != 0u) ? immediate : instruction.destination;
+                break;
+            case vm::opcode_t::RET: {
+                if(calls.empty()) { // `main()` returns an `int`
+                    return static_cast<int>(static_cast<std::int32_t>(left));
+                }
+                const frame_t& caller = calls.back();
+                function = caller.function;
+                code = function->code.data();
+                offset = caller.return_offset;
+                registers = caller.registers;
+                memory = caller.memory;
+                registers[caller.result_register] = left;
+                calls.pop_back();
+                break;
+            }
+        }
+    }
+}
+
+utils::result_t<int> run_program(const ast::validated_program_t& program, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const vm::program_t bytecode, compile_to_bytecode(lower_to_ir(program), diagnostics));
+    return run_program(bytecode, diagnostics);
+}
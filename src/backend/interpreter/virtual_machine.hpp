@@ -0,0 +1,93 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <frontend/ast/ast.hpp>
+#include <middle_end/ir/ir.hpp>
+#include <utils/result.hpp>
+#include <utils/symbol_interner.hpp>
+
+
+// A register based bytecode that IR is compiled to, and an interpreter that runs it in process, without assembling and linking the program (`--run`).
+// Every SSA value of a function is a register of its frame: 8 bytes that hold an integer (of which only the low bits of narrower integers are meaningful, as
+//  in the x86_64 backend), the bits of a `float` or `double`, or a pointer. Pointers are host addresses: allocas live in a stack owned by the interpreter and
+//  globals in memory owned by the program, so loads and stores are plain memory accesses.
+// Opcodes are specialized on what they need to know about the IR types of their operands, so that the interpreter never looks at types. Integer widths are
+//  passed as immediates instead (see `instruction_t`).
+namespace vm {
+enum class opcode_t : std::uint8_t {
+    MOVE, // destination = left
+    CONST, // destination = immediate
+    FRAME_ADDRESS, // destination = the address `immediate` bytes into the memory of the frame (an `ALLOCA`)
+    ADD_IMMEDIATE, // destination = left + immediate (a `PTR_OFFSET`)
+
+    // the value is zero extended from the memory at `left` (a `LOAD`), or `right` is stored to the memory at `left` (a `STORE`)
+    LOAD8, LOAD16, LOAD32, LOAD64,
+    STORE8, STORE16, STORE32, STORE64,
+    COPY, // copies `immediate` bytes from the memory at `right` to the memory at `left`
+
+    // integer operations, `immediate` is the number of unused high bits of their type
+    ADD, SUB, MUL, SDIV, UDIV, SREM, UREM,
+    SHL, ASHR, LSHR, // the shift amount is masked as x86_64 masks it
+    AND, OR, XOR,
+    NEG, NOT,
+    EQ, NE,
+    SLT, SLE, SGT, SGE,
+    ULT, ULE, UGT, UGE,
+    SEXT, ZEXT, // of `left`, whose type has `immediate` unused bits
+
+    FADD32, FSUB32, FMUL32, FDIV32, FNEG32,
+    FEQ32, FNE32, FLT32, FLE32, FGT32, FGE32,
+    FADD64, FSUB64, FMUL64, FDIV64, FNEG64,
+    FEQ64, FNE64, FLT64, FLE64, FGT64, FGE64,
+
+    // conversions between integers (of `immediate` unused bits) and floating point values, the latter as the number says
+    SITOF32, SITOF64, UITOF32, UITOF64,
+    F32TOSI, F64TOSI, F32TOUI64, F64TOUI64,
+    FPEXT, FPTRUNC,
+
+    CALL, // calls `program_t::functions[immediate]` with the `right` registers listed from `function_t::call_arguments[left]` on
+    CALL_HOST, // the same, for the host function `immediate` (see `virtual_machine.cpp`)
+
+    JUMP, // to `immediate`, the index of an instruction of the same function
+    BRANCH, // to `immediate` if `left`, an integer with `right` unused bits, is not zero, else to `destination`
+    RET, // returns `left`
+};
+
+// 24 bytes, so that the interpreter loop touches little memory. What each field means depends on the opcode, see `opcode_t`.
+struct instruction_t {
+    opcode_t opcode;
+    std::uint32_t destination = 0u;
+    std::uint32_t left = 0u;
+    std::uint32_t right = 0u;
+    std::uint64_t immediate = 0u;
+};
+
+struct function_t {
+    utils::symbol_t name;
+    std::uint32_t register_count = 0u;
+    std::uint64_t frame_size = 0u; // bytes of memory for the allocas, a multiple of 16
+    std::vector<std::uint32_t> parameters; // the register of each parameter, which calls copy the arguments to
+    std::vector<std::uint32_t> call_arguments; // the registers of the arguments of every call, one after another
+    std::vector<instruction_t> code;
+};
+
+struct program_t {
+    std::vector<function_t> functions;
+    std::uint32_t main_function = 0u;
+    // The storage of all globals. The code holds their addresses as constants, so it has to stay where it is, which makes programs move only.
+    std::unique_ptr<std::byte[]> globals;
+};
+}
+
+// Compiles IR that passed `verify_module()`. Calls to functions that aren't in the module are bound to the host functions of the same name, of which there
+//  are only a few (`putchar()`, `getchar()`). Calls to other functions, and a missing `main()`, are reported.
+utils::result_t<vm::program_t> compile_to_bytecode(const ir::module_t& module, utils::diagnostics_t& diagnostics);
+// Runs `main()` and returns what it returned. Division by zero, overflowing signed division and running out of stack are reported and stop the program.
+utils::result_t<int> run_program(const vm::program_t& program, utils::diagnostics_t& diagnostics);
+// Lowers a type checked program to IR, compiles it to bytecode and runs it.
+utils::result_t<int> run_program(const ast::validated_program_t& program, utils::diagnostics_t& diagnostics);
@@ -0,0 +1,197 @@
+#include "elf_writer.hpp"
+
+#include <backend/x86_64/encoder.hpp>
+#include <backend/x86_64/generate_from_ir.hpp>
+
+#include <elf.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace {
+constexpr std::size_t FUNCTION_ALIGNMENT = 16u;
+constexpr char NOP = '\x90';
+
+// in the order of the section header table
+enum section_index_t : std::uint16_t {
+    NULL_SECTION,
+    TEXT,
+    DATA,
+    BSS,
+    RODATA,
+    RELA_TEXT,
+    SYMTAB,
+    STRTAB,
+    SHSTRTAB,
+    NOTE_GNU_STACK,
+    SECTION_COUNT,
+};
+
+struct section_t {
+    std::string_view name;
+    Elf64_Word type = SHT_NULL;
+    Elf64_Xword flags = 0u;
+    std::string contents{};
+    Elf64_Xword size = 0u; // of `SHT_NOBITS` sections, which have no contents in the file, the others are as big as their contents
+    Elf64_Xword alignment = 1u;
+    Elf64_Word link = 0u;
+    Elf64_Word info = 0u;
+    Elf64_Xword entry_size = 0u;
+};
+
+template<typename T>
+void append(std::string& output, const T& value) {
+    output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+void pad(std::string& output, const std::size_t alignment, const char padding = '\0') {
+    output.resize((output.size() + alignment - 1u) / alignment * alignment, padding);
+}
+// returns the offset of `text` in `table`
+Elf64_Word add_string(std::string& table, const std::string_view text) {
+    const auto offset = static_cast<Elf64_Word>(table.size());
+    table += text;
+    table += '\0';
+    return offset;
+}
+
+struct symbol_table_t {
+    section_t& symbols;
+    section_t& strings;
+    std::unordered_map<utils::symbol_t, Elf64_Word> indices;
+
+    symbol_table_t(section_t& symbols, section_t& strings) : symbols(symbols), strings(strings) {
+        append(symbols.contents, Elf64_Sym{}); // the undefined symbol, index 0
+        strings.contents += '\0';
+    }
+
+    void add(const utils::symbol_t name, const unsigned char type, const std::uint16_t section, const std::uint64_t value, const std::uint64_t size) {
+        indices[name] = static_cast<Elf64_Word>(symbols.contents.size() / sizeof(Elf64_Sym));
+        Elf64_Sym symbol{};
+        symbol.st_name = add_string(strings.contents, name.text());
+        symbol.st_info = ELF64_ST_INFO(STB_GLOBAL, type);
+        symbol.st_other = STV_DEFAULT;
+        symbol.st_shndx = section;
+        symbol.st_value = value;
+        symbol.st_size = size;
+        append(symbols.contents, symbol);
+    }
+};
+}
+
+
+std::string generate_object(const ir::module_t& module) {
+    std::vector<section_t> sections(SECTION_COUNT);
+    sections[TEXT] = section_t{".text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR};
+    sections[TEXT].alignment = FUNCTION_ALIGNMENT;
+    sections[DATA] = section_t{".data", SHT_PROGBITS, SHF_ALLOC | SHF_WRITE};
+    sections[BSS] = section_t{".bss", SHT_NOBITS, SHF_ALLOC | SHF_WRITE};
+    sections[RODATA] = section_t{".rodata", SHT_PROGBITS, SHF_ALLOC};
+    sections[RELA_TEXT] = section_t{".rela.text", SHT_RELA, SHF_INFO_LINK};
+    sections[RELA_TEXT].alignment = 8u;
+    sections[RELA_TEXT].link = SYMTAB;
+    sections[RELA_TEXT].info = TEXT;
+    sections[RELA_TEXT].entry_size = sizeof(Elf64_Rela);
+    sections[SYMTAB] = section_t{".symtab", SHT_SYMTAB};
+    sections[SYMTAB].alignment = 8u;
+    sections[SYMTAB].link = STRTAB;
+    sections[SYMTAB].info = 1u; // the index of the first global symbol, only the undefined symbol is local
+    sections[SYMTAB].entry_size = sizeof(Elf64_Sym);
+    sections[STRTAB] = section_t{".strtab", SHT_STRTAB};
+    sections[SHSTRTAB] = section_t{".shstrtab", SHT_STRTAB};
+    sections[NOTE_GNU_STACK] = section_t{".note.GNU-stack", SHT_PROGBITS};
+    symbol_table_t symbol_table(sections[SYMTAB], sections[STRTAB]);
+
+    const std::vector<x86_64::function_t> functions = select_instructions(module);
+    std::vector<std::uint64_t> function_offsets;
+    std::vector<x86_64::relocation_t> relocations; // with offsets into `.text`
+    for(const x86_64::function_t& function : functions) {
+        const x86_64::machine_code_t machine_code = encode_function(function);
+        std::string& text = sections[TEXT].contents;
+        pad(text, FUNCTION_ALIGNMENT, NOP);
+        symbol_table.add(function.name, STT_FUNC, TEXT, text.size(), machine_code.code.size());
+        for(x86_64::relocation_t relocation : machine_code.relocations) {
+            relocation.offset += text.size();
+            relocations.push_back(relocation);
+        }
+        text.append(reinterpret_cast<const char*>(machine_code.code.data()), machine_code.code.size());
+    }
+
+    for(const auto& global : module.globals) {
+        const std::size_t alignment = std::max<std::size_t>(global.alignment, 1u);
+        section_t& section = sections[global.initializer.empty() ? BSS : DATA];
+        section.alignment = std::max<Elf64_Xword>(section.alignment, alignment);
+        if(global.initializer.empty()) {
+            section.size = (section.size + alignment - 1u) / alignment * alignment;
+            symbol_table.add(global.name, STT_OBJECT, BSS, section.size, global.size);
+            section.size += global.size;
+        } else {
+            pad(section.contents, alignment);
+            symbol_table.add(global.name, STT_OBJECT, DATA, section.contents.size(), global.size);
+            section.contents.append(reinterpret_cast<const char*>(global.initializer.data()), global.initializer.size());
+        }
+    }
+
+    for(const x86_64::relocation_t& relocation : relocations) {
+        if(symbol_table.indices.count(relocation.symbol) == 0u) { // a function of another object or a library
+            symbol_table.add(relocation.symbol, STT_NOTYPE, SHN_UNDEF, 0u, 0u);
+        }
+        Elf64_Rela rela{};
+        rela.r_offset = relocation.offset;
+        rela.r_info = ELF64_R_INFO(symbol_table.indices[relocation.symbol],
+            (relocation.kind == x86_64::relocation_t::kind_t::FUNCTION) ? R_X86_64_PLT32 : R_X86_64_PC32);
+        rela.r_addend = relocation.addend;
+        append(sections[RELA_TEXT].contents, rela);
+    }
+
+    std::vector<Elf64_Word> section_names(SECTION_COUNT, 0u);
+    sections[SHSTRTAB].contents += '\0';
+    for(std::size_t i = 1u; i < SECTION_COUNT; ++i) {
+        section_names[i] = add_string(sections[SHSTRTAB].contents, sections[i].name);
+    }
+
+    // the ELF header, the contents of the sections and then the section header table
+    std::string output(sizeof(Elf64_Ehdr), '\0');
+    std::vector<Elf64_Shdr> section_headers(SECTION_COUNT, Elf64_Shdr{});
+    for(std::size_t i = 1u; i < SECTION_COUNT; ++i) {
+        const section_t& section = sections[i];
+        pad(output, section.alignment);
+        Elf64_Shdr& header = section_headers[i];
+        header.sh_name = section_names[i];
+        header.sh_type = section.type;
+        header.sh_flags = section.flags;
+        header.sh_offset = output.size();
+        header.sh_size = (section.type == SHT_NOBITS) ? section.size : section.contents.size();
+        header.sh_link = section.link;
+        header.sh_info = section.info;
+        header.sh_addralign = section.alignment;
+        header.sh_entsize = section.entry_size;
+        output += section.contents;
+    }
+    pad(output, 8u);
+    const std::size_t section_headers_offset = output.size();
+    for(const Elf64_Shdr& header : section_headers) {
+        append(output, header);
+    }
+
+    Elf64_Ehdr header{};
+    std::memcpy(header.e_ident, ELFMAG, SELFMAG);
+    header.e_ident[EI_CLASS] = ELFCLASS64;
+    header.e_ident[EI_DATA] = ELFDATA2LSB;
+    header.e_ident[EI_VERSION] = EV_CURRENT;
+    header.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+    header.e_type = ET_REL;
+    header.e_machine = EM_X86_64;
+    header.e_version = EV_CURRENT;
+    header.e_shoff = section_headers_offset;
+    header.e_ehsize = sizeof(Elf64_Ehdr);
+    header.e_shentsize = sizeof(Elf64_Shdr);
+    header.e_shnum = SECTION_COUNT;
+    header.e_shstrndx = SHSTRTAB;
+    std::memcpy(output.data(), &header, sizeof(header));
+    return output;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+#include <middle_end/ir/ir.hpp>
+
+
+// Generates an ELF64 relocatable object (`-c`) from IR that passed `verify_module()`, without printing assembly for an external assembler: the instructions
+//  that `select_instructions()` picks are encoded (see `encoder.hpp`) straight into `.text`.
+// Sections are those that gas makes of `generate_asm()`: `.text` with every function, `.data` with the initialized globals, `.bss` with the zero
+//  initialized ones, an empty `.note.GNU-stack` so that the stack isn't executable, and `.rodata`, which nothing is put in yet as there is no `const`.
+// Every function and global is a global symbol. Calls (`R_X86_64_PLT32`) and global addresses (`R_X86_64_PC32`) are left to the linker, as gas does for
+//  global symbols, and functions that aren't defined are undefined symbols.
+// The object is returned as a string of bytes.
+std::string generate_object(const ir::module_t& module);
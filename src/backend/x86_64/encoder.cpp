@@ -0,0 +1,367 @@
+#include "encoder.hpp"
+
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+using operand_kind_t = x86_64::operand_t::kind_t;
+
+constexpr std::uint8_t OPERAND_SIZE_PREFIX = 0x66u;
+
+struct encoder_t {
+    x86_64::machine_code_t& output;
+    std::vector<std::uint64_t> label_offsets;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> label_fields; // the offset of each 32 bit displacement to a label, and the label
+
+    encoder_t(x86_64::machine_code_t& output, const std::uint32_t label_count) : output(output), label_offsets(label_count, 0u) {}
+
+    void emit(const std::uint8_t byte) {
+        output.code.push_back(byte);
+    }
+    void emit(const std::initializer_list<std::uint8_t> bytes) {
+        output.code.insert(std::end(output.code), bytes);
+    }
+    // little endian
+    void emit_immediate(const std::int64_t value, const std::size_t size) {
+        for(std::size_t i = 0u; i < size; ++i) {
+            emit(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8u * i)));
+        }
+    }
+    void emit_label_displacement(const std::int64_t label) {
+        label_fields.emplace_back(output.code.size(), static_cast<std::uint32_t>(label));
+        emit_immediate(0, 4u);
+    }
+    void emit_relocation(const x86_64::relocation_t::kind_t kind, const utils::symbol_t symbol) {
+        output.relocations.push_back(x86_64::relocation_t{kind, output.code.size(), symbol, 0});
+        emit_immediate(0, 4u);
+    }
+};
+
+[[noreturn]] void throw_unencodable() {
+    throw std::logic_error("Cannot encode x86_64 instruction.");
+}
+bool fits_in_8_bits(const std::int64_t value) {
+    return value >= std::numeric_limits<std::int8_t>::min() && value <= std::numeric_limits<std::int8_t>::max();
+}
+bool fits_in_32_bits(const std::int64_t value) {
+    return value >= std::numeric_limits<std::int32_t>::min() && value <= std::numeric_limits<std::int32_t>::max();
+}
+std::uint8_t get_operand_size_prefix(const std::uint8_t size) {
+    return (size == 2u) ? OPERAND_SIZE_PREFIX : 0u;
+}
+std::uint8_t get_encoding(const x86_64::operand_t& operand) {
+    return x86_64::get_encoding(operand.reg);
+}
+// `%spl`, `%bpl`, `%sil` and `%dil` are only there with a REX prefix, without one the same numbers are `%ah`, `%ch`, `%dh` and `%bh`
+bool needs_rex_for_byte_registers(const x86_64::instruction_t& instruction) {
+    for(std::uint8_t i = 0u; i < instruction.operand_count; ++i) {
+        const x86_64::operand_t& operand = instruction.operands[i];
+        if(operand.kind == operand_kind_t::REGISTER && operand.size == 1u && !x86_64::is_sse_register(operand.reg) && get_encoding(operand) >= 4u && get_encoding(operand) < 8u) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Emits `prefix` (unless it's zero), a REX prefix if one is needed, `opcode`, and ModRM with `reg` (a register number or an opcode extension) and `rm`,
+//  followed by the SIB byte and displacement that `rm` needs.
+void emit_modrm_instruction(encoder_t& out, const x86_64::instruction_t& instruction, const std::uint8_t prefix, const bool is_wide, const std::uint8_t reg,
+    const x86_64::operand_t& rm, const std::initializer_list<std::uint8_t> opcode) {
+    if(prefix != 0u) {
+        out.emit(prefix);
+    }
+    const std::uint8_t rm_encoding = (rm.kind == operand_kind_t::REGISTER || rm.kind == operand_kind_t::MEMORY) ? get_encoding(rm) : 0u;
+    const std::uint8_t rex = static_cast<std::uint8_t>(0x40u | (is_wide ? 0x08u : 0u) | ((reg >> 3u) << 2u) | (rm_encoding >> 3u));
+    if(rex != 0x40u || needs_rex_for_byte_registers(instruction)) {
+        out.emit(rex);
+    }
+    out.emit(opcode);
+    const auto reg_bits = static_cast<std::uint8_t>((reg & 7u) << 3u);
+    switch(rm.kind) {
+        case operand_kind_t::REGISTER:
+            out.emit(static_cast<std::uint8_t>(0xc0u | reg_bits | (rm_encoding & 7u)));
+            return;
+        case operand_kind_t::MEMORY: {
+            // `%rbp` and `%r13` as bases always have a displacement, the encoding without one means `%rip` (or no base, with SIB)
+            const std::uint8_t mod = (rm.value == 0 && (rm_encoding & 7u) != 5u) ? 0u : fits_in_8_bits(rm.value) ? 1u : 2u;
+            if(!fits_in_32_bits(rm.value)) {
+                throw_unencodable();
+            }
+            out.emit(static_cast<std::uint8_t>((mod << 6u) | reg_bits | (rm_encoding & 7u)));
+            if((rm_encoding & 7u) == 4u) { // `%rsp` and `%r12` as bases need SIB, with no index
+                out.emit(0x24u);
+            }
+            if(mod == 1u) {
+                out.emit_immediate(rm.value, 1u);
+            } else if(mod == 2u) {
+                out.emit_immediate(rm.value, 4u);
+            }
+            return;
+        }
+        case operand_kind_t::GLOBAL:
+            out.emit(static_cast<std::uint8_t>(0x05u | reg_bits));
+            out.emit_relocation(x86_64::relocation_t::kind_t::GLOBAL, rm.symbol);
+            return;
+        default:
+            throw_unencodable();
+    }
+}
+// The opcodes that add the register number to their last byte.
+void emit_register_in_opcode(encoder_t& out, const bool is_wide, const x86_64::register_t reg, const std::uint8_t opcode) {
+    const std::uint8_t encoding = x86_64::get_encoding(reg);
+    const std::uint8_t rex = static_cast<std::uint8_t>(0x40u | (is_wide ? 0x08u : 0u) | (encoding >> 3u));
+    if(rex != 0x40u) {
+        out.emit(rex);
+    }
+    out.emit(static_cast<std::uint8_t>(opcode + (encoding & 7u)));
+}
+
+// `add`, `or`, `and`, `sub`, `xor` and `cmp`, which differ only in `extension`
+void encode_arithmetic(encoder_t& out, const x86_64::instruction_t& instruction, const std::uint8_t extension) {
+    const x86_64::operand_t& source = instruction.operands[0];
+    const x86_64::operand_t& destination = instruction.operands[1];
+    const std::uint8_t size = instruction.size;
+    const std::uint8_t prefix = get_operand_size_prefix(size);
+    const bool is_wide = (size == 8u);
+    switch(source.kind) {
+        case operand_kind_t::IMMEDIATE:
+            if(size == 1u) {
+                emit_modrm_instruction(out, instruction, prefix, is_wide, extension, destination, {0x80u});
+                out.emit_immediate(source.value, 1u);
+            } else if(fits_in_8_bits(source.value)) {
+                emit_modrm_instruction(out, instruction, prefix, is_wide, extension, destination, {0x83u});
+                out.emit_immediate(source.value, 1u);
+            } else {
+                emit_modrm_instruction(out, instruction, prefix, is_wide, extension, destination, {0x81u});
+                out.emit_immediate(source.value, (size == 2u) ? 2u : 4u);
+            }
+            return;
+        case operand_kind_t::REGISTER:
+            emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(source), destination,
+                {static_cast<std::uint8_t>((extension << 3u) | ((size == 1u) ? 0u : 1u))});
+            return;
+        default:
+            emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(destination), source,
+                {static_cast<std::uint8_t>((extension << 3u) | ((size == 1u) ? 2u : 3u))});
+            return;
+    }
+}
+// `not`, `neg`, `div` and `idiv`
+void encode_unary(encoder_t& out, const x86_64::instruction_t& instruction, const std::uint8_t extension) {
+    emit_modrm_instruction(out, instruction, get_operand_size_prefix(instruction.size), instruction.size == 8u, extension, instruction.operands[0],
+        {(instruction.size == 1u) ? std::uint8_t{0xf6u} : std::uint8_t{0xf7u}});
+}
+void encode_shift(encoder_t& out, const x86_64::instruction_t& instruction, const std::uint8_t extension) {
+    const std::uint8_t prefix = get_operand_size_prefix(instruction.size);
+    const bool is_wide = (instruction.size == 8u);
+    const std::uint8_t byte_offset = (instruction.size == 1u) ? 0u : 1u;
+    if(instruction.operand_count == 1u) {
+        emit_modrm_instruction(out, instruction, prefix, is_wide, extension, instruction.operands[0], {static_cast<std::uint8_t>(0xd0u + byte_offset)});
+    } else if(instruction.operands[0].kind == operand_kind_t::IMMEDIATE) {
+        emit_modrm_instruction(out, instruction, prefix, is_wide, extension, instruction.operands[1], {static_cast<std::uint8_t>(0xc0u + byte_offset)});
+        out.emit_immediate(instruction.operands[0].value, 1u);
+    } else { // by `%cl`
+        emit_modrm_instruction(out, instruction, prefix, is_wide, extension, instruction.operands[1], {static_cast<std::uint8_t>(0xd2u + byte_offset)});
+    }
+}
+// the scalar SSE arithmetic, with `reg` the destination
+void encode_sse(encoder_t& out, const x86_64::instruction_t& instruction, const bool is_wide, const std::uint8_t opcode) {
+    emit_modrm_instruction(out, instruction, (instruction.size == 4u) ? 0xf3u : 0xf2u, is_wide, get_encoding(instruction.operands[1]), instruction.operands[0], {0x0fu, opcode});
+}
+
+void encode_mov(encoder_t& out, const x86_64::instruction_t& instruction) {
+    const x86_64::operand_t& source = instruction.operands[0];
+    const x86_64::operand_t& destination = instruction.operands[1];
+    const std::uint8_t size = instruction.size;
+    const std::uint8_t prefix = get_operand_size_prefix(size);
+    const bool is_wide = (size == 8u);
+    switch(source.kind) {
+        case operand_kind_t::IMMEDIATE: // sign extended from 32 bits for `movq`
+            if(!fits_in_32_bits(source.value)) {
+                throw_unencodable();
+            }
+            emit_modrm_instruction(out, instruction, prefix, is_wide, 0u, destination, {(size == 1u) ? std::uint8_t{0xc6u} : std::uint8_t{0xc7u}});
+            out.emit_immediate(source.value, (size < 4u) ? size : 4u);
+            return;
+        case operand_kind_t::REGISTER:
+            emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(source), destination, {(size == 1u) ? std::uint8_t{0x88u} : std::uint8_t{0x89u}});
+            return;
+        default:
+            emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(destination), source, {(size == 1u) ? std::uint8_t{0x8au} : std::uint8_t{0x8bu}});
+            return;
+    }
+}
+void encode_movq(encoder_t& out, const x86_64::instruction_t& instruction) {
+    const x86_64::operand_t& source = instruction.operands[0];
+    const x86_64::operand_t& destination = instruction.operands[1];
+    if(destination.kind == operand_kind_t::REGISTER && x86_64::is_sse_register(destination.reg)) {
+        if(source.kind == operand_kind_t::REGISTER && !x86_64::is_sse_register(source.reg)) {
+            emit_modrm_instruction(out, instruction, OPERAND_SIZE_PREFIX, true, get_encoding(destination), source, {0x0fu, 0x6eu});
+        } else {
+            emit_modrm_instruction(out, instruction, 0xf3u, false, get_encoding(destination), source, {0x0fu, 0x7eu});
+        }
+    } else if(destination.kind == operand_kind_t::REGISTER) {
+        emit_modrm_instruction(out, instruction, OPERAND_SIZE_PREFIX, true, get_encoding(source), destination, {0x0fu, 0x7eu});
+    } else {
+        emit_modrm_instruction(out, instruction, OPERAND_SIZE_PREFIX, false, get_encoding(source), destination, {0x0fu, 0xd6u});
+    }
+}
+
+void encode_instruction(encoder_t& out, const x86_64::instruction_t& instruction) {
+    const x86_64::operand_t& source = instruction.operands[0];
+    const x86_64::operand_t& destination = instruction.operands[1];
+    const std::uint8_t size = instruction.size;
+    const auto condition = static_cast<std::uint8_t>(instruction.condition);
+    switch(instruction.opcode) {
+        case x86_64::opcode_t::LABEL:
+            out.label_offsets[static_cast<std::size_t>(source.value)] = out.output.code.size();
+            return;
+
+        case x86_64::opcode_t::MOV:
+            encode_mov(out, instruction);
+            return;
+        case x86_64::opcode_t::MOVABS:
+            emit_register_in_opcode(out, true, destination.reg, 0xb8u);
+            out.emit_immediate(source.value, 8u);
+            return;
+        case x86_64::opcode_t::LEA:
+            emit_modrm_instruction(out, instruction, 0u, true, get_encoding(destination), source, {0x8du});
+            return;
+        case x86_64::opcode_t::MOVZX:
+        case x86_64::opcode_t::MOVSX: {
+            const std::uint8_t prefix = get_operand_size_prefix(destination.size);
+            const bool is_wide = (destination.size == 8u);
+            if(size == 4u) { // `movslq`, there is no `movzlq` as 32 bit operations zero the upper half
+                if(instruction.opcode == x86_64::opcode_t::MOVZX) {
+                    throw_unencodable();
+                }
+                emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(destination), source, {0x63u});
+                return;
+            }
+            const std::uint8_t opcode = ((instruction.opcode == x86_64::opcode_t::MOVZX) ? 0xb6u : 0xbeu) + ((size == 1u) ? 0u : 1u);
+            emit_modrm_instruction(out, instruction, prefix, is_wide, get_encoding(destination), source, {0x0fu, opcode});
+            return;
+        }
+
+        case x86_64::opcode_t::ADD: encode_arithmetic(out, instruction, 0u); return;
+        case x86_64::opcode_t::OR: encode_arithmetic(out, instruction, 1u); return;
+        case x86_64::opcode_t::AND: encode_arithmetic(out, instruction, 4u); return;
+        case x86_64::opcode_t::SUB: encode_arithmetic(out, instruction, 5u); return;
+        case x86_64::opcode_t::XOR: encode_arithmetic(out, instruction, 6u); return;
+        case x86_64::opcode_t::CMP: encode_arithmetic(out, instruction, 7u); return;
+        case x86_64::opcode_t::TEST:
+            if(source.kind != operand_kind_t::REGISTER) {
+                throw_unencodable();
+            }
+            emit_modrm_instruction(out, instruction, get_operand_size_prefix(size), size == 8u, get_encoding(source), destination,
+                {(size == 1u) ? std::uint8_t{0x84u} : std::uint8_t{0x85u}});
+            return;
+        case x86_64::opcode_t::IMUL:
+            if(size == 1u) {
+                throw_unencodable();
+            }
+            emit_modrm_instruction(out, instruction, get_operand_size_prefix(size), size == 8u, get_encoding(destination), source, {0x0fu, 0xafu});
+            return;
+        case x86_64::opcode_t::NOT: encode_unary(out, instruction, 2u); return;
+        case x86_64::opcode_t::NEG: encode_unary(out, instruction, 3u); return;
+        case x86_64::opcode_t::DIV: encode_unary(out, instruction, 6u); return;
+        case x86_64::opcode_t::IDIV: encode_unary(out, instruction, 7u); return;
+        case x86_64::opcode_t::SHL: encode_shift(out, instruction, 4u); return;
+        case x86_64::opcode_t::SHR: encode_shift(out, instruction, 5u); return;
+        case x86_64::opcode_t::SAR: encode_shift(out, instruction, 7u); return;
+        case x86_64::opcode_t::BTC:
+            emit_modrm_instruction(out, instruction, get_operand_size_prefix(size), size == 8u, 7u, destination, {0x0fu, 0xbau});
+            out.emit_immediate(source.value, 1u);
+            return;
+        case x86_64::opcode_t::CDQ:
+            if(size == 8u) {
+                out.emit(0x48u); // REX.W
+            }
+            out.emit(0x99u);
+            return;
+
+        case x86_64::opcode_t::SETCC:
+            emit_modrm_instruction(out, instruction, 0u, false, 0u, source, {0x0fu, static_cast<std::uint8_t>(0x90u + condition)});
+            return;
+        case x86_64::opcode_t::JCC:
+            out.emit({0x0fu, static_cast<std::uint8_t>(0x80u + condition)});
+            out.emit_label_displacement(source.value);
+            return;
+        case x86_64::opcode_t::JMP:
+            out.emit(0xe9u);
+            out.emit_label_displacement(source.value);
+            return;
+        case x86_64::opcode_t::CALL:
+            out.emit(0xe8u);
+            out.emit_relocation(x86_64::relocation_t::kind_t::FUNCTION, source.symbol);
+            return;
+        case x86_64::opcode_t::PUSH:
+            if(source.kind == operand_kind_t::REGISTER) {
+                emit_register_in_opcode(out, false, source.reg, 0x50u);
+            } else {
+                emit_modrm_instruction(out, instruction, 0u, false, 6u, source, {0xffu});
+            }
+            return;
+        case x86_64::opcode_t::POP:
+            if(source.kind == operand_kind_t::REGISTER) {
+                emit_register_in_opcode(out, false, source.reg, 0x58u);
+            } else {
+                emit_modrm_instruction(out, instruction, 0u, false, 0u, source, {0x8fu});
+            }
+            return;
+        case x86_64::opcode_t::LEAVE:
+            out.emit(0xc9u);
+            return;
+        case x86_64::opcode_t::RET:
+            out.emit(0xc3u);
+            return;
+
+        case x86_64::opcode_t::MOVQ:
+            encode_movq(out, instruction);
+            return;
+        case x86_64::opcode_t::MOVD:
+            emit_modrm_instruction(out, instruction, OPERAND_SIZE_PREFIX, false, get_encoding(destination), source, {0x0fu, 0x6eu});
+            return;
+        case x86_64::opcode_t::FADD: encode_sse(out, instruction, false, 0x58u); return;
+        case x86_64::opcode_t::FMUL: encode_sse(out, instruction, false, 0x59u); return;
+        case x86_64::opcode_t::FSUB: encode_sse(out, instruction, false, 0x5cu); return;
+        case x86_64::opcode_t::FDIV: encode_sse(out, instruction, false, 0x5eu); return;
+        case x86_64::opcode_t::UCOMI:
+            emit_modrm_instruction(out, instruction, (size == 4u) ? 0u : OPERAND_SIZE_PREFIX, false, get_encoding(destination), source, {0x0fu, 0x2eu});
+            return;
+        case x86_64::opcode_t::CVTSI2F: encode_sse(out, instruction, true, 0x2au); return;
+        case x86_64::opcode_t::CVTTF2SI: encode_sse(out, instruction, true, 0x2cu); return;
+        case x86_64::opcode_t::CVTSS2SD:
+            emit_modrm_instruction(out, instruction, 0xf3u, false, get_encoding(destination), source, {0x0fu, 0x5au});
+            return;
+        case x86_64::opcode_t::CVTSD2SS:
+            emit_modrm_instruction(out, instruction, 0xf2u, false, get_encoding(destination), source, {0x0fu, 0x5au});
+            return;
+    }
+    throw std::logic_error("Invalid x86_64 opcode.");
+}
+}
+
+
+x86_64::machine_code_t encode_function(const x86_64::function_t& function) {
+    x86_64::machine_code_t output;
+    encoder_t out(output, function.label_count);
+    for(const x86_64::instruction_t& instruction : function.instructions) {
+        const std::size_t first_relocation = output.relocations.size();
+        encode_instruction(out, instruction);
+        // relative to the end of the instruction, which is where the CPU adds the field to
+        for(std::size_t i = first_relocation; i < output.relocations.size(); ++i) {
+            output.relocations[i].addend = static_cast<std::int64_t>(output.relocations[i].offset) - static_cast<std::int64_t>(output.code.size());
+        }
+    }
+    for(const auto& [field_offset, label] : out.label_fields) {
+        const auto displacement = static_cast<std::int64_t>(out.label_offsets[label]) - static_cast<std::int64_t>(field_offset + 4u);
+        for(std::size_t i = 0u; i < 4u; ++i) {
+            output.code[field_offset + i] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(displacement) >> (8u * i));
+        }
+    }
+    return output;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "instructions.hpp"
+#include <utils/symbol_interner.hpp>
+
+
+namespace x86_64 {
+// A 32 bit field of the code that holds `symbol + addend - <the address of the field>` once the symbol has an address: the target of a call
+//  (`FUNCTION`), or a global's memory (`GLOBAL`).
+struct relocation_t {
+    enum class kind_t : std::uint8_t {
+        FUNCTION,
+        GLOBAL,
+    };
+
+    kind_t kind;
+    std::uint64_t offset; // of the field, in the code of the function
+    utils::symbol_t symbol;
+    std::int64_t addend;
+};
+
+struct machine_code_t {
+    std::vector<std::uint8_t> code;
+    std::vector<relocation_t> relocations;
+};
+}
+
+// Encodes the instructions of a function as machine code. Jumps to its labels are resolved, everything else that has an address is left to relocations.
+// Every jump is encoded with a 32 bit displacement, instead of picking the shortest encoding.
+x86_64::machine_code_t encode_function(const x86_64::function_t& function);
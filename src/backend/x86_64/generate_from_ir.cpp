@@ -0,0 +1,714 @@
+#include "generate_from_ir.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+constexpr std::array<x86_64::register_t, 6> INTEGER_ARGUMENT_REGISTERS{
+    x86_64::register_t::RDI, x86_64::register_t::RSI, x86_64::register_t::RDX, x86_64::register_t::RCX, x86_64::register_t::R8, x86_64::register_t::R9
+};
+constexpr std::uint32_t NUMBER_OF_SSE_ARGUMENT_REGISTERS = 8u;
+
+x86_64::register_t get_sse_argument_register(const std::uint32_t index) {
+    return static_cast<x86_64::register_t>(static_cast<std::uint8_t>(x86_64::register_t::XMM0) + index);
+}
+bool is_passed_in_registers(const ir::struct_passing_t& passing) {
+    return passing.is_struct && !passing.is_in_memory;
+}
+// of each eightbyte of a struct that is returned in registers: `%rax` then `%rdx` for the integer ones, `%xmm0` then `%xmm1` for the SSE ones
+std::array<x86_64::register_t, 2> get_struct_return_registers(const ir::struct_passing_t& passing) {
+    std::array<x86_64::register_t, 2> registers{};
+    std::uint32_t integer_count = 0u;
+    std::uint32_t sse_count = 0u;
+    for(std::uint8_t i = 0u; i < passing.eightbyte_count; ++i) {
+        registers[i] = passing.is_sse[i] ? get_sse_argument_register(sse_count++) : ((integer_count++ == 0u) ? x86_64::register_t::RAX : x86_64::register_t::RDX);
+    }
+    return registers;
+}
+
+// Where an argument is passed, which the caller (`generate_call()`) and the callee (`generate_parameters()`) have to agree on.
+struct argument_location_t {
+    bool is_struct = false; // then the argument is the address of the struct, but what is passed is the struct itself
+    bool is_on_stack = false;
+    std::uint64_t stack_offset = 0u; // in bytes, from the first argument on the stack
+    std::uint8_t register_count = 0u; // one per eightbyte of a struct (none for an empty struct), else one if it isn't on the stack
+    std::array<x86_64::register_t, 2> registers{};
+};
+struct argument_locations_t {
+    std::vector<argument_location_t> locations;
+    std::uint32_t sse_count = 0u; // of the registers that are used
+    std::uint64_t stack_size = 0u; // in bytes
+};
+// `types` and `structs` are those of the arguments (see `ir::instruction_t::struct_arguments`). A struct that is returned in registers has no pointer to where
+//  to return it to passed, so argument 0 is then not passed at all.
+argument_locations_t assign_argument_locations(const std::vector<ir::type_t>& types, const std::vector<ir::struct_passing_t>& structs, const ir::struct_passing_t& struct_return) {
+    argument_locations_t arguments;
+    arguments.locations.resize(types.size());
+    std::uint32_t integer_count = 0u;
+    const auto pass_on_stack = [&arguments](argument_location_t& location, const std::uint64_t size) {
+        location.is_on_stack = true;
+        location.stack_offset = arguments.stack_size;
+        arguments.stack_size += (size + 7u) / 8u * 8u;
+    };
+    for(std::size_t i = 0u; i < types.size(); ++i) {
+        argument_location_t& location = arguments.locations[i];
+        if(i == 0u && is_passed_in_registers(struct_return)) {
+            continue;
+        }
+        const ir::struct_passing_t passing = structs.empty() ? ir::struct_passing_t{} : structs[i];
+        location.is_struct = passing.is_struct;
+        if(!passing.is_struct) {
+            if(ir::is_floating(types[i]) && arguments.sse_count < NUMBER_OF_SSE_ARGUMENT_REGISTERS) {
+                location.registers[location.register_count++] = get_sse_argument_register(arguments.sse_count++);
+            } else if(!ir::is_floating(types[i]) && integer_count < INTEGER_ARGUMENT_REGISTERS.size()) {
+                location.registers[location.register_count++] = INTEGER_ARGUMENT_REGISTERS[integer_count++];
+            } else {
+                pass_on_stack(location, 8u);
+            }
+            continue;
+        }
+        const auto sse_eightbyte_count = static_cast<std::uint32_t>(std::count(std::begin(passing.is_sse), std::begin(passing.is_sse) + passing.eightbyte_count, true));
+        const std::uint32_t integer_eightbyte_count = passing.eightbyte_count - sse_eightbyte_count;
+        // a struct is passed in registers only if all of it fits in the ones that are left
+        if(passing.is_in_memory || arguments.sse_count + sse_eightbyte_count > NUMBER_OF_SSE_ARGUMENT_REGISTERS || integer_count + integer_eightbyte_count > INTEGER_ARGUMENT_REGISTERS.size()) {
+            pass_on_stack(location, passing.size);
+            continue;
+        }
+        for(std::uint8_t j = 0u; j < passing.eightbyte_count; ++j) {
+            location.registers[location.register_count++] = passing.is_sse[j] ? get_sse_argument_register(arguments.sse_count++) : INTEGER_ARGUMENT_REGISTERS[integer_count++];
+        }
+    }
+    return arguments;
+}
+// in bytes, the width of the instructions that operate on `type`
+std::uint8_t get_width(const ir::type_t type) {
+    return static_cast<std::uint8_t>(ir::get_size(type));
+}
+// the scratch registers, at the width of an IR type
+x86_64::operand_t rax(const ir::type_t type = ir::type_t::I64) {
+    return x86_64::make_register(x86_64::register_t::RAX, get_width(type));
+}
+x86_64::operand_t rcx(const ir::type_t type = ir::type_t::I64) {
+    return x86_64::make_register(x86_64::register_t::RCX, get_width(type));
+}
+x86_64::operand_t rdx(const ir::type_t type = ir::type_t::I64) {
+    return x86_64::make_register(x86_64::register_t::RDX, get_width(type));
+}
+const x86_64::operand_t XMM0 = x86_64::make_register(x86_64::register_t::XMM0);
+const x86_64::operand_t XMM1 = x86_64::make_register(x86_64::register_t::XMM1);
+
+struct function_output_t {
+    x86_64::function_t& output;
+    const ir::function_t& function;
+    std::vector<std::int64_t> slot_offsets; // from `%rbp`, of each value's slot
+    std::vector<std::int64_t> alloca_offsets; // from `%rbp`, of the memory of each `ALLOCA`, and of each `PARAM` of a struct that may be passed in registers
+    std::int64_t struct_return_offset = 0; // from `%rbp`, of the struct that is returned in registers, or else of the pointer to where it's returned to
+    std::uint64_t frame_size = 0u;
+
+    function_output_t(x86_64::function_t& output, const ir::function_t& function) : output(output), function(function) {
+        output.name = function.name;
+        output.label_count = static_cast<std::uint32_t>(function.blocks.size());
+    }
+
+    void emit(const x86_64::opcode_t opcode, const std::uint8_t size = 8u) {
+        output.instructions.push_back(x86_64::instruction_t{opcode, size, x86_64::condition_t::E, 0u, {}});
+    }
+    void emit(const x86_64::opcode_t opcode, const std::uint8_t size, const x86_64::operand_t& operand) {
+        output.instructions.push_back(x86_64::instruction_t{opcode, size, x86_64::condition_t::E, 1u, {operand, {}}});
+    }
+    void emit(const x86_64::opcode_t opcode, const std::uint8_t size, const x86_64::operand_t& source, const x86_64::operand_t& destination) {
+        output.instructions.push_back(x86_64::instruction_t{opcode, size, x86_64::condition_t::E, 2u, {source, destination}});
+    }
+    void emit_conditional(const x86_64::opcode_t opcode, const x86_64::condition_t condition, const x86_64::operand_t& operand) {
+        output.instructions.push_back(x86_64::instruction_t{opcode, 1u, condition, 1u, {operand, {}}});
+    }
+    void emit_label(const std::uint32_t label) {
+        emit(x86_64::opcode_t::LABEL, 8u, x86_64::make_label(label));
+    }
+    x86_64::operand_t slot(const ir::value_t value) const {
+        return x86_64::make_memory(x86_64::register_t::RBP, slot_offsets[value]);
+    }
+    std::uint32_t new_label() {
+        return output.label_count++;
+    }
+    // moves a whole slot, with `movq` for SSE registers
+    void load(const ir::value_t value, const x86_64::operand_t& destination) {
+        emit(x86_64::is_sse_register(destination.reg) ? x86_64::opcode_t::MOVQ : x86_64::opcode_t::MOV, 8u, slot(value), destination);
+    }
+    void store(const x86_64::operand_t& source, const ir::value_t value) {
+        emit(x86_64::is_sse_register(source.reg) ? x86_64::opcode_t::MOVQ : x86_64::opcode_t::MOV, 8u, source, slot(value));
+    }
+    // moves an eightbyte of a struct between memory and the register it is passed in
+    void move_eightbyte(const x86_64::operand_t& source, const x86_64::operand_t& destination) {
+        const x86_64::operand_t& reg = (source.kind == x86_64::operand_t::kind_t::REGISTER) ? source : destination;
+        emit(x86_64::is_sse_register(reg.reg) ? x86_64::opcode_t::MOVQ : x86_64::opcode_t::MOV, 8u, source, destination);
+    }
+};
+
+void lay_out_frame(function_output_t& out) {
+    const ir::function_t& function = out.function;
+    out.slot_offsets.assign(function.instructions.size(), 0);
+    out.alloca_offsets.assign(function.instructions.size(), 0);
+    const auto allocate = [&out](const std::uint64_t size, const std::uint64_t alignment) {
+        out.frame_size = (out.frame_size + size + alignment - 1u) / alignment * alignment;
+        return -static_cast<std::int64_t>(out.frame_size);
+    };
+    if(function.struct_return.is_struct) {
+        out.struct_return_offset = allocate(is_passed_in_registers(function.struct_return) ? 16u : 8u, 8u);
+    }
+    for(const auto& block : function.blocks) {
+        for(const ir::value_t value : block.instructions) {
+            const ir::instruction_t& instruction = function.get(value);
+            if(instruction.opcode == ir::opcode_t::ALLOCA) {
+                out.alloca_offsets[value] = allocate(instruction.immediate, std::max<std::uint64_t>(instruction.alignment, 1u));
+            } else if(instruction.opcode == ir::opcode_t::PARAM && !function.param_structs.empty() && is_passed_in_registers(function.param_structs[instruction.immediate])) {
+                out.alloca_offsets[value] = allocate(16u, 8u); // where the registers are stored to, if it isn't passed on the stack
+            }
+            if(instruction.type != ir::type_t::VOID) {
+                out.frame_size += 8u;
+                out.slot_offsets[value] = -static_cast<std::int64_t>(out.frame_size);
+            }
+        }
+    }
+    out.frame_size = (out.frame_size + 15u) / 16u * 16u; // keeps `%rsp` 16 byte aligned at calls
+}
+
+// Stores the incoming arguments to the slots of the `PARAM`s, before anything can overwrite the registers they are passed in. A struct is stored to the
+//  frame if it's passed in registers, and the slot of its `PARAM` gets its address.
+void generate_parameters(function_output_t& out) {
+    const ir::function_t& function = out.function;
+    const argument_locations_t parameters = assign_argument_locations(function.param_types, function.param_structs, function.struct_return);
+    if(function.struct_return.is_in_memory) { // returned in `%rax` (see `RET`)
+        out.emit(x86_64::opcode_t::MOV, 8u, x86_64::make_register(parameters.locations[0].registers[0]), x86_64::make_memory(x86_64::register_t::RBP, out.struct_return_offset));
+    }
+    for(const ir::value_t value : function.blocks[0].instructions) {
+        const ir::instruction_t& instruction = function.get(value);
+        if(instruction.opcode != ir::opcode_t::PARAM) {
+            continue;
+        }
+        const argument_location_t& location = parameters.locations[instruction.immediate];
+        const auto stack_location = x86_64::make_memory(x86_64::register_t::RBP, 16 + static_cast<std::int64_t>(location.stack_offset)); // above the saved `%rbp` and the return address
+        if(instruction.immediate == 0u && is_passed_in_registers(function.struct_return)) {
+            out.emit(x86_64::opcode_t::LEA, 8u, x86_64::make_memory(x86_64::register_t::RBP, out.struct_return_offset), rax());
+            out.store(rax(), value);
+        } else if(location.is_struct) {
+            if(location.is_on_stack) {
+                out.emit(x86_64::opcode_t::LEA, 8u, stack_location, rax());
+            } else {
+                for(std::uint8_t i = 0u; i < location.register_count; ++i) {
+                    out.move_eightbyte(x86_64::make_register(location.registers[i]), x86_64::make_memory(x86_64::register_t::RBP, out.alloca_offsets[value] + 8 * i));
+                }
+                out.emit(x86_64::opcode_t::LEA, 8u, x86_64::make_memory(x86_64::register_t::RBP, out.alloca_offsets[value]), rax());
+            }
+            out.store(rax(), value);
+        } else if(location.is_on_stack) {
+            out.emit(x86_64::opcode_t::MOV, 8u, stack_location, rax());
+            out.store(rax(), value);
+        } else {
+            out.store(x86_64::make_register(location.registers[0]), value);
+        }
+    }
+}
+
+// The copies that the phis of `target` need when control goes there from `block`.
+void generate_phi_copies(function_output_t& out, const ir::block_id_t block, const ir::block_id_t target) {
+    std::vector<std::pair<ir::value_t, ir::value_t>> copies; // phi, incoming value
+    for(const ir::value_t value : out.function.blocks[target].instructions) {
+        const ir::instruction_t& instruction = out.function.get(value);
+        if(instruction.opcode != ir::opcode_t::PHI) {
+            break;
+        }
+        for(std::size_t i = 0u; i < instruction.targets.size(); ++i) {
+            if(instruction.targets[i] == block) {
+                copies.emplace_back(value, instruction.operands[i]);
+            }
+        }
+    }
+    for(const auto& copy : copies) {
+        out.emit(x86_64::opcode_t::PUSH, 8u, out.slot(copy.second));
+    }
+    for(auto copy_iter = std::rbegin(copies); copy_iter != std::rend(copies); ++copy_iter) {
+        out.emit(x86_64::opcode_t::POP, 8u, out.slot(copy_iter->first));
+    }
+}
+bool has_phis(const function_output_t& out, const ir::block_id_t block) {
+    return out.function.get(out.function.blocks[block].instructions.front()).opcode == ir::opcode_t::PHI;
+}
+
+void generate_call(function_output_t& out, const ir::value_t value, const ir::instruction_t& call) {
+    std::vector<ir::type_t> types;
+    for(const ir::value_t argument : call.operands) {
+        types.push_back(out.function.get(argument).type);
+    }
+    const argument_locations_t arguments = assign_argument_locations(types, call.struct_arguments, call.struct_return);
+    const x86_64::operand_t rsp = x86_64::make_register(x86_64::register_t::RSP);
+    const std::uint64_t stack_size = (arguments.stack_size + 15u) / 16u * 16u;
+    if(stack_size != arguments.stack_size) {
+        out.emit(x86_64::opcode_t::SUB, 8u, x86_64::make_immediate(8), rsp);
+    }
+    for(std::size_t i = call.operands.size(); i-- > 0u;) { // last to first, so that the first argument ends up lowest
+        const argument_location_t& location = arguments.locations[i];
+        if(!location.is_on_stack) {
+            continue;
+        }
+        if(!location.is_struct) {
+            out.emit(x86_64::opcode_t::PUSH, 8u, out.slot(call.operands[i]));
+            continue;
+        }
+        out.load(call.operands[i], rax());
+        for(std::uint64_t offset = (call.struct_arguments[i].size + 7u) / 8u * 8u; offset != 0u; offset -= 8u) {
+            out.emit(x86_64::opcode_t::PUSH, 8u, x86_64::make_memory(x86_64::register_t::RAX, static_cast<std::int64_t>(offset) - 8));
+        }
+    }
+    for(std::size_t i = 0u; i < call.operands.size(); ++i) {
+        const argument_location_t& location = arguments.locations[i];
+        if(location.is_on_stack || location.register_count == 0u) {
+            continue;
+        }
+        if(!location.is_struct) {
+            out.load(call.operands[i], x86_64::make_register(location.registers[0]));
+            continue;
+        }
+        out.load(call.operands[i], rax());
+        for(std::uint8_t j = 0u; j < location.register_count; ++j) {
+            out.move_eightbyte(x86_64::make_memory(x86_64::register_t::RAX, 8 * j), x86_64::make_register(location.registers[j]));
+        }
+    }
+    out.emit(x86_64::opcode_t::MOV, 4u, x86_64::make_immediate(arguments.sse_count), rax(ir::type_t::I32)); // the number of vector registers used, for variadic functions
+    out.emit(x86_64::opcode_t::CALL, 8u, x86_64::make_function(call.symbol));
+    if(stack_size != 0u) {
+        out.emit(x86_64::opcode_t::ADD, 8u, x86_64::make_immediate(static_cast<std::int64_t>(stack_size)), rsp);
+    }
+    if(is_passed_in_registers(call.struct_return)) {
+        const std::array<x86_64::register_t, 2> registers = get_struct_return_registers(call.struct_return);
+        out.load(call.operands[0], rcx());
+        for(std::uint8_t i = 0u; i < call.struct_return.eightbyte_count; ++i) {
+            out.move_eightbyte(x86_64::make_register(registers[i]), x86_64::make_memory(x86_64::register_t::RCX, 8 * i));
+        }
+    } else if(ir::is_floating(call.type)) {
+        out.store(XMM0, value);
+    } else if(call.type != ir::type_t::VOID) {
+        out.store(rax(), value);
+    }
+}
+
+// Loads the integer operands of `instruction` into `%rax` and `%rcx`.
+void load_integer_operands(function_output_t& out, const ir::instruction_t& instruction) {
+    out.load(instruction.operands[0], rax());
+    if(instruction.operands.size() > 1u) {
+        out.load(instruction.operands[1], rcx());
+    }
+}
+void generate_division(function_output_t& out, const ir::value_t value, const ir::instruction_t& instruction) {
+    const bool is_signed = (instruction.opcode == ir::opcode_t::SDIV || instruction.opcode == ir::opcode_t::SREM);
+    const bool is_remainder = (instruction.opcode == ir::opcode_t::SREM || instruction.opcode == ir::opcode_t::UREM);
+    const ir::type_t type = instruction.type;
+    load_integer_operands(out, instruction);
+    const ir::type_t divide_type = (type == ir::type_t::I64) ? ir::type_t::I64 : ir::type_t::I32;
+    if(type == ir::type_t::I8 || type == ir::type_t::I16) { // widened to 32 bits, where the quotient is the same
+        const x86_64::opcode_t extend = is_signed ? x86_64::opcode_t::MOVSX : x86_64::opcode_t::MOVZX;
+        out.emit(extend, get_width(type), rax(type), rax(ir::type_t::I32));
+        out.emit(extend, get_width(type), rcx(type), rcx(ir::type_t::I32));
+    }
+    if(is_signed) {
+        out.emit(x86_64::opcode_t::CDQ, get_width(divide_type));
+    } else {
+        out.emit(x86_64::opcode_t::XOR, 4u, rdx(ir::type_t::I32), rdx(ir::type_t::I32));
+    }
+    out.emit(is_signed ? x86_64::opcode_t::IDIV : x86_64::opcode_t::DIV, get_width(divide_type), rcx(divide_type));
+    out.store(is_remainder ? rdx() : rax(), value);
+}
+void generate_integer_comparison(function_output_t& out, const ir::value_t value, const ir::instruction_t& instruction, const x86_64::condition_t condition) {
+    const ir::type_t type = out.function.get(instruction.operands[0]).type;
+    load_integer_operands(out, instruction);
+    out.emit(x86_64::opcode_t::CMP, get_width(type), rcx(type), rax(type));
+    out.emit_conditional(x86_64::opcode_t::SETCC, condition, rax(ir::type_t::I8));
+    out.emit(x86_64::opcode_t::MOVZX, 1u, rax(ir::type_t::I8), rax(ir::type_t::I32));
+    out.store(rax(), value);
+}
+// `ucomis[sd]` sets the flags as an unsigned compare would, and sets `PF` if either operand is NaN, which makes every comparison but `!=` false.
+void generate_floating_comparison(function_output_t& out, const ir::value_t value, const ir::instruction_t& instruction) {
+    const std::uint8_t size = get_width(out.function.get(instruction.operands[0]).type);
+    out.load(instruction.operands[0], XMM0);
+    out.load(instruction.operands[1], XMM1);
+    switch(instruction.opcode) {
+        case ir::opcode_t::FEQ:
+        case ir::opcode_t::FNE: {
+            const bool is_equal = (instruction.opcode == ir::opcode_t::FEQ);
+            out.emit(x86_64::opcode_t::UCOMI, size, XMM1, XMM0);
+            out.emit_conditional(x86_64::opcode_t::SETCC, is_equal ? x86_64::condition_t::E : x86_64::condition_t::NE, rax(ir::type_t::I8));
+            out.emit_conditional(x86_64::opcode_t::SETCC, is_equal ? x86_64::condition_t::NP : x86_64::condition_t::P, rcx(ir::type_t::I8));
+            out.emit(is_equal ? x86_64::opcode_t::AND : x86_64::opcode_t::OR, 1u, rcx(ir::type_t::I8), rax(ir::type_t::I8));
+            break;
+        }
+        case ir::opcode_t::FGT:
+        case ir::opcode_t::FGE:
+            out.emit(x86_64::opcode_t::UCOMI, size, XMM1, XMM0);
+            out.emit_conditional(x86_64::opcode_t::SETCC, (instruction.opcode == ir::opcode_t::FGT) ? x86_64::condition_t::A : x86_64::condition_t::AE, rax(ir::type_t::I8));
+            break;
+        default: // `a < b` is `b > a`, so that NaNs compare false
+            out.emit(x86_64::opcode_t::UCOMI, size, XMM0, XMM1);
+            out.emit_conditional(x86_64::opcode_t::SETCC, (instruction.opcode == ir::opcode_t::FLT) ? x86_64::condition_t::A : x86_64::condition_t::AE, rax(ir::type_t::I8));
+            break;
+    }
+    out.emit(x86_64::opcode_t::MOVZX, 1u, rax(ir::type_t::I8), rax(ir::type_t::I32));
+    out.store(rax(), value);
+}
+// Sign or zero extends the integer of type `type` in `%rax` to 64 bits.
+void extend_rax(function_output_t& out, const ir::type_t type, const bool is_signed) {
+    switch(type) {
+        case ir::type_t::I8:
+        case ir::type_t::I16:
+            if(is_signed) {
+                out.emit(x86_64::opcode_t::MOVSX, get_width(type), rax(type), rax());
+            } else {
+                out.emit(x86_64::opcode_t::MOVZX, get_width(type), rax(type), rax(ir::type_t::I32));
+            }
+            break;
+        case ir::type_t::I32:
+            if(is_signed) {
+                out.emit(x86_64::opcode_t::MOVSX, 4u, rax(type), rax());
+            } else {
+                out.emit(x86_64::opcode_t::MOV, 4u, rax(type), rax(type));
+            }
+            break;
+        default:
+            break;
+    }
+}
+void generate_integer_to_floating(function_output_t& out, const ir::value_t value, const ir::instruction_t& instruction) {
+    const ir::type_t from_type = out.function.get(instruction.operands[0]).type;
+    const bool is_signed = (instruction.opcode == ir::opcode_t::SITOFP);
+    const std::uint8_t size = get_width(instruction.type);
+    out.load(instruction.operands[0], rax());
+    extend_rax(out, from_type, is_signed);
+    if(is_signed || from_type != ir::type_t::I64) {
+        out.emit(x86_64::opcode_t::CVTSI2F, size, rax(), XMM0);
+    } else { // an unsigned 64 bit integer with its top bit set is halved (keeping the lowest bit so that it rounds the same), converted and doubled
+        const std::uint32_t halve_label = out.new_label();
+        const std::uint32_t end_label = out.new_label();
+        out.emit(x86_64::opcode_t::TEST, 8u, rax(), rax());
+        out.emit_conditional(x86_64::opcode_t::JCC, x86_64::condition_t::S, x86_64::make_label(halve_label));
+        out.emit(x86_64::opcode_t::CVTSI2F, size, rax(), XMM0);
+        out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(end_label));
+        out.emit_label(halve_label);
+        out.emit(x86_64::opcode_t::MOV, 8u, rax(), rcx());
+        out.emit(x86_64::opcode_t::SHR, 8u, rcx());
+        out.emit(x86_64::opcode_t::AND, 4u, x86_64::make_immediate(1), rax(ir::type_t::I32));
+        out.emit(x86_64::opcode_t::OR, 8u, rax(), rcx());
+        out.emit(x86_64::opcode_t::CVTSI2F, size, rcx(), XMM0);
+        out.emit(x86_64::opcode_t::FADD, size, XMM0, XMM0);
+        out.emit_label(end_label);
+    }
+    out.store(XMM0, value);
+}
+void generate_floating_to_integer(function_output_t& out, const ir::value_t value, const ir::instruction_t& instruction) {
+    const ir::type_t from_type = out.function.get(instruction.operands[0]).type;
+    const std::uint8_t size = get_width(from_type);
+    out.load(instruction.operands[0], XMM0);
+    if(instruction.opcode == ir::opcode_t::FPTOSI || instruction.type != ir::type_t::I64) {
+        out.emit(x86_64::opcode_t::CVTTF2SI, size, XMM0, rax());
+    } else { // values from 2^63 on don't fit an `int64_t`, they are converted with 2^63 subtracted and have it added back as the top bit
+        const std::uint32_t big_label = out.new_label();
+        const std::uint32_t end_label = out.new_label();
+        if(from_type == ir::type_t::F32) {
+            out.emit(x86_64::opcode_t::MOV, 4u, x86_64::make_immediate(0x5f000000), rcx(ir::type_t::I32)); // 2^63
+            out.emit(x86_64::opcode_t::MOVD, 4u, rcx(ir::type_t::I32), XMM1);
+        } else {
+            out.emit(x86_64::opcode_t::MOVABS, 8u, x86_64::make_immediate(0x43e0000000000000), rcx()); // 2^63
+            out.emit(x86_64::opcode_t::MOVQ, 8u, rcx(), XMM1);
+        }
+        out.emit(x86_64::opcode_t::UCOMI, size, XMM1, XMM0);
+        out.emit_conditional(x86_64::opcode_t::JCC, x86_64::condition_t::AE, x86_64::make_label(big_label));
+        out.emit(x86_64::opcode_t::CVTTF2SI, size, XMM0, rax());
+        out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(end_label));
+        out.emit_label(big_label);
+        out.emit(x86_64::opcode_t::FSUB, size, XMM1, XMM0);
+        out.emit(x86_64::opcode_t::CVTTF2SI, size, XMM0, rax());
+        out.emit(x86_64::opcode_t::BTC, 8u, x86_64::make_immediate(63), rax());
+        out.emit_label(end_label);
+    }
+    out.store(rax(), value);
+}
+
+void generate_instruction(function_output_t& out, const ir::block_id_t block, const ir::value_t value) {
+    const ir::instruction_t& instruction = out.function.get(value);
+    const ir::type_t type = instruction.type;
+    switch(instruction.opcode) {
+        case ir::opcode_t::PARAM: // see `generate_parameters()`
+        case ir::opcode_t::PHI: // see `generate_phi_copies()`
+            return;
+        case ir::opcode_t::CONST: {
+            const auto immediate = static_cast<std::int64_t>(instruction.immediate);
+            const bool fits_in_32_bits = immediate >= std::numeric_limits<std::int32_t>::min() && immediate <= std::numeric_limits<std::int32_t>::max();
+            out.emit(fits_in_32_bits ? x86_64::opcode_t::MOV : x86_64::opcode_t::MOVABS, 8u, x86_64::make_immediate(immediate), rax());
+            out.store(rax(), value);
+            return;
+        }
+        case ir::opcode_t::ALLOCA:
+            out.emit(x86_64::opcode_t::LEA, 8u, x86_64::make_memory(x86_64::register_t::RBP, out.alloca_offsets[value]), rax());
+            out.store(rax(), value);
+            return;
+        case ir::opcode_t::GLOBAL_ADDRESS:
+            out.emit(x86_64::opcode_t::LEA, 8u, x86_64::make_global(instruction.symbol), rax());
+            out.store(rax(), value);
+            return;
+        case ir::opcode_t::PTR_OFFSET:
+            out.load(instruction.operands[0], rax());
+            out.emit(x86_64::opcode_t::ADD, 8u, x86_64::make_immediate(static_cast<std::int64_t>(instruction.immediate)), rax());
+            out.store(rax(), value);
+            return;
+        case ir::opcode_t::LOAD: {
+            const x86_64::operand_t address = x86_64::make_memory(x86_64::register_t::RAX);
+            out.load(instruction.operands[0], rax());
+            switch(ir::get_size(type)) {
+                case 1u:
+                case 2u:
+                    out.emit(x86_64::opcode_t::MOVZX, get_width(type), address, rax(ir::type_t::I32));
+                    break;
+                default:
+                    out.emit(x86_64::opcode_t::MOV, get_width(type), address, rax(type));
+                    break;
+            }
+            out.store(rax(), value);
+            return;
+        }
+        case ir::opcode_t::STORE: {
+            const ir::type_t value_type = out.function.get(instruction.operands[0]).type;
+            out.load(instruction.operands[0], rcx());
+            out.load(instruction.operands[1], rax());
+            out.emit(x86_64::opcode_t::MOV, get_width(value_type), rcx(value_type), x86_64::make_memory(x86_64::register_t::RAX));
+            return;
+        }
+        case ir::opcode_t::COPY: {
+            out.load(instruction.operands[0], x86_64::make_register(x86_64::register_t::RDI));
+            out.load(instruction.operands[1], x86_64::make_register(x86_64::register_t::RSI));
+            std::uint64_t offset = 0u;
+            for(const ir::type_t scratch_type : {ir::type_t::I64, ir::type_t::I32, ir::type_t::I16, ir::type_t::I8}) {
+                const std::uint8_t size = get_width(scratch_type);
+                for(; instruction.immediate - offset >= size; offset += size) {
+                    const auto displacement = static_cast<std::int64_t>(offset);
+                    out.emit(x86_64::opcode_t::MOV, size, x86_64::make_memory(x86_64::register_t::RSI, displacement), rdx(scratch_type));
+                    out.emit(x86_64::opcode_t::MOV, size, rdx(scratch_type), x86_64::make_memory(x86_64::register_t::RDI, displacement));
+                }
+            }
+            return;
+        }
+
+        case ir::opcode_t::ADD:
+        case ir::opcode_t::SUB:
+        case ir::opcode_t::AND:
+        case ir::opcode_t::OR:
+        case ir::opcode_t::XOR: {
+            const x86_64::opcode_t opcode = (instruction.opcode == ir::opcode_t::ADD) ? x86_64::opcode_t::ADD : (instruction.opcode == ir::opcode_t::SUB) ? x86_64::opcode_t::SUB
+                : (instruction.opcode == ir::opcode_t::AND) ? x86_64::opcode_t::AND : (instruction.opcode == ir::opcode_t::OR) ? x86_64::opcode_t::OR : x86_64::opcode_t::XOR;
+            load_integer_operands(out, instruction);
+            out.emit(opcode, get_width(type), rcx(type), rax(type));
+            out.store(rax(), value);
+            return;
+        }
+        case ir::opcode_t::MUL: { // there is no two operand 8 bit `imul`, the low 8 bits of a 32 bit product are the same
+            const ir::type_t multiply_type = (type == ir::type_t::I8) ? ir::type_t::I32 : type;
+            load_integer_operands(out, instruction);
+            out.emit(x86_64::opcode_t::IMUL, get_width(multiply_type), rcx(multiply_type), rax(multiply_type));
+            out.store(rax(), value);
+            return;
+        }
+        case ir::opcode_t::SDIV:
+        case ir::opcode_t::UDIV:
+        case ir::opcode_t::SREM:
+        case ir::opcode_t::UREM:
+            generate_division(out, value, instruction);
+            return;
+        case ir::opcode_t::SHL:
+        case ir::opcode_t::ASHR:
+        case ir::opcode_t::LSHR: {
+            const x86_64::opcode_t opcode = (instruction.opcode == ir::opcode_t::SHL) ? x86_64::opcode_t::SHL : (instruction.opcode == ir::opcode_t::ASHR) ? x86_64::opcode_t::SAR : x86_64::opcode_t::SHR;
+            load_integer_operands(out, instruction);
+            out.emit(opcode, get_width(type), rcx(ir::type_t::I8), rax(type));
+            out.store(rax(), value);
+            return;
+        }
+        case ir::opcode_t::NEG:
+        case ir::opcode_t::NOT:
+            out.load(instruction.operands[0], rax());
+            out.emit((instruction.opcode == ir::opcode_t::NEG) ? x86_64::opcode_t::NEG : x86_64::opcode_t::NOT, get_width(type), rax(type));
+            out.store(rax(), value);
+            return;
+
+        case ir::opcode_t::FADD:
+        case ir::opcode_t::FSUB:
+        case ir::opcode_t::FMUL:
+        case ir::opcode_t::FDIV: {
+            const x86_64::opcode_t opcode = (instruction.opcode == ir::opcode_t::FADD) ? x86_64::opcode_t::FADD : (instruction.opcode == ir::opcode_t::FSUB) ? x86_64::opcode_t::FSUB
+                : (instruction.opcode == ir::opcode_t::FMUL) ? x86_64::opcode_t::FMUL : x86_64::opcode_t::FDIV;
+            out.load(instruction.operands[0], XMM0);
+            out.load(instruction.operands[1], XMM1);
+            out.emit(opcode, get_width(type), XMM1, XMM0);
+            out.store(XMM0, value);
+            return;
+        }
+        case ir::opcode_t::FNEG: { // flips the sign bit
+            const ir::type_t bits_type = (type == ir::type_t::F32) ? ir::type_t::I32 : ir::type_t::I64;
+            out.load(instruction.operands[0], rax());
+            out.emit(x86_64::opcode_t::BTC, get_width(bits_type), x86_64::make_immediate(8 * get_width(bits_type) - 1), rax(bits_type));
+            out.store(rax(), value);
+            return;
+        }
+
+        case ir::opcode_t::EQ: generate_integer_comparison(out, value, instruction, x86_64::condition_t::E); return;
+        case ir::opcode_t::NE: generate_integer_comparison(out, value, instruction, x86_64::condition_t::NE); return;
+        case ir::opcode_t::SLT: generate_integer_comparison(out, value, instruction, x86_64::condition_t::L); return;
+        case ir::opcode_t::SLE: generate_integer_comparison(out, value, instruction, x86_64::condition_t::LE); return;
+        case ir::opcode_t::SGT: generate_integer_comparison(out, value, instruction, x86_64::condition_t::G); return;
+        case ir::opcode_t::SGE: generate_integer_comparison(out, value, instruction, x86_64::condition_t::GE); return;
+        case ir::opcode_t::ULT: generate_integer_comparison(out, value, instruction, x86_64::condition_t::B); return;
+        case ir::opcode_t::ULE: generate_integer_comparison(out, value, instruction, x86_64::condition_t::BE); return;
+        case ir::opcode_t::UGT: generate_integer_comparison(out, value, instruction, x86_64::condition_t::A); return;
+        case ir::opcode_t::UGE: generate_integer_comparison(out, value, instruction, x86_64::condition_t::AE); return;
+        case ir::opcode_t::FEQ:
+        case ir::opcode_t::FNE:
+        case ir::opcode_t::FLT:
+        case ir::opcode_t::FLE:
+        case ir::opcode_t::FGT:
+        case ir::opcode_t::FGE:
+            generate_floating_comparison(out, value, instruction);
+            return;
+
+        case ir::opcode_t::SEXT:
+        case ir::opcode_t::ZEXT:
+            out.load(instruction.operands[0], rax());
+            extend_rax(out, out.function.get(instruction.operands[0]).type, instruction.opcode == ir::opcode_t::SEXT);
+            out.store(rax(), value);
+            return;
+        case ir::opcode_t::TRUNC: // the low bits are already there
+            out.load(instruction.operands[0], rax());
+            out.store(rax(), value);
+            return;
+        case ir::opcode_t::SITOFP:
+        case ir::opcode_t::UITOFP:
+            generate_integer_to_floating(out, value, instruction);
+            return;
+        case ir::opcode_t::FPTOSI:
+        case ir::opcode_t::FPTOUI:
+            generate_floating_to_integer(out, value, instruction);
+            return;
+        case ir::opcode_t::FPEXT:
+        case ir::opcode_t::FPTRUNC:
+            out.load(instruction.operands[0], XMM0);
+            out.emit((instruction.opcode == ir::opcode_t::FPEXT) ? x86_64::opcode_t::CVTSS2SD : x86_64::opcode_t::CVTSD2SS, 8u, XMM0, XMM0);
+            out.store(XMM0, value);
+            return;
+
+        case ir::opcode_t::CALL:
+            generate_call(out, value, instruction);
+            return;
+
+        case ir::opcode_t::JUMP:
+            generate_phi_copies(out, block, instruction.targets[0]);
+            out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(instruction.targets[0]));
+            return;
+        case ir::opcode_t::BRANCH: {
+            const ir::type_t condition_type = out.function.get(instruction.operands[0]).type;
+            out.load(instruction.operands[0], rax());
+            out.emit(x86_64::opcode_t::TEST, get_width(condition_type), rax(condition_type), rax(condition_type));
+            if(!has_phis(out, instruction.targets[0]) && !has_phis(out, instruction.targets[1])) {
+                out.emit_conditional(x86_64::opcode_t::JCC, x86_64::condition_t::NE, x86_64::make_label(instruction.targets[0]));
+                out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(instruction.targets[1]));
+                return;
+            }
+            // each edge does its own phi copies
+            const std::uint32_t true_edge_label = out.new_label();
+            out.emit_conditional(x86_64::opcode_t::JCC, x86_64::condition_t::NE, x86_64::make_label(true_edge_label));
+            generate_phi_copies(out, block, instruction.targets[1]);
+            out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(instruction.targets[1]));
+            out.emit_label(true_edge_label);
+            generate_phi_copies(out, block, instruction.targets[0]);
+            out.emit(x86_64::opcode_t::JMP, 8u, x86_64::make_label(instruction.targets[0]));
+            return;
+        }
+        case ir::opcode_t::RET: {
+            const ir::struct_passing_t& struct_return = out.function.struct_return;
+            if(!instruction.operands.empty()) {
+                out.load(instruction.operands[0], ir::is_floating(out.function.return_type) ? XMM0 : rax());
+            } else if(struct_return.is_in_memory) {
+                out.emit(x86_64::opcode_t::MOV, 8u, x86_64::make_memory(x86_64::register_t::RBP, out.struct_return_offset), rax());
+            } else if(struct_return.is_struct) {
+                const std::array<x86_64::register_t, 2> registers = get_struct_return_registers(struct_return);
+                for(std::uint8_t i = 0u; i < struct_return.eightbyte_count; ++i) {
+                    out.move_eightbyte(x86_64::make_memory(x86_64::register_t::RBP, out.struct_return_offset + 8 * i), x86_64::make_register(registers[i]));
+                }
+            }
+            out.emit(x86_64::opcode_t::LEAVE);
+            out.emit(x86_64::opcode_t::RET);
+            return;
+        }
+    }
+    throw std::logic_error("Invalid IR opcode.");
+}
+
+x86_64::function_t select_function_instructions(const ir::function_t& function) {
+    x86_64::function_t output;
+    function_output_t out(output, function);
+    lay_out_frame(out);
+    out.emit(x86_64::opcode_t::PUSH, 8u, x86_64::make_register(x86_64::register_t::RBP));
+    out.emit(x86_64::opcode_t::MOV, 8u, x86_64::make_register(x86_64::register_t::RSP), x86_64::make_register(x86_64::register_t::RBP));
+    if(out.frame_size != 0u) {
+        out.emit(x86_64::opcode_t::SUB, 8u, x86_64::make_immediate(static_cast<std::int64_t>(out.frame_size)), x86_64::make_register(x86_64::register_t::RSP));
+    }
+    generate_parameters(out);
+    for(ir::block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        out.emit_label(block);
+        for(const ir::value_t value : function.blocks[block].instructions) {
+            generate_instruction(out, block, value);
+        }
+    }
+    return output;
+}
+
+void generate_global(std::string& output, const ir::global_t& global) {
+    output += global.initializer.empty() ? ".bss\n" : ".data\n";
+    output += ".align " + std::to_string(global.alignment) + "\n";
+    output += ".globl " + global.name.str() + "\n";
+    output += global.name.str() + ":\n";
+    if(global.initializer.empty()) {
+        output += ".zero " + std::to_string(global.size) + "\n";
+        return;
+    }
+    std::size_t offset = 0u;
+    for(const auto& [size, directive] : {std::make_pair(8u, ".quad "), std::make_pair(4u, ".long "), std::make_pair(2u, ".word "), std::make_pair(1u, ".byte ")}) {
+        for(; global.initializer.size() - offset >= size; offset += size) {
+            std::uint64_t value = 0u;
+            std::memcpy(&value, global.initializer.data() + offset, size);
+            output += directive + std::to_string(value) + "\n";
+        }
+    }
+}
+}
+
+
+std::vector<x86_64::function_t> select_instructions(const ir::module_t& module) {
+    std::vector<x86_64::function_t> functions;
+    functions.reserve(module.functions.size());
+    for(const auto& function : module.functions) {
+        functions.push_back(select_function_instructions(function));
+    }
+    return functions;
+}
+
+std::string generate_asm(const ir::module_t& module) {
+    std::string output;
+    for(const auto& global : module.globals) {
+        generate_global(output, global);
+    }
+    for(const auto& function : select_instructions(module)) {
+        print_function(output, function);
+    }
+    output += ".section .note.GNU-stack,\"\",@progbits\n"; // the stack doesn't need to be executable
+    return output;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <middle_end/ir/ir.hpp>
+#include "instructions.hpp"
+
+
+// Selects x86_64 instructions for IR that passed `verify_module()`, which are printed as assembly (AT&T syntax, for gas) or encoded (see `encoder.hpp`).
+// There is no register allocation yet: every SSA value has an 8 byte stack slot that it is stored to once it is computed, and instructions load their
+//  operands from the slots into scratch registers (`%rax`, `%rcx`, `%rdx`, `%xmm0`, `%xmm1`). Integers narrower than 64 bits only define the low bits
+//  of their slot, the instructions that use them only read those bits (width suffixed instructions, or sign or zero extension first).
+// Phis are turned into copies at the end of their predecessors, which are parallel (push everything, then pop it all) so that phis that use other phis of
+//  the same block read their old values.
+// Calls follow the SysV ABI for integer and floating point arguments and return values (see `lower_ast.hpp` for structs).
+std::vector<x86_64::function_t> select_instructions(const ir::module_t& module);
+// `select_instructions()`, printed, and the globals.
+std::string generate_asm(const ir::module_t& module);
@@ -0,0 +1,140 @@
+#include "instructions.hpp"
+
+#include <stdexcept>
+
+
+namespace {
+constexpr std::array<std::array<const char*, 16>, 4> REGISTER_NAMES{{
+    {"al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil", "r8b", "r9b", "r10b", "r11b", "r12b", "r13b", "r14b", "r15b"},
+    {"ax", "cx", "dx", "bx", "sp", "bp", "si", "di", "r8w", "r9w", "r10w", "r11w", "r12w", "r13w", "r14w", "r15w"},
+    {"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi", "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d"},
+    {"rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"},
+}};
+constexpr std::array<const char*, 16> CONDITION_NAMES{"o", "no", "b", "ae", "e", "ne", "be", "a", "s", "ns", "p", "np", "l", "ge", "le", "g"};
+
+const char* get_suffix(const std::uint8_t size) {
+    switch(size) {
+        case 1u:
+            return "b";
+        case 2u:
+            return "w";
+        case 4u:
+            return "l";
+    }
+    return "q";
+}
+// `ss` or `sd`
+const char* get_sse_suffix(const std::uint8_t size) {
+    return (size == 4u) ? "ss" : "sd";
+}
+std::size_t get_size_index(const std::uint8_t size) {
+    switch(size) {
+        case 1u:
+            return 0u;
+        case 2u:
+            return 1u;
+        case 4u:
+            return 2u;
+    }
+    return 3u;
+}
+
+std::string get_label(const x86_64::function_t& function, const std::int64_t label) {
+    return ".L" + function.name.str() + "_" + std::to_string(label);
+}
+std::string print_register(const x86_64::register_t reg, const std::uint8_t size) {
+    if(x86_64::is_sse_register(reg)) {
+        return "%xmm" + std::to_string(x86_64::get_encoding(reg));
+    }
+    return std::string("%") + REGISTER_NAMES[get_size_index(size)][x86_64::get_encoding(reg)];
+}
+std::string print_operand(const x86_64::function_t& function, const x86_64::operand_t& operand) {
+    switch(operand.kind) {
+        case x86_64::operand_t::kind_t::REGISTER:
+            return print_register(operand.reg, operand.size);
+        case x86_64::operand_t::kind_t::IMMEDIATE:
+            return "$" + std::to_string(operand.value);
+        case x86_64::operand_t::kind_t::MEMORY:
+            return ((operand.value != 0) ? std::to_string(operand.value) : "") + "(" + print_register(operand.reg, 8u) + ")";
+        case x86_64::operand_t::kind_t::GLOBAL:
+            return operand.symbol.str() + "(%rip)";
+        case x86_64::operand_t::kind_t::LABEL:
+            return get_label(function, operand.value);
+        case x86_64::operand_t::kind_t::FUNCTION:
+            return operand.symbol.str();
+    }
+    throw std::logic_error("Invalid x86_64 operand.");
+}
+
+std::string get_mnemonic(const x86_64::instruction_t& instruction) {
+    const std::uint8_t size = instruction.size;
+    const auto with_suffix = [size](const char *const mnemonic) {
+        return std::string(mnemonic) + get_suffix(size);
+    };
+    switch(instruction.opcode) {
+        case x86_64::opcode_t::MOV: return with_suffix("mov");
+        case x86_64::opcode_t::MOVABS: return with_suffix("movabs");
+        case x86_64::opcode_t::LEA: return with_suffix("lea");
+        case x86_64::opcode_t::MOVZX:
+        case x86_64::opcode_t::MOVSX:
+            return std::string((instruction.opcode == x86_64::opcode_t::MOVZX) ? "movz" : "movs") + get_suffix(size) + get_suffix(instruction.operands[1].size);
+        case x86_64::opcode_t::ADD: return with_suffix("add");
+        case x86_64::opcode_t::SUB: return with_suffix("sub");
+        case x86_64::opcode_t::AND: return with_suffix("and");
+        case x86_64::opcode_t::OR: return with_suffix("or");
+        case x86_64::opcode_t::XOR: return with_suffix("xor");
+        case x86_64::opcode_t::CMP: return with_suffix("cmp");
+        case x86_64::opcode_t::TEST: return with_suffix("test");
+        case x86_64::opcode_t::IMUL: return with_suffix("imul");
+        case x86_64::opcode_t::DIV: return with_suffix("div");
+        case x86_64::opcode_t::IDIV: return with_suffix("idiv");
+        case x86_64::opcode_t::NEG: return with_suffix("neg");
+        case x86_64::opcode_t::NOT: return with_suffix("not");
+        case x86_64::opcode_t::SHL: return with_suffix("shl");
+        case x86_64::opcode_t::SAR: return with_suffix("sar");
+        case x86_64::opcode_t::SHR: return with_suffix("shr");
+        case x86_64::opcode_t::BTC: return with_suffix("btc");
+        case x86_64::opcode_t::CDQ: return (size == 8u) ? "cqto" : "cltd";
+        case x86_64::opcode_t::SETCC: return std::string("set") + CONDITION_NAMES[static_cast<std::size_t>(instruction.condition)];
+        case x86_64::opcode_t::JCC: return std::string("j") + CONDITION_NAMES[static_cast<std::size_t>(instruction.condition)];
+        case x86_64::opcode_t::JMP: return "jmp";
+        case x86_64::opcode_t::CALL: return "call";
+        case x86_64::opcode_t::PUSH: return "pushq";
+        case x86_64::opcode_t::POP: return "popq";
+        case x86_64::opcode_t::LEAVE: return "leave";
+        case x86_64::opcode_t::RET: return "ret";
+        case x86_64::opcode_t::MOVQ: return "movq";
+        case x86_64::opcode_t::MOVD: return "movd";
+        case x86_64::opcode_t::FADD: return std::string("add") + get_sse_suffix(size);
+        case x86_64::opcode_t::FSUB: return std::string("sub") + get_sse_suffix(size);
+        case x86_64::opcode_t::FMUL: return std::string("mul") + get_sse_suffix(size);
+        case x86_64::opcode_t::FDIV: return std::string("div") + get_sse_suffix(size);
+        case x86_64::opcode_t::UCOMI: return std::string("ucomi") + get_sse_suffix(size);
+        case x86_64::opcode_t::CVTSI2F: return std::string("cvtsi2") + get_sse_suffix(size) + "q";
+        case x86_64::opcode_t::CVTTF2SI: return std::string("cvtt") + get_sse_suffix(size) + "2siq";
+        case x86_64::opcode_t::CVTSS2SD: return "cvtss2sd";
+        case x86_64::opcode_t::CVTSD2SS: return "cvtsd2ss";
+        case x86_64::opcode_t::LABEL: break;
+    }
+    throw std::logic_error("Invalid x86_64 opcode.");
+}
+}
+
+
+void print_function(std::string& output, const x86_64::function_t& function) {
+    output += ".text\n";
+    output += ".globl " + function.name.str() + "\n";
+    output += function.name.str() + ":\n";
+    for(const x86_64::instruction_t& instruction : function.instructions) {
+        if(instruction.opcode == x86_64::opcode_t::LABEL) {
+            output += get_label(function, instruction.operands[0].value) + ":\n";
+            continue;
+        }
+        output += get_mnemonic(instruction);
+        for(std::uint8_t i = 0u; i < instruction.operand_count; ++i) {
+            output += (i == 0u) ? " " : ", ";
+            output += print_operand(function, instruction.operands[i]);
+        }
+        output += '\n';
+    }
+}
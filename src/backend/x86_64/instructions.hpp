@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <utils/symbol_interner.hpp>
+
+
+// The x86_64 instructions that `select_instructions()` (see `generate_from_ir.hpp`) picks for IR, before they are printed as assembly
+//  (`print_function()`) or encoded as machine code (see `encoder.hpp`). Only the forms the instruction selection uses are supported.
+namespace x86_64 {
+// the general purpose registers in the order of their encoding, then the SSE registers
+enum class register_t : std::uint8_t {
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+    R8, R9, R10, R11, R12, R13, R14, R15,
+    XMM0, XMM1, XMM2, XMM3, XMM4, XMM5, XMM6, XMM7,
+};
+constexpr bool is_sse_register(const register_t reg) {
+    return reg >= register_t::XMM0;
+}
+// the register number in ModRM, SIB and REX
+constexpr std::uint8_t get_encoding(const register_t reg) {
+    return static_cast<std::uint8_t>(reg) & 15u;
+}
+
+// in the order of their encoding
+enum class condition_t : std::uint8_t {
+    O, NO, B, AE, E, NE, BE, A, S, NS, P, NP, L, GE, LE, G,
+};
+
+struct operand_t {
+    enum class kind_t : std::uint8_t {
+        REGISTER,
+        IMMEDIATE,
+        MEMORY, // `value(%reg)`
+        GLOBAL, // `symbol(%rip)`, a global's memory
+        LABEL, // label `value` of the function, a jump target
+        FUNCTION, // `symbol`, a call target
+    };
+
+    kind_t kind = kind_t::IMMEDIATE;
+    register_t reg = register_t::RAX;
+    std::uint8_t size = 8u; // of `REGISTER`s, in bytes
+    std::int64_t value = 0;
+    utils::symbol_t symbol;
+};
+inline operand_t make_register(const register_t reg, const std::uint8_t size = 8u) {
+    return operand_t{operand_t::kind_t::REGISTER, reg, size, 0, {}};
+}
+inline operand_t make_immediate(const std::int64_t value) {
+    return operand_t{operand_t::kind_t::IMMEDIATE, register_t::RAX, 8u, value, {}};
+}
+inline operand_t make_memory(const register_t base, const std::int64_t displacement = 0) {
+    return operand_t{operand_t::kind_t::MEMORY, base, 8u, displacement, {}};
+}
+inline operand_t make_global(const utils::symbol_t symbol) {
+    return operand_t{operand_t::kind_t::GLOBAL, register_t::RAX, 8u, 0, symbol};
+}
+inline operand_t make_label(const std::uint32_t label) {
+    return operand_t{operand_t::kind_t::LABEL, register_t::RAX, 8u, label, {}};
+}
+inline operand_t make_function(const utils::symbol_t symbol) {
+    return operand_t{operand_t::kind_t::FUNCTION, register_t::RAX, 8u, 0, symbol};
+}
+
+enum class opcode_t : std::uint8_t {
+    LABEL, // defines label `operands[0]` here
+
+    MOV, MOVABS, LEA,
+    MOVZX, MOVSX, // from `size` bytes to the width of the destination register
+    ADD, SUB, AND, OR, XOR, CMP, TEST,
+    IMUL, DIV, IDIV, NEG, NOT,
+    SHL, SAR, SHR, // by `%cl`, or by one without a source operand
+    BTC,
+    CDQ, // `cltd`, or `cqto` when `size` is 8
+    SETCC, JCC, // with `condition`
+    JMP, CALL, PUSH, POP, LEAVE, RET,
+
+    // `size` is the width of the floating point type, 4 (`ss`) or 8 (`sd`)
+    MOVQ, // 64 bits between an SSE register and a general purpose register or memory
+    MOVD, // 32 bits from a general purpose register to an SSE register
+    FADD, FSUB, FMUL, FDIV,
+    UCOMI,
+    CVTSI2F, // from a 64 bit integer
+    CVTTF2SI, // to a 64 bit integer
+    CVTSS2SD, CVTSD2SS,
+};
+
+struct instruction_t {
+    opcode_t opcode;
+    std::uint8_t size = 8u; // the width of the operation in bytes, which is the suffix of its mnemonic
+    condition_t condition = condition_t::E;
+    std::uint8_t operand_count = 0u;
+    std::array<operand_t, 2> operands{}; // in AT&T order, the source comes first and the destination last
+};
+
+struct function_t {
+    utils::symbol_t name;
+    std::uint32_t label_count = 0u; // labels are numbered from zero, the first ones are the labels of the IR blocks
+    std::vector<instruction_t> instructions;
+};
+}
+
+// Appends `function` in AT&T syntax, for gas.
+void print_function(std::string& output, const x86_64::function_t& function);
@@ -0,0 +1,137 @@
+#include "jit.hpp"
+
+#include <backend/x86_64/encoder.hpp>
+#include <backend/x86_64/generate_from_ir.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace {
+constexpr std::size_t FUNCTION_ALIGNMENT = 16u;
+// `jmp *0(%rip)` followed by the 8 byte address it jumps to, padded to 16 bytes
+constexpr std::size_t STUB_SIZE = 16u;
+constexpr std::array<std::uint8_t, 6> STUB_JUMP{0xffu, 0x25u, 0x00u, 0x00u, 0x00u, 0x00u};
+
+std::size_t align_up(const std::size_t value, const std::size_t alignment) {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+}
+
+
+namespace x86_64 {
+jit_program_t::jit_program_t(jit_program_t&& other) noexcept
+    : memory(std::exchange(other.memory, nullptr)), size(std::exchange(other.size, 0u)), main_offset(other.main_offset) {}
+jit_program_t& jit_program_t::operator=(jit_program_t&& other) noexcept {
+    std::swap(memory, other.memory);
+    std::swap(size, other.size);
+    std::swap(main_offset, other.main_offset);
+    return *this;
+}
+jit_program_t::~jit_program_t() {
+    if(memory != nullptr) {
+        munmap(memory, size);
+    }
+}
+
+int jit_program_t::run_main() const {
+    const auto main_function = reinterpret_cast<int (*)()>(memory + main_offset);
+    return main_function();
+}
+}
+
+
+utils::result_t<x86_64::jit_program_t> compile_to_memory(const ir::module_t& module, utils::diagnostics_t& diagnostics) {
+    std::vector<x86_64::machine_code_t> functions;
+    functions.reserve(module.functions.size());
+    for(const x86_64::function_t& function : select_instructions(module)) {
+        functions.push_back(encode_function(function));
+    }
+
+    // code, then stubs, then globals from the next page on
+    std::unordered_map<utils::symbol_t, std::size_t> addresses; // offsets into the memory, until it's mapped
+    std::size_t code_size = 0u;
+    for(std::size_t i = 0u; i < functions.size(); ++i) {
+        code_size = align_up(code_size, FUNCTION_ALIGNMENT);
+        addresses[module.functions[i].name] = code_size;
+        code_size += functions[i].code.size();
+    }
+    code_size = align_up(code_size, STUB_SIZE);
+    std::vector<std::pair<std::size_t, void*>> stubs; // offset, what it jumps to
+    for(std::size_t i = 0u; i < functions.size(); ++i) {
+        for(const x86_64::relocation_t& relocation : functions[i].relocations) {
+            if(relocation.kind != x86_64::relocation_t::kind_t::FUNCTION || addresses.count(relocation.symbol) != 0u) {
+                continue;
+            }
+            void *const target = dlsym(RTLD_DEFAULT, relocation.symbol.str().c_str());
+            if(target == nullptr) {
+                return diagnostics.report("In function [" + module.functions[i].name.str() + "]: call to [" + relocation.symbol.str() + "], which is neither defined nor in the process.");
+            }
+            addresses[relocation.symbol] = code_size;
+            stubs.emplace_back(code_size, target);
+            code_size += STUB_SIZE;
+        }
+    }
+    const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t globals_offset = align_up(code_size, page_size);
+    std::size_t size = globals_offset;
+    for(const auto& global : module.globals) {
+        size = align_up(size, std::max<std::size_t>(global.alignment, 1u));
+        addresses[global.name] = size;
+        size += global.size;
+    }
+    size = align_up(std::max<std::size_t>(size, 1u), page_size);
+    if(size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        return diagnostics.report("The program is too big to run, it needs more than 2 GiB.");
+    }
+
+    const auto main_iter = addresses.find(utils::symbol_t("main"));
+    if(main_iter == std::end(addresses) || main_iter->second >= globals_offset) {
+        return diagnostics.report("No [main] function to run.");
+    }
+
+    void *const mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mapping == MAP_FAILED) {
+        return diagnostics.report("Cannot map memory for the program.");
+    }
+    x86_64::jit_program_t program(static_cast<std::byte*>(mapping), size, main_iter->second); // unmaps it on every return from here on
+    const auto memory = static_cast<std::uint8_t*>(mapping);
+
+    for(std::size_t i = 0u; i < functions.size(); ++i) {
+        std::uint8_t *const code = memory + addresses[module.functions[i].name];
+        std::copy(std::begin(functions[i].code), std::end(functions[i].code), code);
+        for(const x86_64::relocation_t& relocation : functions[i].relocations) {
+            const auto field = static_cast<std::int64_t>(code - memory) + static_cast<std::int64_t>(relocation.offset);
+            const auto value = static_cast<std::int32_t>(static_cast<std::int64_t>(addresses[relocation.symbol]) + relocation.addend - field);
+            std::memcpy(memory + field, &value, sizeof(value));
+        }
+    }
+    for(const auto& [offset, target] : stubs) {
+        std::copy(std::begin(STUB_JUMP), std::end(STUB_JUMP), memory + offset);
+        std::memcpy(memory + offset + STUB_JUMP.size(), &target, sizeof(target));
+    }
+    for(const auto& global : module.globals) { // the rest of the mapping is already zero
+        std::copy(std::begin(global.initializer), std::end(global.initializer), reinterpret_cast<std::byte*>(memory + addresses[global.name]));
+    }
+
+    if(globals_offset != 0u && mprotect(mapping, globals_offset, PROT_READ | PROT_EXEC) != 0) {
+        return diagnostics.report("Cannot make the program executable.");
+    }
+    return program;
+}
+
+utils::result_t<int> run_program_natively(const ast::validated_program_t& program, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const x86_64::jit_program_t machine_code, compile_to_memory(lower_to_ir(program), diagnostics));
+    return machine_code.run_main();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <frontend/ast/ast.hpp>
+#include <middle_end/ir/ir.hpp>
+#include <utils/result.hpp>
+
+
+// Runs programs natively in process (`--jit`): the instructions that `select_instructions()` picks are encoded (see `encoder.hpp`) into executable memory,
+//  linked there and `main()` is called, without writing, assembling or linking anything.
+// The memory is one mapping: the code of every function, a stub per function of the process that the code calls (`putchar()` and the like, found with
+//  `dlsym()`) which jumps to it, and then, on pages that aren't executable, the globals. Since it's all within 2 GiB, calls and global addresses are the
+//  same 32 bit relative fields that the linker would fill in.
+namespace x86_64 {
+class jit_program_t {
+    std::byte* memory = nullptr;
+    std::size_t size = 0u;
+    std::size_t main_offset = 0u;
+
+public:
+    jit_program_t(std::byte* memory, std::size_t size, std::size_t main_offset) : memory(memory), size(size), main_offset(main_offset) {}
+    jit_program_t(const jit_program_t&) = delete;
+    jit_program_t& operator=(const jit_program_t&) = delete;
+    jit_program_t(jit_program_t&& other) noexcept;
+    jit_program_t& operator=(jit_program_t&& other) noexcept;
+    ~jit_program_t();
+
+    // Calls `main()`. Unlike `--run`, nothing is checked: division by zero raises `SIGFPE` and deep recursion overflows the stack of the calling thread.
+    int run_main() const;
+};
+}
+
+// Compiles IR that passed `verify_module()`. Calls to functions that are neither in the module nor in the process, and a missing `main()`, are reported.
+utils::result_t<x86_64::jit_program_t> compile_to_memory(const ir::module_t& module, utils::diagnostics_t& diagnostics);
+// Lowers a type checked program to IR, compiles it to memory and runs it.
+utils::result_t<int> run_program_natively(const ast::validated_program_t& program, utils::diagnostics_t& diagnostics);
@@ -9,16 +9,24 @@
 #include <iostream>
 #include <optional>
 #include <unordered_map>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <cstddef>
 #include <cassert>
 #include <cstring>
+#include <algorithm>
 
 #include <frontend/lexing/lexer.hpp>
+#include <utils/data_structures/stable_vector.hpp>
 #include <utils/common.hpp>
+#include <utils/symbol_interner.hpp>
 
 
 namespace ast {
-using var_name_t = std::string;
+// Identifiers are interned (see `utils::symbol_interner_t`), so names are compared and hashed as integers.
+using var_name_t = utils::symbol_t;
 struct constant_t {
     // TODO: maybe use <cstdint> type aliases instead so our type sizes aren't host architecture dependent
     std::variant<char, signed char, unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long, float, double, long double> value;
@@ -30,7 +38,27 @@ enum class type_category_t {
     STRUCT,
     TYPEDEF,
 };
-using type_name_t = std::string;
+using type_name_t = utils::symbol_t;
+// Names of the primitive types, interned once up front so that checking for a specific primitive type is an integer compare.
+namespace primitive_type_names {
+inline const type_name_t CHAR{"char"};
+inline const type_name_t SIGNED_CHAR{"signed char"};
+inline const type_name_t UNSIGNED_CHAR{"unsigned char"};
+inline const type_name_t SHORT{"short"};
+inline const type_name_t UNSIGNED_SHORT{"unsigned short"};
+inline const type_name_t INT{"int"};
+inline const type_name_t UNSIGNED_INT{"unsigned int"};
+inline const type_name_t LONG{"long"};
+inline const type_name_t UNSIGNED_LONG{"unsigned long"};
+inline const type_name_t LONG_LONG{"long long"};
+inline const type_name_t UNSIGNED_LONG_LONG{"unsigned long long"};
+inline const type_name_t FLOAT{"float"};
+inline const type_name_t DOUBLE{"double"};
+inline const type_name_t LONG_DOUBLE{"long double"};
+}
+// anonymous structs have the empty name
+inline const type_name_t ANONYMOUS_TYPE_NAME{};
+
 struct type_t {
     type_category_t type_category;
     type_name_t type_name;
@@ -42,13 +70,118 @@ struct type_t {
     std::optional<std::size_t> size; // is `std::nullopt` if we only have a forward declaration (size and alignment are filled in once the struct is fully defined)
     std::optional<std::size_t> alignment;
 
-    std::unordered_map<std::string, std::size_t> field_offsets; // get the index in `fields` from field name
+    // The fields of a struct, in declaration order. Only set for struct definitions (and typedefs of anonymous struct definitions).
     std::vector<type_t> fields;
+    std::vector<var_name_t> field_names;
+    std::vector<std::size_t> field_offsets; // byte offset of each field from the start of the struct, see `layout_struct_fields()`
+
+    // If `type_category` is `type_category_t::TYPEDEF`, the end of its typedef chain, resolved once when the typedef is defined (see `make_typedef_type_t()`),
+    //  so that finding what a typedef stands for is a single lookup no matter how long the chain is. A typedef of an anonymous struct resolves to itself,
+    //  as it carries the struct's definition. `std::nullopt` otherwise.
+    std::optional<type_category_t> underlying_type_category;
+    std::optional<type_name_t> underlying_type;
+
+    // Index into `fields` of the field named `name`. Structs have few fields, so this is a linear scan over symbols rather than a hash lookup.
+    std::optional<std::uint32_t> find_field(const var_name_t name) const {
+        for(std::uint32_t i = 0u; i < field_names.size(); ++i) {
+            if(field_names[i] == name) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+// Handle of a type interned in a `type_context_t`. Two handles from the same context are equal iff their types are.
+struct type_id_t {
+    std::uint32_t index;
+};
+inline bool operator==(const type_id_t lhs, const type_id_t rhs) {
+    return lhs.index == rhs.index;
+}
+inline bool operator!=(const type_id_t lhs, const type_id_t rhs) {
+    return !(lhs == rhs);
+}
+
+// Stores each distinct type once, so that whatever refers to a type only has to keep a `type_id_t` and types are compared by comparing their ids.
+// Types are looked up by their whole value (including the fields of structs), not just by name, as e.g. a struct forward declaration and its definition share a name.
+class type_context_t {
+    utils::data_structures::stable_vector_t<type_t> types; // indexed by `type_id_t`, references to them stay valid as more types are interned
+    std::unordered_multimap<std::size_t, type_id_t> ids_by_hash;
+
+    static std::size_t hash_combine(const std::size_t seed, const std::size_t value) {
+        return seed ^ (value + 0x9e3779b97f4a7c15u + (seed << 6u) + (seed >> 2u));
+    }
+    static std::size_t hash(const type_t& type) {
+        std::size_t result = std::hash<type_name_t>{}(type.type_name);
+        result = hash_combine(result, static_cast<std::size_t>(type.type_category));
+        result = hash_combine(result, type.size.value_or(0u));
+        for(const auto& field : type.fields) {
+            result = hash_combine(result, hash(field));
+        }
+        return result;
+    }
+    static bool is_same_type(const type_t& lhs, const type_t& rhs) {
+        if(lhs.type_category != rhs.type_category || lhs.type_name != rhs.type_name || lhs.aliased_type_category != rhs.aliased_type_category || lhs.aliased_type != rhs.aliased_type
+            || lhs.size != rhs.size || lhs.alignment != rhs.alignment || lhs.field_names != rhs.field_names || lhs.field_offsets != rhs.field_offsets || lhs.fields.size() != rhs.fields.size()
+            || lhs.underlying_type_category != rhs.underlying_type_category || lhs.underlying_type != rhs.underlying_type) {
+            return false;
+        }
+        for(std::size_t i = 0u; i < lhs.fields.size(); ++i) {
+            if(!is_same_type(lhs.fields[i], rhs.fields[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    type_context_t() = default;
+    type_context_t(const type_context_t&) = delete;
+    type_context_t& operator=(const type_context_t&) = delete;
+
+    type_id_t intern(type_t type) {
+        const std::size_t type_hash = hash(type);
+        const auto [first, last] = ids_by_hash.equal_range(type_hash);
+        for(auto iter = first; iter != last; ++iter) {
+            if(is_same_type(types[iter->second.index], type)) {
+                return iter->second;
+            }
+        }
+        const type_id_t id{types.push_back(std::move(type))};
+        ids_by_hash.insert({type_hash, id});
+        return id;
+    }
+    const type_t& get(const type_id_t id) const {
+        return types[id.index];
+    }
+
+    std::uint32_t size() const {
+        return types.size();
+    }
+    std::size_t capacity_bytes() const {
+        return types.capacity_bytes();
+    }
+
+    // Interns every type of `other`. Returns the ids they have here, indexed by their ids in `other`.
+    std::vector<type_id_t> intern_all(const type_context_t& other) {
+        std::vector<type_id_t> ids;
+        ids.reserve(other.size());
+        for(std::uint32_t i = 0u; i < other.size(); ++i) {
+            ids.push_back(intern(other.types[i]));
+        }
+        return ids;
+    }
 };
 
+struct member_access_t {
+    var_name_t name;
+    std::uint32_t field_index; // into the `fields` of the struct being accessed
+};
 struct variable_access_t {
     var_name_t variable;
-    std::vector<var_name_t> member_accesses;
+    std::vector<member_access_t> member_accesses; // resolved by the parser, outermost first
+    std::size_t member_offset = 0u; // byte offset of the accessed member from the start of `variable`, i.e. the sum of the `field_offsets` along `member_accesses`
 };
 
 struct grouping_t;
@@ -57,12 +190,67 @@ struct unary_expression_t;
 struct binary_expression_t;
 struct ternary_expression_t;
 struct function_call_t;
-// `std::shared_ptr` is to get around not having full recursive type definitions in C++
-// TODO: maybe use `std::unique_ptr` instead of `std::shared_ptr`
-using expression_exp_type_t = std::variant<std::shared_ptr<grouping_t>, std::shared_ptr<convert_t>, std::shared_ptr<unary_expression_t>, std::shared_ptr<binary_expression_t>, std::shared_ptr<ternary_expression_t>, std::shared_ptr<function_call_t>, variable_access_t, constant_t>;
+// Recursive nodes are stored flat, in one `node_pools_t` pool per node kind, and are referenced through 32 bit indices into their pool.
+// A handle doesn't know which pools it belongs to. It is dereferenced through the current thread's pools (see `node_pools_scope_t`).
+// Copying a handle shares the node, it does not copy it.
+template<typename T>
+struct node_handle_t {
+    std::uint32_t index;
+
+    T& operator*() const; // defined below `node_pools_t`
+    T* operator->() const {
+        return &**this;
+    }
+};
+using expression_exp_type_t = std::variant<node_handle_t<grouping_t>, node_handle_t<convert_t>, node_handle_t<unary_expression_t>, node_handle_t<binary_expression_t>, node_handle_t<ternary_expression_t>, node_handle_t<function_call_t>, variable_access_t, constant_t>;
+// The type of an expression, as an id interned in the `type_context_t` of the current `node_pools_t`, so that expressions stay small.
+// Declarations and parameters hold their types the same way.
+// Has the same interface as a `std::optional<type_t>`. Two expression types (of the same pools) are equal iff their types are, which is an integer compare.
+class expression_type_t {
+    static constexpr std::uint32_t NO_TYPE = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t index = NO_TYPE;
+
+public:
+    expression_type_t() = default;
+    expression_type_t(std::nullopt_t) {}
+    expression_type_t(const type_id_t id) : index(id.index) {}
+    expression_type_t(type_t type); // defined below `node_pools_t`
+    expression_type_t(const std::optional<type_t>& type) {
+        if(type.has_value()) {
+            *this = expression_type_t(type.value());
+        }
+    }
+
+    bool has_value() const {
+        return index != NO_TYPE;
+    }
+    // throws `std::bad_optional_access` if there is no type
+    const type_t& value() const; // defined below `node_pools_t`
+    type_id_t id() const {
+        if(!has_value()) {
+            throw std::bad_optional_access();
+        }
+        return type_id_t{index};
+    }
+
+    friend bool operator==(const expression_type_t lhs, const expression_type_t rhs) {
+        return lhs.index == rhs.index;
+    }
+    friend bool operator!=(const expression_type_t lhs, const expression_type_t rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Only for moving types between pools, see `node_pools_t::append()`.
+    void remap_id(const std::vector<type_id_t>& ids) {
+        if(has_value()) {
+            index = ids[index].index;
+        }
+    }
+};
+
 struct expression_t {
     expression_exp_type_t expr;
-    std::optional<type_t> type; // usually has `std::nullopt` if not a literal after initial parsing stage. Is filled in during semantic analysis and type checking pass (as we often need symbol tables).
+    expression_type_t type; // usually has `std::nullopt` if not a literal after initial parsing stage. Is filled in during semantic analysis and type checking pass (as we often need symbol tables).
 };
 
 struct grouping_t { // grouped with `( <expr> )`
@@ -71,8 +259,9 @@ struct grouping_t { // grouped with `( <expr> )`
 struct convert_t { // used for type conversions and casts
     expression_t expr;
 };
+using func_name_t = utils::symbol_t;
 struct function_call_t {
-    std::string function_name;
+    func_name_t function_name;
     std::vector<expression_t> params;
 };
 
@@ -118,7 +307,7 @@ struct return_statement_t {
     expression_t expr;
 };
 struct declaration_t {
-    type_t type_name;
+    expression_type_t type_name;
     var_name_t var_name;
     std::optional<expression_t> value;
 };
@@ -128,7 +317,7 @@ struct expression_statement_t {
 
 struct if_statement_t;
 struct compound_statement_t;
-using statement_t = std::variant<return_statement_t, expression_statement_t, std::shared_ptr<if_statement_t>, std::shared_ptr<compound_statement_t>>;
+using statement_t = std::variant<return_statement_t, expression_statement_t, node_handle_t<if_statement_t>, node_handle_t<compound_statement_t>>;
 
 struct compound_statement_t {
     std::vector<std::variant<statement_t, declaration_t>> stmts;
@@ -139,23 +328,218 @@ struct if_statement_t {
     std::optional<statement_t> else_body;
 };
 
-using func_name_t = std::string;
 struct function_declaration_t {
     type_t return_type;
     func_name_t function_name;
-    std::vector<type_t> params;
+    std::vector<expression_type_t> params;
 };
 struct function_definition_t {
     type_t return_type;
     func_name_t function_name;
-    std::vector<std::pair<type_t, std::optional<var_name_t>>> params;
+    std::vector<std::pair<expression_type_t, std::optional<var_name_t>>> params;
     compound_statement_t statements;
 };
 
+// What `node_pools_t::append()` did to the appended pools. Handles into them have to be fixed up with this.
+struct node_offsets_t {
+    // Handle of the first node of each kind that was moved over. Handles into the appended pools have to be offset by these.
+    std::tuple<
+        node_handle_t<grouping_t>,
+        node_handle_t<convert_t>,
+        node_handle_t<unary_expression_t>,
+        node_handle_t<binary_expression_t>,
+        node_handle_t<ternary_expression_t>,
+        node_handle_t<function_call_t>,
+        node_handle_t<if_statement_t>,
+        node_handle_t<compound_statement_t>
+    > first_nodes;
+    std::vector<type_id_t> type_ids; // the ids that the types of the appended pools were interned as, indexed by their old ids
+};
+inline void offset_node_handles(expression_t& expression, const node_offsets_t& offsets);
+inline void offset_node_handles(statement_t& statement, const node_offsets_t& offsets);
+inline void offset_node_handles(compound_statement_t& compound_statement, const node_offsets_t& offsets);
+
+// Owns every recursive node of a program, with the nodes of each kind stored contiguously in creation order.
+class node_pools_t {
+    std::tuple<
+        utils::data_structures::stable_vector_t<grouping_t>,
+        utils::data_structures::stable_vector_t<convert_t>,
+        utils::data_structures::stable_vector_t<unary_expression_t>,
+        utils::data_structures::stable_vector_t<binary_expression_t>,
+        utils::data_structures::stable_vector_t<ternary_expression_t>,
+        utils::data_structures::stable_vector_t<function_call_t>,
+        utils::data_structures::stable_vector_t<if_statement_t>,
+        utils::data_structures::stable_vector_t<compound_statement_t>
+    > pools; // in the same order as `node_offsets_t::first_nodes`
+    type_context_t types; // of `expression_type_t`s
+
+    template<typename T>
+    node_handle_t<T> move_pool_to_end(utils::data_structures::stable_vector_t<T>& other_pool) {
+        auto& pool = get_pool<T>();
+        const node_handle_t<T> offset{pool.size()};
+        for(std::uint32_t i = 0u; i < other_pool.size(); ++i) {
+            pool.push_back(std::move(other_pool[i]));
+        }
+        other_pool.clear();
+        return offset;
+    }
+
+public:
+    template<typename T>
+    utils::data_structures::stable_vector_t<T>& get_pool() {
+        return std::get<utils::data_structures::stable_vector_t<T>>(pools);
+    }
+    template<typename T>
+    const utils::data_structures::stable_vector_t<T>& get_pool() const {
+        return std::get<utils::data_structures::stable_vector_t<T>>(pools);
+    }
+
+    template<typename T>
+    node_handle_t<T> add(T node) {
+        return node_handle_t<T>{get_pool<T>().push_back(std::move(node))};
+    }
+
+    type_context_t& get_types() {
+        return types;
+    }
+    const type_context_t& get_types() const {
+        return types;
+    }
+
+    // the types of expressions aren't counted as nodes
+    std::size_t node_count() const {
+        return std::apply([](const auto&... pool) { return (std::size_t{0u} + ... + pool.size()); }, pools);
+    }
+    std::size_t capacity_bytes() const {
+        return std::apply([](const auto&... pool) { return (std::size_t{0u} + ... + pool.capacity_bytes()); }, pools) + types.capacity_bytes();
+    }
+
+    // Moves every node of `other` to the end of these pools (in order) and interns its types here, leaving `other` empty, and fixes up the handles inside the moved nodes.
+    // Handles that point into `other` from outside of it (e.g. the statements of a function body) still need to be fixed up with `offset_node_handles()`.
+    node_offsets_t append(node_pools_t&& other) {
+        node_offsets_t offsets;
+        offsets.first_nodes = std::apply([this](auto&... other_pool) { return decltype(offsets.first_nodes){move_pool_to_end(other_pool)...}; }, other.pools);
+        offsets.type_ids = types.intern_all(other.types);
+        std::apply([&offsets](auto&... pool) { (offset_pool_node_handles(pool, offsets), ...); }, pools);
+        return offsets;
+    }
+
+private:
+    template<typename T>
+    static void offset_pool_node_handles(utils::data_structures::stable_vector_t<T>& pool, const node_offsets_t& offsets);
+};
+
+namespace detail {
+inline thread_local node_pools_t* current_node_pools = nullptr;
+}
+// Makes `node_pools` the pools that handles are dereferenced through and that `make_node()` adds to on this thread, for the lifetime of the scope.
+// This saves passing the pools to every function that touches the AST.
+class node_pools_scope_t {
+    node_pools_t* previous_node_pools;
+
+public:
+    explicit node_pools_scope_t(node_pools_t& node_pools) : previous_node_pools(std::exchange(detail::current_node_pools, &node_pools)) {}
+    node_pools_scope_t(const node_pools_scope_t&) = delete;
+    node_pools_scope_t& operator=(const node_pools_scope_t&) = delete;
+    ~node_pools_scope_t() {
+        detail::current_node_pools = previous_node_pools;
+    }
+};
+// throws `std::logic_error` if there is no `node_pools_scope_t` active on this thread
+inline node_pools_t& get_current_node_pools() {
+    if(detail::current_node_pools == nullptr) {
+        throw std::logic_error("No AST node pools are active on this thread.");
+    }
+    return *detail::current_node_pools;
+}
+
+template<typename T>
+T& node_handle_t<T>::operator*() const {
+    return get_current_node_pools().get_pool<T>()[index];
+}
+template<typename T>
+node_handle_t<T> make_node(T node) {
+    return get_current_node_pools().add(std::move(node));
+}
+
+inline expression_type_t::expression_type_t(type_t type) : index(get_current_node_pools().get_types().intern(std::move(type)).index) {}
+inline const type_t& expression_type_t::value() const {
+    return get_current_node_pools().get_types().get(id());
+}
+
+template<typename T>
+void offset_node_handles(node_handle_t<T>& handle, const node_offsets_t& offsets) {
+    handle.index += std::get<node_handle_t<T>>(offsets.first_nodes).index;
+}
+inline void offset_node_handles(expression_t& expression, const node_offsets_t& offsets) {
+    std::visit(overloaded{
+        [&offsets](auto& handle) { offset_node_handles(handle, offsets); },
+        [](variable_access_t&) {},
+        [](constant_t&) {},
+    }, expression.expr);
+    expression.type.remap_id(offsets.type_ids);
+}
+inline void offset_node_handles(declaration_t& declaration, const node_offsets_t& offsets) {
+    declaration.type_name.remap_id(offsets.type_ids);
+    if(declaration.value.has_value()) {
+        offset_node_handles(declaration.value.value(), offsets);
+    }
+}
+inline void offset_node_handles(statement_t& statement, const node_offsets_t& offsets) {
+    std::visit(overloaded{
+        [&offsets](return_statement_t& return_statement) { offset_node_handles(return_statement.expr, offsets); },
+        [&offsets](expression_statement_t& expression_statement) {
+            if(expression_statement.expr.has_value()) {
+                offset_node_handles(expression_statement.expr.value(), offsets);
+            }
+        },
+        [&offsets](auto& handle) { offset_node_handles(handle, offsets); },
+    }, statement);
+}
+inline void offset_node_handles(compound_statement_t& compound_statement, const node_offsets_t& offsets) {
+    for(auto& statement_or_declaration : compound_statement.stmts) {
+        std::visit([&offsets](auto& node) { offset_node_handles(node, offsets); }, statement_or_declaration);
+    }
+}
+
+// Only the handles stored directly in a node are offset, its children are offset as part of their own pools.
+template<typename T>
+void node_pools_t::offset_pool_node_handles(utils::data_structures::stable_vector_t<T>& pool, const node_offsets_t& offsets) {
+    for(std::uint32_t i = std::get<node_handle_t<T>>(offsets.first_nodes).index; i < pool.size(); ++i) {
+        T& node = pool[i];
+        if constexpr(std::is_same_v<T, grouping_t> || std::is_same_v<T, convert_t>) {
+            offset_node_handles(node.expr, offsets);
+        } else if constexpr(std::is_same_v<T, unary_expression_t>) {
+            offset_node_handles(node.exp, offsets);
+        } else if constexpr(std::is_same_v<T, binary_expression_t>) {
+            offset_node_handles(node.left, offsets);
+            offset_node_handles(node.right, offsets);
+        } else if constexpr(std::is_same_v<T, ternary_expression_t>) {
+            offset_node_handles(node.condition, offsets);
+            offset_node_handles(node.if_true, offsets);
+            offset_node_handles(node.if_false, offsets);
+        } else if constexpr(std::is_same_v<T, function_call_t>) {
+            for(auto& param : node.params) {
+                offset_node_handles(param, offsets);
+            }
+        } else if constexpr(std::is_same_v<T, if_statement_t>) {
+            offset_node_handles(node.if_exp, offsets);
+            offset_node_handles(node.if_body, offsets);
+            if(node.else_body.has_value()) {
+                offset_node_handles(node.else_body.value(), offsets);
+            }
+        } else {
+            static_assert(std::is_same_v<T, compound_statement_t>, "Unhandled node kind.");
+            offset_node_handles(node, offsets);
+        }
+    }
+}
+
 using global_variable_declaration_t = declaration_t;
 using type_table_t = std::array<std::unordered_map<type_name_t, type_t>, NUMBER_OF_TYPE_CATEGORIES>;
 
 struct validated_program_t {
+    std::shared_ptr<node_pools_t> nodes; // owns every `node_handle_t` in `top_level_declarations`
     type_table_t type_table;
 
     std::vector<std::variant<function_definition_t, global_variable_declaration_t>> top_level_declarations; // guaranteed to be deduplicated
@@ -164,11 +548,12 @@ struct validated_program_t {
 
 
 
-inline ast::expression_t make_convert_t(ast::expression_t&& expr, ast::type_t type) {
-    return ast::expression_t{ std::make_shared<ast::convert_t>(ast::convert_t{std::move(expr)}), type};
+// `type` is usually the type of another expression, which is passed as is, without interning it again
+inline ast::expression_t make_convert_t(ast::expression_t&& expr, const ast::expression_type_t type) {
+    return ast::expression_t{ ast::make_node<ast::convert_t>(ast::convert_t{std::move(expr)}), type};
 }
-inline std::shared_ptr<ast::grouping_t> make_grouping(ast::expression_t&& exp) {
-    return std::make_shared<ast::grouping_t>(ast::grouping_t{std::move(exp)});
+inline ast::node_handle_t<ast::grouping_t> make_grouping(ast::expression_t&& exp) {
+    return ast::make_node<ast::grouping_t>(ast::grouping_t{std::move(exp)});
 }
 
 
@@ -177,56 +562,75 @@ inline std::shared_ptr<ast::grouping_t> make_grouping(ast::expression_t&& exp) {
 inline ast::type_t make_primitive_type_t(ast::type_category_t type_category, ast::type_name_t type_name, std::size_t size, std::size_t alignment) {
     return ast::type_t{type_category, std::move(type_name), std::nullopt, std::nullopt, size, alignment, {}, {}};
 }
+// Resolves the typedef chain here, once: a typedef of a typedef takes over the resolution of the typedef it aliases.
 inline ast::type_t make_typedef_type_t(const ast::type_table_t& type_table, ast::type_name_t type_name, ast::type_category_t aliased_type_category, ast::type_name_t aliased_type) {
+    ast::type_t typedef_type{ast::type_category_t::TYPEDEF, std::move(type_name), aliased_type_category, aliased_type, std::nullopt, std::nullopt, {}, {}};
+    typedef_type.underlying_type_category = aliased_type_category;
+    typedef_type.underlying_type = aliased_type;
     if(aliased_type_category != ast::type_category_t::STRUCT) {
         auto aliased_type_iter = type_table.at(static_cast<std::uint32_t>(aliased_type_category)).find(aliased_type);
         if(aliased_type_iter == std::end(type_table.at(static_cast<std::uint32_t>(aliased_type_category)))) {
             throw std::logic_error("Type being aliased does not exist.");
         }
+        if(aliased_type_category == ast::type_category_t::TYPEDEF) {
+            typedef_type.underlying_type_category = aliased_type_iter->second.underlying_type_category;
+            typedef_type.underlying_type = aliased_type_iter->second.underlying_type;
+        }
     }
-    return ast::type_t{ast::type_category_t::TYPEDEF, std::move(type_name), aliased_type_category, aliased_type, std::nullopt, std::nullopt, {}, {}};
+    return typedef_type;
 }
 inline ast::type_t make_typedef_with_anonymous_struct_t(const ast::type_table_t& type_table, ast::type_name_t type_name, ast::type_t anonymous_struct_definition) {
     if(anonymous_struct_definition.type_category != ast::type_category_t::STRUCT) {
-        throw std::runtime_error("Expected struct type when constructing typedef to anonymous struct");
+        throw std::logic_error("Expected struct type when constructing typedef to anonymous struct");
     }
-    return ast::type_t{ast::type_category_t::TYPEDEF, std::move(type_name), ast::type_category_t::STRUCT, ast::type_name_t(""), anonymous_struct_definition.alignment.value(), anonymous_struct_definition.size.value(), std::move(anonymous_struct_definition.field_offsets), std::move(anonymous_struct_definition.fields)};
+    ast::type_t typedef_type{ast::type_category_t::TYPEDEF, type_name, ast::type_category_t::STRUCT, ast::ANONYMOUS_TYPE_NAME, anonymous_struct_definition.size.value(), anonymous_struct_definition.alignment.value(),
+        std::move(anonymous_struct_definition.fields), std::move(anonymous_struct_definition.field_names), std::move(anonymous_struct_definition.field_offsets)};
+    typedef_type.underlying_type_category = ast::type_category_t::TYPEDEF;
+    typedef_type.underlying_type = std::move(type_name);
+    return typedef_type;
 }
 inline ast::type_t make_struct_forward_decl_type_t(ast::type_name_t type_name) {
     return ast::type_t{ast::type_category_t::STRUCT, std::move(type_name), std::nullopt, std::nullopt, std::nullopt, std::nullopt, {}, {}};
 }
-inline ast::type_t make_struct_definition_type_t(const ast::type_table_t& type_table, ast::type_name_t type_name, std::vector<ast::type_t> field_types, std::vector<std::string> field_names) {
-    std::cout << "make_struct_definition_type_t: " << type_name << "\n";
-    if(field_types.size() != field_names.size()) {
-        throw std::logic_error("Mismatch of number of field names and types.");
-    }
-    std::unordered_map<std::string, std::size_t> field_offsets;
-    std::size_t struct_size{};
-    std::size_t struct_alignment{};
-    std::size_t prior_field_size{};
-    for(std::size_t i = 0; i < std::size(field_types); ++i) {
-        field_offsets.insert({std::move(field_names.at(i)), i});
-        const ast::type_t& member_type = field_types.at(i);
-        if(!member_type.size.has_value() || !member_type.size.has_value()) {
-            // TODO: Implement checking and handling if `member_type` is a type alias of a struct forward declaration where the struct has been defined since the type alias was created.
-            throw std::runtime_error("You cannot instantiate a struct forward declaration.");
+struct struct_layout_t {
+    std::vector<std::size_t> field_offsets;
+    std::size_t size;
+    std::size_t alignment;
+};
+// Lays out a struct as the SysV x86_64 ABI (and so gcc) does: every field is placed at the next offset that is a multiple of its alignment, the struct is as
+//  aligned as its most aligned field, and its size is rounded up to a multiple of that alignment (tail padding), so that arrays of it keep every field aligned.
+// An empty struct (a GNU extension) has size 0 and alignment 1.
+// `std::nullopt` if a field's type has no size, i.e. is a struct forward declaration.
+inline std::optional<struct_layout_t> layout_struct_fields(const std::vector<ast::type_t>& field_types) {
+    struct_layout_t layout{{}, 0u, 1u};
+    layout.field_offsets.reserve(field_types.size());
+    for(const ast::type_t& field_type : field_types) {
+        if(!field_type.size.has_value() || !field_type.alignment.has_value()) {
+            // TODO: Implement checking and handling if `field_type` is a type alias of a struct forward declaration where the struct has been defined since the type alias was created.
+            return std::nullopt;
         }
-        struct_size += member_type.size.value();
-        // TODO: Maybe insert dummy padding members to make life easier later during assembly codegen
-        struct_size += (prior_field_size % member_type.alignment.value()); // round up to abide by alignment requirements of fields
-        prior_field_size = member_type.size.value();
-        struct_alignment = std::max(struct_alignment, member_type.alignment.value());
+        const std::size_t field_alignment = field_type.alignment.value();
+        layout.size = (layout.size + field_alignment - 1u) / field_alignment * field_alignment;
+        layout.field_offsets.push_back(layout.size);
+        layout.size += field_type.size.value();
+        layout.alignment = std::max(layout.alignment, field_alignment);
     }
-    if(struct_size == 0) {
-        struct_size = 1;
+    layout.size = (layout.size + layout.alignment - 1u) / layout.alignment * layout.alignment;
+    return layout;
+}
+// `std::nullopt` if a field's type has no size, i.e. is a struct forward declaration.
+inline std::optional<ast::type_t> make_struct_definition_type_t(const ast::type_table_t& type_table, ast::type_name_t type_name, std::vector<ast::type_t> field_types, std::vector<ast::var_name_t> field_names) {
+    if(field_types.size() != field_names.size()) {
+        throw std::logic_error("Mismatch of number of field names and types.");
     }
-    if(struct_alignment == 0) {
-        struct_alignment = 1;
+    auto layout = layout_struct_fields(field_types);
+    if(!layout.has_value()) {
+        return std::nullopt;
     }
-    return ast::type_t{ast::type_category_t::STRUCT, std::move(type_name), std::nullopt, std::nullopt, struct_size, struct_alignment, std::move(field_offsets), std::move(field_types)};
+    return ast::type_t{ast::type_category_t::STRUCT, std::move(type_name), std::nullopt, std::nullopt, layout->size, layout->alignment, std::move(field_types), std::move(field_names), std::move(layout->field_offsets)};
 }
-inline ast::type_t make_anonymous_struct_definition_type_t(const ast::type_table_t& type_table, std::vector<ast::type_t> field_types, std::vector<std::string> field_names) {
-    return make_struct_definition_type_t(type_table, "", std::move(field_types), std::move(field_names));
+inline std::optional<ast::type_t> make_anonymous_struct_definition_type_t(const ast::type_table_t& type_table, std::vector<ast::type_t> field_types, std::vector<ast::var_name_t> field_names) {
+    return make_struct_definition_type_t(type_table, ast::ANONYMOUS_TYPE_NAME, std::move(field_types), std::move(field_names));
 }
 
 
@@ -246,6 +650,9 @@ inline bool is_integral(const ast::type_t& lhs) {
 }
 
 // defined in parser.cpp
-std::optional<ast::type_t> get_aliased_type_name(const ast::type_table_t& type_table, const ast::type_name_t& type_name);
-std::optional<ast::type_t> get_aliased_type(const ast::type_table_t& type_table, const ast::type_t& type);
-std::optional<ast::type_t> get_underlying_type(const ast::type_table_t& type_table, const ast::type_t& type);
+// These return the type in `type_table` that a type name or typedef stands for (or `nullptr` if there is none), which stays valid as long as the table does.
+const ast::type_t* get_aliased_type_name(const ast::type_table_t& type_table, const ast::type_name_t& type_name);
+const ast::type_t* get_aliased_type(const ast::type_table_t& type_table, const ast::type_t& type);
+// Unlike `get_aliased_type()`, also takes non typedefs (and then returns `&type` itself), and looks up the definitions of structs that were only forward
+//  declared where `type` was named.
+const ast::type_t* get_underlying_type(const ast::type_table_t& type_table, const ast::type_t& type);
@@ -66,28 +66,28 @@ const char* get_binary_op_name(const ast::binary_operator_token_t op) {
 
 void print_expression(const bool has_types, const ast::expression_t& expr) {
     std::visit(overloaded{
-        [has_types](const std::shared_ptr<ast::grouping_t>& grouping) -> void {
+        [has_types](const ast::node_handle_t<ast::grouping_t>& grouping) -> void {
             std::cout << "(grouping: ";
             print_expression(has_types, grouping->expr);
         },
-        [has_types](const std::shared_ptr<ast::binary_expression_t>& binary_exp) -> void {
+        [has_types](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) -> void {
             std::cout << "(binary_exp: ";
             std::cout << "[" << get_binary_op_name(binary_exp->op) << ']';
             print_expression(has_types, binary_exp->left);
             print_expression(has_types, binary_exp->right);
         },
-        [has_types](const std::shared_ptr<ast::unary_expression_t>& unary_exp) -> void {
+        [has_types](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) -> void {
             std::cout << "(unary_exp: ";
             std::cout << "[" << get_unary_op_name(unary_exp->op) << ']';
             print_expression(has_types, unary_exp->exp);
         },
-        [has_types](const std::shared_ptr<ast::ternary_expression_t>& ternary_exp) -> void {
+        [has_types](const ast::node_handle_t<ast::ternary_expression_t>& ternary_exp) -> void {
             std::cout << "(ternary_exp: ";
             print_expression(has_types, ternary_exp->condition);
             print_expression(has_types, ternary_exp->if_true);
             print_expression(has_types, ternary_exp->if_false);
         },
-        [has_types](const std::shared_ptr<ast::function_call_t>& function_call) -> void {
+        [has_types](const ast::node_handle_t<ast::function_call_t>& function_call) -> void {
             std::cout << "(function call: ";
             std::cout << function_call->function_name;
             std::cout << '(';
@@ -110,11 +110,11 @@ void print_expression(const bool has_types, const ast::expression_t& expr) {
         [](const ast::variable_access_t& var_name) -> void {
             std::cout << "(identifier: ";
             std::cout << var_name.variable;
-            for(const ast::var_name_t& member_access : var_name.member_accesses) {
-                std::cout << '.' << member_access;
+            for(const ast::member_access_t& member_access : var_name.member_accesses) {
+                std::cout << '.' << member_access.name;
             }
         },
-        [has_types](const std::shared_ptr<ast::convert_t>& convert) -> void {
+        [has_types](const ast::node_handle_t<ast::convert_t>& convert) -> void {
             std::cout << "(convert: ";
             print_expression(has_types, convert->expr);
         }
@@ -162,13 +162,13 @@ void print_statement(const bool has_types, const ast::statement_t& stmt, const b
                 }
             }
         },
-        [has_types, is_last_statement, is_nested](const std::shared_ptr<ast::if_statement_t>& stmt) {
+        [has_types, is_last_statement, is_nested](const ast::node_handle_t<ast::if_statement_t>& stmt) {
             print_if_statement(has_types, *stmt);
             if(!is_last_statement || is_nested) {
                 std::cout << '\n';
             }
         },
-        [has_types](const std::shared_ptr<ast::compound_statement_t>& stmt) {
+        [has_types](const ast::node_handle_t<ast::compound_statement_t>& stmt) {
             print_compound_statement(has_types, *stmt, true);
         }
     }, stmt);
@@ -176,7 +176,7 @@ void print_statement(const bool has_types, const ast::statement_t& stmt, const b
 
 void print_declaration(const bool has_types, const ast::declaration_t& declaration, const bool is_last_statement) {
     std::cout << "(declaration: ";
-    std::cout << declaration.type_name.type_name;
+    std::cout << declaration.type_name.value().type_name;
     std::cout << ' ';
     std::cout << declaration.var_name;
     if(declaration.value.has_value()) {
@@ -204,7 +204,7 @@ void print_compound_statement(const bool has_types, const ast::compound_statemen
 void print_function_decl(const ast::function_declaration_t& function_declaration) {
     std::cout << "(" << function_declaration.return_type.type_name << ' ' << function_declaration.function_name << '(';
     for(auto i = 0; i < function_declaration.params.size(); ++i) {
-        std::cout << function_declaration.params[i].type_name;
+        std::cout << function_declaration.params[i].value().type_name;
         if(i != function_declaration.params.size() - 1) {
             std::cout << ", ";
         }
@@ -214,7 +214,7 @@ void print_function_decl(const ast::function_declaration_t& function_declaration
 void print_function_definition(const bool has_types, const ast::function_definition_t& function_definition) {
     std::cout << "(" << function_definition.return_type.type_name << ' ' << function_definition.function_name << '(';
     for(auto i = 0; i < function_definition.params.size(); ++i) {
-        std::cout << function_definition.params[i].first.type_name;
+        std::cout << function_definition.params[i].first.value().type_name;
         if(function_definition.params[i].second.has_value()) {
             std::cout << ' ' << function_definition.params[i].second.value();
         }
@@ -232,7 +232,7 @@ void print_function_definition(const bool has_types, const ast::function_definit
 
 void print_global_variable_definition(const ast::global_variable_declaration_t& global_var_def) {
     std::cout << "(global_var: ";
-    std::cout << global_var_def.type_name.type_name;
+    std::cout << global_var_def.type_name.value().type_name;
     std::cout << ' ';
     std::cout << global_var_def.var_name;
     if(global_var_def.value.has_value()) {
@@ -243,6 +243,7 @@ void print_global_variable_definition(const ast::global_variable_declaration_t&
     std::cout << '\n';
 }
 void print_validated_ast(const ast::validated_program_t& validated_program) {
+    const ast::node_pools_scope_t node_pools_scope(*validated_program.nodes);
     for(const auto& e : validated_program.top_level_declarations) {
         std::visit(overloaded{
             [](const ast::function_definition_t& function_def) {
@@ -0,0 +1,263 @@
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <frontend/lexing/lexer.hpp>
+
+
+// Keyword and punctuator recognition, generated at compile time from the two declarative tables below.
+// To add a keyword or operator, add its `token_type_t` and a row to the matching table. The `static_assert`s at the bottom of this file check that the
+//  generated recognizers still recognize every row.
+//
+// Keywords are looked up with a perfect hash over the identifier text (a single probe and a single string compare, no matter how many keywords there are).
+// Punctuators are matched with a DFA that does maximal munch (i.e. `<<=` over `<<` over `<`) one transition per character.
+
+struct lexeme_t {
+    std::string_view text;
+    token_type_t token_type;
+};
+
+inline constexpr lexeme_t keyword_table[] = {
+    {"char", token_type_t::CHAR_KEYWORD},
+    {"double", token_type_t::DOUBLE_KEYWORD},
+    {"else", token_type_t::ELSE_KEYWORD},
+    {"float", token_type_t::FLOAT_KEYWORD},
+    {"if", token_type_t::IF_KEYWORD},
+    {"int", token_type_t::INT_KEYWORD},
+    {"long", token_type_t::LONG_KEYWORD},
+    {"return", token_type_t::RETURN_KEYWORD},
+    {"short", token_type_t::SHORT_KEYWORD},
+    {"signed", token_type_t::SIGNED_KEYWORD},
+    {"struct", token_type_t::STRUCT_KEYWORD},
+    {"typedef", token_type_t::TYPEDEF_KEYWORD},
+    {"unsigned", token_type_t::UNSIGNED_KEYWORD},
+};
+
+// NOTE: `//` and `/*` are not punctuators, they are handled by the comment lexing before we ever get here.
+inline constexpr lexeme_t punctuator_table[] = {
+    {"(", token_type_t::LEFT_PAREN}, {")", token_type_t::RIGHT_PAREN},
+    {"{", token_type_t::LEFT_CURLY}, {"}", token_type_t::RIGHT_CURLY},
+    {";", token_type_t::SEMICOLON},
+    {",", token_type_t::COMMA},
+    {"?", token_type_t::QUESTION_MARK}, {":", token_type_t::COLON},
+    {".", token_type_t::DOT},
+    {"~", token_type_t::TILDE},
+
+    {"-", token_type_t::DASH}, {"-=", token_type_t::MINUS_EQUALS}, {"--", token_type_t::DASH_DASH},
+    {"+", token_type_t::PLUS}, {"+=", token_type_t::PLUS_EQUALS}, {"++", token_type_t::PLUS_PLUS},
+    {"*", token_type_t::ASTERISK}, {"*=", token_type_t::TIMES_EQUALS},
+    {"/", token_type_t::SLASH}, {"/=", token_type_t::DIVIDE_EQUALS},
+    {"%", token_type_t::MODULO}, {"%=", token_type_t::MODULO_EQUALS},
+    {"!", token_type_t::BANG}, {"!=", token_type_t::NOT_EQUAL},
+    {"=", token_type_t::EQUALS}, {"==", token_type_t::EQUAL_EQUAL},
+    {"^", token_type_t::BITWISE_XOR}, {"^=", token_type_t::XOR_EQUALS},
+    {"&", token_type_t::BITWISE_AND}, {"&&", token_type_t::LOGIC_AND}, {"&=", token_type_t::AND_EQUALS},
+    {"|", token_type_t::BITWISE_OR}, {"||", token_type_t::LOGIC_OR}, {"|=", token_type_t::OR_EQUALS},
+    {"<", token_type_t::LESS_THAN}, {"<=", token_type_t::LESS_THAN_EQUAL}, {"<<", token_type_t::BITWISE_LEFT_SHIFT}, {"<<=", token_type_t::LEFT_SHIFT_EQUALS},
+    {">", token_type_t::GREATER_THAN}, {">=", token_type_t::GREATER_THAN_EQUAL}, {">>", token_type_t::BITWISE_RIGHT_SHIFT}, {">>=", token_type_t::RIGHT_SHIFT_EQUALS},
+};
+
+
+namespace lexeme_tables_detail {
+// Keyword perfect hash:
+
+inline constexpr std::uint32_t keyword_hash_bits = 5u;
+inline constexpr std::uint32_t keyword_hash_table_size = 1u << keyword_hash_bits; // leaves room for more keywords
+static_assert(std::size(keyword_table) <= keyword_hash_table_size);
+
+// Every keyword is distinguished by its first character, last character and length, so that is all we hash (like gperf does).
+// The multiplier is searched for at compile time so that none of the keywords collide.
+constexpr std::uint32_t hash_keyword(const std::string_view text, const std::uint32_t seed) {
+    const std::uint32_t key = static_cast<std::uint8_t>(text.front()) | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(text.back())) << 8u)
+                            | (static_cast<std::uint32_t>(text.size()) << 16u);
+    return (key * seed) >> (32u - keyword_hash_bits);
+}
+
+constexpr bool is_keyword_seed_perfect(const std::uint32_t seed) {
+    std::array<bool, keyword_hash_table_size> is_slot_taken{};
+    for(const auto& keyword : keyword_table) {
+        const auto slot = hash_keyword(keyword.text, seed);
+        if(is_slot_taken[slot]) {
+            return false;
+        }
+        is_slot_taken[slot] = true;
+    }
+    return true;
+}
+constexpr std::uint32_t find_keyword_seed() {
+    for(std::uint32_t seed = 2654435761u; seed < 2654435761u + 200000u; seed += 2u) { // odd multipliers, starting from Knuth's
+        if(is_keyword_seed_perfect(seed)) {
+            return seed;
+        }
+    }
+    return ~0u; // checked below
+}
+inline constexpr std::uint32_t keyword_seed = find_keyword_seed();
+static_assert(keyword_seed != ~0u, "No perfect hash seed found for the keyword table. Increase `keyword_hash_table_size`.");
+
+struct keyword_hash_table_t {
+    // empty slots have an empty `text`, which never matches since identifiers are never empty
+    std::array<lexeme_t, keyword_hash_table_size> slots{};
+    std::size_t min_length = ~std::size_t{0u};
+    std::size_t max_length = 0u;
+};
+constexpr keyword_hash_table_t make_keyword_hash_table() {
+    keyword_hash_table_t table{};
+    for(auto& slot : table.slots) {
+        slot = lexeme_t{"", token_type_t::IDENTIFIER};
+    }
+    for(const auto& keyword : keyword_table) {
+        table.slots[hash_keyword(keyword.text, keyword_seed)] = keyword;
+        table.min_length = (keyword.text.size() < table.min_length) ? keyword.text.size() : table.min_length;
+        table.max_length = (keyword.text.size() > table.max_length) ? keyword.text.size() : table.max_length;
+    }
+    return table;
+}
+inline constexpr keyword_hash_table_t keyword_hash_table = make_keyword_hash_table();
+
+
+// Punctuator DFA:
+
+// Only the characters that appear in punctuators get their own column in the transition table, every other character maps to column `0` (no transition).
+struct punctuator_character_classes_t {
+    std::array<std::uint8_t, 256> character_class{};
+    std::uint32_t class_count = 1u;
+};
+constexpr punctuator_character_classes_t make_punctuator_character_classes() {
+    punctuator_character_classes_t classes{};
+    for(const auto& punctuator : punctuator_table) {
+        for(const char c : punctuator.text) {
+            auto& character_class = classes.character_class[static_cast<std::uint8_t>(c)];
+            if(character_class == 0u) {
+                character_class = static_cast<std::uint8_t>(classes.class_count++);
+            }
+        }
+    }
+    return classes;
+}
+inline constexpr punctuator_character_classes_t punctuator_character_classes = make_punctuator_character_classes();
+
+constexpr std::size_t count_punctuator_characters() {
+    std::size_t count = 0u;
+    for(const auto& punctuator : punctuator_table) {
+        count += punctuator.text.size();
+    }
+    return count;
+}
+constexpr std::uint32_t find_max_punctuator_length() {
+    std::size_t max_length = 0u;
+    for(const auto& punctuator : punctuator_table) {
+        max_length = (punctuator.text.size() > max_length) ? punctuator.text.size() : max_length;
+    }
+    return static_cast<std::uint32_t>(max_length);
+}
+inline constexpr std::uint32_t max_punctuator_length = find_max_punctuator_length();
+
+// State `0` is a dead state that every missing transition leads to (and that never leaves or accepts).
+// State `1` is the start state.
+// Upper bound on the number of states: the dead state, the start state and one state per character of every punctuator.
+inline constexpr std::size_t max_punctuator_states = 2u + count_punctuator_characters();
+static_assert(max_punctuator_states <= 256u, "Punctuator DFA states must fit in a `std::uint8_t`.");
+inline constexpr std::uint8_t dead_state = 0u;
+inline constexpr std::uint8_t start_state = 1u;
+
+struct punctuator_dfa_t {
+    std::array<std::array<std::uint8_t, 64u>, max_punctuator_states> transitions{};
+    std::array<token_type_t, max_punctuator_states> accepts{}; // `ERROR` for states that aren't a complete punctuator
+    std::uint32_t state_count = 2u;
+};
+static_assert(punctuator_character_classes.class_count <= 64u);
+
+constexpr punctuator_dfa_t make_punctuator_dfa() {
+    punctuator_dfa_t dfa{};
+    for(auto& accept : dfa.accepts) {
+        accept = token_type_t::ERROR;
+    }
+    for(const auto& punctuator : punctuator_table) {
+        std::uint32_t state = start_state;
+        for(const char c : punctuator.text) {
+            const auto character_class = punctuator_character_classes.character_class[static_cast<std::uint8_t>(c)];
+            if(dfa.transitions[state][character_class] == dead_state) {
+                dfa.transitions[state][character_class] = static_cast<std::uint8_t>(dfa.state_count++);
+            }
+            state = dfa.transitions[state][character_class];
+        }
+        dfa.accepts[state] = punctuator.token_type;
+    }
+    return dfa;
+}
+inline constexpr punctuator_dfa_t punctuator_dfa = make_punctuator_dfa();
+}
+
+
+// Returns the keyword's token type or `IDENTIFIER` if `text` isn't a keyword.
+constexpr token_type_t classify_identifier(const std::string_view text) {
+    using namespace lexeme_tables_detail;
+    if(text.size() < keyword_hash_table.min_length || text.size() > keyword_hash_table.max_length) {
+        return token_type_t::IDENTIFIER;
+    }
+    const auto& slot = keyword_hash_table.slots[hash_keyword(text, keyword_seed)];
+    return (slot.text == text) ? slot.token_type : token_type_t::IDENTIFIER;
+}
+
+struct punctuator_match_t {
+    token_type_t token_type; // `ERROR` if there is no punctuator at the start of the text
+    std::uint32_t length;
+};
+// Matches the longest punctuator at the start of `[begin, end)`.
+constexpr punctuator_match_t match_punctuator(const char *const begin, const char *const end) {
+    using namespace lexeme_tables_detail;
+    const auto length = (end - begin < static_cast<std::ptrdiff_t>(max_punctuator_length)) ? static_cast<std::uint32_t>(end - begin) : max_punctuator_length;
+    std::uint32_t state = start_state;
+    punctuator_match_t longest_match{token_type_t::ERROR, 0u};
+    for(std::uint32_t i = 0u; i < length; ++i) {
+        state = punctuator_dfa.transitions[state][punctuator_character_classes.character_class[static_cast<std::uint8_t>(begin[i])]];
+        if(state == dead_state) {
+            break;
+        }
+        const token_type_t accept = punctuator_dfa.accepts[state];
+        longest_match = (accept != token_type_t::ERROR) ? punctuator_match_t{accept, i + 1u} : longest_match;
+    }
+    return longest_match;
+}
+
+
+namespace lexeme_tables_detail {
+constexpr bool are_lexemes_unique(const lexeme_t *const table, const std::size_t size) {
+    for(std::size_t i = 0u; i < size; ++i) {
+        for(std::size_t j = i + 1u; j < size; ++j) {
+            if(table[i].text == table[j].text || table[i].token_type == table[j].token_type) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+constexpr bool are_all_keywords_recognized() {
+    for(const auto& keyword : keyword_table) {
+        if(classify_identifier(keyword.text) != keyword.token_type) {
+            return false;
+        }
+    }
+    return true;
+}
+constexpr bool are_all_punctuators_recognized() {
+    for(const auto& punctuator : punctuator_table) {
+        const auto match = match_punctuator(punctuator.text.data(), punctuator.text.data() + punctuator.text.size());
+        if(match.token_type != punctuator.token_type || match.length != punctuator.text.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(are_lexemes_unique(keyword_table, std::size(keyword_table)), "Duplicate keyword in the keyword table.");
+static_assert(are_lexemes_unique(punctuator_table, std::size(punctuator_table)), "Duplicate punctuator in the punctuator table.");
+static_assert(are_all_keywords_recognized(), "Keyword perfect hash does not recognize every keyword.");
+static_assert(are_all_punctuators_recognized(), "Punctuator DFA does not recognize every punctuator.");
+static_assert(classify_identifier("integer") == token_type_t::IDENTIFIER && classify_identifier("i") == token_type_t::IDENTIFIER);
+}
@@ -1,4 +1,6 @@
 #include "lexer.hpp"
+#include "scan_kernels.hpp"
+#include "lexeme_tables.hpp"
 
 
 token_type_t handle_integer_literal_suffix(lexer_t& lexer) {
@@ -68,139 +70,61 @@ token_type_t handle_char(lexer_t& lexer) {
     // first quote is already consumed by caller
     lexer.advance_char();
     if(lexer.advance_char() != '\'') {
-        std::cout << "Missing second quote for char\n";
+        *lexer.debug_output << "Missing second quote for char\n";
         return token_type_t::ERROR;
     }
     return token_type_t::CHAR_CONSTANT;
 }
 
-static token_type_t match_keyword(const lexer_t& lexer, std::uint32_t start_index, std::string_view expected, const token_type_t expected_type) {
-    if(lexer.current_token_str_len() == (start_index + expected.length())
-    && std::memcmp(expected.data(), lexer.start + start_index, expected.length()) == 0) {
-        return expected_type;
-    }
-    return token_type_t::IDENTIFIER;
-}
-
 token_type_t handle_keywords(lexer_t& lexer) {
     if(lexer.current_token_str_len() == 0) {
-        std::cout << "Keyword has string length of 0\n";
+        *lexer.debug_output << "Keyword has string length of 0\n";
         return token_type_t::ERROR;
     }
-
-    switch(lexer.start[0]) {
-        case 'c':
-            return match_keyword(lexer, 1, "har", token_type_t::CHAR_KEYWORD);
-        case 'd':
-            return match_keyword(lexer, 1, "ouble", token_type_t::DOUBLE_KEYWORD);
-        case 'e':
-            return match_keyword(lexer, 1, "lse", token_type_t::ELSE_KEYWORD);
-        case 'f':
-            return match_keyword(lexer, 1, "loat", token_type_t::FLOAT_KEYWORD);
-        case 'i':
-            if(lexer.current_token_str_len() > 1) {
-                switch(lexer.start[1]) {
-                    case 'f':
-                        return match_keyword(lexer, 2, "", token_type_t::IF_KEYWORD);
-                    case 'n':
-                        return match_keyword(lexer, 2, "t", token_type_t::INT_KEYWORD);
-                }
-            }
-            break;
-        case 'l':
-            return match_keyword(lexer, 1, "ong", token_type_t::LONG_KEYWORD);
-        case 'r':
-            return match_keyword(lexer, 1, "eturn", token_type_t::RETURN_KEYWORD);
-        case 's':
-            if(lexer.current_token_str_len() > 1) {
-                switch(lexer.start[1]) {
-                    case 'h':
-                        return match_keyword(lexer, 2, "ort", token_type_t::SHORT_KEYWORD);
-                    case 'i':
-                        return match_keyword(lexer, 2, "gned", token_type_t::SIGNED_KEYWORD);
-                    case 't':
-                        return match_keyword(lexer, 2, "ruct", token_type_t::STRUCT_KEYWORD);
-                }
-            }
-            break;
-        case 't':
-            return match_keyword(lexer, 1, "ypedef", token_type_t::TYPEDEF_KEYWORD);
-        case 'u':
-            return match_keyword(lexer, 1, "nsigned", token_type_t::UNSIGNED_KEYWORD);
-    }
-
-    return token_type_t::IDENTIFIER;
+    return classify_identifier(std::string_view(lexer.start, lexer.current_token_str_len()));
 }
 void handle_whitespace(lexer_t& lexer) {
-    for(;;) {
-        switch(lexer.peek_char()) {
-            case '\n':
-                lexer.incr_line_number();
-                [[fallthrough]];
-            case '\r':
-            case '\t':
-            case ' ':
-                lexer.advance_char();
-                break;
-            default:
-                return;
-        }
-    }
+    lexer.current = skip_whitespace_run(lexer.current, lexer.end);
 }
 
 // this function assumes the opening (/*) of the comment has already been consumed. This consumes the comment text itself and the closing of it
-static void handle_multiline_comment(lexer_t& lexer) {
-    for(;;) {
-        while(lexer.peek_char() != '*' && !lexer.is_eof()) {
-            if(lexer.peek_char() == '\n') {
-                lexer.incr_line_number();
-            }
-            lexer.advance_char();
-        }
-
-        if(lexer.is_eof()) throw std::runtime_error("Unterminated comment");
-        lexer.advance_char(); // consume `*`
-        if(lexer.is_eof()) throw std::runtime_error("Unterminated comment");
-        if(lexer.peek_char() == '/') {
-            lexer.advance_char(); // consume `/`
-            return;
-        }
-
-        // otherwise, we ran into `*`, but not a following `/` and still have text to go, so the comment hasn't ended yet, so keep going
+// returns `false` if the comment is unterminated, in which case everything up to eof is consumed
+static bool handle_multiline_comment(lexer_t& lexer) {
+    const char *const comment_close = find_block_comment_close(lexer.current, lexer.end);
+    if(comment_close == lexer.end) {
+        lexer.current = lexer.end;
+        return false;
     }
+    lexer.current = comment_close + 2; // consume `*/`
+    return true;
 }
 // this function assumes the opening (//) of the comment has already been consumed. This consumes the comment text itself and the closing of it
 static void handle_single_line_comment(lexer_t& lexer) {
-    while(lexer.peek_char() != '\n' && !lexer.is_eof()) {
-        lexer.advance_char();
-    }
+    lexer.current = find_line_end(lexer.current, lexer.end);
 
     if(lexer.is_eof()) return;
 
-    // for `\n`:
-    lexer.advance_char();
-    lexer.incr_line_number();
+    lexer.advance_char(); // for `\n`
 }
 // TODO: clean up this function
-bool handle_comment(lexer_t& lexer) {
+comment_result_t handle_comment(lexer_t& lexer) {
     for(;;) {
         switch(lexer.peek_char()) {
             case '/':
                 if(lexer.peek_char_n(1) == '*') {
                     lexer.advance_char(); // skip over `/` in string
                     lexer.advance_char(); // skip over `*` in string
-                    handle_multiline_comment(lexer);
-                    return true;
+                    return handle_multiline_comment(lexer) ? comment_result_t::COMMENT : comment_result_t::UNTERMINATED_COMMENT;
                 } else if(lexer.peek_char_n(1) == '/') {
                     lexer.advance_char(); // skip over first `/` in string
                     lexer.advance_char(); // skip over second `/` in string
                     handle_single_line_comment(lexer);
-                    return true;
+                    return comment_result_t::COMMENT;
                 }
                 // no characters consumed, leave comment lexer
                 [[fallthrough]];
             default:
-                return false;
+                return comment_result_t::NONE;
         }
     }
 }
@@ -208,13 +132,13 @@ bool handle_comment(lexer_t& lexer) {
 token_t scan_token(lexer_t& lexer) {
     lexer.start = lexer.current; // restart token string for next token
 
-    try {
-        do {
-            handle_whitespace(lexer);
-        } while(handle_comment(lexer));
-    }
-    catch(std::runtime_error &e) {
-        std::cout << "Unterminated comment\n";
+    comment_result_t comment_result;
+    do {
+        handle_whitespace(lexer);
+        comment_result = handle_comment(lexer);
+    } while(comment_result == comment_result_t::COMMENT);
+    if(comment_result == comment_result_t::UNTERMINATED_COMMENT) {
+        *lexer.debug_output << "Unterminated comment\n";
         return lexer.make_token(token_type_t::ERROR); // unterminated multiline comment at eof
     }
 
@@ -241,251 +165,123 @@ token_t scan_token(lexer_t& lexer) {
         return lexer.make_token(handle_char(lexer));
     }
 
-    switch(c) {
-        case '(':
-            return lexer.make_token(token_type_t::LEFT_PAREN);
-        case ')':
-            return lexer.make_token(token_type_t::RIGHT_PAREN);
-        case '{':
-            return lexer.make_token(token_type_t::LEFT_CURLY);
-        case '}':
-            return lexer.make_token(token_type_t::RIGHT_CURLY);
-        case ';':
-            return lexer.make_token(token_type_t::SEMICOLON);
-        case '-':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::MINUS_EQUALS);
-            } else if(lexer.match_char('-')) {
-                return lexer.make_token(token_type_t::DASH_DASH);
-            }
-            return lexer.make_token(token_type_t::DASH);
-        case '~':
-            return lexer.make_token(token_type_t::TILDE);
-        case '!':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::NOT_EQUAL);
-            }
-            return lexer.make_token(token_type_t::BANG);
-        case '+':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::PLUS_EQUALS);
-            } else if(lexer.match_char('+')) {
-                return lexer.make_token(token_type_t::PLUS_PLUS);
-            }
-            return lexer.make_token(token_type_t::PLUS);
-        case '*':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::TIMES_EQUALS);
-            }
-            return lexer.make_token(token_type_t::ASTERISK);
-        case '/':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::DIVIDE_EQUALS);
-            }
-            return lexer.make_token(token_type_t::SLASH);
-        case '&':
-            if(lexer.match_char('&')) {
-                return lexer.make_token(token_type_t::LOGIC_AND);
-            } else if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::AND_EQUALS);
-            }
-            return lexer.make_token(token_type_t::BITWISE_AND);
-        case '|':
-            if(lexer.match_char('|')) {
-                return lexer.make_token(token_type_t::LOGIC_OR);
-            } else if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::OR_EQUALS);
-            }
-            return lexer.make_token(token_type_t::BITWISE_OR);
-        case '<':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::LESS_THAN_EQUAL);
-            } else if(lexer.match_char('<')) {
-                if(lexer.match_char('=')) {
-                    return lexer.make_token(token_type_t::LEFT_SHIFT_EQUALS);
-                }
-                return lexer.make_token(token_type_t::BITWISE_LEFT_SHIFT);
-            }
-            return lexer.make_token(token_type_t::LESS_THAN);
-        case '>':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::GREATER_THAN_EQUAL);
-            } else if(lexer.match_char('>')) {
-                if(lexer.match_char('=')) {
-                    return lexer.make_token(token_type_t::RIGHT_SHIFT_EQUALS);
-                }
-                return lexer.make_token(token_type_t::BITWISE_RIGHT_SHIFT);
-            }
-            return lexer.make_token(token_type_t::GREATER_THAN);
-        case '=':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::EQUAL_EQUAL);
-            }
-            return lexer.make_token(token_type_t::EQUALS);
-        case '%':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::MODULO_EQUALS);
-            }
-            return lexer.make_token(token_type_t::MODULO);
-        case '^':
-            if(lexer.match_char('=')) {
-                return lexer.make_token(token_type_t::XOR_EQUALS);
-            }
-            return lexer.make_token(token_type_t::BITWISE_XOR);
-        case ',':
-            return lexer.make_token(token_type_t::COMMA);
-        case '?':
-            return lexer.make_token(token_type_t::QUESTION_MARK);
-        case ':':
-            return lexer.make_token(token_type_t::COLON);
-        case '.':
-            return lexer.make_token(token_type_t::DOT);
+    const punctuator_match_t punctuator = match_punctuator(lexer.start, lexer.end);
+    if(punctuator.token_type != token_type_t::ERROR) {
+        lexer.current = lexer.start + punctuator.length;
+        return lexer.make_token(punctuator.token_type);
     }
 
-    std::cout << "Unrecognized token: '" << c << "'\n";
+    *lexer.debug_output << "Unrecognized token: '" << c << "'\n";
     return lexer.make_token(token_type_t::ERROR);
 }
-// TODO: Double check that `merge_tokens` is correct and test it thoroughly
-std::vector<token_t> merge_tokens(const std::vector<token_t>& tokens) {
-    std::vector<token_t> result;
-    result.reserve(tokens.size());
 
-    for(std::uint32_t i = 0; ;) {
-        if(i >= tokens.size()) {
-            break;
+
+// The type specifier keywords seen so far in a run of them, e.g. `unsigned long long int`.
+// C allows them in any order (`long unsigned int` is `unsigned long int`), so only how many of each keyword there are matters, not their order.
+struct type_specifiers_t {
+    std::uint8_t signed_count = 0u;
+    std::uint8_t unsigned_count = 0u;
+    std::uint8_t char_count = 0u;
+    std::uint8_t short_count = 0u;
+    std::uint8_t int_count = 0u;
+    std::uint8_t long_count = 0u;
+    std::uint8_t float_count = 0u;
+    std::uint8_t double_count = 0u;
+
+    // Adds the keyword to the run. Returns `false` and leaves the run unchanged if `token_type` isn't a type specifier keyword or if it can't be combined with
+    //  the keywords already in the run (e.g. `long char`), in which case it is left to start the next token.
+    bool add(const token_type_t token_type) {
+        type_specifiers_t next = *this;
+        switch(token_type) {
+            case token_type_t::SIGNED_KEYWORD: ++next.signed_count; break;
+            case token_type_t::UNSIGNED_KEYWORD: ++next.unsigned_count; break;
+            case token_type_t::CHAR_KEYWORD: ++next.char_count; break;
+            case token_type_t::SHORT_KEYWORD: ++next.short_count; break;
+            case token_type_t::INT_KEYWORD: ++next.int_count; break;
+            case token_type_t::LONG_KEYWORD: ++next.long_count; break;
+            case token_type_t::FLOAT_KEYWORD: ++next.float_count; break;
+            case token_type_t::DOUBLE_KEYWORD: ++next.double_count; break;
+            default: return false;
         }
-        const auto token = tokens.at(i);
-        // TODO: Remove a bunch of code duplication and clean this up
-        if(token.token_type == token_type_t::UNSIGNED_KEYWORD) {
-            if((++i) >= tokens.size()) {
-                result.push_back(token_t{token_type_t::UNSIGNED_INT_KEYWORD, "unsigned int", token.line_number});
-            }
-            const auto token_2 = tokens.at(i);
-            if(token_2.token_type == token_type_t::INT_KEYWORD) {
-                ++i;
-                result.push_back(token_t{token_type_t::UNSIGNED_INT_KEYWORD, "unsigned int", token.line_number});
-            } else if(token_2.token_type ==  token_type_t::LONG_KEYWORD) {
-                if((++i) >= tokens.size()) {
-                    result.push_back(token_t{token_type_t::UNSIGNED_LONG_KEYWORD, "unsigned long", token.line_number});
-                }
-                const auto token_3 = tokens.at(i);
-                if(token_3.token_type == token_type_t::LONG_KEYWORD) {
-                    if((++i) >= tokens.size()) {
-                        result.push_back(token_t{token_type_t::UNSIGNED_LONG_LONG_KEYWORD, "unsigned long long", token.line_number});
-                    }
-                    const auto token_4 = tokens.at(i);
-                    if(token_4.token_type == token_type_t::INT_KEYWORD) {
-                        ++i;
-                    }
-                    result.push_back(token_t{token_type_t::UNSIGNED_LONG_LONG_KEYWORD, "unsigned long long", token.line_number});
-                } else if(token_3.token_type == token_type_t::INT_KEYWORD) {
-                    ++i;
-                    result.push_back(token_t{token_type_t::UNSIGNED_LONG_KEYWORD, "unsigned long", token.line_number});
-                } else {
-                    result.push_back(token_t{token_type_t::UNSIGNED_LONG_KEYWORD, "unsigned long", token.line_number});
-                }
-            } else if(token_2.token_type == token_type_t::CHAR_KEYWORD) {
-                ++i;
-                result.push_back(token_t{token_type_t::UNSIGNED_CHAR_KEYWORD, "unsigned char", token.line_number});
-            } else if(token_2.token_type == token_type_t::SHORT_KEYWORD) {
-                if((++i) >= tokens.size()) {
-                    result.push_back(token_t{token_type_t::UNSIGNED_SHORT_KEYWORD, "unsigned short", token.line_number});
-                }
-                const auto token_3 = tokens.at(i);
-                if(token_3.token_type == token_type_t::INT_KEYWORD) {
-                    ++i;
-                }
-                result.push_back(token_t{token_type_t::UNSIGNED_SHORT_KEYWORD, "unsigned short", token.line_number});
-            } else {
-                result.push_back(token_t{token_type_t::UNSIGNED_INT_KEYWORD, "unsigned int", token.line_number});
-            }
-        } else if(token.token_type == token_type_t::LONG_KEYWORD) {
-            if((++i) >= tokens.size()) {
-                result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-            }
-            const auto token_2 = tokens.at(i);
-            if(token_2.token_type == token_type_t::LONG_KEYWORD) {
-                if((++i) >= tokens.size()) {
-                    result.push_back(token_t{token_type_t::LONG_LONG_KEYWORD, "long long", token.line_number});
-                }
-                const auto token_3 = tokens.at(i);
-                if(token_3.token_type == token_type_t::INT_KEYWORD) {
-                    ++i;
-                }
-                result.push_back(token_t{token_type_t::LONG_LONG_KEYWORD, "long long", token.line_number});
-            } else if(token_2.token_type == token_type_t::INT_KEYWORD) {
-                ++i;
-                result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-            } else {
-                result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-            }
-        } else if(token.token_type == token_type_t::SHORT_KEYWORD) {
-            if((++i) >= tokens.size()) {
-                result.push_back(token_t{token_type_t::SHORT_KEYWORD, "short", token.line_number});
-            }
-            const auto token_2 = tokens.at(i);
-            if(token_2.token_type == token_type_t::INT_KEYWORD) {
-                ++i;
-            }
-            result.push_back(token_t{token_type_t::SHORT_KEYWORD, "short", token.line_number});
-        } else if(token.token_type == token_type_t::SIGNED_KEYWORD) {
-            if((++i) >= tokens.size()) {
-                result.push_back(token_t{token_type_t::INT_KEYWORD, "int", token.line_number});
-            }
-            const auto token_2 = tokens.at(i);
-            if(token_2.token_type == token_type_t::CHAR_KEYWORD) {
-                ++i;
-                result.push_back(token_t{token_type_t::SIGNED_KEYWORD, "signed char", token.line_number});
-            } else if(token_2.token_type == token_type_t::SHORT_KEYWORD) {
-                if((++i) >= tokens.size()) {
-                    result.push_back(token_t{token_type_t::SHORT_KEYWORD, "short", token.line_number});
-                }
-                const auto token_3 = tokens.at(i);
-                if(token_3.token_type == token_type_t::INT_KEYWORD) {
-                    ++i;
-                }
-                result.push_back(token_t{token_type_t::SHORT_KEYWORD, "short", token.line_number});
-            } else if(token_2.token_type == token_type_t::INT_KEYWORD) {
-                ++i;
-                result.push_back(token_t{token_type_t::INT_KEYWORD, "int", token.line_number});
-            } else if(token_2.token_type == token_type_t::LONG_KEYWORD) {
-                if((++i) >= tokens.size()) {
-                    result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-                }
-                const auto token_3 = tokens.at(i);
-                if(token_3.token_type == token_type_t::LONG_KEYWORD) {
-                    if((++i) >= tokens.size()) {
-                        result.push_back(token_t{token_type_t::LONG_LONG_KEYWORD, "long long", token.line_number});
-                    }
-                    const auto token_4 = tokens.at(i);
-                    if(token_4.token_type == token_type_t::INT_KEYWORD) {
-                        ++i;
-                    }
-                    result.push_back(token_t{token_type_t::LONG_LONG_KEYWORD, "long long", token.line_number});
-                } else if(token_3.token_type == token_type_t::INT_KEYWORD) {
-                    ++i;
-                    result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-                } else {
-                    result.push_back(token_t{token_type_t::LONG_KEYWORD, "long", token.line_number});
-                }
-            } else {
-                result.push_back(token_t{token_type_t::INT_KEYWORD, "int", token.line_number});
-            }
-        } else {
-            ++i;
-            result.push_back(token);
+        if(!next.is_valid()) {
+            return false;
         }
+        *this = next;
+        return true;
     }
-    return result;
-}
-std::vector<token_t> scan_all_tokens(lexer_t& lexer) {
-    std::vector<token_t> initial_tokens;
-    for(;;) {
-        const auto token = scan_token(lexer);
-        initial_tokens.push_back(token);
-        if(token.token_type == token_type_t::EOF_TOK) {
-            break;
+
+    // Whether the keywords are (a part of) a valid type, i.e. whether more keywords could still be added to make them valid.
+    // Every part of a valid combination is itself a valid combination, so this is also whether `merged_token_type()` is meaningful.
+    bool is_valid() const {
+        if(signed_count + unsigned_count > 1u || char_count > 1u || short_count > 1u || int_count > 1u || long_count > 2u || float_count > 1u || double_count > 1u) {
+            return false;
+        }
+        if(char_count != 0u) {
+            return short_count == 0u && int_count == 0u && long_count == 0u && float_count == 0u && double_count == 0u;
+        }
+        if(short_count != 0u) {
+            return long_count == 0u && float_count == 0u && double_count == 0u;
+        }
+        if(float_count != 0u) {
+            return signed_count == 0u && unsigned_count == 0u && int_count == 0u && long_count == 0u && double_count == 0u;
+        }
+        if(double_count != 0u) {
+            return signed_count == 0u && unsigned_count == 0u && int_count == 0u && long_count <= 1u;
+        }
+        return true;
+    }
+
+    token_type_t merged_token_type() const {
+        const bool is_unsigned = unsigned_count != 0u;
+        if(float_count != 0u) {
+            return token_type_t::FLOAT_KEYWORD;
+        } else if(double_count != 0u) {
+            return (long_count != 0u) ? token_type_t::LONG_DOUBLE_KEYWORD : token_type_t::DOUBLE_KEYWORD;
+        } else if(char_count != 0u) {
+            return is_unsigned ? token_type_t::UNSIGNED_CHAR_KEYWORD : ((signed_count != 0u) ? token_type_t::SIGNED_CHAR_KEYWORD : token_type_t::CHAR_KEYWORD);
+        } else if(short_count != 0u) {
+            return is_unsigned ? token_type_t::UNSIGNED_SHORT_KEYWORD : token_type_t::SHORT_KEYWORD;
+        } else if(long_count == 2u) {
+            return is_unsigned ? token_type_t::UNSIGNED_LONG_LONG_KEYWORD : token_type_t::LONG_LONG_KEYWORD;
+        } else if(long_count == 1u) {
+            return is_unsigned ? token_type_t::UNSIGNED_LONG_KEYWORD : token_type_t::LONG_KEYWORD;
         }
+        return is_unsigned ? token_type_t::UNSIGNED_INT_KEYWORD : token_type_t::INT_KEYWORD; // `int`, `signed` and `unsigned` on their own
+    }
+};
+
+// Consumes the next token if it is a type specifier keyword that can be added to `specifiers`. Otherwise, leaves `lexer` as it was without scanning the token,
+//  so that it is scanned (and any errors in it are reported) only once, as the next token.
+static bool scan_next_type_specifier(lexer_t& lexer, type_specifiers_t& specifiers) {
+    lexer_t next_lexer = lexer;
+    comment_result_t comment_result;
+    do {
+        handle_whitespace(next_lexer);
+        comment_result = handle_comment(next_lexer);
+    } while(comment_result == comment_result_t::COMMENT);
+    if(comment_result == comment_result_t::UNTERMINATED_COMMENT) {
+        return false; // which the next token reports
+    }
+    next_lexer.start = next_lexer.current;
+    if(!utils::is_alpha(next_lexer.peek_char())) {
+        return false;
     }
-    return merge_tokens(initial_tokens);
+    next_lexer.advance_char();
+    if(!specifiers.add(handle_identifier(next_lexer))) {
+        return false;
+    }
+    lexer = next_lexer;
+    return true;
+}
+
+token_t scan_merged_token(lexer_t& lexer) {
+    const token_t first_token = scan_token(lexer);
+    type_specifiers_t specifiers;
+    if(!specifiers.add(first_token.token_type)) {
+        return first_token;
+    }
+    while(scan_next_type_specifier(lexer, specifiers));
+
+    const char *const run_start = first_token.token_text.data();
+    return token_t{specifiers.merged_token_type(), {run_start, static_cast<std::size_t>(lexer.current - run_start)}};
 }
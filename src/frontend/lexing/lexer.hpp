@@ -12,8 +12,7 @@
 #include <iostream>
 
 
-// TODO: add support for `short` and `signed` keywords for integer types
-enum class token_type_t : std::uint32_t {
+enum class token_type_t : std::uint8_t {
     // single character lexemes:
     LEFT_PAREN = 0, RIGHT_PAREN,
     LEFT_CURLY, RIGHT_CURLY,
@@ -67,46 +66,44 @@ enum class token_type_t : std::uint32_t {
 struct token_t {
     token_type_t token_type;
     std::string_view token_text;
-    utils::line_number_t line_number;
 
 
     token_t() = delete;
 
-    token_t(token_type_t token_type, std::string_view token_text, utils::line_number_t line_number) :
+    token_t(token_type_t token_type, std::string_view token_text) :
         token_type(token_type),
-        token_text(token_text),
-        line_number(line_number)
+        token_text(token_text)
     {}
 };
 
 struct lexer_t {
     const char* start; // start character of current token being lexed
     const char* current; // current character being lexed of the current token being lexed
-    utils::line_number_t current_line_number;
+    const char* end; // one past the last character of the text being lexed. The text is NOT required to be null terminated.
+    std::ostream* debug_output = &std::cout; // where lexing errors are printed
 
 
     lexer_t() = delete;
 
-    // `text` is the text to be lexed
-    lexer_t(const char *const text) :
-        start(text),
-        current(text),
-        current_line_number(1)
+    // `[begin, end)` is the text to be lexed
+    lexer_t(const char *const begin, const char *const end) :
+        start(begin),
+        current(begin),
+        end(end)
     {}
+    lexer_t(const std::string_view text) : lexer_t(text.data(), text.data() + text.size()) {}
 
-    // TODO: We should detect eof by using the length of the file we load instead of checking for a null terminator
     bool is_eof() const {
-        return *current == '\0';
+        return current >= end;
     }
     // `is_eof()` == `is_eof_n(0)`
     bool is_eof_n(const std::uint32_t n) const {
-        for(std::uint32_t i = 0; i < n; ++i) {
-            if (current[i] == '\0') return true;
-        }
-        return false;
+        return static_cast<std::size_t>(end - current) <= n;
     }
 
     char peek_char() const {
+        if(is_eof()) return '\0';
+
         return *current;
     }
     // `peek_char()` == `peek_char_n(0)`
@@ -123,7 +120,7 @@ struct lexer_t {
     }
     // `advance_char()` == `advance_char_n(1)`
     void advance_char_n(const std::uint32_t n) {
-        current += n;
+        current = is_eof_n(n) ? end : (current + n);
     }
 
     std::uint32_t current_token_str_len() const {
@@ -139,17 +136,13 @@ struct lexer_t {
         return true;
     }
 
-    void incr_line_number() {
-        ++current_line_number;
-    }
-
 
     // factory to use once token string is lexed
     token_t make_token(token_type_t token_type) const {
         if(token_type == token_type_t::ERROR) {
-            std::cout << "Error token emited\n";
+            *debug_output << "Error token emited\n";
         }
-        return token_t{token_type, {start, current_token_str_len()}, current_line_number};
+        return token_t{token_type, {start, current_token_str_len()}};
     }
 };
 
@@ -159,9 +152,15 @@ token_type_t handle_identifier(lexer_t& lexer);
 token_type_t handle_char(lexer_t& lexer);
 token_type_t handle_keywords(lexer_t& lexer);
 void handle_whitespace(lexer_t& lexer);
-// return `true` if comment is lexed, `false` otherwise
-bool handle_comment(lexer_t& lexer);
+enum class comment_result_t : std::uint8_t {
+    NONE, // no comment, nothing is consumed
+    COMMENT,
+    UNTERMINATED_COMMENT, // a `/*` without a `*/`, the rest of the input is consumed
+};
+// lexes a single comment, if there is one
+comment_result_t handle_comment(lexer_t& lexer);
 
 token_t scan_token(lexer_t& lexer);
-std::vector<token_t> merge_tokens(const std::vector<token_t>& tokens);
-std::vector<token_t> scan_all_tokens(lexer_t& lexer); // internally calls `merge_tokens()`
+// `scan_token()`, but a run of type specifier keywords (in any order, e.g. `long unsigned int`) is merged into the single keyword token of the type it spells out
+//  (e.g. `UNSIGNED_LONG_KEYWORD`) as it is scanned. The merged token's text spans all of the keywords in the run.
+token_t scan_merged_token(lexer_t& lexer);
@@ -0,0 +1,118 @@
+#include "parallel_lexer.hpp"
+#include "lexer.hpp"
+#include "token_stream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <vector>
+
+
+namespace {
+constexpr std::uint32_t reached_eof = ~0u;
+
+struct chunk_tokens_t {
+    token_table_t tokens;
+    std::uint32_t resume_offset; // offset of the first token after the chunk, `reached_eof` if `tokens` ends with `EOF_TOK`
+};
+
+// Lexes the tokens that start in `[chunk_begin, source + chunk_end_offset)`. The last token may run past the end of the chunk.
+chunk_tokens_t scan_chunk(const char *const source, const char *const chunk_begin, const std::uint32_t chunk_end_offset, const char *const end) {
+    token_stream_t token_stream(lexer_t(chunk_begin, end));
+    const auto base_offset = static_cast<std::uint32_t>(chunk_begin - source);
+
+    chunk_tokens_t chunk{token_table_t(source), reached_eof};
+    for(;;) {
+        const token_index_t token = token_stream.peek_token();
+        const token_type_t token_type = token_stream.token_type(token);
+        const std::uint32_t offset = base_offset + token_stream.token_offset(token);
+        if(offset >= chunk_end_offset && token_type != token_type_t::EOF_TOK) {
+            chunk.resume_offset = offset;
+            return chunk;
+        }
+        chunk.tokens.push_back(token_type, offset, static_cast<std::uint32_t>(token_stream.token_text(token).size()));
+        if(token_type == token_type_t::EOF_TOK) {
+            return chunk;
+        }
+        token_stream.advance_token();
+    }
+}
+
+// Returns the index of the token starting at `offset` in `tokens` or `tokens.size()` if there is none.
+token_index_t find_token_at_offset(const token_table_t& tokens, const std::uint32_t offset) {
+    token_index_t low = 0u;
+    token_index_t high = tokens.size();
+    while(low < high) { // offsets are sorted
+        const token_index_t middle = low + (high - low) / 2u;
+        if(tokens.offset(middle) < offset) {
+            low = middle + 1u;
+        } else {
+            high = middle;
+        }
+    }
+    return (low < tokens.size() && tokens.offset(low) == offset) ? low : tokens.size();
+}
+
+// Splits `[begin, end)` into `chunk_count` roughly equal chunks, each starting just after a newline. Returns the end offset of each chunk.
+std::vector<std::uint32_t> find_chunk_ends(const char *const begin, const char *const end, const std::uint32_t chunk_count) {
+    const auto length = static_cast<std::uint32_t>(end - begin);
+    std::vector<std::uint32_t> chunk_ends;
+    std::uint32_t previous_chunk_end = 0u;
+    for(std::uint32_t i = 1u; i < chunk_count; ++i) {
+        const std::uint32_t target = std::max(previous_chunk_end, static_cast<std::uint32_t>((static_cast<std::uint64_t>(length) * i) / chunk_count));
+        const void *const newline = std::memchr(begin + target, '\n', length - target);
+        if(newline == nullptr) {
+            break;
+        }
+        previous_chunk_end = static_cast<std::uint32_t>(static_cast<const char*>(newline) - begin) + 1u;
+        chunk_ends.push_back(previous_chunk_end);
+    }
+    chunk_ends.push_back(length);
+    chunk_ends.erase(std::unique(std::begin(chunk_ends), std::end(chunk_ends)), std::end(chunk_ends));
+    return chunk_ends;
+}
+}
+
+
+token_table_t scan_all_tokens_parallel(const char *const begin, const char *const end, utils::thread_pool_t& thread_pool) {
+    const auto length = static_cast<std::size_t>(end - begin);
+    // a couple of chunks per thread so that one slow chunk doesn't hold everything up
+    const auto chunk_count = static_cast<std::uint32_t>(std::min<std::size_t>(thread_pool.thread_count() * 2u, length / min_parallel_lexing_chunk_size));
+    if(chunk_count <= 1u) {
+        return scan_all_tokens(lexer_t(begin, end));
+    }
+
+    const std::vector<std::uint32_t> chunk_ends = find_chunk_ends(begin, end, chunk_count);
+    std::vector<std::future<chunk_tokens_t>> chunks;
+    chunks.reserve(chunk_ends.size());
+    for(std::size_t i = 0u; i < chunk_ends.size(); ++i) {
+        const char *const chunk_begin = begin + ((i == 0u) ? 0u : chunk_ends[i - 1u]);
+        const std::uint32_t chunk_end_offset = chunk_ends[i];
+        chunks.push_back(thread_pool.submit([begin, chunk_begin, chunk_end_offset, end]() { return scan_chunk(begin, chunk_begin, chunk_end_offset, end); }));
+    }
+
+    token_table_t tokens(begin);
+    std::uint32_t resume_offset = 0u; // offset of the next token, as lexed by the previous chunks
+    for(std::size_t i = 0u; i < chunks.size(); ++i) {
+        const chunk_tokens_t chunk = chunks[i].get();
+        if(i == 0u) { // the first chunk really does start at the start of a token
+            tokens.append(chunk.tokens, 0u);
+            resume_offset = chunk.resume_offset;
+            continue;
+        }
+        if(resume_offset == reached_eof || resume_offset >= chunk_ends[i]) {
+            continue; // the previous chunks' tokens already cover this whole chunk (e.g. it is inside of a block comment)
+        }
+
+        const token_index_t resume_token = find_token_at_offset(chunk.tokens, resume_offset);
+        if(resume_token != chunk.tokens.size()) {
+            tokens.append(chunk.tokens, resume_token);
+            resume_offset = chunk.resume_offset;
+        } else { // mispeculated, relex from the first token we know is right
+            const chunk_tokens_t relexed_chunk = scan_chunk(begin, begin + resume_offset, chunk_ends[i], end);
+            tokens.append(relexed_chunk.tokens, 0u);
+            resume_offset = relexed_chunk.resume_offset;
+        }
+    }
+    return tokens;
+}
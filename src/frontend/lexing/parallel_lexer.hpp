@@ -0,0 +1,21 @@
+#pragma once
+
+
+#include <cstdint>
+
+#include <frontend/lexing/token_table.hpp>
+#include <utils/thread_pool.hpp>
+
+
+// Lexes large texts in chunks on a thread pool.
+// The text is split into chunks just after newlines, and every chunk is lexed speculatively as if it started outside of a comment at the start of a token.
+// When the chunks are stitched back together, each chunk's tokens are only used from the token where the previous chunk's lexing actually resumes.
+// If the speculation was wrong (e.g. the chunk started in the middle of a block comment) and there is no such token, the chunk is relexed serially from there.
+// Since lexing from the start of a token doesn't depend on anything before it, the result is token for token identical to `scan_all_tokens()`.
+// Token positions are offsets into the whole text, so nothing has to be fixed up when stitching.
+
+// texts smaller than this are lexed serially, and chunks are never smaller than this
+inline constexpr std::uint32_t min_parallel_lexing_chunk_size = 64u * 1024u;
+
+// Lexes `[begin, end)` on `thread_pool`. Returns the same tokens as `scan_all_tokens(lexer_t(begin, end))`.
+token_table_t scan_all_tokens_parallel(const char* begin, const char* end, utils::thread_pool_t& thread_pool);
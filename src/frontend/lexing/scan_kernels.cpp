@@ -0,0 +1,222 @@
+#include "scan_kernels.hpp"
+
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FOO_CC_HAS_X86_SCAN_KERNELS 1
+#include <immintrin.h>
+#endif
+
+
+static bool is_whitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static const char* skip_whitespace_run_scalar(const char* current, const char *const end) {
+    for(; current != end && is_whitespace(*current); ++current);
+    return current;
+}
+static const char* find_block_comment_close_scalar(const char* current, const char *const end) {
+    for(; current != end; ++current) {
+        if(*current == '*' && (current + 1) != end && current[1] == '/') {
+            return current;
+        }
+    }
+    return end;
+}
+static const char* find_line_end_scalar(const char* current, const char *const end) {
+    for(; current != end && *current != '\n'; ++current);
+    return current;
+}
+static void find_line_starts_scalar(const char *const begin, const char* current, const char *const end, std::vector<std::uint32_t>& line_starts) {
+    for(; current != end; ++current) {
+        if(*current == '\n') {
+            line_starts.push_back(static_cast<std::uint32_t>(current + 1 - begin));
+        }
+    }
+}
+
+
+#ifdef FOO_CC_HAS_X86_SCAN_KERNELS
+static const char* skip_whitespace_run_sse2(const char* current, const char *const end) {
+    const __m128i spaces = _mm_set1_epi8(' ');
+    const __m128i tabs = _mm_set1_epi8('\t');
+    const __m128i carriage_returns = _mm_set1_epi8('\r');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while(end - current >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        const __m128i is_newline = _mm_cmpeq_epi8(chunk, newlines);
+        const __m128i is_whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, spaces), _mm_cmpeq_epi8(chunk, tabs)), _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage_returns), is_newline));
+        const auto non_whitespace_mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(is_whitespace)) & 0xFFFFu;
+        if(non_whitespace_mask != 0u) {
+            return current + __builtin_ctz(non_whitespace_mask);
+        }
+        current += 16;
+    }
+    return skip_whitespace_run_scalar(current, end);
+}
+static const char* find_block_comment_close_sse2(const char* current, const char *const end) {
+    const __m128i stars = _mm_set1_epi8('*');
+    const __m128i slashes = _mm_set1_epi8('/');
+    while(end - current >= 17) { // the extra byte is for the `/` following a `*` in the last lane
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        const __m128i next_chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + 1));
+        const auto close_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(chunk, stars), _mm_cmpeq_epi8(next_chunk, slashes))));
+        if(close_mask != 0u) {
+            return current + __builtin_ctz(close_mask);
+        }
+        current += 16;
+    }
+    return find_block_comment_close_scalar(current, end);
+}
+static const char* find_line_end_sse2(const char* current, const char *const end) {
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while(end - current >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        const auto newline_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newlines)));
+        if(newline_mask != 0u) {
+            return current + __builtin_ctz(newline_mask);
+        }
+        current += 16;
+    }
+    return find_line_end_scalar(current, end);
+}
+static void find_line_starts_sse2(const char *const begin, const char* current, const char *const end, std::vector<std::uint32_t>& line_starts) {
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while(end - current >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        auto newline_mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newlines)));
+        for(; newline_mask != 0u; newline_mask &= newline_mask - 1u) { // clears the lowest set bit
+            line_starts.push_back(static_cast<std::uint32_t>(current + __builtin_ctz(newline_mask) + 1 - begin));
+        }
+        current += 16;
+    }
+    find_line_starts_scalar(begin, current, end, line_starts);
+}
+
+__attribute__((target("avx2,bmi")))
+static const char* skip_whitespace_run_avx2(const char* current, const char *const end) {
+    const __m256i spaces = _mm256_set1_epi8(' ');
+    const __m256i tabs = _mm256_set1_epi8('\t');
+    const __m256i carriage_returns = _mm256_set1_epi8('\r');
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    while(end - current >= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+        const __m256i is_newline = _mm256_cmpeq_epi8(chunk, newlines);
+        const __m256i is_whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaces), _mm256_cmpeq_epi8(chunk, tabs)), _mm256_or_si256(_mm256_cmpeq_epi8(chunk, carriage_returns), is_newline));
+        const auto non_whitespace_mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_whitespace));
+        if(non_whitespace_mask != 0u) {
+            return current + __builtin_ctz(non_whitespace_mask);
+        }
+        current += 32;
+    }
+    return skip_whitespace_run_sse2(current, end);
+}
+__attribute__((target("avx2,bmi")))
+static const char* find_block_comment_close_avx2(const char* current, const char *const end) {
+    const __m256i stars = _mm256_set1_epi8('*');
+    const __m256i slashes = _mm256_set1_epi8('/');
+    while(end - current >= 33) { // the extra byte is for the `/` following a `*` in the last lane
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+        const __m256i next_chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + 1));
+        const auto close_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(chunk, stars), _mm256_cmpeq_epi8(next_chunk, slashes))));
+        if(close_mask != 0u) {
+            return current + __builtin_ctz(close_mask);
+        }
+        current += 32;
+    }
+    return find_block_comment_close_sse2(current, end);
+}
+__attribute__((target("avx2,bmi")))
+static const char* find_line_end_avx2(const char* current, const char *const end) {
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    while(end - current >= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+        const auto newline_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newlines)));
+        if(newline_mask != 0u) {
+            return current + __builtin_ctz(newline_mask);
+        }
+        current += 32;
+    }
+    return find_line_end_sse2(current, end);
+}
+__attribute__((target("avx2,bmi")))
+static void find_line_starts_avx2(const char *const begin, const char* current, const char *const end, std::vector<std::uint32_t>& line_starts) {
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    while(end - current >= 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current));
+        auto newline_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newlines)));
+        for(; newline_mask != 0u; newline_mask &= newline_mask - 1u) { // clears the lowest set bit
+            line_starts.push_back(static_cast<std::uint32_t>(current + __builtin_ctz(newline_mask) + 1 - begin));
+        }
+        current += 32;
+    }
+    find_line_starts_sse2(begin, current, end, line_starts);
+}
+#endif
+
+
+namespace {
+struct scan_kernels_t {
+    scan_implementation_t implementation;
+    const char* (*skip_whitespace_run)(const char*, const char*);
+    const char* (*find_block_comment_close)(const char*, const char*);
+    const char* (*find_line_end)(const char*, const char*);
+    void (*find_line_starts)(const char*, const char*, const char*, std::vector<std::uint32_t>&);
+};
+
+scan_kernels_t get_scan_kernels(const scan_implementation_t implementation) {
+    switch(implementation) {
+        case scan_implementation_t::SCALAR:
+            return {implementation, &skip_whitespace_run_scalar, &find_block_comment_close_scalar, &find_line_end_scalar, &find_line_starts_scalar};
+#ifdef FOO_CC_HAS_X86_SCAN_KERNELS
+        case scan_implementation_t::SSE2:
+            return {implementation, &skip_whitespace_run_sse2, &find_block_comment_close_sse2, &find_line_end_sse2, &find_line_starts_sse2};
+        case scan_implementation_t::AVX2:
+            return {implementation, &skip_whitespace_run_avx2, &find_block_comment_close_avx2, &find_line_end_avx2, &find_line_starts_avx2};
+#endif
+    }
+    throw std::logic_error("Scan implementation not compiled in.");
+}
+scan_implementation_t detect_best_scan_implementation() {
+#ifdef FOO_CC_HAS_X86_SCAN_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi")) {
+        return scan_implementation_t::AVX2;
+    }
+    return scan_implementation_t::SSE2; // SSE2 is part of the x86_64 baseline
+#else
+    return scan_implementation_t::SCALAR;
+#endif
+}
+
+// selected once at startup, only changed afterwards through `set_scan_implementation()`
+scan_kernels_t active_scan_kernels = get_scan_kernels(detect_best_scan_implementation());
+}
+
+
+bool is_scan_implementation_supported(const scan_implementation_t implementation) {
+    return static_cast<std::uint8_t>(implementation) <= static_cast<std::uint8_t>(detect_best_scan_implementation());
+}
+scan_implementation_t get_scan_implementation() {
+    return active_scan_kernels.implementation;
+}
+void set_scan_implementation(const scan_implementation_t implementation) {
+    if(!is_scan_implementation_supported(implementation)) {
+        throw std::runtime_error("Scan implementation not supported on this CPU.");
+    }
+    active_scan_kernels = get_scan_kernels(implementation);
+}
+
+const char* skip_whitespace_run(const char *const begin, const char *const end) {
+    return active_scan_kernels.skip_whitespace_run(begin, end);
+}
+const char* find_block_comment_close(const char *const begin, const char *const end) {
+    return active_scan_kernels.find_block_comment_close(begin, end);
+}
+const char* find_line_end(const char *const begin, const char *const end) {
+    return active_scan_kernels.find_line_end(begin, end);
+}
+void find_line_starts(const char *const begin, const char *const end, std::vector<std::uint32_t>& line_starts) {
+    active_scan_kernels.find_line_starts(begin, begin, end, line_starts);
+}
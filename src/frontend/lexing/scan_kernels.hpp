@@ -0,0 +1,33 @@
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+#include <utils/common.hpp>
+
+
+// Bulk character scanning used by the lexer to skip over whitespace and comments without going through `lexer_t::advance_char()` one byte at a time.
+// Each kernel has a scalar version plus SSE2 (16 bytes per step) and AVX2 (32 bytes per step) versions for x86_64. The fastest one the CPU supports is picked at
+//  startup, but any supported implementation can be forced with `set_scan_implementation()` (e.g. for testing the SIMD versions against the scalar version).
+// All kernels only ever read inside `[begin, end)`, so they are safe to run right up to the end of a memory mapped file.
+
+enum class scan_implementation_t : std::uint8_t {
+    SCALAR = 0,
+    SSE2,
+    AVX2,
+};
+
+bool is_scan_implementation_supported(scan_implementation_t implementation);
+scan_implementation_t get_scan_implementation();
+// throws `std::runtime_error` if the CPU does not support `implementation`
+void set_scan_implementation(scan_implementation_t implementation);
+
+// Returns the first character in `[begin, end)` that isn't ` `, `\t`, `\r` or `\n` (or `end` if there is none).
+const char* skip_whitespace_run(const char* begin, const char* end);
+// Returns a pointer to the `*` of the first `*/` in `[begin, end)` (or `end` if there is none).
+const char* find_block_comment_close(const char* begin, const char* end);
+// Returns a pointer to the first `\n` in `[begin, end)` (or `end` if there is none).
+const char* find_line_end(const char* begin, const char* end);
+// Appends the offset (from `begin`) of the character after every `\n` in `[begin, end)`, i.e. the start of every line but the first, to `line_starts`.
+void find_line_starts(const char* begin, const char* end, std::vector<std::uint32_t>& line_starts);
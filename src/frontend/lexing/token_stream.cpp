@@ -0,0 +1,62 @@
+#include "token_stream.hpp"
+
+#include <stdexcept>
+
+
+void token_stream_t::scan_next_token() const {
+    const token_t token = scan_merged_token(lexer); // the lexer keeps returning `EOF_TOK` once it is out of text
+    const auto offset = static_cast<std::uint32_t>(token.token_text.data() - source);
+    const auto length = static_cast<std::uint32_t>(token.token_text.size());
+
+    const auto slot = scanned_count & (window_size - 1u);
+    window_types[slot] = token.token_type;
+    window_offsets[slot] = offset;
+    window_lengths[slot] = length;
+    window_symbols[slot] = (token.token_type == token_type_t::IDENTIFIER) ? utils::intern(token.token_text) : utils::symbol_t{};
+    ++scanned_count;
+}
+
+std::uint32_t token_stream_t::get_window_slot(const token_index_t token) const {
+    if(token >= scanned_count || token + max_lookbehind < current_token) {
+        throw std::logic_error("Invalid token index. Out of bounds of the token stream's window.");
+    }
+    return token & (window_size - 1u);
+}
+
+token_index_t token_stream_t::peek_token_n(const std::uint32_t lookahead) const {
+    if(lookahead >= max_lookahead) {
+        throw std::logic_error("Invalid lookahead. Out of bounds of the token stream's lookahead window.");
+    }
+    while(scanned_count <= current_token + lookahead) {
+        scan_next_token();
+    }
+    return current_token + lookahead;
+}
+
+token_index_t token_stream_t::peek_back_n(const std::uint32_t lookbehind) const {
+    if(lookbehind == 0u || !has_lookbehind_n(lookbehind)) {
+        throw std::logic_error("Invalid lookbehind. Out of bounds of the token stream's lookbehind window.");
+    }
+    return current_token - lookbehind;
+}
+
+token_index_t token_stream_t::advance_token() {
+    const token_index_t token = peek_token();
+    ++current_token;
+    return token;
+}
+
+
+token_table_t scan_all_tokens(lexer_t lexer) {
+    token_stream_t token_stream(lexer);
+    token_table_t tokens(token_stream.get_source());
+    for(;;) {
+        const token_index_t token = token_stream.advance_token();
+        const std::string_view text = token_stream.token_text(token);
+        tokens.push_back(token_stream.token_type(token), token_stream.token_offset(token), static_cast<std::uint32_t>(text.size()));
+        if(token_stream.token_type(token) == token_type_t::EOF_TOK) {
+            break;
+        }
+    }
+    return tokens;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_table.hpp>
+#include <utils/symbol_interner.hpp>
+
+
+// Pull based token source for the parser.
+// Tokens are scanned (with multi-keyword type specifiers such as `unsigned long long int` merged into a single token by `scan_merged_token()`) on demand as the parser peeks at them,
+//  so only a small window of tokens around the parser's current position is ever held in memory instead of the whole file.
+// The window is stored the same way as `token_table_t`, as parallel arrays of types, offsets and lengths, and tokens are handed out as `token_index_t`s.
+// A token index can only be looked up while it is inside the window (i.e. up to `max_lookbehind` tokens after it was consumed).
+// Token text is a view into the source text though, so it stays valid for as long as the source text does.
+// Identifiers are interned as they are scanned into the window, so the parser gets their `utils::symbol_t` without hashing the text again.
+// Once the end of the text is reached, the stream keeps yielding `EOF_TOK`.
+class token_stream_t {
+public:
+    static constexpr std::uint32_t max_lookahead = 4u; // `peek_token_n()` supports lookaheads in `[0, max_lookahead)`
+    static constexpr std::uint32_t max_lookbehind = 4u; // `peek_back_n()` supports lookbehinds in `[1, max_lookbehind]`
+
+private:
+    static constexpr std::uint32_t window_size = max_lookbehind + max_lookahead;
+    static_assert((window_size & (window_size - 1u)) == 0u, "Token window size must be a power of two.");
+
+    // peeking only fills in tokens we would have scanned anyways, so it is logically `const`
+    mutable lexer_t lexer;
+    const char* source; // token offsets are relative to this
+
+    // token `i` is stored at `i % window_size`
+    mutable std::array<token_type_t, window_size> window_types;
+    mutable std::array<std::uint32_t, window_size> window_offsets;
+    mutable std::array<std::uint32_t, window_size> window_lengths;
+    mutable std::array<utils::symbol_t, window_size> window_symbols; // the empty symbol for anything other than an `IDENTIFIER`
+    mutable token_index_t scanned_count = 0u; // number of tokens scanned into the window so far
+    token_index_t current_token = 0u;
+
+    void scan_next_token() const;
+    std::uint32_t get_window_slot(token_index_t token) const;
+
+public:
+    token_stream_t() = delete;
+    token_stream_t(lexer_t lexer) : lexer(lexer), source(lexer.current) {}
+
+    const char* get_source() const {
+        return source;
+    }
+    // where the lexer prints its errors
+    std::ostream& get_debug_output() const {
+        return *lexer.debug_output;
+    }
+    void set_debug_output(std::ostream& output) {
+        lexer.debug_output = &output;
+    }
+
+    bool is_eof() const {
+        return peek_token_type() == token_type_t::EOF_TOK;
+    }
+
+    token_index_t peek_token() const {
+        return peek_token_n(0u);
+    }
+    // `peek_token()` == `peek_token_n(0)`
+    token_index_t peek_token_n(std::uint32_t lookahead) const;
+    token_type_t peek_token_type() const {
+        return token_type(peek_token());
+    }
+
+    // `peek_back()` == `peek_back_n(1)`
+    token_index_t peek_back_n(std::uint32_t lookbehind) const;
+    bool has_lookbehind_n(const std::uint32_t lookbehind) const {
+        return lookbehind <= max_lookbehind && lookbehind <= current_token;
+    }
+
+    token_index_t advance_token();
+
+    token_type_t token_type(const token_index_t token) const {
+        return window_types[get_window_slot(token)];
+    }
+    std::uint32_t token_offset(const token_index_t token) const {
+        return window_offsets[get_window_slot(token)];
+    }
+    std::string_view token_text(const token_index_t token) const {
+        const auto slot = get_window_slot(token);
+        return {source + window_offsets[slot], window_lengths[slot]};
+    }
+    // Interned text of an `IDENTIFIER` token. Any other token has the empty symbol.
+    utils::symbol_t token_symbol(const token_index_t token) const {
+        return window_symbols[get_window_slot(token)];
+    }
+};
+
+
+// Drains a `token_stream_t` into a token table. Includes the trailing `EOF_TOK`.
+token_table_t scan_all_tokens(lexer_t lexer);
@@ -0,0 +1,69 @@
+#pragma once
+
+
+#include <cstddef>
+#include <iterator>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <frontend/lexing/lexer.hpp>
+
+
+// Tokens are referred to by their position in the token sequence of a file (starting at `0`) instead of being passed around as `token_t`s.
+using token_index_t = std::uint32_t;
+
+// Compact token storage as parallel arrays (one per token field) instead of an array of `token_t`s.
+// Each token takes up 9 bytes (its type, the offset of its first character in the source text and its length) instead of the 32 bytes of a `token_t`,
+//  and its text is only materialized (as a view into the source text) when it is asked for.
+class token_table_t {
+    const char* source; // `offsets` are relative to this
+    std::vector<token_type_t> types;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> lengths;
+
+public:
+    static constexpr std::size_t bytes_per_token = sizeof(token_type_t) + sizeof(std::uint32_t) + sizeof(std::uint32_t);
+
+
+    token_table_t() = delete;
+    explicit token_table_t(const char *const source) : source(source) {}
+
+    void reserve(const std::size_t token_count) {
+        types.reserve(token_count);
+        offsets.reserve(token_count);
+        lengths.reserve(token_count);
+    }
+    void push_back(const token_type_t type, const std::uint32_t offset, const std::uint32_t length) {
+        types.push_back(type);
+        offsets.push_back(offset);
+        lengths.push_back(length);
+    }
+    // Appends the tokens in `[first, other.size())` of `other`. Both tables must have the same source text.
+    void append(const token_table_t& other, const token_index_t first) {
+        types.insert(std::end(types), std::begin(other.types) + first, std::end(other.types));
+        offsets.insert(std::end(offsets), std::begin(other.offsets) + first, std::end(other.offsets));
+        lengths.insert(std::end(lengths), std::begin(other.lengths) + first, std::end(other.lengths));
+    }
+
+    std::uint32_t size() const {
+        return static_cast<std::uint32_t>(types.size());
+    }
+    // heap memory used by the token arrays
+    std::size_t capacity_bytes() const {
+        return types.capacity() * sizeof(token_type_t) + offsets.capacity() * sizeof(std::uint32_t) + lengths.capacity() * sizeof(std::uint32_t);
+    }
+
+    token_type_t type(const token_index_t token) const {
+        return types.at(token);
+    }
+    std::uint32_t offset(const token_index_t token) const {
+        return offsets.at(token);
+    }
+    std::uint32_t length(const token_index_t token) const {
+        return lengths.at(token);
+    }
+    std::string_view text(const token_index_t token) const {
+        return {source + offsets.at(token), lengths.at(token)};
+    }
+};
@@ -1,64 +1,73 @@
 #include "parser.hpp"
 
 
-void validate_type_name(const ast::type_t& expected, const ast::type_t& actual, const std::string& error_message) {
+utils::result_t<void> validate_type_name(parser_t& parser, const ast::type_t& expected, const ast::type_t& actual, const std::string& error_message) {
     if(expected.type_category != actual.type_category) { // optimization to avoid having to do string comparisons for built-in types
         if(expected.type_name != actual.type_name) {
-            throw std::runtime_error(error_message);
+            return parser.error(error_message);
         }
     }
+    return {};
 }
 
-ast::type_t get_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name) {
+const ast::type_t* find_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name) {
     if(validation.variable_lookup.contains_in_accessible_scopes(variable_name)) {
-        return validation.variable_lookup.find_in_accessible_scopes(variable_name);
+        return &validation.variable_lookup.find_in_accessible_scopes(variable_name);
     }
-    if(utils::contains(validation.global_variable_declarations, variable_name)) {
-        return validation.global_variable_declarations.at(variable_name).type_name;
+    if(utils::contains(validation.globals->global_variable_declarations, variable_name)) {
+        return &validation.globals->get_type(validation.globals->global_variable_declarations.at(variable_name).type_name);
     }
-    if(utils::contains(validation.global_variable_definitions, variable_name)) {
-        return validation.global_variable_definitions.at(variable_name).type_name;
+    if(utils::contains(validation.globals->global_variable_definitions, variable_name)) {
+        return &validation.globals->get_type(validation.globals->global_variable_definitions.at(variable_name).type_name);
     }
-    throw std::runtime_error("Variable [" + variable_name + "] is not declared.");
+    return nullptr;
+}
+const ast::type_t& get_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name) {
+    const ast::type_t *const type = find_type_of_variable(validation, variable_name);
+    if(type == nullptr) {
+        throw std::logic_error("Variable [" + variable_name.str() + "] is not declared.");
+    }
+    return *type;
 }
 
 
 // TODO: refactor and double check the implementation
-void validate_compile_time_expression(validation_t& validation, const ast::expression_t& expression) {
-    std::visit(overloaded{
-        [&validation](const std::shared_ptr<ast::grouping_t>& expression) {
-            validate_compile_time_expression(validation, expression->expr);
+utils::result_t<void> validate_compile_time_expression(parser_t& parser, const ast::expression_t& expression) {
+    return std::visit(overloaded{
+        [&parser](const ast::node_handle_t<ast::grouping_t>& expression) -> utils::result_t<void> {
+            return validate_compile_time_expression(parser, expression->expr);
         },
-        [&validation](const std::shared_ptr<ast::unary_expression_t>& expression) {
+        [&parser](const ast::node_handle_t<ast::unary_expression_t>& expression) -> utils::result_t<void> {
             if(expression->op == ast::unary_operator_token_t::PLUS_PLUS || expression->op == ast::unary_operator_token_t::MINUS_MINUS) {
-                throw std::runtime_error("`++` and `--` not supported in compile time expressions.");
+                return parser.error("`++` and `--` not supported in compile time expressions.");
             }
-            validate_compile_time_expression(validation, expression->exp);
+            return validate_compile_time_expression(parser, expression->exp);
         },
-        [&validation](const std::shared_ptr<ast::binary_expression_t>& expression) {
+        [&parser](const ast::node_handle_t<ast::binary_expression_t>& expression) -> utils::result_t<void> {
             if(expression->op == ast::binary_operator_token_t::ASSIGNMENT) {
-                throw std::runtime_error("Assignment not supported in compile time expressions.");
+                return parser.error("Assignment not supported in compile time expressions.");
             }
-            validate_compile_time_expression(validation, expression->left);
-            validate_compile_time_expression(validation, expression->right);
+            TRY(validate_compile_time_expression(parser, expression->left));
+            return validate_compile_time_expression(parser, expression->right);
         },
-        [&validation](const std::shared_ptr<ast::ternary_expression_t>& expression) {
-            validate_compile_time_expression(validation, expression->condition);
-            validate_compile_time_expression(validation, expression->if_true);
-            validate_compile_time_expression(validation, expression->if_false);
+        [&parser](const ast::node_handle_t<ast::ternary_expression_t>& expression) -> utils::result_t<void> {
+            TRY(validate_compile_time_expression(parser, expression->condition));
+            TRY(validate_compile_time_expression(parser, expression->if_true));
+            return validate_compile_time_expression(parser, expression->if_false);
         },
-        [](const std::shared_ptr<ast::function_call_t>& expression) {
-            throw std::runtime_error("Function calls not supported in compile time expressions.");
+        [&parser](const ast::node_handle_t<ast::function_call_t>& expression) -> utils::result_t<void> {
+            return parser.error("Function calls not supported in compile time expressions.");
         },
-        [](const ast::constant_t& expression) {
+        [](const ast::constant_t& expression) -> utils::result_t<void> {
             // totally fine, no need to go further as this is a terminal node of the AST
+            return {};
         },
-        [](const ast::variable_access_t& expression) {
-            throw std::runtime_error("Variables not supported in compile time expressions.");
+        [&parser](const ast::variable_access_t& expression) -> utils::result_t<void> {
             // TODO: Maybe support referencing other global variables???? Check the C standard to see what is considered valid.
+            return parser.error("Variables not supported in compile time expressions.");
         },
-        [&validation](const std::shared_ptr<ast::convert_t>& expression) {
-            validate_compile_time_expression(validation, expression->expr);
+        [&parser](const ast::node_handle_t<ast::convert_t>& expression) -> utils::result_t<void> {
+            return validate_compile_time_expression(parser, expression->expr);
         }
     }, expression.expr);
 }
@@ -121,7 +130,7 @@ bool is_constant_with_value_zero(const ast::expression_t& expr) {
                 }
             }, constant.value);
         },
-        [](const std::shared_ptr<ast::convert_t>& convert) {
+        [](const ast::node_handle_t<ast::convert_t>& convert) {
             return is_constant_with_value_zero(convert->expr);
         },
         [](const auto&) {
@@ -136,42 +145,42 @@ static type_punned_constant_t type_pun_value(const T& value) {
     std::memcpy(buffer.get(), &value, sizeof(value));
     return type_punned_constant_t{std::move(buffer), sizeof(value)};
 }
-static type_punned_constant_t get_type_punned_constant_value_with_optional_convert(const ast::expression_t& expr, const std::optional<ast::type_t>& convert_type) {
+static type_punned_constant_t get_type_punned_constant_value_with_optional_convert(const ast::expression_t& expr, const ast::expression_type_t& convert_type) {
     return std::visit(overloaded{
         [&convert_type](const ast::constant_t& constant) {
             return std::visit(overloaded{
                 [&convert_type](const auto& value) {
                     if(convert_type.has_value()) {
-                        if(convert_type.value().type_name == "char") {
+                        if(convert_type.value().type_name == ast::primitive_type_names::CHAR) {
                             return type_pun_value(static_cast<char>(value));
-                        } else if(convert_type.value().type_name == "signed char") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::SIGNED_CHAR) {
                             return type_pun_value(static_cast<signed char>(value));
-                        } else if(convert_type.value().type_name == "unsigned char") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::UNSIGNED_CHAR) {
                             return type_pun_value(static_cast<unsigned char>(value));
-                        } else if(convert_type.value().type_name == "short") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::SHORT) {
                             return type_pun_value(static_cast<short>(value));
-                        } else if(convert_type.value().type_name == "unsigned short") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::UNSIGNED_SHORT) {
                             return type_pun_value(static_cast<unsigned short>(value));
-                        } else if(convert_type.value().type_name == "int") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::INT) {
                             return type_pun_value(static_cast<int>(value));
-                        } else if(convert_type.value().type_name == "unsigned int") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::UNSIGNED_INT) {
                             return type_pun_value(static_cast<unsigned int>(value));
-                        } else if(convert_type.value().type_name == "long") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::LONG) {
                             return type_pun_value(static_cast<long>(value));
-                        } else if(convert_type.value().type_name == "unsigned long") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::UNSIGNED_LONG) {
                             return type_pun_value(static_cast<unsigned long>(value));
-                        } else if(convert_type.value().type_name == "long long") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::LONG_LONG) {
                             return type_pun_value(static_cast<long long>(value));
-                        } else if(convert_type.value().type_name == "unsigned long long") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::UNSIGNED_LONG_LONG) {
                             return type_pun_value(static_cast<unsigned long long>(value));
-                        } else if(convert_type.value().type_name == "float") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::FLOAT) {
                             return type_pun_value(static_cast<float>(value));
-                        } else if(convert_type.value().type_name == "double") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::DOUBLE) {
                             return type_pun_value(static_cast<double>(value));
-                        } else if(convert_type.value().type_name == "long double") {
+                        } else if(convert_type.value().type_name == ast::primitive_type_names::LONG_DOUBLE) {
                             return type_pun_value(static_cast<long double>(value));
                         } else {
-                            throw std::logic_error("Unsupported type: [" + convert_type.value().type_name + "]");
+                            throw std::logic_error("Unsupported type: [" + convert_type.value().type_name.str() + "]");
                             return type_punned_constant_t{};
                         }
                     } else {
@@ -191,7 +200,7 @@ type_punned_constant_t get_type_punned_constant(const ast::expression_t& expr) {
         [&expr](const ast::constant_t& constant) {
             return get_type_punned_constant_value_with_optional_convert(expr, std::nullopt);
         },
-        [&expr](const std::shared_ptr<ast::convert_t>& convert) {
+        [&expr](const ast::node_handle_t<ast::convert_t>& convert) {
             return get_type_punned_constant_value_with_optional_convert(convert->expr, expr.type);
         },
         [](const auto&) {
@@ -231,214 +240,221 @@ static ast::type_category_t get_type_category_from_token_type(token_type_t token
         case token_type_t::LONG_DOUBLE_KEYWORD:
             return ast::type_category_t::FLOATING;
     }
-    throw std::runtime_error("Invalid/Unsupported type: [" + std::to_string(static_cast<std::uint32_t>(token_type)) + std::string("]"));
+    throw std::logic_error("Invalid/Unsupported type: [" + std::to_string(static_cast<std::uint32_t>(token_type)) + std::string("]"));
 }
 static std::size_t get_size_from_type(const ast::type_name_t& type_name) {
-    if(type_name == "char" || type_name == "signed char" || type_name == "unsigned char") {
+    if(type_name == ast::primitive_type_names::CHAR || type_name == ast::primitive_type_names::SIGNED_CHAR || type_name == ast::primitive_type_names::UNSIGNED_CHAR) {
         return sizeof(char);
-    } else if(type_name == "short" || type_name == "unsigned short") {
+    } else if(type_name == ast::primitive_type_names::SHORT || type_name == ast::primitive_type_names::UNSIGNED_SHORT) {
         return sizeof(std::uint16_t);
-    } else if(type_name == "int" || type_name == "unsigned int") {
+    } else if(type_name == ast::primitive_type_names::INT || type_name == ast::primitive_type_names::UNSIGNED_INT) {
         return sizeof(std::uint32_t);
-    } else if(type_name == "long" || type_name == "unsigned long") {
+    } else if(type_name == ast::primitive_type_names::LONG || type_name == ast::primitive_type_names::UNSIGNED_LONG) {
         return sizeof(std::uint64_t);
-    } else if(type_name == "long long" || type_name == "unsigned long long") {
+    } else if(type_name == ast::primitive_type_names::LONG_LONG || type_name == ast::primitive_type_names::UNSIGNED_LONG_LONG) {
         return sizeof(std::uint64_t);
-    } else if(type_name == "float") {
+    } else if(type_name == ast::primitive_type_names::FLOAT) {
         return sizeof(float);
-    } else if(type_name == "double") {
+    } else if(type_name == ast::primitive_type_names::DOUBLE) {
         return sizeof(double);
-    } else if(type_name == "long double") {
+    } else if(type_name == ast::primitive_type_names::LONG_DOUBLE) {
         return sizeof(long double);
     } else {
-        throw std::runtime_error("Unsupported type: [" + type_name + std::string("]"));
+        throw std::logic_error("Unsupported type: [" + type_name.str() + std::string("]"));
     }
 }
 static std::size_t get_alignment_from_type(const ast::type_name_t& type_name) {
     // `get_alignment_from_type()` and `get_size_from_type()` will diverge once we implement structs and other non-primitive types
-    if(type_name == "char" || type_name == "signed char" || type_name == "unsigned char") {
+    if(type_name == ast::primitive_type_names::CHAR || type_name == ast::primitive_type_names::SIGNED_CHAR || type_name == ast::primitive_type_names::UNSIGNED_CHAR) {
         return alignof(char);
-    } else if(type_name == "short" || type_name == "unsigned short") {
+    } else if(type_name == ast::primitive_type_names::SHORT || type_name == ast::primitive_type_names::UNSIGNED_SHORT) {
         return alignof(std::uint16_t);
-    } else if(type_name == "int" || type_name == "unsigned int") {
+    } else if(type_name == ast::primitive_type_names::INT || type_name == ast::primitive_type_names::UNSIGNED_INT) {
         return alignof(std::uint32_t);
-    } else if(type_name == "long" || type_name == "unsigned long") {
+    } else if(type_name == ast::primitive_type_names::LONG || type_name == ast::primitive_type_names::UNSIGNED_LONG) {
         return alignof(std::uint64_t);
-    } else if(type_name == "long long" || type_name == "unsigned long long") {
+    } else if(type_name == ast::primitive_type_names::LONG_LONG || type_name == ast::primitive_type_names::UNSIGNED_LONG_LONG) {
         return alignof(std::uint64_t);
-    } else if(type_name == "float") {
+    } else if(type_name == ast::primitive_type_names::FLOAT) {
         return alignof(float);
-    } else if(type_name == "double") {
+    } else if(type_name == ast::primitive_type_names::DOUBLE) {
         return alignof(double);
-    } else if(type_name == "long double") {
+    } else if(type_name == ast::primitive_type_names::LONG_DOUBLE) {
         return alignof(long double);
     } else {
-        throw std::runtime_error("Unsupported type: [" + type_name + std::string("]"));
+        throw std::logic_error("Unsupported type: [" + type_name.str() + std::string("]"));
     }
 }
 
 static ast::type_name_t primitive_token_keyword_to_name(token_type_t token_type) {
     switch(token_type) {
         case token_type_t::CHAR_KEYWORD:
-            return "char";
+            return ast::primitive_type_names::CHAR;
         case token_type_t::SIGNED_CHAR_KEYWORD:
-            return "signed char";
+            return ast::primitive_type_names::SIGNED_CHAR;
         case token_type_t::UNSIGNED_CHAR_KEYWORD:
-            return "unsigned char";
+            return ast::primitive_type_names::UNSIGNED_CHAR;
         case token_type_t::SHORT_KEYWORD:
-            return "short";
+            return ast::primitive_type_names::SHORT;
         case token_type_t::UNSIGNED_SHORT_KEYWORD:
-            return "unsigned short";
+            return ast::primitive_type_names::UNSIGNED_SHORT;
         case token_type_t::INT_KEYWORD:
-            return "int";
+            return ast::primitive_type_names::INT;
         case token_type_t::UNSIGNED_INT_KEYWORD:
-            return "unsigned int";
+            return ast::primitive_type_names::UNSIGNED_INT;
         case token_type_t::LONG_KEYWORD:
-            return "long";
+            return ast::primitive_type_names::LONG;
         case token_type_t::UNSIGNED_LONG_KEYWORD:
-            return "unsigned long";
+            return ast::primitive_type_names::UNSIGNED_LONG;
         case token_type_t::LONG_LONG_KEYWORD:
-            return "long long";
+            return ast::primitive_type_names::LONG_LONG;
         case token_type_t::UNSIGNED_LONG_LONG_KEYWORD:
-            return "unsigned long long";
+            return ast::primitive_type_names::UNSIGNED_LONG_LONG;
         case token_type_t::FLOAT_KEYWORD:
-            return "float";
+            return ast::primitive_type_names::FLOAT;
         case token_type_t::DOUBLE_KEYWORD:
-            return "double";
+            return ast::primitive_type_names::DOUBLE;
         case token_type_t::LONG_DOUBLE_KEYWORD:
-            return "long double";
+            return ast::primitive_type_names::LONG_DOUBLE;
     }
-    throw std::runtime_error("Not a primitive type keyword.");
+    throw std::logic_error("Not a primitive type keyword.");
 }
 
 template<typename T>
 static ast::constant_t parse_constant(parser_t& parser, const std::size_t suffix_size = 0u) {
     auto next = parser.advance_token();
-    if(!is_constant(next)) {
-        throw std::runtime_error("Invalid constant: [" + std::to_string(static_cast<std::uint32_t>(next.token_type)) + std::string("]"));
+    if(!is_constant(parser.token_type(next))) {
+        throw std::logic_error("Invalid constant: [" + std::to_string(static_cast<std::uint32_t>(parser.token_type(next))) + std::string("]"));
     }
 
     T result{};
-    utils::str_to_T(next.token_text, result, suffix_size);
+    utils::str_to_T(parser.token_text(next), result, suffix_size);
     return ast::constant_t { result };
 }
 static ast::expression_t parse_char_constant(parser_t& parser) {
-    return ast::expression_t { ast::constant_t { parser.advance_token().token_text[1] }, make_primitive_type_t(ast::type_category_t::INT, "char", sizeof(char), alignof(char)) };
+    return ast::expression_t { ast::constant_t { parser.token_text(parser.advance_token())[1] }, make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::CHAR, sizeof(char), alignof(char)) };
 }
 static ast::expression_t parse_int_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<int>(parser), make_primitive_type_t(ast::type_category_t::INT, "int", sizeof(std::int32_t), alignof(std::int32_t)) };
+    return ast::expression_t { parse_constant<int>(parser), make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t)) };
 }
 static ast::expression_t parse_unsigned_int_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<unsigned int>(parser, 1), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, "unsigned int", sizeof(std::int32_t), alignof(std::int32_t)) };
+    return ast::expression_t { parse_constant<unsigned int>(parser, 1), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, ast::primitive_type_names::UNSIGNED_INT, sizeof(std::int32_t), alignof(std::int32_t)) };
 }
 static ast::expression_t parse_long_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<long>(parser, 1), make_primitive_type_t(ast::type_category_t::INT, "long", sizeof(std::int64_t), alignof(std::int64_t)) };
+    return ast::expression_t { parse_constant<long>(parser, 1), make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::LONG, sizeof(std::int64_t), alignof(std::int64_t)) };
 }
 static ast::expression_t parse_unsigned_long_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<unsigned long>(parser, 2), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, "unsigned long", sizeof(std::uint64_t), alignof(std::uint64_t)) };
+    return ast::expression_t { parse_constant<unsigned long>(parser, 2), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, ast::primitive_type_names::UNSIGNED_LONG, sizeof(std::uint64_t), alignof(std::uint64_t)) };
 }
 static ast::expression_t parse_long_long_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<long long>(parser, 2), make_primitive_type_t(ast::type_category_t::INT, "long long", sizeof(std::int64_t), alignof(std::int64_t)) };
+    return ast::expression_t { parse_constant<long long>(parser, 2), make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::LONG_LONG, sizeof(std::int64_t), alignof(std::int64_t)) };
 }
 static ast::expression_t parse_unsigned_long_long_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<unsigned long long>(parser, 3), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, "unsigned long long", sizeof(std::uint64_t), alignof(std::uint64_t)) };
+    return ast::expression_t { parse_constant<unsigned long long>(parser, 3), make_primitive_type_t(ast::type_category_t::UNSIGNED_INT, ast::primitive_type_names::UNSIGNED_LONG_LONG, sizeof(std::uint64_t), alignof(std::uint64_t)) };
 }
 static ast::expression_t parse_float_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<float>(parser, 1), make_primitive_type_t(ast::type_category_t::FLOATING, "float", sizeof(float), alignof(float)) };
+    return ast::expression_t { parse_constant<float>(parser, 1), make_primitive_type_t(ast::type_category_t::FLOATING, ast::primitive_type_names::FLOAT, sizeof(float), alignof(float)) };
 }
 static ast::expression_t parse_double_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<double>(parser), make_primitive_type_t(ast::type_category_t::FLOATING, "double", sizeof(double), alignof(double)) };
+    return ast::expression_t { parse_constant<double>(parser), make_primitive_type_t(ast::type_category_t::FLOATING, ast::primitive_type_names::DOUBLE, sizeof(double), alignof(double)) };
 }
 static ast::expression_t parse_long_double_constant(parser_t& parser) {
-    return ast::expression_t { parse_constant<long double>(parser, 1), make_primitive_type_t(ast::type_category_t::FLOATING, "long double", sizeof(long double), alignof(long double)) };
+    return ast::expression_t { parse_constant<long double>(parser, 1), make_primitive_type_t(ast::type_category_t::FLOATING, ast::primitive_type_names::LONG_DOUBLE, sizeof(long double), alignof(long double)) };
 }
 
 static ast::type_t get_function_return_type(parser_t& parser, const ast::func_name_t& function_name) {
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, function_name)) {
-        return parser.symbol_info.function_declarations_lookup.at(function_name).return_type;
-    } else if(utils::contains(parser.symbol_info.function_definitions_lookup, function_name)) {
-        return parser.symbol_info.function_definitions_lookup.at(function_name).return_type;
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, function_name)) {
+        return parser.symbol_info.globals->function_declarations_lookup.at(function_name).return_type;
+    } else if(utils::contains(parser.symbol_info.globals->function_definitions_lookup, function_name)) {
+        return parser.symbol_info.globals->function_definitions_lookup.at(function_name).return_type;
     } else {
-        throw std::logic_error("Function [" + function_name + "] not declared or defined.");
+        throw std::logic_error("Function [" + function_name.str() + "] not declared or defined.");
     }
 }
 
-static std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>> parse_function_definition_parameter_list(parser_t& parser) {
-    std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>> param_list;
+static utils::result_t<std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>>> parse_function_definition_parameter_list(parser_t& parser) {
+    std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>> param_list;
     for(;;) {
-        std::vector<token_t> current_param;
-        while(parser.peek_token().token_type != token_type_t::COMMA && parser.peek_token().token_type != token_type_t::RIGHT_PAREN) {
+        std::vector<token_index_t> current_param;
+        while(parser.peek_token_type() != token_type_t::COMMA && parser.peek_token_type() != token_type_t::RIGHT_PAREN) {
             if(parser.is_eof()) {
-                throw std::runtime_error("Unexpected end of file.");
+                return parser.error("Unexpected end of file.");
+            }
+            if(current_param.size() == 3u) { // a parameter is at most `struct name var` (this also keeps every token of it inside the token window)
+                return parser.error("Unexpected token in function definition parameter list.");
             }
             current_param.push_back(parser.advance_token());
         }
 
         if(param_list.size() != 0 && current_param.size() == 0) {
-            throw std::runtime_error("You have a trailing comma in your parameter list.");
+            return parser.error("You have a trailing comma in your parameter list.");
         }
 
         if(current_param.size() == 0) {
             break; // empty param list. e.g. `int main();`
         } else if(current_param.size() == 1) {
             if(!is_a_type_token(parser, current_param[0])) {
-                throw std::runtime_error("Expected identifier name (type name) in function declaration.");
+                return parser.error("Expected identifier name (type name) in function declaration.");
             }
-            param_list.push_back({parse_type_name_from_token(parser, current_param[0]), std::nullopt});
+            TRY_ASSIGN(auto param_type, parse_type_name_from_token(parser, current_param[0]));
+            param_list.push_back({std::move(param_type), std::nullopt});
         } else if(current_param.size() == 2) {
-            if(is_struct_keyword(current_param[0])) {
-                param_list.push_back({parse_struct_name_from_token(parser, current_param[0]), std::nullopt});
+            if(is_struct_keyword(parser.token_type(current_param[0]))) {
+                TRY_ASSIGN(auto param_type, parse_struct_name_from_token(parser, current_param[0]));
+                param_list.push_back({std::move(param_type), std::nullopt});
             } else {
                 if(!is_a_type_token(parser, current_param[0])) {
-                    throw std::runtime_error("Expected identifier name (type name) in function declaration.");
+                    return parser.error("Expected identifier name (type name) in function declaration.");
                 }
-                if(current_param[1].token_type != token_type_t::IDENTIFIER) {
-                    throw std::runtime_error("Expected identifier name (variable name) in function declaration.");
+                if(parser.token_type(current_param[1]) != token_type_t::IDENTIFIER) {
+                    return parser.error("Expected identifier name (variable name) in function declaration.");
                 }
-                param_list.push_back({parse_type_name_from_token(parser, current_param[0]), std::make_optional(ast::var_name_t{current_param[1].token_text})});
+                TRY_ASSIGN(auto param_type, parse_type_name_from_token(parser, current_param[0]));
+                param_list.push_back({std::move(param_type), std::make_optional(parser.token_symbol(current_param[1]))});
             }
         } else if(current_param.size() == 3) {
-            if(!is_struct_keyword(current_param[0])) {
-                throw std::runtime_error("Expected `struct` keyword in parameter list.");
+            if(!is_struct_keyword(parser.token_type(current_param[0]))) {
+                return parser.error("Expected `struct` keyword in parameter list.");
             }
-            if(current_param[2].token_type != token_type_t::IDENTIFIER) {
-                throw std::runtime_error("Expected identifier name (variable name) in function declaration.");
+            if(parser.token_type(current_param[2]) != token_type_t::IDENTIFIER) {
+                return parser.error("Expected identifier name (variable name) in function declaration.");
             }
-            param_list.push_back({parse_struct_name_from_token(parser, current_param[1]), std::make_optional(ast::var_name_t{current_param[2].token_text})});
+            TRY_ASSIGN(auto param_type, parse_struct_name_from_token(parser, current_param[1]));
+            param_list.push_back({std::move(param_type), std::make_optional(parser.token_symbol(current_param[2]))});
         } else {
-            throw std::runtime_error("Unexpected token in function definition parameter list.");
+            return parser.error("Unexpected token in function definition parameter list.");
         }
 
-        if(parser.peek_token().token_type == token_type_t::COMMA) {
+        if(parser.peek_token_type() == token_type_t::COMMA) {
             parser.advance_token(); // consume `,`
-        } else if(parser.peek_token().token_type == token_type_t::RIGHT_PAREN) {
+        } else if(parser.peek_token_type() == token_type_t::RIGHT_PAREN) {
             break;
         } else {
-            throw std::runtime_error("Unexpected token in function definition parameter list."); // should be impossible to trigger
+            return parser.error("Unexpected token in function definition parameter list."); // should be impossible to trigger
         }
     }
     return param_list;
 }
-static std::vector<ast::type_t> parse_function_declaration_parameter_list(std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>> list_with_names) {
-    std::vector<ast::type_t> ret_type_list;
+static std::vector<ast::expression_type_t> parse_function_declaration_parameter_list(std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>> list_with_names) {
+    std::vector<ast::expression_type_t> ret_type_list;
     for(const auto& param : list_with_names) {
-        ret_type_list.push_back(std::move(param.first));
+        ret_type_list.push_back(param.first);
     }
     return ret_type_list;
 }
 
-std::shared_ptr<ast::grouping_t> parse_grouping(parser_t& parser) {
-    parser.expect_token(token_type_t::LEFT_PAREN, "Expected '(' in grouping expression.");
-    auto exp = parse_and_validate_expression(parser, 0u);
-    if(parser.peek_token().token_type != token_type_t::RIGHT_PAREN) {
-        throw std::runtime_error("expected `)`");
+utils::result_t<ast::node_handle_t<ast::grouping_t>> parse_grouping(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::LEFT_PAREN, "Expected '(' in grouping expression."));
+    TRY_ASSIGN(auto exp, parse_and_validate_expression(parser, 0u));
+    if(parser.peek_token_type() != token_type_t::RIGHT_PAREN) {
+        return parser.error("expected `)`");
     }
-    parser.expect_token(token_type_t::RIGHT_PAREN, "Expected ')' in grouping expression.");
+    TRY(parser.expect_token(token_type_t::RIGHT_PAREN, "Expected ')' in grouping expression."));
     return make_grouping(std::move(exp));
 }
 
-bool is_prefix_op(const token_t& token) {
-    switch(token.token_type) {
+bool is_prefix_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_PLUS:
         case token_type_t::DASH_DASH:
         case token_type_t::PLUS:
@@ -449,8 +465,8 @@ bool is_prefix_op(const token_t& token) {
     }
     return false;
 }
-ast::unary_operator_token_t parse_prefix_op(const token_t& token) {
-    switch(token.token_type) {
+ast::unary_operator_token_t parse_prefix_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_PLUS:
             return ast::unary_operator_token_t::PLUS_PLUS;
         case token_type_t::DASH_DASH:
@@ -464,7 +480,7 @@ ast::unary_operator_token_t parse_prefix_op(const token_t& token) {
         case token_type_t::TILDE:
             return ast::unary_operator_token_t::BITWISE_NOT;
     }
-    throw std::runtime_error("Invalid prefix token.");
+    throw std::logic_error("Invalid prefix token.");
 }
 ast::precedence_t prefix_binding_power(const ast::unary_operator_token_t token) {
     switch(token) {
@@ -476,132 +492,122 @@ ast::precedence_t prefix_binding_power(const ast::unary_operator_token_t token)
         case ast::unary_operator_token_t::BITWISE_NOT:
             return 27;
     }
-    throw std::runtime_error("Invalid prefix token.");
+    throw std::logic_error("Invalid prefix token.");
 }
-std::shared_ptr<ast::unary_expression_t> make_prefix_op(const ast::unary_operator_token_t op, ast::expression_t&& rhs) {
+utils::result_t<ast::node_handle_t<ast::unary_expression_t>> make_prefix_op(parser_t& parser, const ast::unary_operator_token_t op, ast::expression_t&& rhs) {
     // TODO: Double check these are valid lvalues for `++` and `--`
     if(op == ast::unary_operator_token_t::PLUS_PLUS || op == ast::unary_operator_token_t::MINUS_MINUS) {
-        auto lvalue = validate_lvalue_expression_exp_with_type(std::move(rhs));
-        return std::make_shared<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::PREFIX, op, std::move(lvalue)});
+        TRY_ASSIGN(auto lvalue, validate_lvalue_expression_exp_with_type(parser, std::move(rhs)));
+        return ast::make_node<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::PREFIX, op, std::move(lvalue)});
     }
-    return std::make_shared<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::PREFIX, op, std::move(rhs)});
+    return ast::make_node<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::PREFIX, op, std::move(rhs)});
 }
-ast::var_name_t parse_and_validate_variable(parser_t& parser, const token_t name_token) {
-    auto name = ast::var_name_t { name_token.token_text };
-    if(!parser.symbol_info.variable_lookup.contains_in_accessible_scopes(name) && !utils::contains(parser.symbol_info.global_variable_declarations, name) && !utils::contains(parser.symbol_info.global_variable_definitions, name)) {
-        throw std::runtime_error("Variable [" + name + "] is not declared in currently accessible scopes.");
+utils::result_t<ast::var_name_t> parse_and_validate_variable(parser_t& parser, const ast::var_name_t name) {
+    if(!parser.symbol_info.variable_lookup.contains_in_accessible_scopes(name) && !utils::contains(parser.symbol_info.globals->global_variable_declarations, name) && !utils::contains(parser.symbol_info.globals->global_variable_definitions, name)) {
+        return parser.error("Variable [" + name.str() + "] is not declared in currently accessible scopes.");
     }
     return name;
 }
-std::shared_ptr<ast::function_call_t> parse_and_validate_function_call(parser_t& parser, const token_t name_token) {
-    parser.expect_token(token_type_t::LEFT_PAREN, "Expected `(` in function call.");
+utils::result_t<ast::node_handle_t<ast::function_call_t>> parse_and_validate_function_call(parser_t& parser, const ast::func_name_t name) {
+    TRY(parser.expect_token(token_type_t::LEFT_PAREN, "Expected `(` in function call."));
 
     std::vector<ast::expression_t> args;
-    while(parser.peek_token().token_type != token_type_t::RIGHT_PAREN) {
-        args.push_back(parse_and_validate_expression(parser, 3)); // accept all expressions as arguments except for comma operator, so pass precedence of assignment operator lhs
+    while(parser.peek_token_type() != token_type_t::RIGHT_PAREN) {
+        TRY_ASSIGN(auto arg, parse_and_validate_expression(parser, 3)); // accept all expressions as arguments except for comma operator, so pass precedence of assignment operator lhs
+        args.push_back(std::move(arg));
 
-        if(parser.peek_token().token_type != token_type_t::COMMA) {
+        if(parser.peek_token_type() != token_type_t::COMMA) {
             break;
         }
         parser.advance_token();
     }
 
-    parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in function call.");
+    TRY(parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in function call."));
 
-    auto function_call = ast::function_call_t{ast::func_name_t(name_token.token_text), std::move(args)};
+    auto function_call = ast::function_call_t{name, std::move(args)};
 
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, function_call.function_name)) {
-        const auto declaration = parser.symbol_info.function_declarations_lookup.at(function_call.function_name);
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, function_call.function_name)) {
+        const auto declaration = parser.symbol_info.globals->function_declarations_lookup.at(function_call.function_name);
         if(declaration.params.size() != function_call.params.size()) {
-            throw std::runtime_error("Function [" + function_call.function_name + "] param count mismatch.");
+            return parser.error("Function [" + function_call.function_name.str() + "] param count mismatch.");
         }
         // TODO: type check parameters to function call
-    } else if(utils::contains(parser.symbol_info.function_definitions_lookup, function_call.function_name)) {
-        const auto definition = parser.symbol_info.function_definitions_lookup.at(function_call.function_name);
+    } else if(utils::contains(parser.symbol_info.globals->function_definitions_lookup, function_call.function_name)) {
+        const auto definition = parser.symbol_info.globals->function_definitions_lookup.at(function_call.function_name);
         if(definition.params.size() != function_call.params.size()) {
-            throw std::runtime_error("Function [" + function_call.function_name + "] param count mismatch.");
+            return parser.error("Function [" + function_call.function_name.str() + "] param count mismatch.");
         }
         // TODO: type check parameters to function call
     } else {
-        throw std::runtime_error("Function [" + function_call.function_name + "] not declared or defined.");
+        return parser.error("Function [" + function_call.function_name.str() + "] not declared or defined.");
     }
 
-    return std::make_shared<ast::function_call_t>(std::move(function_call));
+    return ast::make_node<ast::function_call_t>(std::move(function_call));
 }
 
-ast::type_t get_aliased_type(parser_t& parser, const ast::type_t type) {
+utils::result_t<ast::type_t> get_aliased_type(parser_t& parser, const ast::type_t& type) {
     // Check whether it is a valid typedef name
-    if(type.type_category != ast::type_category_t::TYPEDEF) {
+    if(type.type_category != ast::type_category_t::TYPEDEF || type.size.has_value()) {
         return type;
     }
 
-    auto current_type = type;
-    if(!current_type.size.has_value()) {
-        while(current_type.type_category == ast::type_category_t::TYPEDEF) {
-            auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(current_type.aliased_type_category.value()));
-            auto type_iter = type_table.find(current_type.aliased_type.value());
-            if(type_iter == std::end(type_table)) {
-                throw std::runtime_error("Type not found.");
-            }
-            current_type = type_iter->second;
-        }
-
-        if(current_type.type_category == ast::type_category_t::STRUCT) {
-            auto& struct_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
-            auto struct_type_iter = struct_type_table.find(current_type.type_name);
-            if(struct_type_iter == std::end(struct_type_table)) {
-                throw std::runtime_error("Member access not supported for struct forward declarations.");
-            }
-            current_type = struct_type_iter->second;
-        }
+    const ast::type_t *const aliased_type = get_aliased_type(parser.symbol_info.globals->type_table, type);
+    if(aliased_type == nullptr) {
+        return parser.error("Type not found.");
     }
-
-    return current_type;
+    return *aliased_type;
 }
 
-ast::expression_t parse_and_validate_member_access(parser_t& parser, const token_t name_token) {
-    ast::var_name_t name = ast::var_name_t { name_token.token_text };
-    ast::type_t variable_type = get_type_of_variable(parser.symbol_info, name);
+utils::result_t<ast::expression_t> parse_and_validate_member_access(parser_t& parser, const ast::var_name_t name) {
+    const ast::type_t *const variable_type = find_type_of_variable(parser.symbol_info, name);
+    if(variable_type == nullptr) {
+        return parser.error("Variable [" + name.str() + "] is not declared.");
+    }
 
-    std::vector<ast::var_name_t> member_accesses;
-    ast::type_t current_member_access_type = get_aliased_type(parser, variable_type);
+    ast::variable_access_t variable_access{name, {}};
+    TRY_ASSIGN(ast::type_t current_member_access_type, get_aliased_type(parser, *variable_type));
 
     do {
-        parser.expect_token(token_type_t::DOT, "Expected `.` in member access.");
+        TRY(parser.expect_token(token_type_t::DOT, "Expected `.` in member access."));
 
         auto member_access_token = parser.advance_token();
-        if(member_access_token.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier in member access.");
+        if(parser.token_type(member_access_token) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier in member access.");
         }
-        auto member_access_name = ast::var_name_t { member_access_token.token_text };
+        auto member_access_name = parser.token_symbol(member_access_token);
 
-        if(!utils::contains(current_member_access_type.field_offsets, member_access_name)) {
-            throw std::runtime_error("Member [" + member_access_name + "] does not exist in type [" + current_member_access_type.type_name + "]");
+        const auto field_index = current_member_access_type.find_field(member_access_name);
+        if(!field_index.has_value()) {
+            return parser.error("Member [" + member_access_name.str() + "] does not exist in type [" + current_member_access_type.type_name.str() + "]");
         }
 
-        member_accesses.push_back(member_access_name);
-        current_member_access_type = get_aliased_type(parser, current_member_access_type.fields.at(current_member_access_type.field_offsets.at(member_access_name)));
-    } while(parser.peek_token().token_type == token_type_t::DOT);
+        variable_access.member_accesses.push_back(ast::member_access_t{member_access_name, field_index.value()});
+        variable_access.member_offset += current_member_access_type.field_offsets[field_index.value()];
+        TRY_ASSIGN(current_member_access_type, get_aliased_type(parser, current_member_access_type.fields[field_index.value()]));
+    } while(parser.peek_token_type() == token_type_t::DOT);
 
-    return {ast::variable_access_t{name, member_accesses}, current_member_access_type};
+    return ast::expression_t{std::move(variable_access), current_member_access_type};
 }
 
-ast::expression_t parse_and_validate_variable_or_function_call(parser_t& parser) {
+utils::result_t<ast::expression_t> parse_and_validate_variable_or_function_call(parser_t& parser) {
     auto name_token = parser.advance_token();
-    if(name_token.token_type != token_type_t::IDENTIFIER) {
-        throw std::runtime_error("Invalid identifier: [" + std::to_string(static_cast<std::uint32_t>(name_token.token_type)) + std::string("]"));
+    if(parser.token_type(name_token) != token_type_t::IDENTIFIER) {
+        return parser.error("Invalid identifier: [" + std::to_string(static_cast<std::uint32_t>(parser.token_type(name_token))) + std::string("]"));
     }
+    const auto name = parser.token_symbol(name_token); // the token itself leaves the token window while parsing function call arguments
 
-    if(parser.peek_token().token_type == token_type_t::LEFT_PAREN) {
-        return {parse_and_validate_function_call(parser, name_token), get_function_return_type(parser, ast::func_name_t(name_token.token_text))};
-    } else if(parser.peek_token().token_type == token_type_t::DOT) {
-        return parse_and_validate_member_access(parser, name_token);
+    if(parser.peek_token_type() == token_type_t::LEFT_PAREN) {
+        TRY_ASSIGN(auto function_call, parse_and_validate_function_call(parser, name));
+        return ast::expression_t{std::move(function_call), get_function_return_type(parser, name)};
+    } else if(parser.peek_token_type() == token_type_t::DOT) {
+        return parse_and_validate_member_access(parser, name);
     } else {
-        return {ast::variable_access_t{parse_and_validate_variable(parser, name_token), {}}, get_type_of_variable(parser.symbol_info, ast::var_name_t(name_token.token_text))};
+        TRY_ASSIGN(auto variable_name, parse_and_validate_variable(parser, name));
+        return ast::expression_t{ast::variable_access_t{variable_name, {}}, get_type_of_variable(parser.symbol_info, name)};
     }
 }
-ast::expression_t parse_prefix_expression(parser_t& parser) {
-    switch(parser.peek_token().token_type) {
+utils::result_t<ast::expression_t> parse_prefix_expression(parser_t& parser) {
+    switch(parser.peek_token_type()) {
         case token_type_t::IDENTIFIER:
             return parse_and_validate_variable_or_function_call(parser);
         case token_type_t::CHAR_CONSTANT:
@@ -624,35 +630,40 @@ ast::expression_t parse_prefix_expression(parser_t& parser) {
             return parse_double_constant(parser);
         case token_type_t::LONG_DOUBLE_CONSTANT:
             return parse_long_double_constant(parser);
-        case token_type_t::LEFT_PAREN:
-            return {parse_grouping(parser), std::nullopt};
+        case token_type_t::LEFT_PAREN: {
+            TRY_ASSIGN(auto grouping, parse_grouping(parser));
+            return ast::expression_t{std::move(grouping), std::nullopt};
+        }
         default:
-            if(is_prefix_op(parser.peek_token())) {
-                auto op = parse_prefix_op(parser.advance_token());
+            if(is_prefix_op(parser.peek_token_type())) {
+                auto op = parse_prefix_op(parser.token_type(parser.advance_token()));
                 auto r_bp = prefix_binding_power(op);
-                auto rhs = parse_and_validate_expression(parser, r_bp);
-                return {make_prefix_op(op, std::move(rhs)), std::nullopt};
+                TRY_ASSIGN(auto rhs, parse_and_validate_expression(parser, r_bp));
+                TRY_ASSIGN(auto prefix_op, make_prefix_op(parser, op, std::move(rhs)));
+                return ast::expression_t{std::move(prefix_op), std::nullopt};
             }
-            std::cout << static_cast<std::uint32_t>(parser.peek_token().token_type) << ": " << parser.peek_token().token_text << std::endl;
-            throw std::runtime_error("Invalid prefix expression.");
+            if(!parser.is_speculative) {
+                parser.get_debug_output() << static_cast<std::uint32_t>(parser.peek_token_type()) << ": " << parser.token_text(parser.peek_token()) << std::endl;
+            }
+            return parser.error("Invalid prefix expression.");
     }
 }
-bool is_postfix_op(const token_t& token) {
-    switch(token.token_type) {
+bool is_postfix_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_PLUS:
         case token_type_t::DASH_DASH:
             return true;
     }
     return false;
 }
-ast::unary_operator_token_t parse_postfix_op(const token_t& token) {
-    switch(token.token_type) {
+ast::unary_operator_token_t parse_postfix_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_PLUS:
             return ast::unary_operator_token_t::PLUS_PLUS;
         case token_type_t::DASH_DASH:
             return ast::unary_operator_token_t::MINUS_MINUS;
     }
-    throw std::runtime_error("Invalid postfix token.");
+    throw std::logic_error("Invalid postfix token.");
 }
 ast::precedence_t postfix_binding_power(const ast::unary_operator_token_t token) {
     switch(token) {
@@ -660,17 +671,17 @@ ast::precedence_t postfix_binding_power(const ast::unary_operator_token_t token)
         case ast::unary_operator_token_t::MINUS_MINUS:
             return 28;
     }
-    throw std::runtime_error("Invalid postfix token.");
+    throw std::logic_error("Invalid postfix token.");
 }
-std::shared_ptr<ast::unary_expression_t> make_postfix_op(const ast::unary_operator_token_t op, ast::expression_t&& lhs) {
+utils::result_t<ast::node_handle_t<ast::unary_expression_t>> make_postfix_op(parser_t& parser, const ast::unary_operator_token_t op, ast::expression_t&& lhs) {
     if(op == ast::unary_operator_token_t::PLUS_PLUS || op == ast::unary_operator_token_t::MINUS_MINUS) {
-        auto lvalue = validate_lvalue_expression_exp_with_type(std::move(lhs));
-        return std::make_shared<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::POSTFIX, op, std::move(lvalue)});
+        TRY_ASSIGN(auto lvalue, validate_lvalue_expression_exp_with_type(parser, std::move(lhs)));
+        return ast::make_node<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::POSTFIX, op, std::move(lvalue)});
     }
-    return std::make_shared<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::POSTFIX, op, std::move(lhs)});
+    return ast::make_node<ast::unary_expression_t>(ast::unary_expression_t{ast::unary_operator_fixity_t::POSTFIX, op, std::move(lhs)});
 }
-bool is_infix_binary_op(const token_t& token) {
-    switch(token.token_type) {
+bool is_infix_binary_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::ASTERISK:
         case token_type_t::SLASH:
         case token_type_t::MODULO:
@@ -695,8 +706,8 @@ bool is_infix_binary_op(const token_t& token) {
     }
     return false;
 }
-ast::binary_operator_token_t parse_infix_binary_op(const token_t& token) {
-    switch(token.token_type) {
+ast::binary_operator_token_t parse_infix_binary_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::ASTERISK:
             return ast::binary_operator_token_t::MULTIPLY;
         case token_type_t::SLASH:
@@ -738,7 +749,7 @@ ast::binary_operator_token_t parse_infix_binary_op(const token_t& token) {
         case token_type_t::COMMA:
             return ast::binary_operator_token_t::COMMA;
     }
-    throw std::runtime_error("Invalid infix token.");
+    throw std::logic_error("Invalid infix token.");
 }
 std::pair<ast::precedence_t, ast::precedence_t> infix_binding_power(const ast::binary_operator_token_t token) {
     switch(token) {
@@ -775,17 +786,17 @@ std::pair<ast::precedence_t, ast::precedence_t> infix_binding_power(const ast::b
         case ast::binary_operator_token_t::COMMA:
             return {2, 1}; // left-to-right
     }
-    throw std::runtime_error("Invalid infix token.");
+    throw std::logic_error("Invalid infix token.");
 }
-std::shared_ptr<ast::binary_expression_t> make_infix_op(const ast::binary_operator_token_t op, ast::expression_t&& lhs, ast::expression_t&& rhs) {
+utils::result_t<ast::node_handle_t<ast::binary_expression_t>> make_infix_op(parser_t& parser, const ast::binary_operator_token_t op, ast::expression_t&& lhs, ast::expression_t&& rhs) {
     if(op == ast::binary_operator_token_t::ASSIGNMENT) {
-        auto lvalue = validate_lvalue_expression_exp_with_type(std::move(lhs));
-        return std::make_shared<ast::binary_expression_t>(ast::binary_expression_t{op, std::move(lvalue), std::move(rhs)});
+        TRY_ASSIGN(auto lvalue, validate_lvalue_expression_exp_with_type(parser, std::move(lhs)));
+        return ast::make_node<ast::binary_expression_t>(ast::binary_expression_t{op, std::move(lvalue), std::move(rhs)});
     }
-    return std::make_shared<ast::binary_expression_t>(ast::binary_expression_t{op, std::move(lhs), std::move(rhs)});
+    return ast::make_node<ast::binary_expression_t>(ast::binary_expression_t{op, std::move(lhs), std::move(rhs)});
 }
-bool is_compound_assignment_op(const token_t& token) {
-    switch(token.token_type) {
+bool is_compound_assignment_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_EQUALS:
         case token_type_t::MINUS_EQUALS:
         case token_type_t::TIMES_EQUALS:
@@ -800,8 +811,8 @@ bool is_compound_assignment_op(const token_t& token) {
     }
     return false;
 }
-ast::binary_operator_token_t get_op_from_compound_assignment_op(const token_t& token) {
-    switch(token.token_type) {
+ast::binary_operator_token_t get_op_from_compound_assignment_op(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::PLUS_EQUALS:
             return ast::binary_operator_token_t::PLUS;
         case token_type_t::MINUS_EQUALS:
@@ -823,60 +834,65 @@ ast::binary_operator_token_t get_op_from_compound_assignment_op(const token_t& t
         case token_type_t::RIGHT_SHIFT_EQUALS:
             return ast::binary_operator_token_t::RIGHT_BITSHIFT;
     }
-    throw std::runtime_error("Invalid compound assignment token.");
+    throw std::logic_error("Invalid compound assignment token.");
 }
 std::pair<ast::precedence_t, ast::precedence_t> ternary_binding_power() {
     return {5, 6}; // right-to-left
 }
-ast::expression_t parse_and_validate_expression(parser_t& parser, const ast::precedence_t precedence) {
-    auto lhs = parse_prefix_expression(parser);
+utils::result_t<ast::expression_t> parse_and_validate_expression(parser_t& parser, const ast::precedence_t precedence) {
+    TRY_ASSIGN(auto lhs, parse_prefix_expression(parser));
 
     for(;;) {
-        if(parser.peek_token().token_type == token_type_t::EOF_TOK) {
+        if(parser.peek_token_type() == token_type_t::EOF_TOK) {
             break;
         }
 
-        if(is_postfix_op(parser.peek_token())) {
-            auto op = parse_postfix_op(parser.peek_token());
+        if(is_postfix_op(parser.peek_token_type())) {
+            auto op = parse_postfix_op(parser.peek_token_type());
             auto post_bp = postfix_binding_power(op);
             if(post_bp < precedence) {
                 break;
             }
             parser.advance_token();
-            lhs = ast::expression_t{make_postfix_op(op, std::move(lhs)), std::nullopt};
+            TRY_ASSIGN(auto postfix_op, make_postfix_op(parser, op, std::move(lhs)));
+            lhs = ast::expression_t{std::move(postfix_op), std::nullopt};
             continue;
         }
 
-        if(is_infix_binary_op(parser.peek_token())) {
-            auto op = parse_infix_binary_op(parser.peek_token());
+        if(is_infix_binary_op(parser.peek_token_type())) {
+            auto op = parse_infix_binary_op(parser.peek_token_type());
             auto [r_bp, l_bp] = infix_binding_power(op);
             if(l_bp < precedence) {
                 break;
             }
             parser.advance_token();
-            auto rhs = parse_and_validate_expression(parser, r_bp);
-            lhs = ast::expression_t{make_infix_op(op, std::move(lhs), std::move(rhs)), std::nullopt};
+            TRY_ASSIGN(auto rhs, parse_and_validate_expression(parser, r_bp));
+            TRY_ASSIGN(auto infix_op, make_infix_op(parser, op, std::move(lhs), std::move(rhs)));
+            lhs = ast::expression_t{std::move(infix_op), std::nullopt};
             continue;
         }
 
-        if(is_compound_assignment_op(parser.peek_token())) {
-            auto op = get_op_from_compound_assignment_op(parser.peek_token());
+        if(is_compound_assignment_op(parser.peek_token_type())) {
+            auto op = get_op_from_compound_assignment_op(parser.peek_token_type());
             parser.advance_token();
-            auto lvalue = validate_lvalue_expression_exp_with_type(lhs);
-            lhs = ast::expression_t{make_infix_op(ast::binary_operator_token_t::ASSIGNMENT, ast::expression_t{validate_lvalue_expression_exp(lvalue), lvalue.type.value()}, ast::expression_t{make_infix_op(op, ast::expression_t{validate_lvalue_expression_exp(lvalue), lvalue.type.value()}, parse_and_validate_expression(parser, precedence)), std::nullopt}), std::nullopt};
+            TRY_ASSIGN(auto lvalue, validate_lvalue_expression_exp_with_type(parser, lhs));
+            TRY_ASSIGN(auto rhs, parse_and_validate_expression(parser, precedence));
+            TRY_ASSIGN(auto operation, make_infix_op(parser, op, ast::expression_t{validate_lvalue_expression_exp(lvalue), lvalue.type.value()}, std::move(rhs)));
+            TRY_ASSIGN(auto assignment, make_infix_op(parser, ast::binary_operator_token_t::ASSIGNMENT, ast::expression_t{validate_lvalue_expression_exp(lvalue), lvalue.type.value()}, ast::expression_t{std::move(operation), std::nullopt}));
+            lhs = ast::expression_t{std::move(assignment), std::nullopt};
             continue;
         }
 
-        if(parser.peek_token().token_type == token_type_t::QUESTION_MARK) {
+        if(parser.peek_token_type() == token_type_t::QUESTION_MARK) {
             auto [r_bp, l_bp] = ternary_binding_power();
             if(l_bp < precedence) {
                 break;
             }
             parser.advance_token();
-            auto if_true = parse_and_validate_expression(parser, precedence);
-            parser.expect_token(token_type_t::COLON, "Expected `:` in ternary expression.");
-            auto if_false = parse_and_validate_expression(parser, 28); // 28 is the highest level of precedence, we use this so it greedily parses `a < b ? a = 1 : a = 2` as `(a < b ? a = 1 : a) = 2` instead of `(a < b ? a = 1 : a = 2)`.
-            lhs = {std::make_shared<ast::ternary_expression_t>(ast::ternary_expression_t{std::move(lhs), std::move(if_true), std::move(if_false)}), std::nullopt};
+            TRY_ASSIGN(auto if_true, parse_and_validate_expression(parser, precedence));
+            TRY(parser.expect_token(token_type_t::COLON, "Expected `:` in ternary expression."));
+            TRY_ASSIGN(auto if_false, parse_and_validate_expression(parser, 28)); // 28 is the highest level of precedence, we use this so it greedily parses `a < b ? a = 1 : a = 2` as `(a < b ? a = 1 : a) = 2` instead of `(a < b ? a = 1 : a = 2)`.
+            lhs = {ast::make_node<ast::ternary_expression_t>(ast::ternary_expression_t{std::move(lhs), std::move(if_true), std::move(if_false)}), std::nullopt};
             continue;
         }
 
@@ -885,7 +901,7 @@ ast::expression_t parse_and_validate_expression(parser_t& parser, const ast::pre
 
     return lhs;
 }
-ast::expression_t parse_and_validate_expression(parser_t& parser) {
+utils::result_t<ast::expression_t> parse_and_validate_expression(parser_t& parser) {
     return parse_and_validate_expression(parser, 0u);
 }
 
@@ -895,184 +911,182 @@ ast::type_t make_primitive_type(token_type_t token_type) {
 }
 
 void add_floating_point_types_to_type_table(parser_t& parser) {
-    auto& floating_point_symbol_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::FLOATING));
-    floating_point_symbol_table.insert({"float", make_primitive_type(token_type_t::FLOAT_KEYWORD)});
-    floating_point_symbol_table.insert({"double", make_primitive_type(token_type_t::DOUBLE_KEYWORD)});
-    floating_point_symbol_table.insert({"long double", make_primitive_type(token_type_t::LONG_DOUBLE_KEYWORD)});
+    auto& floating_point_symbol_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::FLOATING));
+    floating_point_symbol_table.insert({ast::primitive_type_names::FLOAT, make_primitive_type(token_type_t::FLOAT_KEYWORD)});
+    floating_point_symbol_table.insert({ast::primitive_type_names::DOUBLE, make_primitive_type(token_type_t::DOUBLE_KEYWORD)});
+    floating_point_symbol_table.insert({ast::primitive_type_names::LONG_DOUBLE, make_primitive_type(token_type_t::LONG_DOUBLE_KEYWORD)});
 }
 void add_integer_types_to_type_table(parser_t& parser) {
-    auto& integer_symbol_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::INT));
-    integer_symbol_table.insert({"char", make_primitive_type(token_type_t::CHAR_KEYWORD)});
-    integer_symbol_table.insert({"signed char", make_primitive_type(token_type_t::SIGNED_CHAR_KEYWORD)});
-    integer_symbol_table.insert({"short", make_primitive_type(token_type_t::SHORT_KEYWORD)});
-    integer_symbol_table.insert({"int", make_primitive_type(token_type_t::INT_KEYWORD)});
-    integer_symbol_table.insert({"long", make_primitive_type(token_type_t::LONG_KEYWORD)});
-    integer_symbol_table.insert({"long long", make_primitive_type(token_type_t::LONG_LONG_KEYWORD)});
+    auto& integer_symbol_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::INT));
+    integer_symbol_table.insert({ast::primitive_type_names::CHAR, make_primitive_type(token_type_t::CHAR_KEYWORD)});
+    integer_symbol_table.insert({ast::primitive_type_names::SIGNED_CHAR, make_primitive_type(token_type_t::SIGNED_CHAR_KEYWORD)});
+    integer_symbol_table.insert({ast::primitive_type_names::SHORT, make_primitive_type(token_type_t::SHORT_KEYWORD)});
+    integer_symbol_table.insert({ast::primitive_type_names::INT, make_primitive_type(token_type_t::INT_KEYWORD)});
+    integer_symbol_table.insert({ast::primitive_type_names::LONG, make_primitive_type(token_type_t::LONG_KEYWORD)});
+    integer_symbol_table.insert({ast::primitive_type_names::LONG_LONG, make_primitive_type(token_type_t::LONG_LONG_KEYWORD)});
 }
 void add_unsigned_integer_types_to_type_table(parser_t& parser) {
-    auto& unsigned_integer_symbol_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::UNSIGNED_INT));
-    unsigned_integer_symbol_table.insert({"unsigned char", make_primitive_type(token_type_t::UNSIGNED_CHAR_KEYWORD)});
-    unsigned_integer_symbol_table.insert({"unsigned short", make_primitive_type(token_type_t::UNSIGNED_SHORT_KEYWORD)});
-    unsigned_integer_symbol_table.insert({"unsigned int", make_primitive_type(token_type_t::UNSIGNED_INT_KEYWORD)});
-    unsigned_integer_symbol_table.insert({"unsigned long", make_primitive_type(token_type_t::UNSIGNED_LONG_KEYWORD)});
-    unsigned_integer_symbol_table.insert({"unsigned long long", make_primitive_type(token_type_t::UNSIGNED_LONG_LONG_KEYWORD)});
+    auto& unsigned_integer_symbol_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::UNSIGNED_INT));
+    unsigned_integer_symbol_table.insert({ast::primitive_type_names::UNSIGNED_CHAR, make_primitive_type(token_type_t::UNSIGNED_CHAR_KEYWORD)});
+    unsigned_integer_symbol_table.insert({ast::primitive_type_names::UNSIGNED_SHORT, make_primitive_type(token_type_t::UNSIGNED_SHORT_KEYWORD)});
+    unsigned_integer_symbol_table.insert({ast::primitive_type_names::UNSIGNED_INT, make_primitive_type(token_type_t::UNSIGNED_INT_KEYWORD)});
+    unsigned_integer_symbol_table.insert({ast::primitive_type_names::UNSIGNED_LONG, make_primitive_type(token_type_t::UNSIGNED_LONG_KEYWORD)});
+    unsigned_integer_symbol_table.insert({ast::primitive_type_names::UNSIGNED_LONG_LONG, make_primitive_type(token_type_t::UNSIGNED_LONG_LONG_KEYWORD)});
 }
 
 bool is_a_type(const parser_t& parser) {
-    if(is_struct_keyword(parser.peek_token())) {
+    if(is_struct_keyword(parser.peek_token_type())) {
         const auto identifier_token = parser.peek_token_n(1);
-        auto type_name = ast::type_name_t(identifier_token.token_text);
-        auto& struct_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+        auto type_name = parser.token_symbol(identifier_token);
+        auto& struct_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
         auto struct_type_iter = struct_type_table.find(type_name);
         if(struct_type_iter != std::end(struct_type_table) && struct_type_iter->second.size.has_value()) {
             return true;
         }
         return false;
     }
-    if(is_keyword_a_type(parser.peek_token().token_type)) {
+    if(is_keyword_a_type(parser.peek_token_type())) {
         return true;
     }
-    auto type_name = ast::type_name_t(parser.peek_token().token_text);
-    auto& typedef_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+    auto type_name = parser.token_symbol(parser.peek_token());
+    auto& typedef_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
     if(typedef_type_table.find(type_name) != std::end(typedef_type_table)) {
         return true;
     }
     return false;
 }
 
-bool is_a_type_token(parser_t& parser, token_t token) {
-    if(is_keyword_a_type(token.token_type)) {
+bool is_a_type_token(parser_t& parser, const token_index_t token) {
+    if(is_keyword_a_type(parser.token_type(token))) {
         return true;
     }
-    auto type_name = ast::type_name_t(token.token_text);
-    auto& typedef_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+    auto type_name = parser.token_symbol(token);
+    auto& typedef_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
     if(typedef_type_table.find(type_name) != std::end(typedef_type_table)) {
         return true;
     }
     return false;
 }
 
-ast::type_t parse_type_name_from_token(parser_t& parser, token_t token) {
-    if(is_keyword_a_type(token.token_type)) {
+utils::result_t<ast::type_t> parse_type_name_from_token(parser_t& parser, const token_index_t token) {
+    if(is_keyword_a_type(parser.token_type(token))) {
         // Return the primitive type associated with it
-        const ast::type_category_t type_category = get_type_category_from_token_type(token.token_type);
-        auto type_name = ast::type_name_t(token.token_text);
-        auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(type_category));
+        const ast::type_category_t type_category = get_type_category_from_token_type(parser.token_type(token));
+        auto type_name = primitive_token_keyword_to_name(parser.token_type(token));
+        auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(type_category));
         auto type_iter = type_table.find(type_name);
         if(type_iter == std::end(type_table)) {
-            throw std::runtime_error("Type not found.");
+            return parser.error("Type not found.");
         }
         return type_iter->second;
     } else {
         // Check whether it is a valid typedef name
-        auto type_name = ast::type_name_t(token.token_text);
-        auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+        auto type_name = parser.token_symbol(token);
+        auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
         auto type_iter = type_table.find(type_name);
         if(type_iter == std::end(type_table)) {
-            throw std::runtime_error("Type not found.");
+            return parser.error("Type not found.");
         }
         return type_iter->second;
     }
 }
-ast::type_t parse_struct_name_from_token(parser_t& parser, token_t token) {
+utils::result_t<ast::type_t> parse_struct_name_from_token(parser_t& parser, const token_index_t token) {
     // Check whether struct exists with the next token's name (if identifier type)
     // Since we don't currently support pointers, if the struct type only has a forward declaration, we will throw as it is an invalid type to instantiate
-    auto type_name = ast::type_name_t(token.token_text);
-    auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+    auto type_name = parser.token_symbol(token);
+    auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
     auto type_iter = type_table.find(type_name);
     if(type_iter == std::end(type_table)) {
-        throw std::runtime_error("Type not found.");
+        return parser.error("Type not found.");
     }
     if(!type_iter->second.size.has_value()) {
-        throw std::runtime_error("Cannot instantiate struct forward declaration.");
+        return parser.error("Cannot instantiate struct forward declaration.");
     }
     return type_iter->second;
 }
 
-ast::global_variable_declaration_t parse_global_variable_declaration(parser_t& parser, ast::type_t var_type, token_t name_token) {
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of global variable declaration.");
+utils::result_t<ast::global_variable_declaration_t> parse_global_variable_declaration(parser_t& parser, ast::type_t var_type, const ast::var_name_t var_name) {
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of global variable declaration."));
 
-    auto var_name = ast::var_name_t(name_token.token_text);
 
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, var_name) || utils::contains(parser.symbol_info.function_definitions_lookup, var_name)) {
-        throw std::runtime_error("Global variable [" + var_name + "] already declared as a function.");
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, var_name) || utils::contains(parser.symbol_info.globals->function_definitions_lookup, var_name)) {
+        return parser.error("Global variable [" + var_name.str() + "] already declared as a function.");
     }
 
-    if(utils::contains(parser.symbol_info.global_variable_declarations, var_name)) {
-        auto existing_declaration = parser.symbol_info.global_variable_declarations.at(var_name);
+    if(utils::contains(parser.symbol_info.globals->global_variable_declarations, var_name)) {
+        auto existing_declaration = parser.symbol_info.globals->global_variable_declarations.at(var_name);
 
-        validate_type_name(existing_declaration.type_name, var_type, "Mismatched global variable type.");
+        TRY(validate_type_name(parser, existing_declaration.type_name.value(), var_type, "Mismatched global variable type."));
     }
-    if(utils::contains(parser.symbol_info.global_variable_definitions, var_name)) {
-        auto existing_definition = parser.symbol_info.global_variable_definitions.at(var_name);
+    if(utils::contains(parser.symbol_info.globals->global_variable_definitions, var_name)) {
+        auto existing_definition = parser.symbol_info.globals->global_variable_definitions.at(var_name);
 
-        validate_type_name(existing_definition.type_name, var_type, "Mismatched global variable type.");
+        TRY(validate_type_name(parser, existing_definition.type_name.value(), var_type, "Mismatched global variable type."));
     }
 
     auto global_var_declaration = ast::global_variable_declaration_t{std::move(var_type), var_name, std::nullopt};
 
-    parser.symbol_info.global_variable_declarations.insert({std::move(var_name), global_var_declaration}); // idempotent operation
+    parser.symbol_info.globals->global_variable_declarations.insert({std::move(var_name), global_var_declaration}); // idempotent operation
 
     return global_var_declaration;
 }
-ast::global_variable_declaration_t parse_global_variable_definition(parser_t& parser, ast::type_t var_type, token_t name_token) {
-    parser.expect_token(token_type_t::EQUALS, "Expected `=` in global variable definition.");
+utils::result_t<ast::global_variable_declaration_t> parse_global_variable_definition(parser_t& parser, ast::type_t var_type, const ast::var_name_t var_name) {
+    TRY(parser.expect_token(token_type_t::EQUALS, "Expected `=` in global variable definition."));
 
-    auto expression = parse_and_validate_expression(parser);
+    TRY_ASSIGN(auto expression, parse_and_validate_expression(parser));
 
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of global variable definition.");
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of global variable definition."));
 
-    auto var_name = ast::var_name_t(name_token.token_text);
 
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, var_name) || utils::contains(parser.symbol_info.function_definitions_lookup, var_name)) {
-        throw std::runtime_error("Global variable [" + var_name + "] already declared as a function.");
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, var_name) || utils::contains(parser.symbol_info.globals->function_definitions_lookup, var_name)) {
+        return parser.error("Global variable [" + var_name.str() + "] already declared as a function.");
     }
 
-    if(utils::contains(parser.symbol_info.global_variable_definitions, var_name)) {
-        throw std::runtime_error("Global variable [" + var_name + "] already defined.");
+    if(utils::contains(parser.symbol_info.globals->global_variable_definitions, var_name)) {
+        return parser.error("Global variable [" + var_name.str() + "] already defined.");
     }
 
-    if(utils::contains(parser.symbol_info.global_variable_declarations, var_name)) {
-        auto existing_declaration = parser.symbol_info.global_variable_declarations.at(var_name);
+    if(utils::contains(parser.symbol_info.globals->global_variable_declarations, var_name)) {
+        auto existing_declaration = parser.symbol_info.globals->global_variable_declarations.at(var_name);
 
-        validate_type_name(existing_declaration.type_name, var_type, "Mismatched global variable type.");
+        TRY(validate_type_name(parser, existing_declaration.type_name.value(), var_type, "Mismatched global variable type."));
     }
 
-    validate_compile_time_expression(parser.symbol_info, expression);
+    TRY(validate_compile_time_expression(parser, expression));
 
     auto global_var_definition = ast::global_variable_declaration_t{std::move(var_type), var_name, std::move(expression)};
 
-    parser.symbol_info.global_variable_definitions.insert({std::move(var_name), global_var_definition}); // idempotent operation
+    parser.symbol_info.globals->global_variable_definitions.insert({std::move(var_name), global_var_definition}); // idempotent operation
 
     return global_var_definition;
 }
 
-ast::type_t parse_and_validate_typedef_struct_body(parser_t& parser, const ast::type_name_t& name) {
-    parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition.");
+utils::result_t<ast::type_t> parse_and_validate_typedef_struct_body(parser_t& parser, const ast::type_name_t& name) {
+    TRY(parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition."));
 
     std::vector<ast::type_t> struct_field_types;
-    std::vector<std::string> struct_field_names;
+    std::vector<ast::var_name_t> struct_field_names;
 
-    while(parser.peek_token().token_type != token_type_t::RIGHT_CURLY) {
-        auto field_type = parse_and_validate_type(parser);
+    while(parser.peek_token_type() != token_type_t::RIGHT_CURLY) {
+        TRY_ASSIGN(auto field_type, parse_and_validate_type(parser));
 
-        std::vector<std::string> field_names_in_line;
+        std::vector<ast::var_name_t> field_names_in_line;
         auto field_name = parser.advance_token();
-        if(field_name.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in struct definition for field.");
+        if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in struct definition for field.");
         }
-        field_names_in_line.push_back(std::string(field_name.token_text));
+        field_names_in_line.push_back(parser.token_symbol(field_name));
 
-        while(parser.peek_token().token_type == token_type_t::COMMA) {
+        while(parser.peek_token_type() == token_type_t::COMMA) {
             parser.advance_token();
             field_name = parser.advance_token();
-            if(field_name.token_type != token_type_t::IDENTIFIER) {
-                throw std::runtime_error("Expected identifier name in struct definition for field.");
+            if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+                return parser.error("Expected identifier name in struct definition for field.");
             }
-            field_names_in_line.push_back(std::string(field_name.token_text));
+            field_names_in_line.push_back(parser.token_symbol(field_name));
         }
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition."));
 
         for(auto& field_name : field_names_in_line) {
             struct_field_types.push_back(field_type);
@@ -1080,37 +1094,42 @@ ast::type_t parse_and_validate_typedef_struct_body(parser_t& parser, const ast::
         }
     }
 
-    parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition.");
+    TRY(parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition."));
 
-    return make_struct_definition_type_t(parser.symbol_info.type_table, name, std::move(struct_field_types), std::move(struct_field_names));
+    parser.get_debug_output() << "make_struct_definition_type_t: " << name << "\n";
+    auto struct_definition = make_struct_definition_type_t(parser.symbol_info.globals->type_table, name, std::move(struct_field_types), std::move(struct_field_names));
+    if(!struct_definition.has_value()) {
+        return parser.error("You cannot instantiate a struct forward declaration.");
+    }
+    return std::move(struct_definition.value());
 }
 
-ast::type_t parse_and_validate_anonymous_typedef_struct_definition(parser_t& parser) {
-    parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition.");
+utils::result_t<ast::type_t> parse_and_validate_anonymous_typedef_struct_definition(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition."));
 
     std::vector<ast::type_t> struct_field_types;
-    std::vector<std::string> struct_field_names;
+    std::vector<ast::var_name_t> struct_field_names;
 
-    while(parser.peek_token().token_type != token_type_t::RIGHT_CURLY) {
-        auto field_type = parse_and_validate_type(parser);
+    while(parser.peek_token_type() != token_type_t::RIGHT_CURLY) {
+        TRY_ASSIGN(auto field_type, parse_and_validate_type(parser));
 
-        std::vector<std::string> field_names_in_line;
+        std::vector<ast::var_name_t> field_names_in_line;
         auto field_name = parser.advance_token();
-        if(field_name.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in struct definition for field.");
+        if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in struct definition for field.");
         }
-        field_names_in_line.push_back(std::string(field_name.token_text));
+        field_names_in_line.push_back(parser.token_symbol(field_name));
 
-        while(parser.peek_token().token_type == token_type_t::COMMA) {
+        while(parser.peek_token_type() == token_type_t::COMMA) {
             parser.advance_token();
             field_name = parser.advance_token();
-            if(field_name.token_type != token_type_t::IDENTIFIER) {
-                throw std::runtime_error("Expected identifier name in struct definition for field.");
+            if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+                return parser.error("Expected identifier name in struct definition for field.");
             }
-            field_names_in_line.push_back(std::string(field_name.token_text));
+            field_names_in_line.push_back(parser.token_symbol(field_name));
         }
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition."));
 
         for(auto& field_name : field_names_in_line) {
             struct_field_types.push_back(field_type);
@@ -1118,128 +1137,127 @@ ast::type_t parse_and_validate_anonymous_typedef_struct_definition(parser_t& par
         }
     }
 
-    parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition.");
+    TRY(parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition."));
 
-    return make_anonymous_struct_definition_type_t(parser.symbol_info.type_table, std::move(struct_field_types), std::move(struct_field_names));
+    parser.get_debug_output() << "make_struct_definition_type_t: " << ast::ANONYMOUS_TYPE_NAME << "\n";
+    auto struct_definition = make_anonymous_struct_definition_type_t(parser.symbol_info.globals->type_table, std::move(struct_field_types), std::move(struct_field_names));
+    if(!struct_definition.has_value()) {
+        return parser.error("You cannot instantiate a struct forward declaration.");
+    }
+    return std::move(struct_definition.value());
 }
 
-ast::type_t parse_and_validate_type(parser_t& parser) {
-    if(is_struct_keyword(parser.peek_token())) {
+utils::result_t<ast::type_t> parse_and_validate_type(parser_t& parser) {
+    if(is_struct_keyword(parser.peek_token_type())) {
         // Check whether struct exists with the next token's name (if identifier type)
         // Since we don't currently support pointers, if the struct type only has a forward declaration, we will throw as it is an invalid type to instantiate
         parser.advance_token();
         const auto type_token = parser.advance_token();
-        auto type_name = ast::type_name_t(type_token.token_text);
-        auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+        auto type_name = parser.token_symbol(type_token);
+        auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
         auto type_iter = type_table.find(type_name);
         if(type_iter == std::end(type_table)) {
-            throw std::runtime_error("Type not found.");
+            return parser.error("Type not found.");
         }
         if(!type_iter->second.size.has_value()) {
-            throw std::runtime_error("Cannot instantiate struct forward declaration.");
+            return parser.error("Cannot instantiate struct forward declaration.");
         }
         return type_iter->second;
-    } else if(is_keyword_a_type(parser.peek_token().token_type)) {
+    } else if(is_keyword_a_type(parser.peek_token_type())) {
         // Return the primitive type associated with it
         const auto type_token = parser.advance_token();
-        const ast::type_category_t type_category = get_type_category_from_token_type(type_token.token_type);
-        auto type_name = ast::type_name_t(type_token.token_text);
-        auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(type_category));
+        const ast::type_category_t type_category = get_type_category_from_token_type(parser.token_type(type_token));
+        auto type_name = primitive_token_keyword_to_name(parser.token_type(type_token));
+        auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(type_category));
         auto type_iter = type_table.find(type_name);
         if(type_iter == std::end(type_table)) {
-            throw std::runtime_error("Type not found.");
+            return parser.error("Type not found.");
         }
         return type_iter->second;
     } else {
         // Check whether it is a valid typedef name
         const auto type_token = parser.advance_token();
-        auto type_name = ast::type_name_t(type_token.token_text);
-        auto& type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+        auto type_name = parser.token_symbol(type_token);
+        auto& type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
         auto type_iter = type_table.find(type_name);
         if(type_iter == std::end(type_table)) {
-            throw std::runtime_error("Type not found.");
+            return parser.error("Type not found.");
         }
 
-        auto actual_type_alias_iter = type_iter;
-
         if(!type_iter->second.size.has_value()) {
-            while(type_iter->second.aliased_type_category.value() == ast::type_category_t::TYPEDEF) {
-                type_iter = type_table.find(type_iter->second.aliased_type.value());
-                if(type_iter == std::end(type_table)) {
-                    throw std::runtime_error("Type not found.");
-                }
-            }
-
-            auto& aliased_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(type_iter->second.aliased_type_category.value()));
-            auto aliased_type_iter = aliased_type_table.find(type_iter->second.aliased_type.value());
-
-            if(!aliased_type_iter->second.size.has_value() && aliased_type_iter->second.type_category != ast::type_category_t::STRUCT) {
-                std::cout << "type_iter->second.type_name: " << type_iter->second.type_name << '\n';
-                std::cout << "type_iter->second.type_category: " << static_cast<std::uint32_t>(type_iter->second.type_category) << '\n';
-
-                throw std::logic_error("Expected struct for undefined type size in typedef.");
+            const ast::type_t *const aliased_type = get_aliased_type(parser.symbol_info.globals->type_table, type_iter->second);
+            if(aliased_type == nullptr) {
+                return parser.error("Cannot instantiate aliased struct forward declaration.");
             }
-
-            if(aliased_type_iter == std::end(aliased_type_table)) {
-                throw std::runtime_error("Cannot instantiate aliased struct forward declaration.");
-            }
-            if(!aliased_type_iter->second.size.has_value()) {
-                throw std::runtime_error("Cannot instantiate aliased struct forward declaration.");
+            if(!aliased_type->size.has_value()) {
+                if(aliased_type->type_category != ast::type_category_t::STRUCT) {
+                    throw std::logic_error("Expected struct for undefined type size in typedef.");
+                }
+                return parser.error("Cannot instantiate aliased struct forward declaration.");
             }
         }
 
-        return actual_type_alias_iter->second;
+        return type_iter->second;
     }
 }
 
 // TODO: Maybe move to and create ast.cpp:
-std::optional<ast::type_t> get_aliased_type_name(const ast::type_table_t& type_table, const ast::type_name_t& type_name) {
-    auto type_iter = type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF)).find(type_name);
-    if(type_iter == std::end(type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF)))) {
-        return std::nullopt;
-    }
-    while(type_iter->second.type_category == ast::type_category_t::TYPEDEF) {
-        auto& aliased_type_table = type_table.at(static_cast<std::uint32_t>(type_iter->second.aliased_type_category.value()));
-        auto new_type_iter = aliased_type_table.find(type_iter->second.aliased_type.value());
-        if(new_type_iter == std::end(aliased_type_table)) {
-            return std::nullopt;
-        }
-        type_iter = new_type_iter;
+const ast::type_t* get_aliased_type_name(const ast::type_table_t& type_table, const ast::type_name_t& type_name) {
+    const auto& typedef_type_table = type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+    const auto type_iter = typedef_type_table.find(type_name);
+    if(type_iter == std::end(typedef_type_table)) {
+        return nullptr;
     }
-    return type_iter->second;
+    return get_aliased_type(type_table, type_iter->second);
 }
-std::optional<ast::type_t> get_aliased_type(const ast::type_table_t& type_table, const ast::type_t& type) {
+const ast::type_t* get_aliased_type(const ast::type_table_t& type_table, const ast::type_t& type) {
     if(type.type_category != ast::type_category_t::TYPEDEF) {
         throw std::logic_error("Expected type category to be TYPEDEF.");
     }
-    return get_aliased_type_name(type_table, type.type_name);
-}
-std::optional<ast::type_t> get_underlying_type(const ast::type_table_t& type_table, const ast::type_t& type) {
-    if(type.type_category != ast::type_category_t::TYPEDEF) {
-        return type;
+    // the typedef chain was already resolved when the typedef was defined, see `make_typedef_type_t()`
+    const auto& underlying_type_table = type_table.at(static_cast<std::uint32_t>(type.underlying_type_category.value()));
+    const auto underlying_type_iter = underlying_type_table.find(type.underlying_type.value());
+    if(underlying_type_iter == std::end(underlying_type_table)) {
+        return nullptr;
+    }
+    return &underlying_type_iter->second;
+}
+const ast::type_t* get_underlying_type(const ast::type_table_t& type_table, const ast::type_t& type) {
+    if(type.type_category == ast::type_category_t::TYPEDEF && type.size.has_value()) {
+        return &type; // a typedef of an anonymous struct carries the struct's definition itself
+    }
+    const ast::type_t *const underlying_type = (type.type_category == ast::type_category_t::TYPEDEF) ? get_aliased_type(type_table, type) : &type;
+    if(underlying_type != nullptr && underlying_type->type_category == ast::type_category_t::STRUCT && !underlying_type->size.has_value()) {
+        // the struct was only forward declared where `type` was named, look up its definition
+        const auto& struct_type_table = type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+        const auto struct_type_iter = struct_type_table.find(underlying_type->type_name);
+        if(struct_type_iter == std::end(struct_type_table)) {
+            return nullptr;
+        }
+        return &struct_type_iter->second;
     }
-    return get_aliased_type(type_table, type);
+    return underlying_type;
 }
 
-ast::type_t parse_typedef_struct_decl_or_def(parser_t& parser) {
-    parser.expect_token(token_type_t::STRUCT_KEYWORD, "Expected `struct` keyword in struct declaration/definition.");
+utils::result_t<ast::type_t> parse_typedef_struct_decl_or_def(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::STRUCT_KEYWORD, "Expected `struct` keyword in struct declaration/definition."));
 
     const auto name_token = parser.peek_token();
-    if(name_token.token_type == token_type_t::IDENTIFIER) {
+    if(parser.token_type(name_token) == token_type_t::IDENTIFIER) {
         parser.advance_token(); // consume name token
-        auto name = ast::type_name_t(name_token.token_text);
+        auto name = parser.token_symbol(name_token);
 
-        auto& struct_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+        auto& struct_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
 
         const auto next_token = parser.peek_token();
-        if(next_token.token_type == token_type_t::LEFT_CURLY) {
+        if(parser.token_type(next_token) == token_type_t::LEFT_CURLY) {
             // parse struct definition
             if(!utils::contains(struct_type_table, name) || !struct_type_table.at(name).size.has_value()) {
-                auto struct_definition = parse_and_validate_typedef_struct_body(parser, name);
+                TRY_ASSIGN(auto struct_definition, parse_and_validate_typedef_struct_body(parser, name));
                 struct_type_table[name] = struct_definition;
                 return struct_definition;
             }
-            throw std::runtime_error("Struct [" + name + "] already defined.");
+            return parser.error("Struct [" + name.str() + "] already defined.");
         }
         else {
             // parse struct declaration
@@ -1249,95 +1267,100 @@ ast::type_t parse_typedef_struct_decl_or_def(parser_t& parser) {
             }
             return struct_forward_decl;
         }
-    } else if(name_token.token_type == token_type_t::LEFT_CURLY) {
+    } else if(parser.token_type(name_token) == token_type_t::LEFT_CURLY) {
         return parse_and_validate_anonymous_typedef_struct_definition(parser);
     } else {
-        throw std::runtime_error("Expected identifier name in struct declaration/definition.");
+        return parser.error("Expected identifier name in struct declaration/definition.");
     }
 }
 
-ast::return_statement_t parse_and_validate_return_statement(parser_t& parser) {
-    parser.expect_token(token_type_t::RETURN_KEYWORD, "Expected `return` keyword in statement.");
+utils::result_t<ast::return_statement_t> parse_and_validate_return_statement(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::RETURN_KEYWORD, "Expected `return` keyword in statement."));
 
-    auto expression = parse_and_validate_expression(parser);
+    TRY_ASSIGN(auto expression, parse_and_validate_expression(parser));
 
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement.");
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement."));
 
     return ast::return_statement_t{std::move(expression)};
 }
-ast::expression_statement_t parse_and_validate_expression_statement(parser_t& parser) {
-    if(parser.peek_token().token_type == token_type_t::SEMICOLON) {
+utils::result_t<ast::expression_statement_t> parse_and_validate_expression_statement(parser_t& parser) {
+    if(parser.peek_token_type() == token_type_t::SEMICOLON) {
         parser.advance_token();
         return ast::expression_statement_t{std::nullopt}; // null statement, i.e. `;`
     }
 
-    auto expression = parse_and_validate_expression(parser);
+    TRY_ASSIGN(auto expression, parse_and_validate_expression(parser));
 
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement.");
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement."));
 
     return ast::expression_statement_t{std::move(expression)};
 }
-ast::if_statement_t parse_and_validate_if_statement(parser_t& parser) {
-    parser.expect_token(token_type_t::IF_KEYWORD, "Expected `if` keyword in statement.");
+utils::result_t<ast::if_statement_t> parse_and_validate_if_statement(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::IF_KEYWORD, "Expected `if` keyword in statement."));
 
-    parser.expect_token(token_type_t::LEFT_PAREN, "Expected `(` in statement.");
+    TRY(parser.expect_token(token_type_t::LEFT_PAREN, "Expected `(` in statement."));
 
-    auto if_exp = parse_and_validate_expression(parser);
+    TRY_ASSIGN(auto if_exp, parse_and_validate_expression(parser));
 
-    parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in statement.");
+    TRY(parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in statement."));
 
     ast::statement_t if_body;
-    if(parser.peek_token().token_type == token_type_t::LEFT_CURLY) {
-        if_body = std::make_shared<ast::compound_statement_t>(parse_and_validate_compound_statement(parser));
+    if(parser.peek_token_type() == token_type_t::LEFT_CURLY) {
+        TRY_ASSIGN(auto compound_statement, parse_and_validate_compound_statement(parser));
+        if_body = ast::make_node<ast::compound_statement_t>(std::move(compound_statement));
     } else {
-        if_body = parse_and_validate_statement(parser);
+        TRY_ASSIGN(if_body, parse_and_validate_statement(parser));
     }
 
-    if(parser.peek_token().token_type != token_type_t::ELSE_KEYWORD) {
+    if(parser.peek_token_type() != token_type_t::ELSE_KEYWORD) {
         return ast::if_statement_t{std::move(if_exp), std::move(if_body), std::nullopt};
     }
 
     parser.advance_token(); // consume `else` keyword
 
-    if(parser.peek_token().token_type == token_type_t::LEFT_CURLY) {
-        return ast::if_statement_t{std::move(if_exp), std::move(if_body), std::make_shared<ast::compound_statement_t>(parse_and_validate_compound_statement(parser))};
+    if(parser.peek_token_type() == token_type_t::LEFT_CURLY) {
+        TRY_ASSIGN(auto else_body, parse_and_validate_compound_statement(parser));
+        return ast::if_statement_t{std::move(if_exp), std::move(if_body), ast::make_node<ast::compound_statement_t>(std::move(else_body))};
     } else {
-        return ast::if_statement_t{std::move(if_exp), std::move(if_body), parse_and_validate_statement(parser)};
+        TRY_ASSIGN(auto else_body, parse_and_validate_statement(parser));
+        return ast::if_statement_t{std::move(if_exp), std::move(if_body), std::move(else_body)};
     }
 }
-ast::statement_t parse_and_validate_statement(parser_t& parser) {
+utils::result_t<ast::statement_t> parse_and_validate_statement(parser_t& parser) {
     if(parser.is_eof()) {
-        throw std::runtime_error("Unexpected end of file.");
+        return parser.error("Unexpected end of file.");
     }
 
-    const auto next_token_type = parser.peek_token().token_type;
+    const auto next_token_type = parser.peek_token_type();
     if(next_token_type == token_type_t::RETURN_KEYWORD) {
         return parse_and_validate_return_statement(parser);
     } else if(next_token_type == token_type_t::IF_KEYWORD) {
-        return std::make_shared<ast::if_statement_t>(parse_and_validate_if_statement(parser));
+        TRY_ASSIGN(auto if_statement, parse_and_validate_if_statement(parser));
+        return ast::statement_t{ast::make_node<ast::if_statement_t>(std::move(if_statement))};
     } else if(next_token_type == token_type_t::LEFT_CURLY) {
-        return std::make_shared<ast::compound_statement_t>(parse_and_validate_compound_statement(parser));
+        TRY_ASSIGN(auto compound_statement, parse_and_validate_compound_statement(parser));
+        return ast::statement_t{ast::make_node<ast::compound_statement_t>(std::move(compound_statement))};
     }
     return parse_and_validate_expression_statement(parser);
 }
-ast::declaration_t parse_and_validate_declaration(parser_t& parser) {
-    const auto type = parse_and_validate_type(parser);
+utils::result_t<ast::declaration_t> parse_and_validate_declaration(parser_t& parser) {
+    TRY_ASSIGN(const auto type, parse_and_validate_type(parser));
 
     auto identifier_token = parser.advance_token();
-    if(identifier_token.token_type != token_type_t::IDENTIFIER) {
-        throw std::runtime_error("Expected identifier.");
+    if(parser.token_type(identifier_token) != token_type_t::IDENTIFIER) {
+        return parser.error("Expected identifier.");
     }
 
-    auto var_name = ast::var_name_t(identifier_token.token_text);
+    auto var_name = parser.token_symbol(identifier_token);
 
     if(parser.symbol_info.variable_lookup.contains_in_lowest_scope(var_name)) {
-        throw std::runtime_error("Variable " + var_name + " already declared in current scope.");
+        return parser.error("Variable " + var_name.str() + " already declared in current scope.");
     }
 
-    if(parser.peek_token().token_type != token_type_t::EQUALS) {
+    if(parser.peek_token_type() != token_type_t::EQUALS) {
         auto ret = ast::declaration_t{type, var_name, std::nullopt};
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement."));
 
         parser.symbol_info.variable_lookup.add_new_variable_in_current_scope(var_name, type);
 
@@ -1346,32 +1369,35 @@ ast::declaration_t parse_and_validate_declaration(parser_t& parser) {
 
     parser.advance_token(); // consume `=` token
 
-    auto ret = ast::declaration_t{type, var_name, parse_and_validate_expression(parser)};
+    TRY_ASSIGN(auto value, parse_and_validate_expression(parser));
+    auto ret = ast::declaration_t{type, var_name, std::move(value)};
 
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement.");
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in statement."));
 
     parser.symbol_info.variable_lookup.add_new_variable_in_current_scope(var_name, type);
 
     return ret;
 }
-ast::compound_statement_t parse_and_validate_compound_statement(parser_t& parser, bool is_function_block) {
+utils::result_t<ast::compound_statement_t> parse_and_validate_compound_statement(parser_t& parser, bool is_function_block) {
     if(!is_function_block) {
         parser.symbol_info.variable_lookup.create_new_scope();
     }
 
-    parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in statement.");
+    TRY(parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in statement."));
 
     ast::compound_statement_t ret{};
 
-    while(parser.peek_token().token_type != token_type_t::RIGHT_CURLY) {
+    while(parser.peek_token_type() != token_type_t::RIGHT_CURLY) {
         if(parser.is_eof()) {
-            throw std::runtime_error("Unexpected end of file. Unterminated compound statement.");
+            return parser.error("Unexpected end of file. Unterminated compound statement.");
         }
 
         if(is_a_type(parser)) {
-            ret.stmts.push_back(parse_and_validate_declaration(parser));
+            TRY_ASSIGN(auto declaration, parse_and_validate_declaration(parser));
+            ret.stmts.push_back(std::move(declaration));
         } else {
-            ret.stmts.push_back(parse_and_validate_statement(parser));
+            TRY_ASSIGN(auto statement, parse_and_validate_statement(parser));
+            ret.stmts.push_back(std::move(statement));
         }
     }
     parser.advance_token(); // consume `}` token
@@ -1382,62 +1408,113 @@ ast::compound_statement_t parse_and_validate_compound_statement(parser_t& parser
 
     return ret;
 }
-ast::function_declaration_t parse_function_declaration(parser_t& parser, ast::type_t type, const token_t name_token, std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>>&& param_list) {
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in function declaration.");
+utils::result_t<ast::function_declaration_t> parse_function_declaration(parser_t& parser, ast::type_t type, const ast::func_name_t name, std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>>&& param_list) {
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in function declaration."));
 
 
-    auto function_declaration = ast::function_declaration_t{ type, ast::func_name_t(name_token.token_text), parse_function_declaration_parameter_list(param_list) };
+    auto function_declaration = ast::function_declaration_t{ type, name, parse_function_declaration_parameter_list(param_list) };
 
-    if(utils::contains(parser.symbol_info.global_variable_declarations, function_declaration.function_name) || utils::contains(parser.symbol_info.global_variable_definitions, function_declaration.function_name)) {
-        throw std::runtime_error("Function [" + function_declaration.function_name + "] is already declared as a global variable.");
+    if(utils::contains(parser.symbol_info.globals->global_variable_declarations, function_declaration.function_name) || utils::contains(parser.symbol_info.globals->global_variable_definitions, function_declaration.function_name)) {
+        return parser.error("Function [" + function_declaration.function_name.str() + "] is already declared as a global variable.");
     }
 
-    if(utils::contains(parser.symbol_info.function_definitions_lookup, function_declaration.function_name)) {
-        const auto existing_function_definition = parser.symbol_info.function_definitions_lookup.at(function_declaration.function_name);
-        validate_type_name(function_declaration.return_type, existing_function_definition.return_type, "Function [" + function_declaration.function_name + "] return type mismatch.");
+    if(utils::contains(parser.symbol_info.globals->function_definitions_lookup, function_declaration.function_name)) {
+        const auto existing_function_definition = parser.symbol_info.globals->function_definitions_lookup.at(function_declaration.function_name);
+        TRY(validate_type_name(parser, function_declaration.return_type, existing_function_definition.return_type, "Function [" + function_declaration.function_name.str() + "] return type mismatch."));
         if(function_declaration.params.size() != existing_function_definition.params.size()) {
-            throw std::runtime_error("Function [" + function_declaration.function_name + "] param count mismatch.");
+            return parser.error("Function [" + function_declaration.function_name.str() + "] param count mismatch.");
         }
         for(std::uint32_t i = 0u; i < function_declaration.params.size(); ++i) {
-            validate_type_name(function_declaration.params[i], existing_function_definition.params[i].first, "Function [" + function_declaration.function_name + "] param type mismatch.");
+            TRY(validate_type_name(parser, function_declaration.params[i].value(), existing_function_definition.params[i].first.value(), "Function [" + function_declaration.function_name.str() + "] param type mismatch."));
         }
     }
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, function_declaration.function_name)) {
-        const auto existing_function_declaration = parser.symbol_info.function_declarations_lookup.at(function_declaration.function_name);
-        validate_type_name(function_declaration.return_type, existing_function_declaration.return_type, "Function [" + function_declaration.function_name + "] return type mismatch.");
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, function_declaration.function_name)) {
+        const auto existing_function_declaration = parser.symbol_info.globals->function_declarations_lookup.at(function_declaration.function_name);
+        TRY(validate_type_name(parser, function_declaration.return_type, existing_function_declaration.return_type, "Function [" + function_declaration.function_name.str() + "] return type mismatch."));
         if(function_declaration.params.size() != existing_function_declaration.params.size()) {
-            throw std::runtime_error("Function [" + function_declaration.function_name + "] param count mismatch.");
+            return parser.error("Function [" + function_declaration.function_name.str() + "] param count mismatch.");
         }
         for(std::uint32_t i = 0u; i < function_declaration.params.size(); ++i) {
-            validate_type_name(function_declaration.params[i], existing_function_declaration.params[i], "Function [" + function_declaration.function_name + "] param type mismatch.");
+            TRY(validate_type_name(parser, function_declaration.params[i].value(), existing_function_declaration.params[i].value(), "Function [" + function_declaration.function_name.str() + "] param type mismatch."));
         }
     } else {
-        parser.symbol_info.function_declarations_lookup.insert({function_declaration.function_name, function_declaration});
+        parser.symbol_info.globals->function_declarations_lookup.insert({function_declaration.function_name, function_declaration});
     }
 
 
     return function_declaration;
 }
-ast::function_definition_t parse_function_definition(parser_t& parser, ast::type_t type, const token_t name_token, std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>>&& param_list) {
-    auto name = ast::func_name_t(name_token.token_text);
+static const ast::func_name_t main_function_name{"main"};
+utils::result_t<ast::compound_statement_t> parse_and_validate_function_body(parser_t& parser, const ast::function_definition_t& function_definition) {
+    parser.symbol_info.variable_lookup.create_new_scope();
+    for(const auto& param : function_definition.params) {
+        if(param.second.has_value()) {
+            parser.symbol_info.variable_lookup.add_new_variable_in_current_scope(param.second.value(), parser.symbol_info.globals->get_type(param.first));
+        }
+    }
+    TRY_ASSIGN(ast::compound_statement_t function_body_statements, parse_and_validate_compound_statement(parser, true));
+    parser.symbol_info.variable_lookup.destroy_current_scope();
+
 
-    if(utils::contains(parser.symbol_info.global_variable_declarations, name) || utils::contains(parser.symbol_info.global_variable_definitions, name)) {
-        throw std::runtime_error("Function [" + name + "] is already declared as a global variable.");
+    if(function_definition.function_name == main_function_name && function_definition.return_type.type_name == ast::primitive_type_names::INT) {
+        constexpr int DEFAULT_RETURN_VALUE = 0;
+        // use `has_return_statement` instead of `is_return_statement` because we don't need to emit a return statement if there already is one,
+        //  even if there is unreachable code after the already existing return statement.
+        if(function_body_statements.stmts.size() == 0 || !has_return_statement(function_body_statements)) {
+            function_body_statements.stmts.push_back(ast::return_statement_t { ast::expression_t{ ast::constant_t{DEFAULT_RETURN_VALUE}, make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t)) } } );
+        }
+    }
+
+    return function_body_statements;
+}
+// Skips over a function body by matching braces, without validating anything in it.
+utils::result_t<skipped_function_body_t> skip_function_body(parser_t& parser) {
+    skipped_function_body_t skipped_body{parser.tokens, {}};
+
+    std::uint32_t depth = 0u;
+    do {
+        const auto token = parser.advance_token();
+        switch(parser.token_type(token)) {
+            case token_type_t::LEFT_CURLY:
+                ++depth;
+                break;
+            case token_type_t::RIGHT_CURLY:
+                --depth;
+                break;
+            case token_type_t::IDENTIFIER:
+                skipped_body.identifiers.push_back(parser.token_symbol(token));
+                break;
+            case token_type_t::EOF_TOK:
+                return parser.error("Unexpected end of file.");
+            case token_type_t::ERROR:
+                // the lexer prints something for every error token, so the body can't be lexed a second time without printing it twice
+                return parser.error("Invalid token in function body.");
+            default:
+                break;
+        }
+    } while(depth != 0u);
+
+    return skipped_body;
+}
+utils::result_t<ast::function_definition_t> parse_function_definition(parser_t& parser, ast::type_t type, const ast::func_name_t name, std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>>&& param_list) {
+
+    if(utils::contains(parser.symbol_info.globals->global_variable_declarations, name) || utils::contains(parser.symbol_info.globals->global_variable_definitions, name)) {
+        return parser.error("Function [" + name.str() + "] is already declared as a global variable.");
     }
 
-    if(utils::contains(parser.symbol_info.function_definitions_lookup, name)) {
-        throw std::runtime_error("Function [" + name + "] already defined.");
+    if(utils::contains(parser.symbol_info.globals->function_definitions_lookup, name)) {
+        return parser.error("Function [" + name.str() + "] already defined.");
     }
 
 
-    if(utils::contains(parser.symbol_info.function_declarations_lookup, name)) {
-        const auto existing_function_declaration = parser.symbol_info.function_declarations_lookup.at(name);
-        validate_type_name(type, existing_function_declaration.return_type, "Function [" + name + "] return type mismatch.");
+    if(utils::contains(parser.symbol_info.globals->function_declarations_lookup, name)) {
+        const auto existing_function_declaration = parser.symbol_info.globals->function_declarations_lookup.at(name);
+        TRY(validate_type_name(parser, type, existing_function_declaration.return_type, "Function [" + name.str() + "] return type mismatch."));
         if(param_list.size() != existing_function_declaration.params.size()) {
-            throw std::runtime_error("Function [" + name + "] param count mismatch.");
+            return parser.error("Function [" + name.str() + "] param count mismatch.");
         }
         for(std::uint32_t i = 0u; i < param_list.size(); ++i) {
-            validate_type_name(param_list[i].first, existing_function_declaration.params[i], "Function [" + name + "] param type mismatch.");
+            TRY(validate_type_name(parser, param_list[i].first.value(), existing_function_declaration.params[i].value(), "Function [" + name.str() + "] param type mismatch."));
         }
     } else {
         // We add it to the function declaration table even though it is not a function definition because then we can do parsing and symbol validation all
@@ -1445,95 +1522,84 @@ ast::function_definition_t parse_function_definition(parser_t& parser, ast::type
         // We don't need to remove the function declaration once we're done because the function declarations do not matter after symbol validation.
         // And a function definition is a stronger statement than a function declaration anyways and can be redeclared infinite times (as long as they all match).
         ast::function_declaration_t function_declaration = ast::function_declaration_t{ type, name, parse_function_declaration_parameter_list(param_list) };
-        parser.symbol_info.function_declarations_lookup.insert({name, std::move(function_declaration)});
-    }
-
-    parser.symbol_info.variable_lookup.create_new_scope();
-    for(const auto& param : param_list) {
-        if(param.second.has_value()) {
-            parser.symbol_info.variable_lookup.add_new_variable_in_current_scope(param.second.value(), param.first);
-        }
+        parser.symbol_info.globals->function_declarations_lookup.insert({name, std::move(function_declaration)});
     }
-    ast::compound_statement_t function_body_statements = parse_and_validate_compound_statement(parser, true);
-    parser.symbol_info.variable_lookup.destroy_current_scope();
 
+    ast::function_definition_t function_definition = ast::function_definition_t{ std::move(type), name, std::move(param_list), ast::compound_statement_t{} };
+    parser.symbol_info.globals->function_definitions_lookup.insert({name, function_definition});
 
-    if(name_token.token_text == "main" && type.type_name == "int") {
-        constexpr int DEFAULT_RETURN_VALUE = 0;
-        // use `has_return_statement` instead of `is_return_statement` because we don't need to emit a return statement if there already is one,
-        //  even if there is unreachable code after the already existing return statement.
-        if(function_body_statements.stmts.size() == 0 || !has_return_statement(function_body_statements)) {
-            function_body_statements.stmts.push_back(ast::return_statement_t { ast::expression_t{ ast::constant_t{DEFAULT_RETURN_VALUE}, make_primitive_type_t(ast::type_category_t::INT, "int", sizeof(std::int32_t), alignof(std::int32_t)) } } );
-        }
+    if(parser.skipped_function_bodies != nullptr) {
+        TRY_ASSIGN(auto skipped_body, skip_function_body(parser));
+        parser.skipped_function_bodies->push_back(std::move(skipped_body));
+    } else {
+        TRY_ASSIGN(function_definition.statements, parse_and_validate_function_body(parser, function_definition));
     }
 
-    ast::function_definition_t function_definition = ast::function_definition_t{ std::move(type), name, std::move(param_list), std::move(function_body_statements) };
-
-    parser.symbol_info.function_definitions_lookup.insert({std::move(name), function_definition});
-
     return function_definition;
 }
-std::variant<ast::function_declaration_t, ast::function_definition_t> parse_function_decl_or_def(parser_t& parser, ast::type_t type, const token_t name_token) {
-    parser.expect_token(token_type_t::LEFT_PAREN, "Expected '(' in function declaration/definition.");
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t>> parse_function_decl_or_def(parser_t& parser, ast::type_t type, const ast::func_name_t name) {
+    TRY(parser.expect_token(token_type_t::LEFT_PAREN, "Expected '(' in function declaration/definition."));
 
-    auto param_list = parse_function_definition_parameter_list(parser);
+    TRY_ASSIGN(auto param_list, parse_function_definition_parameter_list(parser));
 
-    parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in function declaration/definition.");
+    TRY(parser.expect_token(token_type_t::RIGHT_PAREN, "Expected `)` in function declaration/definition."));
 
     const auto next_token = parser.peek_token();
-    if(next_token.token_type == token_type_t::SEMICOLON) {
-        return parse_function_declaration(parser, type, name_token, std::move(param_list));
-    } else if(next_token.token_type == token_type_t::LEFT_CURLY) {
-        return parse_function_definition(parser, type, name_token, std::move(param_list));
+    if(parser.token_type(next_token) == token_type_t::SEMICOLON) {
+        return parse_function_declaration(parser, type, name, std::move(param_list));
+    } else if(parser.token_type(next_token) == token_type_t::LEFT_CURLY) {
+        return parse_function_definition(parser, type, name, std::move(param_list));
     } else {
-        throw std::runtime_error("Expected either `;` or `{` in function declaration/definition.");
+        return parser.error("Expected either `;` or `{` in function declaration/definition.");
     }
 }
-std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t> parse_function_or_global(parser_t& parser) {
-    ast::type_t type = parse_and_validate_type(parser);
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t>> parse_function_or_global(parser_t& parser) {
+    TRY_ASSIGN(ast::type_t type, parse_and_validate_type(parser));
 
     const auto name_token = parser.advance_token();
-    if(name_token.token_type != token_type_t::IDENTIFIER) {
-        throw std::runtime_error("Expected an identifier name in function or global variable declaration/definition.");
+    if(parser.token_type(name_token) != token_type_t::IDENTIFIER) {
+        return parser.error("Expected an identifier name in function or global variable declaration/definition.");
     }
+    const auto name = parser.token_symbol(name_token);
 
     const auto next_token = parser.peek_token();
-    if(next_token.token_type == token_type_t::LEFT_PAREN) {
-        return utils::variant_adapter<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t>>(parse_function_decl_or_def(parser, type, name_token)); // parses either a function declaration or definition
-    } else if(next_token.token_type == token_type_t::EQUALS) {
-        return parse_global_variable_definition(parser, type, name_token);
-    } else if(next_token.token_type == token_type_t::SEMICOLON) {
-        return parse_global_variable_declaration(parser, type, name_token);
+    if(parser.token_type(next_token) == token_type_t::LEFT_PAREN) {
+        TRY_ASSIGN(auto function_decl_or_def, parse_function_decl_or_def(parser, type, name)); // parses either a function declaration or definition
+        return utils::variant_adapter<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t>>(std::move(function_decl_or_def));
+    } else if(parser.token_type(next_token) == token_type_t::EQUALS) {
+        return parse_global_variable_definition(parser, type, name);
+    } else if(parser.token_type(next_token) == token_type_t::SEMICOLON) {
+        return parse_global_variable_declaration(parser, type, name);
     } else {
-        throw std::runtime_error("Expected either global variable declaration, global variable definition, or start of function.");
+        return parser.error("Expected either global variable declaration, global variable definition, or start of function.");
     }
 }
-ast::type_t parse_and_validate_struct_body(parser_t& parser, const ast::type_name_t& name) {
-    parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition.");
+utils::result_t<ast::type_t> parse_and_validate_struct_body(parser_t& parser, const ast::type_name_t& name) {
+    TRY(parser.expect_token(token_type_t::LEFT_CURLY, "Expected `{` in struct definition."));
 
     std::vector<ast::type_t> struct_field_types;
-    std::vector<std::string> struct_field_names;
+    std::vector<ast::var_name_t> struct_field_names;
 
-    while(parser.peek_token().token_type != token_type_t::RIGHT_CURLY) {
-        auto field_type = parse_and_validate_type(parser);
+    while(parser.peek_token_type() != token_type_t::RIGHT_CURLY) {
+        TRY_ASSIGN(auto field_type, parse_and_validate_type(parser));
 
-        std::vector<std::string> field_names_in_line;
+        std::vector<ast::var_name_t> field_names_in_line;
         auto field_name = parser.advance_token();
-        if(field_name.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in struct definition for field.");
+        if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in struct definition for field.");
         }
-        field_names_in_line.push_back(std::string(field_name.token_text));
+        field_names_in_line.push_back(parser.token_symbol(field_name));
 
-        while(parser.peek_token().token_type == token_type_t::COMMA) {
+        while(parser.peek_token_type() == token_type_t::COMMA) {
             parser.advance_token();
             field_name = parser.advance_token();
-            if(field_name.token_type != token_type_t::IDENTIFIER) {
-                throw std::runtime_error("Expected identifier name in struct definition for field.");
+            if(parser.token_type(field_name) != token_type_t::IDENTIFIER) {
+                return parser.error("Expected identifier name in struct definition for field.");
             }
-            field_names_in_line.push_back(std::string(field_name.token_text));
+            field_names_in_line.push_back(parser.token_symbol(field_name));
         }
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition."));
 
         for(auto& field_name : field_names_in_line) {
             struct_field_types.push_back(field_type);
@@ -1541,24 +1607,29 @@ ast::type_t parse_and_validate_struct_body(parser_t& parser, const ast::type_nam
         }
     }
 
-    parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition.");
-    parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition.");
+    TRY(parser.expect_token(token_type_t::RIGHT_CURLY, "Expected `}` in struct definition."));
+    TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` in struct definition."));
 
-    return make_struct_definition_type_t(parser.symbol_info.type_table, name, std::move(struct_field_types), std::move(struct_field_names));
+    parser.get_debug_output() << "make_struct_definition_type_t: " << name << "\n";
+    auto struct_definition = make_struct_definition_type_t(parser.symbol_info.globals->type_table, name, std::move(struct_field_types), std::move(struct_field_names));
+    if(!struct_definition.has_value()) {
+        return parser.error("You cannot instantiate a struct forward declaration.");
+    }
+    return std::move(struct_definition.value());
 }
-ast::type_t parse_struct(parser_t& parser) {
-    parser.expect_token(token_type_t::STRUCT_KEYWORD, "Expected `struct` keyword in struct declaration/definition.");
+utils::result_t<ast::type_t> parse_struct(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::STRUCT_KEYWORD, "Expected `struct` keyword in struct declaration/definition."));
 
     const auto name_token = parser.advance_token();
-    if(name_token.token_type != token_type_t::IDENTIFIER) {
-        throw std::runtime_error("Expected identifier name in struct declaration/definition.");
+    if(parser.token_type(name_token) != token_type_t::IDENTIFIER) {
+        return parser.error("Expected identifier name in struct declaration/definition.");
     }
-    auto name = ast::type_name_t(name_token.token_text);
+    auto name = parser.token_symbol(name_token);
 
-    auto& struct_type_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+    auto& struct_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
 
     const auto next_token = parser.peek_token();
-    if(next_token.token_type == token_type_t::SEMICOLON) {
+    if(parser.token_type(next_token) == token_type_t::SEMICOLON) {
         parser.advance_token();
         // parse struct declaration
         auto struct_forward_decl = make_struct_forward_decl_type_t(name);
@@ -1566,180 +1637,522 @@ ast::type_t parse_struct(parser_t& parser) {
             struct_type_table.insert({name, struct_forward_decl});
         }
         return struct_forward_decl;
-    } else if(next_token.token_type == token_type_t::LEFT_CURLY) {
+    } else if(parser.token_type(next_token) == token_type_t::LEFT_CURLY) {
         // parse struct definition
         if(!utils::contains(struct_type_table, name) || !struct_type_table.at(name).size.has_value()) {
-            auto struct_definition = parse_and_validate_struct_body(parser, name);
+            TRY_ASSIGN(auto struct_definition, parse_and_validate_struct_body(parser, name));
             struct_type_table[name] = struct_definition;
             return struct_definition;
         }
-        throw std::runtime_error("Struct [" + name + "] already defined.");
+        return parser.error("Struct [" + name.str() + "] already defined.");
     }
-    throw std::runtime_error("Expected either `;` or `{` in struct declaration/definition.");
+    return parser.error("Expected either `;` or `{` in struct declaration/definition.");
 }
-ast::type_t parse_typedef(parser_t& parser) {
-    parser.expect_token(token_type_t::TYPEDEF_KEYWORD, "Expected `typedef` keyword in typedef declaration.");
+utils::result_t<ast::type_t> parse_typedef(parser_t& parser) {
+    TRY(parser.expect_token(token_type_t::TYPEDEF_KEYWORD, "Expected `typedef` keyword in typedef declaration."));
 
-    auto& typedef_symbol_table = parser.symbol_info.type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
+    auto& typedef_symbol_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF));
 
-    if(is_struct_keyword(parser.peek_token())) {
-        auto struct_decl_or_def = parse_typedef_struct_decl_or_def(parser);
+    if(is_struct_keyword(parser.peek_token_type())) {
+        TRY_ASSIGN(auto struct_decl_or_def, parse_typedef_struct_decl_or_def(parser));
 
         assert(struct_decl_or_def.type_category == ast::type_category_t::STRUCT);
 
         auto typedef_name_token = parser.advance_token();
-        if(typedef_name_token.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in typedef declaration.");
+        if(parser.token_type(typedef_name_token) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in typedef declaration.");
         }
-        auto typedef_name = ast::type_name_t(typedef_name_token.token_text);
+        auto typedef_name = parser.token_symbol(typedef_name_token);
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration."));
 
         ast::type_t typedef_decl;
-        if(struct_decl_or_def.type_name != ast::type_name_t("")) {
-            typedef_decl = make_typedef_type_t(parser.symbol_info.type_table, typedef_name, struct_decl_or_def.type_category, std::move(struct_decl_or_def.type_name));
+        if(struct_decl_or_def.type_name != ast::ANONYMOUS_TYPE_NAME) {
+            typedef_decl = make_typedef_type_t(parser.symbol_info.globals->type_table, typedef_name, struct_decl_or_def.type_category, std::move(struct_decl_or_def.type_name));
         } else {
-            typedef_decl = make_typedef_with_anonymous_struct_t(parser.symbol_info.type_table, typedef_name, struct_decl_or_def);
+            typedef_decl = make_typedef_with_anonymous_struct_t(parser.symbol_info.globals->type_table, typedef_name, struct_decl_or_def);
         }
 
         auto existing_typdef_type_iter = typedef_symbol_table.find(typedef_name);
         if(existing_typdef_type_iter == std::end(typedef_symbol_table)) {
             typedef_symbol_table.insert({std::move(typedef_name), typedef_decl});
-        } else if(existing_typdef_type_iter->second.aliased_type.value() == ast::type_name_t("")) {
-            throw std::runtime_error("Typedef to anonymous struct already exists with the same name.");
+        } else if(existing_typdef_type_iter->second.aliased_type.value() == ast::ANONYMOUS_TYPE_NAME) {
+            return parser.error("Typedef to anonymous struct already exists with the same name.");
         } else {
             if(existing_typdef_type_iter->second.aliased_type_category != typedef_decl.aliased_type_category || existing_typdef_type_iter->second.aliased_type != typedef_decl.aliased_type) {
-                throw std::runtime_error("Conflicting typedef declarations.");
+                return parser.error("Conflicting typedef declarations.");
             }
         }
 
         return typedef_decl;
-    } else if(is_keyword_a_type(parser.peek_token().token_type)) { // if the next token is a primitive type
+    } else if(is_keyword_a_type(parser.peek_token_type())) { // if the next token is a primitive type
         auto aliased_type_token = parser.advance_token();
-        auto aliased_type_name = ast::type_name_t(aliased_type_token.token_text);
-        const auto primitive_type_category = get_type_category_from_token_type(aliased_type_token.token_type);
+        auto aliased_type_name = primitive_token_keyword_to_name(parser.token_type(aliased_type_token));
+        const auto primitive_type_category = get_type_category_from_token_type(parser.token_type(aliased_type_token));
 
         auto typedef_name_token = parser.advance_token();
-        if(typedef_name_token.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in typedef declaration.");
+        if(parser.token_type(typedef_name_token) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in typedef declaration.");
         }
-        auto typedef_name = ast::type_name_t(typedef_name_token.token_text);
+        auto typedef_name = parser.token_symbol(typedef_name_token);
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration."));
 
-        ast::type_t typedef_decl = make_typedef_type_t(parser.symbol_info.type_table, typedef_name, primitive_type_category, std::move(aliased_type_name));
+        ast::type_t typedef_decl = make_typedef_type_t(parser.symbol_info.globals->type_table, typedef_name, primitive_type_category, std::move(aliased_type_name));
 
         auto existing_typdef_type_iter = typedef_symbol_table.find(typedef_name);
         if(existing_typdef_type_iter == std::end(typedef_symbol_table)) {
             typedef_symbol_table.insert({std::move(typedef_name), typedef_decl});
         } else {
             if(existing_typdef_type_iter->second.aliased_type_category != typedef_decl.aliased_type_category || existing_typdef_type_iter->second.aliased_type != typedef_decl.aliased_type) {
-                throw std::runtime_error("Conflicting typedef declarations.");
+                return parser.error("Conflicting typedef declarations.");
             }
         }
 
         return typedef_decl;
     } else { // type being aliased must be a typedef/non-primitive type name
         auto aliased_type_token = parser.advance_token();
-        auto aliased_type_name = ast::type_name_t(aliased_type_token.token_text);
+        auto aliased_type_name = parser.token_symbol(aliased_type_token);
         if(typedef_symbol_table.find(aliased_type_name) == std::end(typedef_symbol_table)) {
-            throw std::runtime_error("Type being aliased has not been declared.");
+            return parser.error("Type being aliased has not been declared.");
         }
 
         auto typedef_name_token = parser.advance_token();
-        if(typedef_name_token.token_type != token_type_t::IDENTIFIER) {
-            throw std::runtime_error("Expected identifier name in typedef declaration.");
+        if(parser.token_type(typedef_name_token) != token_type_t::IDENTIFIER) {
+            return parser.error("Expected identifier name in typedef declaration.");
         }
-        auto typedef_name = ast::type_name_t(typedef_name_token.token_text);
+        auto typedef_name = parser.token_symbol(typedef_name_token);
 
-        parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration.");
+        TRY(parser.expect_token(token_type_t::SEMICOLON, "Expected `;` at end of typedef declaration."));
 
-        ast::type_t typedef_decl = make_typedef_type_t(parser.symbol_info.type_table, typedef_name, ast::type_category_t::TYPEDEF, std::move(aliased_type_name));
+        ast::type_t typedef_decl = make_typedef_type_t(parser.symbol_info.globals->type_table, typedef_name, ast::type_category_t::TYPEDEF, std::move(aliased_type_name));
 
         auto existing_typdef_type_iter = typedef_symbol_table.find(typedef_name);
         if(existing_typdef_type_iter == std::end(typedef_symbol_table)) {
             typedef_symbol_table.insert({std::move(typedef_name), typedef_decl});
         } else {
             if(existing_typdef_type_iter->second.aliased_type_category != typedef_decl.aliased_type_category || existing_typdef_type_iter->second.aliased_type != typedef_decl.aliased_type) {
-                throw std::runtime_error("Conflicting typedef declarations.");
+                return parser.error("Conflicting typedef declarations.");
             }
         }
 
         return typedef_decl;
     }
 }
-std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t> parse_top_level_declaration(parser_t& parser) {
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>> parse_top_level_declaration(parser_t& parser) {
     if(is_a_type(parser)) { // includes struct types using the `struct` tag
-        return utils::variant_adapter<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>>(parse_function_or_global(parser)); // parses either a global variable declaration/definition, function declaration, or function definition
+        TRY_ASSIGN(auto function_or_global, parse_function_or_global(parser)); // parses either a global variable declaration/definition, function declaration, or function definition
+        return utils::variant_adapter<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>>(std::move(function_or_global));
     }
 
     const auto first_token = parser.peek_token();
 
-    if(is_struct_keyword(first_token)) {
+    if(is_struct_keyword(parser.token_type(first_token))) {
         return parse_struct(parser); // parses either a struct declaration or struct definition
     }
 
-    if(is_typedef_keyword(first_token)) {
+    if(is_typedef_keyword(parser.token_type(first_token))) {
         return parse_typedef(parser);
     }
 
-    throw std::runtime_error("Unrecognized top level declaration/definition.");
+    return parser.error("Unrecognized top level declaration/definition.");
 }
 
-ast::validated_program_t parse(parser_t& parser) {
+using top_level_declarations_t = std::vector<std::variant<ast::function_definition_t, ast::global_variable_declaration_t>>;
+static void add_primitive_types_to_type_table(parser_t& parser) {
     add_floating_point_types_to_type_table(parser);
     add_integer_types_to_type_table(parser);
     add_unsigned_integer_types_to_type_table(parser);
+}
+static void add_to_top_level_declarations(top_level_declarations_t& top_level_declarations, std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>&& top_level_decl) {
+    std::visit(overloaded{
+        [](ast::type_t& type) {}, // We only need to store the types in the type table, not in the top level declaration list
+        [](ast::function_declaration_t& function_declaration) {}, // function declarations are only needed during parsing and the parser doesn't need/use `top_level_declarations`
 
-    std::vector<std::variant<ast::function_definition_t, ast::global_variable_declaration_t>> top_level_declarations;
-    while(parser.peek_token().token_type != token_type_t::EOF_TOK) {
-        auto top_level_decl = parse_top_level_declaration(parser);
-        std::visit(overloaded{
-            [](const ast::type_t& type) {}, // We only need to store the types in the type table, not in the top level declaration list
-            [](const ast::function_declaration_t& function_declaration) {}, // function declarations are only needed during parsing and the parser doesn't need/use `top_level_declarations`
-
-            // We can't instead use `auto&` below because of stupid C++ template nonsense where it gets confused thinking the param still might be `ast::type_t` even though it *never* can be.
-            [&top_level_declarations](const ast::function_definition_t& function_def) {
-                std::variant<ast::function_definition_t, ast::global_variable_declaration_t> top_level_decl = function_def;
-                top_level_declarations.push_back(top_level_decl);
-            },
-            [&top_level_declarations](const ast::global_variable_declaration_t& global_var) {
-                std::variant<ast::function_definition_t, ast::global_variable_declaration_t> top_level_decl = global_var;
-                top_level_declarations.push_back(top_level_decl);
-            },
-        }, top_level_decl);
-    }
-
+        // We can't instead use `auto&` below because of stupid C++ template nonsense where it gets confused thinking the param still might be `ast::type_t` even though it *never* can be.
+        [&top_level_declarations](ast::function_definition_t& function_def) {
+            top_level_declarations.push_back(std::move(function_def));
+        },
+        [&top_level_declarations](ast::global_variable_declaration_t& global_var) {
+            top_level_declarations.push_back(std::move(global_var));
+        },
+    }, top_level_decl);
+}
+static top_level_declarations_t deduplicate_top_level_declarations(const parser_t& parser, top_level_declarations_t&& top_level_declarations) {
     std::unordered_set<ast::var_name_t> global_variable_declarations;
-    std::vector<std::variant<ast::function_definition_t, ast::global_variable_declaration_t>> deduplicated_top_level_declarations;
-    for(const auto& top_level_decl : top_level_declarations) {
+    top_level_declarations_t deduplicated_top_level_declarations;
+    for(auto& top_level_decl : top_level_declarations) {
         std::visit(overloaded{
             // We can't instead use `auto&` below because of stupid C++ template nonsense where it gets confused thinking the param still might be `ast::type_t` even though it *never* can be.
-            [&deduplicated_top_level_declarations](const ast::function_definition_t& function_def) {
-                std::variant<ast::function_definition_t, ast::global_variable_declaration_t> top_level_decl = function_def;
-                deduplicated_top_level_declarations.push_back(top_level_decl);
+            [&deduplicated_top_level_declarations](ast::function_definition_t& function_def) {
+                deduplicated_top_level_declarations.push_back(std::move(function_def));
             },
-            [&global_variable_declarations, &parser, &deduplicated_top_level_declarations](const ast::global_variable_declaration_t& global_var) {
+            [&global_variable_declarations, &parser, &deduplicated_top_level_declarations](ast::global_variable_declaration_t& global_var) {
                 if(global_var.value.has_value()) {
-                    if(utils::contains(parser.symbol_info.global_variable_definitions, global_var.var_name)) {
-                        std::variant<ast::function_definition_t, ast::global_variable_declaration_t> top_level_decl = global_var;
-                        deduplicated_top_level_declarations.push_back(top_level_decl);
+                    if(utils::contains(parser.symbol_info.globals->global_variable_definitions, global_var.var_name)) {
+                        deduplicated_top_level_declarations.push_back(std::move(global_var));
                     } else {
                         throw std::logic_error("Global variable definition isn't in global variable definition table.");
                     }
                 } else {
-                    if(!utils::contains(parser.symbol_info.global_variable_definitions, global_var.var_name) && global_variable_declarations.count(global_var.var_name) == 0) {
+                    if(!utils::contains(parser.symbol_info.globals->global_variable_definitions, global_var.var_name) && global_variable_declarations.count(global_var.var_name) == 0) {
                         global_variable_declarations.insert(global_var.var_name);
-                        std::variant<ast::function_definition_t, ast::global_variable_declaration_t> top_level_decl = global_var;
-                        deduplicated_top_level_declarations.push_back(top_level_decl);
+                        deduplicated_top_level_declarations.push_back(std::move(global_var));
+                    }
+                }
+            },
+        }, top_level_decl);
+    }
+    return deduplicated_top_level_declarations;
+}
+
+utils::result_t<ast::validated_program_t> parse(parser_t& parser) {
+    auto nodes = std::make_shared<ast::node_pools_t>();
+    const ast::node_pools_scope_t node_pools_scope(*nodes);
+    parser.symbol_info.globals->types = &nodes->get_types();
+
+    add_primitive_types_to_type_table(parser);
+
+    top_level_declarations_t top_level_declarations;
+    while(parser.peek_token_type() != token_type_t::EOF_TOK) {
+        TRY_ASSIGN(auto top_level_decl, parse_top_level_declaration(parser));
+        add_to_top_level_declarations(top_level_declarations, std::move(top_level_decl));
+    }
+
+    ast::validated_program_t validated_program{};
+    validated_program.nodes = std::move(nodes);
+    validated_program.type_table = parser.symbol_info.globals->type_table;
+    validated_program.top_level_declarations = deduplicate_top_level_declarations(parser, std::move(top_level_declarations));
+    return validated_program;
+}
+
+
+// Catches function bodies that would come out differently if they were parsed after all of the top level declarations instead of in order.
+// That is the case when a later top level declaration changes what an identifier used in the body refers to,
+//  i.e. when it declares the identifier for the first time, or completes a struct forward declaration that the identifier names (directly or through typedefs).
+// Identifiers are tracked by name only, so e.g. a local variable that shadows a later global counts as well. That only ever costs us the parallelism.
+class order_dependence_tracker_t {
+    std::unordered_map<utils::symbol_t, std::uint32_t> first_uses; // index of the first top level declaration whose skipped body uses the identifier
+
+    // declared so far
+    std::unordered_set<utils::symbol_t> ordinary_names; // functions and global variables
+    std::unordered_set<utils::symbol_t> struct_tags;
+    std::unordered_set<utils::symbol_t> typedef_names;
+    std::unordered_set<utils::symbol_t> incomplete_struct_tags;
+
+    bool is_order_dependent = false;
+
+    void check_use(const utils::symbol_t name, const std::uint32_t index) {
+        const auto first_use_iter = first_uses.find(name);
+        if(first_use_iter != std::end(first_uses) && first_use_iter->second < index) {
+            is_order_dependent = true;
+        }
+    }
+    void declare(std::unordered_set<utils::symbol_t>& names, const utils::symbol_t name, const std::uint32_t index) {
+        if(names.insert(name).second) {
+            check_use(name, index);
+        }
+    }
+    void declare_struct(const parser_t& parser, const ast::type_name_t tag, const std::uint32_t index) {
+        if(tag == ast::ANONYMOUS_TYPE_NAME) {
+            return;
+        }
+        declare(struct_tags, tag, index);
+
+        const auto& struct_type_table = parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::STRUCT));
+        const auto struct_type_iter = struct_type_table.find(tag);
+        if(struct_type_iter == std::end(struct_type_table) || !struct_type_iter->second.size.has_value()) {
+            incomplete_struct_tags.insert(tag);
+        } else if(incomplete_struct_tags.erase(tag) != 0u) {
+            check_use(tag, index);
+            for(const auto& [typedef_name, typedef_type] : parser.symbol_info.globals->type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF))) {
+                if(typedef_type.underlying_type_category == ast::type_category_t::STRUCT && typedef_type.underlying_type == tag) {
+                    check_use(typedef_name, index);
+                }
+            }
+        }
+    }
+
+public:
+    // `top_level_decl` is the `index`th top level declaration. Has to be called before the uses of its own body are added, as a function can call itself.
+    void add_declaration(const parser_t& parser, const std::uint32_t index, const std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>& top_level_decl) {
+        std::visit(overloaded{
+            [this, index](const ast::function_declaration_t& function_declaration) { declare(ordinary_names, function_declaration.function_name, index); },
+            [this, index](const ast::function_definition_t& function_definition) { declare(ordinary_names, function_definition.function_name, index); },
+            [this, index](const ast::global_variable_declaration_t& global_var) { declare(ordinary_names, global_var.var_name, index); },
+            [this, &parser, index](const ast::type_t& type) {
+                if(type.type_category == ast::type_category_t::STRUCT) {
+                    declare_struct(parser, type.type_name, index);
+                } else if(type.type_category == ast::type_category_t::TYPEDEF) {
+                    declare(typedef_names, type.type_name, index);
+                    if(type.aliased_type_category == ast::type_category_t::STRUCT) {
+                        declare_struct(parser, type.aliased_type.value(), index);
                     }
                 }
             },
         }, top_level_decl);
     }
+    void add_uses(const skipped_function_body_t& skipped_body, const std::uint32_t index) {
+        for(const auto identifier : skipped_body.identifiers) {
+            first_uses.try_emplace(identifier, index);
+        }
+    }
+
+    bool get_is_order_dependent() const {
+        return is_order_dependent;
+    }
+};
+
+// Phase one of `parse_in_parallel()` and `parse_lazily()`. Returns `false` if the bodies can't be parsed out of order.
+// The identifiers used in each body are only kept if `keep_identifiers` is set.
+static bool parse_top_level_declarations_skipping_function_bodies(parser_t& parser, top_level_declarations_t& top_level_declarations, std::vector<skipped_function_body_t>& skipped_bodies, const bool keep_identifiers) {
+    parser.skipped_function_bodies = &skipped_bodies;
+    order_dependence_tracker_t order_dependence_tracker;
+    add_primitive_types_to_type_table(parser);
+
+    for(std::uint32_t index = 0u; parser.peek_token_type() != token_type_t::EOF_TOK; ++index) {
+        const auto skipped_body_count = skipped_bodies.size();
+        auto top_level_decl = parse_top_level_declaration(parser);
+        if(!top_level_decl.has_value()) {
+            parser.skipped_function_bodies = nullptr;
+            return false;
+        }
+        order_dependence_tracker.add_declaration(parser, index, top_level_decl.value());
+        if(skipped_bodies.size() != skipped_body_count) {
+            order_dependence_tracker.add_uses(skipped_bodies.back(), index);
+            if(!keep_identifiers) {
+                skipped_bodies.back().identifiers = {};
+            }
+        }
+        add_to_top_level_declarations(top_level_declarations, std::move(top_level_decl).value());
+    }
+    parser.skipped_function_bodies = nullptr;
+    return !order_dependence_tracker.get_is_order_dependent();
+}
+// the function definitions, in the same order as their skipped bodies
+static std::vector<ast::function_definition_t*> get_function_definitions(top_level_declarations_t& top_level_declarations, const std::vector<skipped_function_body_t>& skipped_bodies) {
+    std::vector<ast::function_definition_t*> function_definitions;
+    for(auto& top_level_decl : top_level_declarations) {
+        if(auto *const function_definition = std::get_if<ast::function_definition_t>(&top_level_decl)) {
+            function_definitions.push_back(function_definition);
+        }
+    }
+    if(function_definitions.size() != skipped_bodies.size()) {
+        throw std::logic_error("Mismatch of number of function definitions and skipped function bodies.");
+    }
+    return function_definitions;
+}
+// Phase two of `parse_in_parallel()`. Returns `false` if any body doesn't parse. What the bodies print is written to `debug_output` in source order.
+static bool parse_skipped_function_bodies(const parser_t& parser, std::ostream& debug_output, ast::node_pools_t& nodes, top_level_declarations_t& top_level_declarations, const std::vector<skipped_function_body_t>& skipped_bodies, utils::thread_pool_t& thread_pool) {
+    const auto function_definitions = get_function_definitions(top_level_declarations, skipped_bodies);
+
+    // Bodies are parsed in contiguous batches, each into its own pools, which keeps the number of pools (and tasks) down.
+    // A few batches per thread keeps the threads busy when the bodies differ in size.
+    constexpr std::size_t batches_per_thread = 4u;
+    const std::size_t batch_count = std::min(skipped_bodies.size(), thread_pool.thread_count() * batches_per_thread);
+    struct parsed_batch_t {
+        std::unique_ptr<ast::node_pools_t> nodes;
+        std::vector<ast::compound_statement_t> bodies;
+        std::string debug_output; // printed in source order once every batch has parsed
+    };
+    std::vector<std::future<utils::result_t<parsed_batch_t>>> parsed_batch_futures;
+    parsed_batch_futures.reserve(batch_count);
+    for(std::size_t batch = 0u; batch < batch_count; ++batch) {
+        const std::size_t first_body = skipped_bodies.size() * batch / batch_count;
+        const std::size_t last_body = skipped_bodies.size() * (batch + 1u) / batch_count;
+        parsed_batch_futures.push_back(thread_pool.submit([&globals = parser.symbol_info.globals, &skipped_bodies, &function_definitions, first_body, last_body]() -> utils::result_t<parsed_batch_t> {
+            parsed_batch_t parsed_batch{std::make_unique<ast::node_pools_t>(), {}, {}};
+            const ast::node_pools_scope_t node_pools_scope(*parsed_batch.nodes);
+            std::ostringstream debug_output;
+            parsed_batch.bodies.reserve(last_body - first_body);
+            for(std::size_t i = first_body; i < last_body; ++i) {
+                parser_t body_parser(skipped_bodies[i].tokens, globals);
+                body_parser.is_speculative = true;
+                body_parser.set_debug_output(debug_output);
+                TRY_ASSIGN(auto body, parse_and_validate_function_body(body_parser, *function_definitions[i]));
+                parsed_batch.bodies.push_back(std::move(body));
+            }
+            parsed_batch.debug_output = debug_output.str();
+            return parsed_batch;
+        }));
+    }
+
+    // Every batch has to be waited for before bailing out, as they all refer to our caller's symbol tables.
+    std::vector<parsed_batch_t> parsed_batches;
+    parsed_batches.reserve(batch_count);
+    bool has_error = false;
+    std::exception_ptr internal_error;
+    for(auto& parsed_batch_future : parsed_batch_futures) {
+        try {
+            auto parsed_batch = parsed_batch_future.get();
+            if(parsed_batch.has_value()) {
+                parsed_batches.push_back(std::move(parsed_batch).value());
+            } else {
+                has_error = true;
+            }
+        } catch(...) { // errors in the program come back as `utils::error`, so anything thrown is an internal error
+            if(internal_error == nullptr) {
+                internal_error = std::current_exception();
+            }
+        }
+    }
+    if(internal_error != nullptr) {
+        std::rethrow_exception(internal_error);
+    }
+    if(has_error) {
+        return false;
+    }
+
+    // moved over in source order, so that the result doesn't depend on which thread finished first
+    auto function_definition_iter = std::begin(function_definitions);
+    for(auto& parsed_batch : parsed_batches) {
+        debug_output << parsed_batch.debug_output;
+        const ast::node_offsets_t offsets = nodes.append(std::move(*parsed_batch.nodes));
+        for(auto& body : parsed_batch.bodies) {
+            ast::offset_node_handles(body, offsets);
+            (*function_definition_iter++)->statements = std::move(body);
+        }
+    }
+    return true;
+}
+// A fresh parser from `initial_tokens`, which prints to where `parser` did.
+static void restart_parser(parser_t& parser, const token_stream_t& initial_tokens) {
+    std::ostream& debug_output = parser.get_debug_output();
+    parser = parser_t(initial_tokens);
+    parser.set_debug_output(debug_output);
+}
+utils::result_t<ast::validated_program_t> parse_in_parallel(parser_t& parser, utils::thread_pool_t& thread_pool) {
+    if(thread_pool.thread_count() <= 1u) {
+        return parse(parser); // nothing to gain from skipping the bodies
+    }
+
+    const token_stream_t initial_tokens = parser.tokens;
+
+    auto nodes = std::make_shared<ast::node_pools_t>();
+    const ast::node_pools_scope_t node_pools_scope(*nodes);
+    parser.symbol_info.globals->types = &nodes->get_types();
+
+    top_level_declarations_t top_level_declarations;
+    std::vector<skipped_function_body_t> skipped_bodies;
+
+    // Whatever the parsers (and their lexers) print is held back, so that nothing is printed twice if we have to start over.
+    std::ostringstream held_back_output;
+    bool can_parse_in_parallel = false;
+    {
+        const debug_output_scope_t debug_output_scope(parser, held_back_output);
+        can_parse_in_parallel = parse_top_level_declarations_skipping_function_bodies(parser, top_level_declarations, skipped_bodies, false);
+    }
+
+    if(can_parse_in_parallel) {
+        top_level_declarations = deduplicate_top_level_declarations(parser, std::move(top_level_declarations));
+        if(parse_skipped_function_bodies(parser, held_back_output, *nodes, top_level_declarations, skipped_bodies, thread_pool)) {
+            parser.get_debug_output() << held_back_output.str();
+
+            ast::validated_program_t validated_program{};
+            validated_program.nodes = std::move(nodes);
+            validated_program.type_table = parser.symbol_info.globals->type_table;
+            validated_program.top_level_declarations = std::move(top_level_declarations);
+            return validated_program;
+        }
+    }
+
+    // Parsing in order gives the same diagnostics (and `parser.diagnostic_offset()`) that `parse()` does, at the cost of parsing everything twice.
+    // That's only for programs that don't compile (or that use identifiers before they are declared at file scope), so the common case stays fast.
+    restart_parser(parser, initial_tokens);
+    return parse(parser);
+}
+
+
+// Whether other translation units can call the function. There is no `static` (yet), so every function can.
+static bool has_external_linkage(const ast::function_definition_t&) {
+    return true;
+}
+// Indices of the skipped bodies that `parse_lazily()` has to parse: those of the functions reachable from the ones with external linkage, or from `main` if the
+//  translation unit is the whole program (and has a `main`).
+// A body is taken to reach every function whose name it uses as an identifier, which can only ever be too many (e.g. for a local variable named like a function).
+static std::vector<bool> find_needed_function_bodies(const std::vector<ast::function_definition_t*>& function_definitions, const std::vector<skipped_function_body_t>& skipped_bodies, const bool is_whole_program) {
+    std::unordered_map<ast::func_name_t, std::uint32_t> function_definition_indices;
+    for(std::uint32_t i = 0u; i < function_definitions.size(); ++i) {
+        function_definition_indices.insert({function_definitions[i]->function_name, i});
+    }
+
+    std::vector<bool> is_needed(function_definitions.size(), false);
+    std::vector<std::uint32_t> worklist;
+    const auto main_iter = function_definition_indices.find(main_function_name);
+    if(is_whole_program && main_iter != std::end(function_definition_indices)) {
+        worklist.push_back(main_iter->second);
+    } else {
+        for(std::uint32_t i = 0u; i < function_definitions.size(); ++i) {
+            if(!is_whole_program && !has_external_linkage(*function_definitions[i])) {
+                continue;
+            }
+            worklist.push_back(i);
+        }
+    }
+    while(!worklist.empty()) {
+        const auto index = worklist.back();
+        worklist.pop_back();
+        if(is_needed[index]) {
+            continue;
+        }
+        is_needed[index] = true;
+        for(const auto identifier : skipped_bodies[index].identifiers) {
+            const auto function_iter = function_definition_indices.find(identifier);
+            if(function_iter != std::end(function_definition_indices) && !is_needed[function_iter->second]) {
+                worklist.push_back(function_iter->second);
+            }
+        }
+    }
+    return is_needed;
+}
+utils::result_t<ast::validated_program_t> parse_lazily(parser_t& parser, const bool is_whole_program) {
+    const token_stream_t initial_tokens = parser.tokens;
+
+    auto nodes = std::make_shared<ast::node_pools_t>();
+    const ast::node_pools_scope_t node_pools_scope(*nodes);
+    parser.symbol_info.globals->types = &nodes->get_types();
+
+    top_level_declarations_t top_level_declarations;
+    std::vector<skipped_function_body_t> skipped_bodies;
+
+    // Whatever the top level declarations (and the lexer scanning them) print is held back, so that nothing is printed twice if we have to start over.
+    std::ostringstream top_level_output;
+    bool can_skip_function_bodies = false;
+    {
+        const debug_output_scope_t debug_output_scope(parser, top_level_output);
+        can_skip_function_bodies = parse_top_level_declarations_skipping_function_bodies(parser, top_level_declarations, skipped_bodies, true);
+    }
+
+    if(!can_skip_function_bodies) {
+        restart_parser(parser, initial_tokens);
+        return parse(parser);
+    }
+    parser.get_debug_output() << top_level_output.str();
+
+    top_level_declarations = deduplicate_top_level_declarations(parser, std::move(top_level_declarations));
+    const auto function_definitions = get_function_definitions(top_level_declarations, skipped_bodies);
+    const auto is_needed = find_needed_function_bodies(function_definitions, skipped_bodies, is_whole_program);
+
+    // In source order, so that the first error among them is the one reported. This parser is used so that `parser.diagnostic_offset()` points into the body.
+    std::ostream& debug_output = parser.get_debug_output();
+    for(std::size_t i = 0u; i < skipped_bodies.size(); ++i) {
+        if(is_needed[i]) {
+            parser.tokens = skipped_bodies[i].tokens; // which print to where the top level declarations were held back
+            parser.set_debug_output(debug_output);
+            TRY_ASSIGN(function_definitions[i]->statements, parse_and_validate_function_body(parser, *function_definitions[i]));
+        }
+    }
 
     ast::validated_program_t validated_program{};
-    validated_program.type_table = parser.symbol_info.type_table;
-    validated_program.top_level_declarations = std::move(deduplicated_top_level_declarations);
+    std::size_t function_definition_index = 0u;
+    for(auto& top_level_decl : top_level_declarations) {
+        // the functions that aren't needed are left out of the program altogether, so they aren't type checked or compiled either
+        if(std::holds_alternative<ast::function_definition_t>(top_level_decl) && !is_needed[function_definition_index++]) {
+            continue;
+        }
+        validated_program.top_level_declarations.push_back(std::move(top_level_decl));
+    }
+    validated_program.nodes = std::move(nodes);
+    validated_program.type_table = parser.symbol_info.globals->type_table;
     return validated_program;
 }
@@ -4,12 +4,18 @@
 #include <stdexcept>
 #include <string_view>
 #include <string>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <memory>
 #include <cstddef>
 #include <cassert>
 #include <unordered_set>
+#include <future>
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <iostream>
 
 #include <frontend/lexing/lexer.hpp>
 #include <frontend/ast/ast.hpp>
@@ -17,35 +23,39 @@
 #include <backend/interpreter/compile_time_evaluator.hpp>
 #include "parser_utils.hpp"
 #include <utils/common.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/result.hpp>
 
 
-void validate_type_name(const ast::type_t& expected, const ast::type_t& actual, const std::string& error_message);
+utils::result_t<void> validate_type_name(parser_t& parser, const ast::type_t& expected, const ast::type_t& actual, const std::string& error_message);
 
-ast::type_t get_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name);
+const ast::type_t& get_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name);
+// `nullptr` if the variable isn't declared
+const ast::type_t* find_type_of_variable(const validation_t& validation, const ast::var_name_t& variable_name);
 
-std::shared_ptr<ast::grouping_t> parse_grouping(parser_t& parser);
+utils::result_t<ast::node_handle_t<ast::grouping_t>> parse_grouping(parser_t& parser);
 
-bool is_prefix_op(const token_t& token);
-ast::unary_operator_token_t parse_prefix_op(const token_t& token);
+bool is_prefix_op(const token_type_t token_type);
+ast::unary_operator_token_t parse_prefix_op(const token_type_t token_type);
 ast::precedence_t prefix_binding_power(const ast::unary_operator_token_t token);
-std::shared_ptr<ast::unary_expression_t> make_prefix_op(const ast::unary_operator_token_t op, ast::expression_t&& rhs);
-ast::var_name_t parse_and_validate_variable(parser_t& parser, const token_t name_token);
-std::shared_ptr<ast::function_call_t> parse_and_validate_function_call(parser_t& parser, const token_t name_token);
-ast::expression_t parse_and_validate_variable_or_function_call(parser_t& parser);
-ast::expression_t parse_prefix_expression(parser_t& parser);
-bool is_postfix_op(const token_t& token);
-ast::unary_operator_token_t parse_postfix_op(const token_t& token);
+utils::result_t<ast::node_handle_t<ast::unary_expression_t>> make_prefix_op(parser_t& parser, const ast::unary_operator_token_t op, ast::expression_t&& rhs);
+utils::result_t<ast::var_name_t> parse_and_validate_variable(parser_t& parser, ast::var_name_t name);
+utils::result_t<ast::node_handle_t<ast::function_call_t>> parse_and_validate_function_call(parser_t& parser, ast::func_name_t name);
+utils::result_t<ast::expression_t> parse_and_validate_variable_or_function_call(parser_t& parser);
+utils::result_t<ast::expression_t> parse_prefix_expression(parser_t& parser);
+bool is_postfix_op(const token_type_t token_type);
+ast::unary_operator_token_t parse_postfix_op(const token_type_t token_type);
 ast::precedence_t postfix_binding_power(const ast::unary_operator_token_t token);
-std::shared_ptr<ast::unary_expression_t> make_postfix_op(const ast::unary_operator_token_t op, ast::expression_t&& lhs);
-bool is_infix_binary_op(const token_t& token);
-ast::binary_operator_token_t parse_infix_binary_op(const token_t& token);
+utils::result_t<ast::node_handle_t<ast::unary_expression_t>> make_postfix_op(parser_t& parser, const ast::unary_operator_token_t op, ast::expression_t&& lhs);
+bool is_infix_binary_op(const token_type_t token_type);
+ast::binary_operator_token_t parse_infix_binary_op(const token_type_t token_type);
 std::pair<ast::precedence_t, ast::precedence_t> infix_binding_power(const ast::binary_operator_token_t token);
-std::shared_ptr<ast::binary_expression_t> make_infix_op(const ast::binary_operator_token_t op, ast::expression_t&& lhs, ast::expression_t&& rhs);
-bool is_compound_assignment_op(const token_t& token);
-ast::binary_operator_token_t get_op_from_compound_assignment_op(const token_t& token);
+utils::result_t<ast::node_handle_t<ast::binary_expression_t>> make_infix_op(parser_t& parser, const ast::binary_operator_token_t op, ast::expression_t&& lhs, ast::expression_t&& rhs);
+bool is_compound_assignment_op(const token_type_t token_type);
+ast::binary_operator_token_t get_op_from_compound_assignment_op(const token_type_t token_type);
 std::pair<ast::precedence_t, ast::precedence_t> ternary_binding_power();
-ast::expression_t parse_and_validate_expression(parser_t& parser, const ast::precedence_t precedence);
-ast::expression_t parse_and_validate_expression(parser_t& parser);
+utils::result_t<ast::expression_t> parse_and_validate_expression(parser_t& parser, const ast::precedence_t precedence);
+utils::result_t<ast::expression_t> parse_and_validate_expression(parser_t& parser);
 
 ast::type_t make_primitive_type(token_type_t token_type);
 
@@ -56,39 +66,54 @@ void add_unsigned_integer_types_to_type_table(parser_t& parser);
 bool is_a_type(const parser_t& parser);
 
 // checks whether or not the token is either a typedef or primitive type
-bool is_a_type_token(parser_t& parser, token_t token);
-
-ast::type_t parse_type_name_from_token(parser_t& parser, token_t token);
-ast::type_t parse_struct_name_from_token(parser_t& parser, token_t token);
-
-ast::global_variable_declaration_t parse_global_variable_declaration(parser_t& parser, ast::type_t var_type, token_t name_token);
-ast::global_variable_declaration_t parse_global_variable_definition(parser_t& parser, ast::type_t var_type, token_t name_token);
-
-ast::type_t parse_and_validate_typedef_struct_body(parser_t& parser, const ast::type_name_t& name);
-
-ast::type_t parse_and_validate_anonymous_typedef_struct_definition(parser_t& parser);
-
-ast::type_t parse_and_validate_type(parser_t& parser);
-ast::type_t parse_typedef_struct_decl_or_def(parser_t& parser);
-
-ast::return_statement_t parse_and_validate_return_statement(parser_t& parser);
-ast::expression_statement_t parse_and_validate_expression_statement(parser_t& parser);
-ast::if_statement_t parse_and_validate_if_statement(parser_t& parser);
-ast::statement_t parse_and_validate_statement(parser_t& parser);
-ast::declaration_t parse_and_validate_declaration(parser_t& parser);
-ast::compound_statement_t parse_and_validate_compound_statement(parser_t& parser, bool is_function_block = false);
-ast::function_declaration_t parse_function_declaration(parser_t& parser, ast::type_t type, token_t name_token, std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>>&& param_list);
-ast::function_definition_t parse_function_definition(parser_t& parser, ast::type_t type, token_t name_token, std::vector<std::pair<ast::type_t, std::optional<ast::var_name_t>>>&& param_list);
-std::variant<ast::function_declaration_t, ast::function_definition_t> parse_function_decl_or_def(parser_t& parser, ast::type_t type, token_t name_token);
-std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t> parse_function_or_global(parser_t& parser);
-ast::type_t parse_and_validate_struct_body(parser_t& parser, const ast::type_name_t& name);
-ast::type_t parse_struct(parser_t& parser);
-ast::type_t parse_typedef(parser_t& parser);
-std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t> parse_top_level_declaration(parser_t& parser);
-ast::validated_program_t parse(parser_t& parser);
+bool is_a_type_token(parser_t& parser, token_index_t token);
+
+utils::result_t<ast::type_t> parse_type_name_from_token(parser_t& parser, token_index_t token);
+utils::result_t<ast::type_t> parse_struct_name_from_token(parser_t& parser, token_index_t token);
+
+utils::result_t<ast::global_variable_declaration_t> parse_global_variable_declaration(parser_t& parser, ast::type_t var_type, ast::var_name_t var_name);
+utils::result_t<ast::global_variable_declaration_t> parse_global_variable_definition(parser_t& parser, ast::type_t var_type, ast::var_name_t var_name);
+
+utils::result_t<ast::type_t> parse_and_validate_typedef_struct_body(parser_t& parser, const ast::type_name_t& name);
+
+utils::result_t<ast::type_t> parse_and_validate_anonymous_typedef_struct_definition(parser_t& parser);
+
+utils::result_t<ast::type_t> parse_and_validate_type(parser_t& parser);
+utils::result_t<ast::type_t> parse_typedef_struct_decl_or_def(parser_t& parser);
+
+utils::result_t<ast::return_statement_t> parse_and_validate_return_statement(parser_t& parser);
+utils::result_t<ast::expression_statement_t> parse_and_validate_expression_statement(parser_t& parser);
+utils::result_t<ast::if_statement_t> parse_and_validate_if_statement(parser_t& parser);
+utils::result_t<ast::statement_t> parse_and_validate_statement(parser_t& parser);
+utils::result_t<ast::declaration_t> parse_and_validate_declaration(parser_t& parser);
+utils::result_t<ast::compound_statement_t> parse_and_validate_compound_statement(parser_t& parser, bool is_function_block = false);
+utils::result_t<ast::function_declaration_t> parse_function_declaration(parser_t& parser, ast::type_t type, ast::func_name_t name, std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>>&& param_list);
+utils::result_t<ast::function_definition_t> parse_function_definition(parser_t& parser, ast::type_t type, ast::func_name_t name, std::vector<std::pair<ast::expression_type_t, std::optional<ast::var_name_t>>>&& param_list);
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t>> parse_function_decl_or_def(parser_t& parser, ast::type_t type, ast::func_name_t name);
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t>> parse_function_or_global(parser_t& parser);
+utils::result_t<ast::type_t> parse_and_validate_struct_body(parser_t& parser, const ast::type_name_t& name);
+utils::result_t<ast::type_t> parse_struct(parser_t& parser);
+utils::result_t<ast::type_t> parse_typedef(parser_t& parser);
+utils::result_t<std::variant<ast::function_declaration_t, ast::function_definition_t, ast::global_variable_declaration_t, ast::type_t>> parse_top_level_declaration(parser_t& parser);
+utils::result_t<ast::compound_statement_t> parse_and_validate_function_body(parser_t& parser, const ast::function_definition_t& function_definition);
+utils::result_t<skipped_function_body_t> skip_function_body(parser_t& parser);
+// Errors in the program are reported to `parser.diagnostics` and make the result `utils::error`. Only internal errors are thrown.
+utils::result_t<ast::validated_program_t> parse(parser_t& parser);
+// Gives the same result as `parse()`, but parses the function bodies concurrently on `thread_pool`.
+// Phase one parses the top level declarations in order and skips over each function body by matching braces.
+// Phase two parses the bodies, each with its own parser and variable scopes, reading the (by then complete) global symbol tables.
+// The nodes of each body are moved into the program's pools in source order afterwards, so the result is deterministic.
+// Falls back to `parse()` from the start if anything doesn't parse, or if a body uses an identifier that a later top level declaration changes the meaning of.
+utils::result_t<ast::validated_program_t> parse_in_parallel(parser_t& parser, utils::thread_pool_t& thread_pool);
+// Only parses (and keeps in the program, so only type checks and compiles) the function bodies that are needed. The other bodies are only lexed, to skip over them.
+// Those are the functions that (transitively) can be called from other translation units, which is every function as there is no `static` (yet).
+// If `is_whole_program` (i.e. nothing else is linked in, e.g. to run the program right away), they are only the functions that `main` (transitively) calls,
+//  or every function if there is no `main`.
+// Errors in the bodies that aren't needed aren't reported. Otherwise the result is the same as `parse()`'s, which it falls back to in the same cases as `parse_in_parallel()`.
+utils::result_t<ast::validated_program_t> parse_lazily(parser_t& parser, bool is_whole_program);
 
 // defined in middle_end/typing/generate_typing.cpp:
 
 // `exp_type` is an outparam
-void add_type_to_function_call(const validation_t& validation, const ast::function_call_t& expr, std::optional<ast::type_t>& exp_type);
-void add_type_to_variable(const validation_t& validation, const ast::var_name_t& expr, std::optional<ast::type_t>& exp_type);
+void add_type_to_function_call(const validation_t& validation, const ast::function_call_t& expr, ast::expression_type_t& exp_type);
+void add_type_to_variable(const validation_t& validation, const ast::var_name_t& expr, ast::expression_type_t& exp_type);
@@ -1,8 +1,8 @@
 #include "parser_utils.hpp"
 
 
-bool is_constant(token_t token) {
-    switch(token.token_type) {
+bool is_constant(const token_type_t token_type) {
+    switch(token_type) {
         case token_type_t::CHAR_CONSTANT:
         case token_type_t::INT_CONSTANT:
         case token_type_t::UNSIGNED_INT_CONSTANT:
@@ -20,10 +20,10 @@ bool is_constant(token_t token) {
 
 ast::variable_access_t validate_lvalue_expression_exp(const ast::expression_t& expr) {
     return std::visit(overloaded{
-        [](const std::shared_ptr<ast::grouping_t>& grouping) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::grouping_t>& grouping) -> ast::variable_access_t {
             return validate_lvalue_expression_exp(grouping->expr);
         },
-        [](const std::shared_ptr<ast::unary_expression_t>& unary_exp) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) -> ast::variable_access_t {
             switch(unary_exp->op) {
                 case ast::unary_operator_token_t::PLUS_PLUS:
                 case ast::unary_operator_token_t::MINUS_MINUS:
@@ -32,9 +32,9 @@ ast::variable_access_t validate_lvalue_expression_exp(const ast::expression_t& e
                     }
             }
             throw std::runtime_error("Cannot assign to unary operator of type [" + std::to_string(static_cast<std::uint16_t>(unary_exp->op)) + "].");
-            return ast::variable_access_t{ast::var_name_t(""), std::vector<ast::var_name_t>{}};
+            return ast::variable_access_t{ast::var_name_t{}, {}};
         },
-        [](const std::shared_ptr<ast::binary_expression_t>& binary_exp) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) -> ast::variable_access_t {
             switch(binary_exp->op) {
                 case ast::binary_operator_token_t::ASSIGNMENT:
                     return validate_lvalue_expression_exp(binary_exp->left);
@@ -44,71 +44,66 @@ ast::variable_access_t validate_lvalue_expression_exp(const ast::expression_t& e
             throw std::runtime_error("Cannot assign to binary operator of type [" + std::to_string(static_cast<std::uint16_t>(binary_exp->op)) + "].");
         },
         // TODO: Check if C has lvalue ternary expressions. Currently only rvalue ternary expressions are supported. I believe only C++ has lvalue expressions, but I need to double check.
-        [](const std::shared_ptr<ast::ternary_expression_t>& ternary_exp) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::ternary_expression_t>& ternary_exp) -> ast::variable_access_t {
             throw std::runtime_error("Cannot assign to ternary operator.");
-            return ast::variable_access_t{ast::var_name_t(""), std::vector<ast::var_name_t>{}};
+            return ast::variable_access_t{ast::var_name_t{}, {}};
         },
-        [](const std::shared_ptr<ast::function_call_t>& function_call) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::function_call_t>& function_call) -> ast::variable_access_t {
             throw std::runtime_error("Cannot assign to function call.");
-            return ast::variable_access_t{ast::var_name_t(""), std::vector<ast::var_name_t>{}};
+            return ast::variable_access_t{ast::var_name_t{}, {}};
         },
         [](const ast::constant_t& constant) -> ast::variable_access_t {
             throw std::runtime_error("You cannot assign to a constant.");
-            return ast::variable_access_t{ast::var_name_t(""), std::vector<ast::var_name_t>{}};
+            return ast::variable_access_t{ast::var_name_t{}, {}};
         },
         [](const ast::variable_access_t& var_name) -> ast::variable_access_t {
             return var_name;
         },
-        [](const std::shared_ptr<ast::convert_t>& convert) -> ast::variable_access_t {
+        [](const ast::node_handle_t<ast::convert_t>& convert) -> ast::variable_access_t {
             throw std::runtime_error("Cannot assign to cast.");
-            return ast::variable_access_t{ast::var_name_t(""), std::vector<ast::var_name_t>{}};
+            return ast::variable_access_t{ast::var_name_t{}, {}};
         }
     }, expr.expr);
 }
-ast::expression_t validate_lvalue_expression_exp_with_type(const ast::expression_t& expr) {
+utils::result_t<ast::expression_t> validate_lvalue_expression_exp_with_type(parser_t& parser, const ast::expression_t& expr) {
     return std::visit(overloaded{
-        [&expr](const std::shared_ptr<ast::grouping_t>& grouping) -> ast::expression_t {
-            return validate_lvalue_expression_exp_with_type(grouping->expr);
+        [&parser](const ast::node_handle_t<ast::grouping_t>& grouping) -> utils::result_t<ast::expression_t> {
+            return validate_lvalue_expression_exp_with_type(parser, grouping->expr);
         },
-        [&expr](const std::shared_ptr<ast::unary_expression_t>& unary_exp) -> ast::expression_t {
+        [&parser](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) -> utils::result_t<ast::expression_t> {
             switch(unary_exp->op) {
                 case ast::unary_operator_token_t::PLUS_PLUS:
                 case ast::unary_operator_token_t::MINUS_MINUS:
                     if(unary_exp->fixity == ast::unary_operator_fixity_t::PREFIX) {
-                        return validate_lvalue_expression_exp_with_type(unary_exp->exp);
+                        return validate_lvalue_expression_exp_with_type(parser, unary_exp->exp);
                     }
             }
-            throw std::runtime_error("Cannot assign to unary operator of type [" + std::to_string(static_cast<std::uint16_t>(unary_exp->op)) + "].");
-            return expr;
+            return parser.error("Cannot assign to unary operator of type [" + std::to_string(static_cast<std::uint16_t>(unary_exp->op)) + "].");
         },
-        [](const std::shared_ptr<ast::binary_expression_t>& binary_exp) -> ast::expression_t {
+        [&parser](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) -> utils::result_t<ast::expression_t> {
             switch(binary_exp->op) {
                 case ast::binary_operator_token_t::ASSIGNMENT:
-                    return validate_lvalue_expression_exp_with_type(binary_exp->left);
+                    return validate_lvalue_expression_exp_with_type(parser, binary_exp->left);
                 case ast::binary_operator_token_t::COMMA:
-                    return validate_lvalue_expression_exp_with_type(binary_exp->right);
+                    return validate_lvalue_expression_exp_with_type(parser, binary_exp->right);
             }
-            throw std::runtime_error("Cannot assign to binary operator of type [" + std::to_string(static_cast<std::uint16_t>(binary_exp->op)) + "].");
+            return parser.error("Cannot assign to binary operator of type [" + std::to_string(static_cast<std::uint16_t>(binary_exp->op)) + "].");
         },
         // TODO: Check if C has lvalue ternary expressions. Currently only rvalue ternary expressions are supported. I believe only C++ has lvalue expressions, but I need to double check.
-        [&expr](const std::shared_ptr<ast::ternary_expression_t>& ternary_exp) -> ast::expression_t {
-            throw std::runtime_error("Cannot assign to ternary operator.");
-            return expr;
+        [&parser](const ast::node_handle_t<ast::ternary_expression_t>& ternary_exp) -> utils::result_t<ast::expression_t> {
+            return parser.error("Cannot assign to ternary operator.");
         },
-        [&expr](const std::shared_ptr<ast::function_call_t>& function_call) -> ast::expression_t {
-            throw std::runtime_error("Cannot assign to function call.");
-            return expr;
+        [&parser](const ast::node_handle_t<ast::function_call_t>& function_call) -> utils::result_t<ast::expression_t> {
+            return parser.error("Cannot assign to function call.");
         },
-        [&expr](const ast::constant_t& constant) -> ast::expression_t {
-            throw std::runtime_error("You cannot assign to a constant.");
-            return expr;
+        [&parser](const ast::constant_t& constant) -> utils::result_t<ast::expression_t> {
+            return parser.error("You cannot assign to a constant.");
         },
-        [&expr](const ast::variable_access_t& var_name) -> ast::expression_t {
+        [&expr](const ast::variable_access_t& var_name) -> utils::result_t<ast::expression_t> {
             return expr;
         },
-        [&expr](const std::shared_ptr<ast::convert_t>& convert) -> ast::expression_t {
-            throw std::runtime_error("Cannot assign to cast.");
-            return expr;
+        [&parser](const ast::node_handle_t<ast::convert_t>& convert) -> utils::result_t<ast::expression_t> {
+            return parser.error("Cannot assign to cast.");
         }
     }, expr.expr);
 }
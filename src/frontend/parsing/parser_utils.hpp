@@ -2,61 +2,111 @@
 
 
 #include <stdexcept>
+#include <iostream>
+#include <ostream>
 #include <utility>
 #include <memory>
+#include <string>
 
 #include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
 #include <frontend/ast/ast.hpp>
 #include <utils/data_structures/random_access_stack.hpp>
 #include <utils/common.hpp>
+#include <utils/result.hpp>
 
 
-struct validation_t {
-    utils::data_structures::validation_variable_lookup_t variable_lookup;
-
+// Symbols declared at file scope. Only top level declarations add to them, function bodies only ever read them.
+struct global_symbols_t {
     std::unordered_map<ast::func_name_t, ast::function_declaration_t> function_declarations_lookup;
-    std::unordered_map<ast::func_name_t, ast::function_definition_t> function_definitions_lookup;
+    std::unordered_map<ast::func_name_t, ast::function_definition_t> function_definitions_lookup; // the bodies are left out, only the signatures are needed
 
     std::unordered_map<ast::var_name_t, ast::global_variable_declaration_t> global_variable_declarations;
     std::unordered_map<ast::var_name_t, ast::global_variable_declaration_t> global_variable_definitions;
 
     ast::type_table_t type_table;
+    // The types of the declarations above are interned here, in the pools of the top level declarations. Function bodies parsed into pools of their own
+    //  (see `parse_in_parallel()`) resolve them through this, as their current pools are not the ones that interned them.
+    const ast::type_context_t* types = nullptr;
+
+    const ast::type_t& get_type(const ast::expression_type_t type) const {
+        return types->get(type.id());
+    }
+};
+
+struct validation_t {
+    utils::data_structures::validation_variable_lookup_t variable_lookup;
+
+    // Shared (and not copied) between the parsers of function bodies that are parsed in parallel (see `parse_in_parallel()`), each of which has its own `variable_lookup`.
+    std::shared_ptr<global_symbols_t> globals = std::make_shared<global_symbols_t>();
+};
+
+// A function body that `parse_function_definition()` skipped over by brace matching instead of parsing it, to be parsed later by `parse_in_parallel()`.
+struct skipped_function_body_t {
+    token_stream_t tokens; // starts at the body's `{`
+    std::vector<utils::symbol_t> identifiers; // every identifier used in the body, with repeats
 };
 
 struct parser_t {
-    std::vector<token_t> tokens;
-    std::uint32_t current_token_index = 0; // number of tokens processed so far, starts at `0`, terminates at `tokens.size()`.
+    token_stream_t tokens;
 
     validation_t symbol_info;
 
+    // If set, function definitions are added with empty bodies and their bodies are skipped over and appended to this instead.
+    std::vector<skipped_function_body_t>* skipped_function_bodies = nullptr;
+    // Set for parsers whose errors are thrown away because everything is parsed again in order on an error (see `parse_in_parallel()`), so they stay quiet.
+    bool is_speculative = false;
+
+    // Every error is reported here (at `diagnostic_offset()`) before the function that found it returns `utils::error`.
+    utils::diagnostics_t diagnostics;
+
     parser_t() = delete;
-    parser_t(std::vector<token_t> tokens) : tokens(std::move(tokens)) {}
+    parser_t(token_stream_t tokens) : tokens(std::move(tokens)) {}
+    parser_t(token_stream_t tokens, std::shared_ptr<global_symbols_t> globals) : tokens(std::move(tokens)) {
+        symbol_info.globals = std::move(globals);
+    }
 
+    // Where the debug output goes, which is where the lexer prints to as well. Pointed at a buffer (see `debug_output_scope_t`) while what is printed might
+    //  still be thrown away, or has to be put in order.
+    std::ostream& get_debug_output() const {
+        return tokens.get_debug_output();
+    }
+    void set_debug_output(std::ostream& output) {
+        tokens.set_debug_output(output);
+    }
+
+    // `true` once the current token is `EOF_TOK`
     bool is_eof() const {
-        return current_token_index >= tokens.size();
+        return tokens.is_eof();
     }
     // `is_eof()` == `is_eof_n(0)`
     bool is_eof_n(const std::uint32_t lookahead) const {
-        return (current_token_index + lookahead) >= tokens.size();
+        return token_type(peek_token_n(lookahead)) == token_type_t::EOF_TOK;
     }
 
-    token_t peek_token() const {
-        if(is_eof()) {
-            return token_t{token_type_t::EOF_TOK, "", 0}; // TODO: Put in an actual line number instead of just `0`
-        }
-        return tokens.at(current_token_index);
+    token_type_t token_type(const token_index_t token) const {
+        return tokens.token_type(token);
+    }
+    std::string_view token_text(const token_index_t token) const {
+        return tokens.token_text(token);
+    }
+    utils::symbol_t token_symbol(const token_index_t token) const {
+        return tokens.token_symbol(token);
+    }
+
+    token_index_t peek_token() const {
+        return tokens.peek_token();
     }
     // `peek_token()` == `peek_token(0)`
-    token_t peek_token_n(const std::uint32_t lookahead) const {
-        if(is_eof_n(lookahead)) {
-            throw std::logic_error("Invalid lookahead. Out of bounds of parser tokens.");
-        }
-        return tokens.at(current_token_index + lookahead);
+    token_index_t peek_token_n(const std::uint32_t lookahead) const {
+        return tokens.peek_token_n(lookahead);
+    }
+    token_type_t peek_token_type() const {
+        return tokens.peek_token_type();
     }
 
     bool is_eof_back_n(const std::uint32_t lookbehind) const {
-        const std::int64_t new_index = static_cast<std::int64_t>(current_token_index) - static_cast<std::int64_t>(lookbehind);
-        return new_index < 0;
+        return !tokens.has_lookbehind_n(lookbehind);
     }
     // `is_eof_back()` == `is_eof_back_n(1)`
     bool is_eof_back() const {
@@ -64,48 +114,74 @@ struct parser_t {
     }
 
     // `peek_back()` == `peek_back_n(1)`
-    token_t peek_back_n(const std::uint32_t lookbehind) const {
-        const std::int64_t new_index = static_cast<std::int64_t>(current_token_index) - static_cast<std::int64_t>(lookbehind);
-        if(is_eof_back_n(lookbehind)) {
-            throw std::logic_error("Invalid lookbehind. Out of bounds of parser tokens.");
-        }
-        return tokens.at(new_index);
+    token_index_t peek_back_n(const std::uint32_t lookbehind) const {
+        return tokens.peek_back_n(lookbehind);
     }
-    token_t peek_back() const {
+    token_index_t peek_back() const {
         return peek_back_n(1);
     }
 
-    token_t advance_token() {
-        if(is_eof()) {
-            return token_t{token_type_t::EOF_TOK, "", 0}; // TODO: Put in an actual line number instead of just `0`
-        }
-        return tokens.at(current_token_index++);
+    // Source offset to report a diagnostic at: the last consumed token, since that is usually the one that didn't fit.
+    std::uint32_t diagnostic_offset() const {
+        return is_eof_back() ? 0u : tokens.token_offset(peek_back());
+    }
+
+    // `return parser.error(...);` reports an error at the last consumed token and fails.
+    utils::error_t error(std::string message) {
+        return diagnostics.report(std::move(message), diagnostic_offset());
+    }
+
+    token_index_t advance_token() {
+        return tokens.advance_token();
     }
     // `advance_token()` == `advance_token_n(1)`
-    token_t advance_token_n(const std::uint32_t lookahead) {
-        return tokens.at((current_token_index += lookahead) - 1);
+    token_index_t advance_token_n(const std::uint32_t lookahead) {
+        for(std::uint32_t i = 1; i < lookahead; ++i) {
+            tokens.advance_token();
+        }
+        return tokens.advance_token();
     }
 
-    void expect_token(const token_type_t expected, const char *const error_message) {
+    utils::result_t<void> expect_token(const token_type_t expected, const char *const error_message) {
         const auto actual_token = advance_token();
-        if(actual_token.token_type != expected) {
-            std::cout << "Found token: " << static_cast<std::uint32_t>(actual_token.token_type) << ": " << actual_token.token_text << std::endl;
-            throw std::runtime_error(error_message);
+        if(token_type(actual_token) != expected) {
+            if(!is_speculative) {
+                get_debug_output() << "Found token: " << static_cast<std::uint32_t>(token_type(actual_token)) << ": " << token_text(actual_token) << std::endl;
+            }
+            return error(error_message);
         }
+        return {};
+    }
+};
+
+
+// Points the debug output of `parser` (and of its lexer) at `output` for the lifetime of the scope, whichever way it's left.
+class debug_output_scope_t {
+    parser_t& parser;
+    std::ostream& previous_debug_output;
+
+public:
+    debug_output_scope_t(parser_t& parser, std::ostream& output) : parser(parser), previous_debug_output(parser.get_debug_output()) {
+        parser.set_debug_output(output);
+    }
+    debug_output_scope_t(const debug_output_scope_t&) = delete;
+    debug_output_scope_t& operator=(const debug_output_scope_t&) = delete;
+    ~debug_output_scope_t() {
+        parser.set_debug_output(previous_debug_output);
     }
 };
 
 
-bool is_constant(token_t token);
-inline bool is_var_name(token_t token) {
-    return token.token_type == token_type_t::IDENTIFIER;
+bool is_constant(token_type_t token_type);
+inline bool is_var_name(const token_type_t token_type) {
+    return token_type == token_type_t::IDENTIFIER;
 }
-inline bool is_struct_keyword(token_t token) {
-    return token.token_type == token_type_t::STRUCT_KEYWORD;
+inline bool is_struct_keyword(const token_type_t token_type) {
+    return token_type == token_type_t::STRUCT_KEYWORD;
 }
-inline bool is_typedef_keyword(token_t token) {
-    return token.token_type == token_type_t::TYPEDEF_KEYWORD;
+inline bool is_typedef_keyword(const token_type_t token_type) {
+    return token_type == token_type_t::TYPEDEF_KEYWORD;
 }
 
 ast::variable_access_t validate_lvalue_expression_exp(const ast::expression_t& expr);
-ast::expression_t validate_lvalue_expression_exp_with_type(const ast::expression_t& expr);
+utils::result_t<ast::expression_t> validate_lvalue_expression_exp_with_type(parser_t& parser, const ast::expression_t& expr);
@@ -23,7 +23,7 @@ std::string read_file_into_string(const char *const filename) {
 }
 
 void write_string_into_file(const std::string& contents, const char *const filename) {
-    std::ofstream out_file(filename);
+    std::ofstream out_file(filename, std::ios::binary); // object files aren't text
     out_file << contents;
 }
 
@@ -0,0 +1,136 @@
+#include "source_buffer.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+source_buffer_t::source_buffer_t(source_buffer_t&& other) noexcept :
+    data(std::exchange(other.data, nullptr)),
+    length(std::exchange(other.length, 0u)),
+    is_mapped(std::exchange(other.is_mapped, false))
+{}
+source_buffer_t& source_buffer_t::operator=(source_buffer_t&& other) noexcept {
+    if(this != &other) {
+        this->~source_buffer_t();
+        data = std::exchange(other.data, nullptr);
+        length = std::exchange(other.length, 0u);
+        is_mapped = std::exchange(other.is_mapped, false);
+    }
+    return *this;
+}
+source_buffer_t::~source_buffer_t() {
+    if(data == nullptr) {
+        return;
+    }
+    if(is_mapped) {
+        munmap(const_cast<char*>(data), length);
+    } else {
+        std::free(const_cast<char*>(data));
+    }
+}
+
+
+static source_buffer_t read_unmappable_file(const int fd, const char *const filename) {
+    std::size_t capacity = 64u * 1024u;
+    std::size_t length = 0u;
+    char* buffer = static_cast<char*>(std::malloc(capacity));
+
+    for(;;) {
+        if(buffer == nullptr) {
+            throw std::bad_alloc();
+        }
+        if(length == capacity) {
+            capacity *= 2u;
+            char *const new_buffer = static_cast<char*>(std::realloc(buffer, capacity));
+            if(new_buffer == nullptr) {
+                std::free(buffer);
+                throw std::bad_alloc();
+            }
+            buffer = new_buffer;
+        }
+
+        const ssize_t amount_read = read(fd, buffer + length, capacity - length);
+        if(amount_read == 0) {
+            break;
+        }
+        if(amount_read < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            std::free(buffer);
+            throw std::runtime_error("Failed to read file: " + std::string(filename));
+        }
+        length += static_cast<std::size_t>(amount_read);
+    }
+
+    return source_buffer_t{buffer, length, false};
+}
+
+// tokens store their position as a 32-bit offset into the source text
+static void check_source_size(const std::size_t length, const char *const filename) {
+    if(length > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Source files larger than 4 GiB are not supported: " + std::string(filename));
+    }
+}
+
+namespace {
+// Closes a file descriptor that `open()` returned when the scope is left, by whichever path. stdin is never closed.
+class file_descriptor_guard_t {
+    int fd;
+    bool is_owned;
+
+public:
+    file_descriptor_guard_t(const int fd, const bool is_owned) : fd(fd), is_owned(is_owned) {}
+    file_descriptor_guard_t(const file_descriptor_guard_t&) = delete;
+    file_descriptor_guard_t& operator=(const file_descriptor_guard_t&) = delete;
+    ~file_descriptor_guard_t() {
+        if(is_owned && fd >= 0) {
+            close(fd);
+        }
+    }
+};
+}
+
+source_buffer_t load_source_file(const char *const filename) {
+    const bool is_stdin = std::strcmp(filename, "-") == 0;
+    const int fd = is_stdin ? STDIN_FILENO : open(filename, O_RDONLY | O_CLOEXEC);
+    const file_descriptor_guard_t fd_guard(fd, !is_stdin);
+    if(fd < 0) {
+        // we should report this error (besides a stack trace) to the user since mistyping a filename is a common user error
+        std::cout << "Failed to read file: " << filename << '\n';
+        throw std::runtime_error("Failed to read file: " + std::string(filename));
+    }
+
+    struct stat file_info{};
+    if(fstat(fd, &file_info) != 0 || !S_ISREG(file_info.st_mode)) {
+        auto buffer = read_unmappable_file(fd, filename);
+        check_source_size(buffer.size(), filename);
+        return buffer;
+    }
+
+    const auto length = static_cast<std::size_t>(file_info.st_size);
+    check_source_size(length, filename);
+    // `mmap()` rejects zero length mappings. The mapping keeps its own reference to the file, so `fd` can be closed as soon as we return.
+    void *const mapping = (length == 0u) ? nullptr : mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(length == 0u) {
+        return source_buffer_t{};
+    }
+    if(mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map file: " + std::string(filename));
+    }
+    madvise(mapping, length, MADV_SEQUENTIAL); // the lexer only ever walks forwards, so let the kernel read ahead aggressively
+
+    return source_buffer_t{static_cast<const char*>(mapping), length, true};
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+
+#include <cstddef>
+#include <string_view>
+
+
+// Read-only bytes of a source file.
+// Regular files are memory-mapped so the lexer (and every token's `std::string_view`) points straight into the page cache instead of into a copy.
+// Pipes, character devices and stdin (passed as `-`) can't be mapped, so for those we fall back to `read()`ing into a heap buffer.
+// NOTE: The buffer is NOT null terminated. All reads must be bounded by `end()`.
+class source_buffer_t {
+    const char* data = nullptr;
+    std::size_t length = 0u;
+    bool is_mapped = false; // `true` if `data` must be released with `munmap()`, `false` if it must be released with `std::free()`
+
+public:
+    source_buffer_t() = default;
+    source_buffer_t(const char* data, std::size_t length, bool is_mapped) : data(data), length(length), is_mapped(is_mapped) {}
+
+    source_buffer_t(const source_buffer_t&) = delete;
+    source_buffer_t& operator=(const source_buffer_t&) = delete;
+    source_buffer_t(source_buffer_t&& other) noexcept;
+    source_buffer_t& operator=(source_buffer_t&& other) noexcept;
+    ~source_buffer_t();
+
+    const char* begin() const {
+        return data;
+    }
+    const char* end() const {
+        return data + length;
+    }
+    std::size_t size() const {
+        return length;
+    }
+    std::string_view view() const {
+        return {data, length};
+    }
+};
+
+
+// `filename` of `-` reads from stdin
+source_buffer_t load_source_file(const char* filename);
@@ -0,0 +1,19 @@
+#include "source_manager.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <frontend/lexing/scan_kernels.hpp>
+
+
+source_manager_t::source_manager_t(const std::string_view text) {
+    line_starts.push_back(0u);
+    find_line_starts(text.data(), text.data() + text.size(), line_starts);
+}
+
+source_location_t source_manager_t::get_location(const std::uint32_t offset) const {
+    // the last line starting at or before `offset`. `line_starts[0] == 0`, so there always is one
+    const auto line_start_iter = std::prev(std::upper_bound(std::begin(line_starts), std::end(line_starts), offset));
+    const auto line = static_cast<utils::line_number_t>(std::distance(std::begin(line_starts), line_start_iter));
+    return source_location_t{line + 1u, offset - *line_start_iter + 1u};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <utils/common.hpp>
+
+
+// 1 based line and column of a character in a source text. Columns count bytes, not code points.
+struct source_location_t {
+    utils::line_number_t line;
+    std::uint32_t column;
+};
+
+// Maps byte offsets into a source text back to line:column.
+// The lexer doesn't keep track of line numbers, tokens only store their offset. The start of every line is recorded once up front instead,
+//  and a location is only resolved (by binary search) when something like a diagnostic actually needs it.
+class source_manager_t {
+    std::vector<std::uint32_t> line_starts; // offset of the first character of each line, always starts with `0`
+
+public:
+    source_manager_t() = delete;
+    explicit source_manager_t(std::string_view text);
+
+    std::uint32_t line_count() const {
+        return static_cast<std::uint32_t>(line_starts.size());
+    }
+
+    // `offset` may be anywhere in `[0, text.size()]`. A `\n` belongs to the line it ends.
+    source_location_t get_location(std::uint32_t offset) const;
+};
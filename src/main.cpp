@@ -9,58 +9,182 @@
 #include <iostream>
 #include <cstring>
 #include <stdexcept>
+#include <vector>
+#include <optional>
 
 #include <io/file_io.hpp>
+#include <io/source_buffer.hpp>
+#include <io/source_manager.hpp>
 #include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
 #include <frontend/parsing/parser.hpp>
 #include <frontend/ast/ast_printer.hpp>
 #include <middle_end/typing/type_checker.hpp>
-#include <backend/x86_64/traverse_ast.hpp>
+#include <middle_end/optimization/fold_constants.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <middle_end/ir/ir_printer.hpp>
+#include <middle_end/ir/verifier.hpp>
+#include <backend/x86_64/generate_from_ir.hpp>
+#include <backend/x86_64/elf_writer.hpp>
+#include <backend/x86_64/jit.hpp>
+#include <backend/interpreter/virtual_machine.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/result.hpp>
 
 #include <exception_stack_trace.hpp>
 
 
 #define FUZZING
 
+#ifdef FUZZING
+constexpr int EXIT_FAILURE_CODE = 0; // Temporary while we are fuzzing.
+#else
+constexpr int EXIT_FAILURE_CODE = 1;
+#endif
+
+static void print_diagnostics(const char *const filename, const source_buffer_t& source, const utils::diagnostics_t& diagnostics) {
+    std::optional<source_manager_t> source_manager; // line numbers are only worked out once we actually have something to report
+    for(const auto& diagnostic : diagnostics.get_diagnostics()) {
+        std::cerr << filename;
+        if(diagnostic.offset.has_value()) {
+            if(!source_manager.has_value()) {
+                source_manager.emplace(source.view());
+            }
+            const source_location_t location = source_manager->get_location(diagnostic.offset.value());
+            std::cerr << ':' << location.line << ':' << location.column;
+        }
+        std::cerr << ": error: " << diagnostic.message << '\n';
+    }
+}
+
 int main(int argc, char** argv) {
+    // `--lazy`: only parse, type check and compile the functions that are needed (see `parse_lazily()`). With `--run` or `--jit`, those are only the functions
+    //  that `main` needs.
+    bool is_lazy = false;
+    // `--dump-ir`: print the IR that the assembly is generated from
+    bool is_dumping_ir = false;
+    // `--run`: run the program in process (see `virtual_machine.hpp`) and exit with what `main()` returned, instead of generating assembly. Only what the
+    //  program prints is printed.
+    bool is_running = false;
+    // `--jit`: the same, natively (see `jit.hpp`)
+    bool is_jitting = false;
+    // `-c`: write an object file (see `elf_writer.hpp`) instead of assembly
+    bool is_writing_object = false;
+    std::vector<char*> args; // the input file and (optionally) the output file
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--lazy") == 0) {
+            is_lazy = true;
+        } else if(std::strcmp(argv[i], "--dump-ir") == 0) {
+            is_dumping_ir = true;
+        } else if(std::strcmp(argv[i], "--run") == 0) {
+            is_running = true;
+        } else if(std::strcmp(argv[i], "--jit") == 0) {
+            is_jitting = true;
+        } else if(std::strcmp(argv[i], "-c") == 0) {
+            is_writing_object = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
     std::string out_filename;
-    if(argc == 2) {
+    if(args.size() == 1) {
         uint32_t i;
-        for(i = 0; i < std::strlen(argv[1])-1 && (argv[1][i] != '.' || argv[1][i+1] == '/'); ++i);
-        out_filename = std::string(argv[1], i) + std::string(".s");
+        for(i = 0; i < std::strlen(args[0])-1 && (args[0][i] != '.' || args[0][i+1] == '/'); ++i);
+        out_filename = std::string(args[0], i) + std::string(is_writing_object ? ".o" : ".s");
     }
-    else if(argc == 3) {
-        out_filename = std::string(argv[2]);
+    else if(args.size() == 2) {
+        out_filename = std::string(args[1]);
     } else {
         std::cerr << "You require an input file\n";
     }
 
-    if(argc > 1) {
-        std::string file_contents = read_file_into_string(argv[1]);
+    if(!args.empty()) {
+        const source_buffer_t source = load_source_file(args[0]); // must outlive the tokens since their `std::string_view`s point straight into it
 
 #ifdef FUZZING
         try {
 #endif
-            lexer_t lexer(file_contents.c_str());
-            std::vector<token_t> tokens_list = scan_all_tokens(lexer);
-
-            parser_t parser(tokens_list);
-            ast::validated_program_t ast = parse(parser);
+            // what the compiler prints would be mixed up with what the program prints
+            std::streambuf *const cout_buffer = std::cout.rdbuf((is_running || is_jitting) ? nullptr : std::cout.rdbuf());
+            parser_t parser(token_stream_t{lexer_t(source.begin(), source.end())});
+            auto parsed_program = [&parser, is_lazy, is_whole_program = is_running || is_jitting]() {
+                if(is_lazy) {
+                    return parse_lazily(parser, is_whole_program);
+                }
+                utils::thread_pool_t thread_pool; // only started (and joined again) for the parallel parse
+                return parse_in_parallel(parser, thread_pool);
+            }();
+            if(!parsed_program.has_value()) {
+                print_diagnostics(args[0], source, parser.diagnostics);
+                return EXIT_FAILURE_CODE;
+            }
+            ast::validated_program_t ast = std::move(parsed_program).value();
 
             std::cout << "before type checking\n";
             print_validated_ast(ast);
 
-            type_check(ast); // mutates `valid_ast`
+            utils::diagnostics_t type_diagnostics;
+            if(!type_check(ast, type_diagnostics).has_value()) { // mutates `valid_ast`
+                print_diagnostics(args[0], source, type_diagnostics);
+                return EXIT_FAILURE_CODE;
+            }
 
             std::cout << "after type checking\n";
             print_validated_ast(ast);
 
-            std::string assembly_output = generate_asm(ast);
-            std::cout << "after assembly generation\n";
+            fold_constants(ast);
+
+            const ir::module_t ir_module = lower_to_ir(ast);
+            if(is_dumping_ir) {
+                // asked for, so it's printed even when the rest of what the compiler prints is silenced
+                std::streambuf *const silenced_buffer = std::cout.rdbuf(cout_buffer);
+                print_ir_module(ir_module);
+                std::cout.rdbuf(silenced_buffer);
+            }
+            utils::diagnostics_t ir_diagnostics;
+            if(!verify_module(ir_module, ir_diagnostics).has_value()) { // a bug in the lowering, not in the program
+                print_diagnostics(args[0], source, ir_diagnostics);
+                return EXIT_FAILURE_CODE;
+            }
+
+            if(is_running) {
+                std::cout.rdbuf(cout_buffer);
+                utils::diagnostics_t run_diagnostics;
+                auto program = compile_to_bytecode(ir_module, run_diagnostics);
+                const auto exit_code = program.has_value() ? run_program(program.value(), run_diagnostics) : utils::error;
+                if(!exit_code.has_value()) {
+                    print_diagnostics(args[0], source, run_diagnostics);
+                    return EXIT_FAILURE_CODE;
+                }
+                return exit_code.value();
+            }
+            if(is_jitting) {
+                std::cout.rdbuf(cout_buffer);
+                utils::diagnostics_t jit_diagnostics;
+                const auto program = compile_to_memory(ir_module, jit_diagnostics);
+                if(!program.has_value()) {
+                    print_diagnostics(args[0], source, jit_diagnostics);
+                    return EXIT_FAILURE_CODE;
+                }
+                return program.value().run_main();
+            }
+
+            if(is_writing_object) {
+                std::string object_output = generate_object(ir_module);
+                std::cout << "after object generation\n";
+
+#ifndef FUZZING
+                write_string_into_file(object_output, out_filename.c_str());
+#endif
+            } else {
+                std::string assembly_output = generate_asm(ir_module);
+                std::cout << "after assembly generation\n";
 
 #ifndef FUZZING
-            write_string_into_file(assembly_output, out_filename.c_str());
+                write_string_into_file(assembly_output, out_filename.c_str());
 #endif
+            }
 
 #ifdef FUZZING
         } catch(const std::runtime_error &e) {
@@ -0,0 +1,213 @@
+#include "ir.hpp"
+
+
+namespace ir {
+const instruction_t* function_t::terminator(const block_id_t block) const {
+    if(blocks[block].instructions.empty()) {
+        return nullptr;
+    }
+    const instruction_t& last = instructions[blocks[block].instructions.back()];
+    return is_terminator(last.opcode) ? &last : nullptr;
+}
+
+bool is_terminator(const opcode_t opcode) {
+    return opcode == opcode_t::JUMP || opcode == opcode_t::BRANCH || opcode == opcode_t::RET;
+}
+bool is_integer(const type_t type) {
+    return type == type_t::I8 || type == type_t::I16 || type == type_t::I32 || type == type_t::I64;
+}
+bool is_floating(const type_t type) {
+    return type == type_t::F32 || type == type_t::F64;
+}
+std::size_t get_size(const type_t type) {
+    switch(type) {
+        case type_t::VOID:
+            return 0u;
+        case type_t::I8:
+            return 1u;
+        case type_t::I16:
+            return 2u;
+        case type_t::I32:
+        case type_t::F32:
+            return 4u;
+        case type_t::I64:
+        case type_t::F64:
+        case type_t::PTR:
+            return 8u;
+    }
+    throw std::logic_error("Invalid IR type.");
+}
+
+const char* get_type_name(const type_t type) {
+    switch(type) {
+        case type_t::VOID:
+            return "void";
+        case type_t::I8:
+            return "i8";
+        case type_t::I16:
+            return "i16";
+        case type_t::I32:
+            return "i32";
+        case type_t::I64:
+            return "i64";
+        case type_t::F32:
+            return "f32";
+        case type_t::F64:
+            return "f64";
+        case type_t::PTR:
+            return "ptr";
+    }
+    throw std::logic_error("Invalid IR type.");
+}
+const char* get_opcode_name(const opcode_t opcode) {
+    switch(opcode) {
+        case opcode_t::PARAM: return "param";
+        case opcode_t::CONST: return "const";
+        case opcode_t::ALLOCA: return "alloca";
+        case opcode_t::GLOBAL_ADDRESS: return "global_address";
+        case opcode_t::PTR_OFFSET: return "ptr_offset";
+        case opcode_t::LOAD: return "load";
+        case opcode_t::STORE: return "store";
+        case opcode_t::COPY: return "copy";
+        case opcode_t::ADD: return "add";
+        case opcode_t::SUB: return "sub";
+        case opcode_t::MUL: return "mul";
+        case opcode_t::SDIV: return "sdiv";
+        case opcode_t::UDIV: return "udiv";
+        case opcode_t::SREM: return "srem";
+        case opcode_t::UREM: return "urem";
+        case opcode_t::SHL: return "shl";
+        case opcode_t::ASHR: return "ashr";
+        case opcode_t::LSHR: return "lshr";
+        case opcode_t::AND: return "and";
+        case opcode_t::OR: return "or";
+        case opcode_t::XOR: return "xor";
+        case opcode_t::NEG: return "neg";
+        case opcode_t::NOT: return "not";
+        case opcode_t::FADD: return "fadd";
+        case opcode_t::FSUB: return "fsub";
+        case opcode_t::FMUL: return "fmul";
+        case opcode_t::FDIV: return "fdiv";
+        case opcode_t::FNEG: return "fneg";
+        case opcode_t::EQ: return "eq";
+        case opcode_t::NE: return "ne";
+        case opcode_t::SLT: return "slt";
+        case opcode_t::SLE: return "sle";
+        case opcode_t::SGT: return "sgt";
+        case opcode_t::SGE: return "sge";
+        case opcode_t::ULT: return "ult";
+        case opcode_t::ULE: return "ule";
+        case opcode_t::UGT: return "ugt";
+        case opcode_t::UGE: return "uge";
+        case opcode_t::FEQ: return "feq";
+        case opcode_t::FNE: return "fne";
+        case opcode_t::FLT: return "flt";
+        case opcode_t::FLE: return "fle";
+        case opcode_t::FGT: return "fgt";
+        case opcode_t::FGE: return "fge";
+        case opcode_t::SEXT: return "sext";
+        case opcode_t::ZEXT: return "zext";
+        case opcode_t::TRUNC: return "trunc";
+        case opcode_t::SITOFP: return "sitofp";
+        case opcode_t::UITOFP: return "uitofp";
+        case opcode_t::FPTOSI: return "fptosi";
+        case opcode_t::FPTOUI: return "fptoui";
+        case opcode_t::FPEXT: return "fpext";
+        case opcode_t::FPTRUNC: return "fptrunc";
+        case opcode_t::CALL: return "call";
+        case opcode_t::PHI: return "phi";
+        case opcode_t::JUMP: return "jump";
+        case opcode_t::BRANCH: return "branch";
+        case opcode_t::RET: return "ret";
+    }
+    throw std::logic_error("Invalid IR opcode.");
+}
+
+std::vector<std::vector<block_id_t>> compute_predecessors(const function_t& function) {
+    std::vector<std::vector<block_id_t>> predecessors(function.blocks.size());
+    for(block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        if(const instruction_t *const terminator = function.terminator(block)) {
+            for(const block_id_t target : terminator->targets) {
+                predecessors[target].push_back(block);
+            }
+        }
+    }
+    return predecessors;
+}
+
+void remove_unreachable_blocks(function_t& function) {
+    constexpr auto REMOVED = std::numeric_limits<std::uint32_t>::max();
+
+    // number the reachable blocks in the order they were made, so that the entry block stays first
+    std::vector<bool> is_reachable(function.blocks.size(), false);
+    std::vector<block_id_t> worklist{0u};
+    is_reachable[0] = true;
+    while(!worklist.empty()) {
+        const block_id_t block = worklist.back();
+        worklist.pop_back();
+        if(const instruction_t *const terminator = function.terminator(block)) {
+            for(const block_id_t target : terminator->targets) {
+                if(!is_reachable[target]) {
+                    is_reachable[target] = true;
+                    worklist.push_back(target);
+                }
+            }
+        }
+    }
+    std::vector<block_id_t> new_block_ids(function.blocks.size(), REMOVED);
+    block_id_t block_count = 0u;
+    for(block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        if(is_reachable[block]) {
+            new_block_ids[block] = block_count++;
+        }
+    }
+
+    // values are numbered in block order, so that a dump reads top to bottom (phis can refer to values that come later, so this takes two passes)
+    std::vector<value_t> new_values(function.instructions.size(), REMOVED);
+    value_t value_count = 0u;
+    for(block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        if(is_reachable[block]) {
+            for(const value_t value : function.blocks[block].instructions) {
+                new_values[value] = value_count++;
+            }
+        }
+    }
+
+    std::vector<instruction_t> instructions;
+    std::vector<block_t> blocks;
+    instructions.reserve(value_count);
+    blocks.reserve(block_count);
+    for(block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        if(!is_reachable[block]) {
+            continue;
+        }
+        block_t& new_block = blocks.emplace_back();
+        for(const value_t value : function.blocks[block].instructions) {
+            instruction_t instruction = std::move(function.instructions[value]);
+            if(instruction.opcode == opcode_t::PHI) {
+                std::vector<value_t> operands;
+                std::vector<block_id_t> incoming_blocks;
+                for(std::size_t i = 0u; i < instruction.targets.size(); ++i) {
+                    if(is_reachable[instruction.targets[i]]) {
+                        operands.push_back(new_values[instruction.operands[i]]);
+                        incoming_blocks.push_back(new_block_ids[instruction.targets[i]]);
+                    }
+                }
+                instruction.operands = std::move(operands);
+                instruction.targets = std::move(incoming_blocks);
+            } else {
+                for(auto& operand : instruction.operands) {
+                    operand = new_values[operand];
+                }
+                for(auto& target : instruction.targets) {
+                    target = new_block_ids[target];
+                }
+            }
+            new_block.instructions.push_back(static_cast<value_t>(instructions.size()));
+            instructions.push_back(std::move(instruction));
+        }
+    }
+    function.instructions = std::move(instructions);
+    function.blocks = std::move(blocks);
+}
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <utils/symbol_interner.hpp>
+
+
+// A typed SSA intermediate representation, between the type checker and the backends.
+// A function is a list of basic blocks, each a list of instructions that ends in exactly one terminator. Every instruction that produces something
+//  defines one SSA value, named by the index of the instruction (`value_t`). Values that merge control flow are `PHI`s at the start of a block.
+// Variables live in memory: every local is an `ALLOCA` in the entry block and is read and written with explicit `LOAD`s and `STORE`s (promoting them
+//  to SSA values is left to an optimization pass). Structs are never held in SSA values, a struct valued expression is the address of its storage.
+namespace ir {
+// Signedness is not part of a type, it is a property of the operations (`SDIV` vs `UDIV`, `SEXT` vs `ZEXT`, ...), as in most compiler IRs.
+// `long double` is lowered to `F64` (see `lower_ast.cpp`).
+enum class type_t : std::uint8_t {
+    VOID, // the type of instructions that don't produce a value
+    I8, I16, I32, I64,
+    F32, F64,
+    PTR,
+};
+
+enum class opcode_t : std::uint8_t {
+    PARAM, // `immediate` is the index of the parameter. Only in the entry block.
+    CONST, // `immediate` holds the bits of the constant (floating point constants are type punned)
+    ALLOCA, // `immediate` bytes of stack memory aligned to `alignment`, lives as long as the function runs. Only in the entry block.
+    GLOBAL_ADDRESS, // address of the global `symbol`
+    PTR_OFFSET, // operands[0] + `immediate` bytes
+
+    LOAD, // operands: address
+    STORE, // operands: value, address
+    COPY, // operands: destination address, source address; copies `immediate` bytes (used for struct assignment)
+
+    ADD, SUB, MUL, SDIV, UDIV, SREM, UREM,
+    SHL, ASHR, LSHR, // the shift amount is of the same type as the shifted value
+    AND, OR, XOR,
+    NEG, NOT,
+
+    FADD, FSUB, FMUL, FDIV,
+    FNEG,
+
+    // comparisons are of `I32` type and are 0 or 1
+    EQ, NE,
+    SLT, SLE, SGT, SGE,
+    ULT, ULE, UGT, UGE,
+    FEQ, FNE, FLT, FLE, FGT, FGE,
+
+    SEXT, ZEXT, TRUNC,
+    SITOFP, UITOFP, FPTOSI, FPTOUI,
+    FPEXT, FPTRUNC,
+
+    CALL, // calls `symbol` with `operands` as the arguments, see `instruction_t::struct_arguments`
+    PHI, // `operands[i]` if control came from `targets[i]`
+
+    // terminators
+    JUMP, // to `targets[0]`
+    BRANCH, // to `targets[0]` if operands[0] != 0, else to `targets[1]`
+    RET, // returns operands[0], or nothing if there are no operands
+};
+
+// How the SysV x86_64 ABI passes a struct by value, which the `PTR` that stands for it in the IR doesn't say (see `classify_struct()` in `lower_ast.cpp`).
+// Backends that only call code they generated themselves may ignore it.
+struct struct_passing_t {
+    bool is_struct = false; // the rest is only set if it is
+    bool is_in_memory = false; // the MEMORY class: passed as a copy on the stack, and returned through a hidden pointer that is returned in `%rax`
+    std::uint8_t eightbyte_count = 0u; // else each 8 bytes of it are passed in a register, an SSE one if `is_sse`, else an integer one
+    std::array<bool, 2u> is_sse{};
+    std::uint64_t size = 0u;
+};
+
+using value_t = std::uint32_t; // index of the instruction that defines the value, in `function_t::instructions`
+using block_id_t = std::uint32_t; // index into `function_t::blocks`
+
+struct instruction_t {
+    opcode_t opcode;
+    type_t type; // of the value it defines, `VOID` if it doesn't define one
+    std::vector<value_t> operands;
+    std::vector<block_id_t> targets; // successors of terminators, incoming blocks of phis
+    std::uint64_t immediate = 0u;
+    std::uint32_t alignment = 0u; // of `ALLOCA`s
+    utils::symbol_t symbol{}; // of `CALL`s and `GLOBAL_ADDRESS`es
+    // Of `CALL`s: how each operand is passed if it is a struct, empty if none of them is. A call of a function that returns a struct has where to return
+    //  it to as `operands[0]`, and how it's returned as `struct_return`.
+    std::vector<struct_passing_t> struct_arguments{};
+    struct_passing_t struct_return{};
+};
+
+struct block_t {
+    std::vector<value_t> instructions; // in execution order, phis first and the terminator last
+};
+
+struct function_t {
+    utils::symbol_t name;
+    type_t return_type;
+    std::vector<type_t> param_types;
+    // as in `instruction_t`: of each parameter, or empty if none is a struct, and if the function returns a struct (to where parameter 0 points)
+    std::vector<struct_passing_t> param_structs{};
+    struct_passing_t struct_return{};
+
+    std::vector<instruction_t> instructions; // every instruction of every block, indexed by `value_t`
+    std::vector<block_t> blocks; // `blocks[0]` is the entry block
+
+    block_id_t add_block() {
+        blocks.emplace_back();
+        return static_cast<block_id_t>(blocks.size() - 1u);
+    }
+    value_t append(const block_id_t block, instruction_t instruction) {
+        instructions.push_back(std::move(instruction));
+        const auto value = static_cast<value_t>(instructions.size() - 1u);
+        blocks[block].instructions.push_back(value);
+        return value;
+    }
+    const instruction_t& get(const value_t value) const {
+        return instructions[value];
+    }
+    // `nullptr` if `block` doesn't end in a terminator (yet)
+    const instruction_t* terminator(block_id_t block) const;
+};
+
+// A global variable. Functions refer to it with `GLOBAL_ADDRESS`.
+struct global_t {
+    utils::symbol_t name;
+    std::size_t size;
+    std::size_t alignment;
+    std::vector<std::byte> initializer; // `size` bytes, or empty if the global is zero initialized
+};
+
+struct module_t {
+    std::vector<global_t> globals;
+    std::vector<function_t> functions;
+};
+
+
+bool is_terminator(opcode_t opcode);
+bool is_integer(type_t type);
+bool is_floating(type_t type);
+std::size_t get_size(type_t type); // in bytes, of the value in memory
+
+const char* get_type_name(type_t type);
+const char* get_opcode_name(opcode_t opcode);
+
+std::vector<std::vector<block_id_t>> compute_predecessors(const function_t& function);
+// Drops the blocks that can't be reached from the entry block (and what phis got from them), and renumbers blocks and values in order.
+void remove_unreachable_blocks(function_t& function);
+}
@@ -0,0 +1,158 @@
+#include "ir_printer.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+namespace {
+std::string get_constant_text(const ir::instruction_t& constant) {
+    std::ostringstream text;
+    switch(constant.type) {
+        case ir::type_t::I8:
+            text << static_cast<std::int32_t>(static_cast<std::int8_t>(constant.immediate));
+            break;
+        case ir::type_t::I16:
+            text << static_cast<std::int16_t>(constant.immediate);
+            break;
+        case ir::type_t::I32:
+            text << static_cast<std::int32_t>(constant.immediate);
+            break;
+        case ir::type_t::F32: {
+            const auto bits = static_cast<std::uint32_t>(constant.immediate);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            text.precision(9); // round trips a `float`
+            text << value;
+            break;
+        }
+        case ir::type_t::F64: {
+            double value;
+            std::memcpy(&value, &constant.immediate, sizeof(value));
+            text.precision(17); // round trips a `double`
+            text << value;
+            break;
+        }
+        default:
+            text << static_cast<std::int64_t>(constant.immediate);
+            break;
+    }
+    return text.str();
+}
+// e.g. ` {12: int, sse}` or ` {24: memory}`, nothing if it isn't a struct
+std::string get_struct_passing_text(const ir::struct_passing_t& passing) {
+    if(!passing.is_struct) {
+        return "";
+    }
+    std::string text = " {" + std::to_string(passing.size) + ":";
+    if(passing.is_in_memory) {
+        return text + " memory}";
+    }
+    for(std::uint8_t i = 0u; i < passing.eightbyte_count; ++i) {
+        text += (i == 0u) ? " " : ", ";
+        text += passing.is_sse[i] ? "sse" : "int";
+    }
+    return text + "}";
+}
+}
+
+
+void print_ir_instruction(const ir::function_t& function, const ir::value_t value) {
+    const ir::instruction_t& instruction = function.get(value);
+    std::cout << "  ";
+    if(instruction.type != ir::type_t::VOID) {
+        std::cout << '%' << value << " = ";
+    }
+    std::cout << ir::get_opcode_name(instruction.opcode);
+    if(instruction.type != ir::type_t::VOID) {
+        std::cout << ' ' << ir::get_type_name(instruction.type);
+    }
+
+    switch(instruction.opcode) {
+        case ir::opcode_t::PARAM:
+            std::cout << ' ' << instruction.immediate;
+            break;
+        case ir::opcode_t::CONST:
+            std::cout << ' ' << get_constant_text(instruction);
+            break;
+        case ir::opcode_t::ALLOCA:
+            std::cout << ' ' << instruction.immediate << ", align " << instruction.alignment;
+            break;
+        case ir::opcode_t::GLOBAL_ADDRESS:
+            std::cout << " @" << instruction.symbol;
+            break;
+        case ir::opcode_t::CALL:
+            std::cout << " @" << instruction.symbol << '(';
+            for(std::size_t i = 0u; i < instruction.operands.size(); ++i) {
+                std::cout << ((i == 0u) ? "%" : ", %") << instruction.operands[i];
+                if(!instruction.struct_arguments.empty()) {
+                    std::cout << get_struct_passing_text(instruction.struct_arguments[i]);
+                }
+            }
+            std::cout << ')';
+            if(instruction.struct_return.is_struct) {
+                std::cout << " ->" << get_struct_passing_text(instruction.struct_return);
+            }
+            break;
+        case ir::opcode_t::PHI:
+            for(std::size_t i = 0u; i < instruction.operands.size(); ++i) {
+                std::cout << ((i == 0u) ? " [%" : ", [%") << instruction.operands[i] << ", bb" << instruction.targets[i] << ']';
+            }
+            break;
+        default:
+            for(std::size_t i = 0u; i < instruction.operands.size(); ++i) {
+                std::cout << ((i == 0u) ? " %" : ", %") << instruction.operands[i];
+            }
+            if(instruction.opcode == ir::opcode_t::PTR_OFFSET || instruction.opcode == ir::opcode_t::COPY) {
+                std::cout << ", " << instruction.immediate;
+            }
+            for(std::size_t i = 0u; i < instruction.targets.size(); ++i) {
+                std::cout << ((i == 0u && instruction.operands.empty()) ? " bb" : ", bb") << instruction.targets[i];
+            }
+            break;
+    }
+    std::cout << '\n';
+}
+void print_ir_function(const ir::function_t& function) {
+    std::cout << "function " << ir::get_type_name(function.return_type) << " @" << function.name << '(';
+    for(std::size_t i = 0u; i < function.param_types.size(); ++i) {
+        std::cout << ((i == 0u) ? "" : ", ") << ir::get_type_name(function.param_types[i]);
+        if(!function.param_structs.empty()) {
+            std::cout << get_struct_passing_text(function.param_structs[i]);
+        }
+    }
+    std::cout << ')';
+    if(function.struct_return.is_struct) {
+        std::cout << " ->" << get_struct_passing_text(function.struct_return);
+    }
+    std::cout << " {\n";
+    for(ir::block_id_t block = 0u; block < function.blocks.size(); ++block) {
+        std::cout << "bb" << block << ":\n";
+        for(const ir::value_t value : function.blocks[block].instructions) {
+            print_ir_instruction(function, value);
+        }
+    }
+    std::cout << "}\n";
+}
+void print_ir_global(const ir::global_t& global) {
+    std::cout << "global @" << global.name << ": size " << global.size << ", align " << global.alignment;
+    if(global.initializer.empty()) {
+        std::cout << ", zero\n";
+        return;
+    }
+    std::ostringstream bytes;
+    bytes << std::hex;
+    for(const std::byte byte : global.initializer) {
+        bytes << ' ' << ((static_cast<unsigned>(byte) < 0x10u) ? "0" : "") << static_cast<unsigned>(byte);
+    }
+    std::cout << ", bytes" << bytes.str() << '\n';
+}
+void print_ir_module(const ir::module_t& module) {
+    for(const auto& global : module.globals) {
+        print_ir_global(global);
+    }
+    for(const auto& function : module.functions) {
+        print_ir_function(function);
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+
+#include <middle_end/ir/ir.hpp>
+
+
+// Prints the IR to `std::cout`, e.g.
+//  function i32 @main() {
+//  bb0:
+//    %0 = alloca 4, align 4
+//    jump bb1
+//  bb1:
+//    %2 = const i32 7
+//    store %2, %0
+//    ...
+void print_ir_instruction(const ir::function_t& function, ir::value_t value);
+void print_ir_function(const ir::function_t& function);
+void print_ir_global(const ir::global_t& global);
+void print_ir_module(const ir::module_t& module);
@@ -0,0 +1,698 @@
+#include "lower_ast.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+
+#include <utils/common.hpp>
+#include <utils/data_structures/scoped_symbol_table.hpp>
+
+
+namespace {
+struct lowering_context_t {
+    const ast::type_table_t& type_table;
+    std::unordered_map<ast::func_name_t, const ast::function_definition_t*> function_definitions;
+    std::unordered_set<ast::var_name_t> global_variables;
+
+    // of the function being lowered
+    ir::function_t* function = nullptr;
+    ir::block_id_t current_block = 0u;
+    utils::data_structures::scoped_symbol_table_t<ir::value_t> locals; // the address of each local variable
+    std::optional<ir::value_t> struct_return_address; // the hidden parameter of functions that return a struct
+
+    lowering_context_t(const ast::type_table_t& type_table) : type_table(type_table) {}
+};
+
+// What the type of a variable or expression stands for, with typedefs resolved. Throws if it is a struct that was only forward declared.
+const ast::type_t& resolve_type(const lowering_context_t& context, const ast::type_t& type) {
+    const ast::type_t *const underlying_type = get_underlying_type(context.type_table, type);
+    if(underlying_type == nullptr || !underlying_type->size.has_value()) {
+        throw std::runtime_error("Type [" + type.type_name.str() + "] is incomplete.");
+    }
+    return *underlying_type;
+}
+const ast::type_t& resolve_type(const lowering_context_t& context, const ast::expression_type_t& type) {
+    return resolve_type(context, type.value());
+}
+// takes resolved types; typedefs of anonymous structs resolve to themselves (see `make_typedef_with_anonymous_struct_t()`)
+bool is_struct(const ast::type_t& type) {
+    return type.type_category == ast::type_category_t::STRUCT || type.type_category == ast::type_category_t::TYPEDEF;
+}
+bool is_signed(const ast::type_t& type) {
+    return type.type_category == ast::type_category_t::INT;
+}
+bool is_floating(const ast::type_t& type) {
+    return type.type_category == ast::type_category_t::FLOATING;
+}
+ir::type_t get_integer_type(const std::size_t size) {
+    switch(size) {
+        case 1u:
+            return ir::type_t::I8;
+        case 2u:
+            return ir::type_t::I16;
+        case 4u:
+            return ir::type_t::I32;
+        case 8u:
+            return ir::type_t::I64;
+    }
+    throw std::logic_error("No integer type of size " + std::to_string(size) + ".");
+}
+ir::type_t get_ir_type(const ast::type_t& type) {
+    if(is_struct(type)) {
+        return ir::type_t::PTR;
+    } else if(is_floating(type)) {
+        return (type.type_name == ast::primitive_type_names::FLOAT) ? ir::type_t::F32 : ir::type_t::F64;
+    }
+    return get_integer_type(type.size.value());
+}
+// Clears the `is_sse` of each eightbyte of `passing` that an integer field of `type` is in, with `type` at `offset` in the struct being classified.
+// `false` if `type` has a `long double` in it, which makes the struct MEMORY class.
+bool classify_fields(const lowering_context_t& context, const ast::type_t& type, const std::size_t offset, ir::struct_passing_t& passing) {
+    for(std::size_t i = 0u; i < type.fields.size(); ++i) {
+        const ast::type_t& field_type = resolve_type(context, type.fields[i]);
+        const std::size_t field_offset = offset + type.field_offsets[i];
+        if(is_struct(field_type)) {
+            if(!classify_fields(context, field_type, field_offset, passing)) {
+                return false;
+            }
+        } else if(field_type.type_name == ast::primitive_type_names::LONG_DOUBLE) {
+            return false;
+        } else if(!is_floating(field_type)) {
+            passing.is_sse[field_offset / 8u] = false;
+        }
+    }
+    return true;
+}
+// How the SysV x86_64 ABI (section 3.2.3) passes the struct `type` by value, so that calls to and from code that other compilers built agree on it: a struct
+//  of more than 16 bytes, or with a `long double` in it, is MEMORY class, a smaller one goes in a register per eightbyte, an SSE one if every field in the
+//  eightbyte is floating point. There are no unions, arrays or bit fields to complicate it.
+ir::struct_passing_t classify_struct(const lowering_context_t& context, const ast::type_t& type) {
+    ir::struct_passing_t passing;
+    passing.is_struct = true;
+    passing.size = type.size.value();
+    if(passing.size <= 16u) {
+        passing.eightbyte_count = static_cast<std::uint8_t>((passing.size + 7u) / 8u);
+        for(std::uint8_t i = 0u; i < passing.eightbyte_count; ++i) {
+            passing.is_sse[i] = true;
+        }
+        if(classify_fields(context, type, 0u, passing)) {
+            return passing;
+        }
+    }
+    passing.is_in_memory = true;
+    passing.eightbyte_count = 0u;
+    passing.is_sse = {};
+    return passing;
+}
+// `struct_arguments` and `param_structs` are left empty when there is no struct among them
+void drop_if_no_structs(std::vector<ir::struct_passing_t>& structs) {
+    if(std::none_of(std::begin(structs), std::end(structs), [](const ir::struct_passing_t& passing) { return passing.is_struct; })) {
+        structs.clear();
+    }
+}
+
+
+ir::value_t emit(lowering_context_t& context, ir::instruction_t instruction) {
+    return context.function->append(context.current_block, std::move(instruction));
+}
+ir::value_t emit(lowering_context_t& context, const ir::opcode_t opcode, const ir::type_t type, std::vector<ir::value_t> operands) {
+    return emit(context, ir::instruction_t{opcode, type, std::move(operands), {}});
+}
+ir::value_t emit_constant(lowering_context_t& context, const ir::type_t type, const std::uint64_t bits) {
+    ir::instruction_t instruction{ir::opcode_t::CONST, type, {}, {}};
+    instruction.immediate = bits;
+    return emit(context, std::move(instruction));
+}
+// Allocas go to the entry block, wherever they are declared, so that every one of them is allocated once per call.
+ir::value_t emit_alloca(lowering_context_t& context, const ast::type_t& type) {
+    ir::instruction_t instruction{ir::opcode_t::ALLOCA, ir::type_t::PTR, {}, {}};
+    instruction.immediate = type.size.value();
+    instruction.alignment = static_cast<std::uint32_t>(type.alignment.value());
+    return context.function->append(0u, std::move(instruction));
+}
+// A copy of a struct that is passed or returned by value. It's rounded up to whole eightbytes, as that is what a backend moves to and from registers.
+ir::value_t emit_struct_temporary(lowering_context_t& context, const ast::type_t& type) {
+    const ir::value_t address = emit_alloca(context, type);
+    ir::instruction_t& instruction = context.function->instructions[address];
+    instruction.immediate = (instruction.immediate + 7u) / 8u * 8u;
+    return address;
+}
+void emit_jump(lowering_context_t& context, const ir::block_id_t target) {
+    emit(context, ir::instruction_t{ir::opcode_t::JUMP, ir::type_t::VOID, {}, {target}});
+}
+void emit_branch(lowering_context_t& context, const ir::value_t condition, const ir::block_id_t if_true, const ir::block_id_t if_false) {
+    emit(context, ir::instruction_t{ir::opcode_t::BRANCH, ir::type_t::VOID, {condition}, {if_true, if_false}});
+}
+ir::value_t emit_phi(lowering_context_t& context, const ir::type_t type, std::vector<ir::value_t> values, std::vector<ir::block_id_t> incoming_blocks) {
+    return emit(context, ir::instruction_t{ir::opcode_t::PHI, type, std::move(values), std::move(incoming_blocks)});
+}
+void emit_copy(lowering_context_t& context, const ir::value_t destination, const ir::value_t source, const ast::type_t& type) {
+    ir::instruction_t instruction{ir::opcode_t::COPY, ir::type_t::VOID, {destination, source}, {}};
+    instruction.immediate = type.size.value();
+    emit(context, std::move(instruction));
+}
+
+// Struct values are addresses, so loading one is a no op and storing one is a copy.
+ir::value_t emit_load(lowering_context_t& context, const ir::value_t address, const ast::type_t& type) {
+    return is_struct(type) ? address : emit(context, ir::opcode_t::LOAD, get_ir_type(type), {address});
+}
+void emit_store(lowering_context_t& context, const ir::value_t value, const ir::value_t address, const ast::type_t& type) {
+    if(is_struct(type)) {
+        emit_copy(context, address, value, type);
+    } else {
+        emit(context, ir::opcode_t::STORE, ir::type_t::VOID, {value, address});
+    }
+}
+// `value != 0` as an `I32`
+ir::value_t emit_is_nonzero(lowering_context_t& context, const ir::value_t value, const ast::type_t& type) {
+    const ir::type_t ir_type = get_ir_type(type);
+    const ir::value_t zero = emit_constant(context, ir_type, 0u); // the bits of `0.0` are all zero as well
+    return emit(context, is_floating(type) ? ir::opcode_t::FNE : ir::opcode_t::NE, ir::type_t::I32, {value, zero});
+}
+void start_block(lowering_context_t& context, const ir::block_id_t block) {
+    context.current_block = block;
+}
+
+ir::value_t convert(lowering_context_t& context, const ir::value_t value, const ast::type_t& from_type, const ast::type_t& to_type) {
+    const ast::type_t& from = resolve_type(context, from_type);
+    const ast::type_t& to = resolve_type(context, to_type);
+    if(is_struct(from) || is_struct(to)) {
+        return value; // the type checker only lets structs be converted to themselves
+    }
+    const ir::type_t from_ir_type = get_ir_type(from);
+    const ir::type_t to_ir_type = get_ir_type(to);
+    if(is_floating(from) && is_floating(to)) {
+        if(from_ir_type == to_ir_type) {
+            return value;
+        }
+        return emit(context, (from_ir_type == ir::type_t::F32) ? ir::opcode_t::FPEXT : ir::opcode_t::FPTRUNC, to_ir_type, {value});
+    } else if(is_floating(from)) {
+        return emit(context, is_signed(to) ? ir::opcode_t::FPTOSI : ir::opcode_t::FPTOUI, to_ir_type, {value});
+    } else if(is_floating(to)) {
+        return emit(context, is_signed(from) ? ir::opcode_t::SITOFP : ir::opcode_t::UITOFP, to_ir_type, {value});
+    }
+    if(from_ir_type == to_ir_type) {
+        return value;
+    } else if(ir::get_size(from_ir_type) > ir::get_size(to_ir_type)) {
+        return emit(context, ir::opcode_t::TRUNC, to_ir_type, {value});
+    }
+    return emit(context, is_signed(from) ? ir::opcode_t::SEXT : ir::opcode_t::ZEXT, to_ir_type, {value});
+}
+ir::value_t convert(lowering_context_t& context, const ir::value_t value, const ast::expression_type_t& from_type, const ast::expression_type_t& to_type) {
+    return (from_type == to_type) ? value : convert(context, value, from_type.value(), to_type.value());
+}
+
+
+ir::value_t lower_expression(lowering_context_t& context, const ast::expression_t& expression);
+ir::value_t lower_address(lowering_context_t& context, const ast::expression_t& expression);
+
+ir::value_t lower_variable_address(lowering_context_t& context, const ast::variable_access_t& variable_access) {
+    ir::value_t address;
+    if(const ir::value_t *const local = context.locals.find(variable_access.variable)) {
+        address = *local;
+    } else if(context.global_variables.count(variable_access.variable) != 0u) {
+        ir::instruction_t instruction{ir::opcode_t::GLOBAL_ADDRESS, ir::type_t::PTR, {}, {}};
+        instruction.symbol = variable_access.variable;
+        address = emit(context, std::move(instruction));
+    } else {
+        throw std::logic_error("Variable [" + variable_access.variable.str() + "] is not declared.");
+    }
+    if(variable_access.member_offset != 0u) {
+        ir::instruction_t instruction{ir::opcode_t::PTR_OFFSET, ir::type_t::PTR, {address}, {}};
+        instruction.immediate = variable_access.member_offset;
+        address = emit(context, std::move(instruction));
+    }
+    return address;
+}
+
+struct assignment_t {
+    ir::value_t address;
+    ir::value_t value; // what was stored, i.e. the value of the assignment expression
+};
+// `++` and `--`
+assignment_t lower_increment(lowering_context_t& context, const ast::unary_expression_t& unary_exp, const ast::expression_type_t& type) {
+    const ast::type_t& resolved_type = resolve_type(context, type);
+    const ir::type_t ir_type = get_ir_type(resolved_type);
+    const ir::value_t address = lower_address(context, unary_exp.exp);
+    const ir::value_t old_value = emit_load(context, address, resolved_type);
+    const ir::value_t one = emit_constant(context, ir_type, 1u);
+    const ir::value_t new_value = emit(context, (unary_exp.op == ast::unary_operator_token_t::PLUS_PLUS) ? ir::opcode_t::ADD : ir::opcode_t::SUB, ir_type, {old_value, one});
+    emit_store(context, new_value, address, resolved_type);
+    return assignment_t{address, (unary_exp.fixity == ast::unary_operator_fixity_t::PREFIX) ? new_value : old_value};
+}
+assignment_t lower_assignment(lowering_context_t& context, const ast::binary_expression_t& assignment) {
+    const ast::type_t& type = resolve_type(context, assignment.left.type);
+    const ir::value_t value = convert(context, lower_expression(context, assignment.right), assignment.right.type, assignment.left.type);
+    const ir::value_t address = lower_address(context, assignment.left);
+    emit_store(context, value, address, type);
+    return assignment_t{address, is_struct(type) ? address : value};
+}
+
+// The lvalue expressions are those that `validate_lvalue_expression_exp()` accepts.
+ir::value_t lower_address(lowering_context_t& context, const ast::expression_t& expression) {
+    return std::visit(overloaded{
+        [&context](const ast::node_handle_t<ast::grouping_t>& grouping) {
+            return lower_address(context, grouping->expr);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) {
+            return lower_increment(context, *unary_exp, expression.type).address;
+        },
+        [&context](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) {
+            if(binary_exp->op == ast::binary_operator_token_t::COMMA) {
+                lower_expression(context, binary_exp->left);
+                return lower_address(context, binary_exp->right);
+            }
+            return lower_assignment(context, *binary_exp).address;
+        },
+        [&context](const ast::variable_access_t& variable_access) {
+            return lower_variable_address(context, variable_access);
+        },
+        [](const auto&) -> ir::value_t {
+            throw std::logic_error("Expression is not an lvalue.");
+        }
+    }, expression.expr);
+}
+
+ir::value_t lower_constant(lowering_context_t& context, const ast::constant_t& constant) {
+    return std::visit([&context](const auto value) {
+        using value_type_t = std::decay_t<decltype(value)>;
+        if constexpr(std::is_same_v<value_type_t, float>) {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return emit_constant(context, ir::type_t::F32, bits);
+        } else if constexpr(std::is_floating_point_v<value_type_t>) {
+            const double double_value = static_cast<double>(value); // `long double` is lowered to `double`
+            std::uint64_t bits;
+            std::memcpy(&bits, &double_value, sizeof(bits));
+            return emit_constant(context, ir::type_t::F64, bits);
+        } else {
+            return emit_constant(context, get_integer_type(sizeof(value_type_t)), static_cast<std::uint64_t>(value));
+        }
+    }, constant.value);
+}
+
+ir::value_t lower_unary_expression(lowering_context_t& context, const ast::unary_expression_t& unary_exp, const ast::expression_type_t& type) {
+    switch(unary_exp.op) {
+        case ast::unary_operator_token_t::PLUS_PLUS:
+        case ast::unary_operator_token_t::MINUS_MINUS:
+            return lower_increment(context, unary_exp, type).value;
+        case ast::unary_operator_token_t::PLUS:
+            return convert(context, lower_expression(context, unary_exp.exp), unary_exp.exp.type, type);
+        case ast::unary_operator_token_t::MINUS: {
+            const ir::value_t operand = convert(context, lower_expression(context, unary_exp.exp), unary_exp.exp.type, type);
+            const ast::type_t& resolved_type = resolve_type(context, type);
+            return emit(context, is_floating(resolved_type) ? ir::opcode_t::FNEG : ir::opcode_t::NEG, get_ir_type(resolved_type), {operand});
+        }
+        case ast::unary_operator_token_t::LOGICAL_NOT: {
+            const ast::type_t& operand_type = resolve_type(context, unary_exp.exp.type);
+            const ir::value_t operand = lower_expression(context, unary_exp.exp);
+            const ir::value_t zero = emit_constant(context, get_ir_type(operand_type), 0u);
+            return emit(context, is_floating(operand_type) ? ir::opcode_t::FEQ : ir::opcode_t::EQ, ir::type_t::I32, {operand, zero});
+        }
+        case ast::unary_operator_token_t::BITWISE_NOT: {
+            const ir::value_t operand = convert(context, lower_expression(context, unary_exp.exp), unary_exp.exp.type, type);
+            return emit(context, ir::opcode_t::NOT, get_ir_type(resolve_type(context, type)), {operand});
+        }
+    }
+    throw std::logic_error("Invalid unary operator.");
+}
+
+ir::opcode_t get_arithmetic_opcode(const ast::binary_operator_token_t op, const ast::type_t& type) {
+    const bool is_float = is_floating(type);
+    switch(op) {
+        case ast::binary_operator_token_t::MULTIPLY:
+            return is_float ? ir::opcode_t::FMUL : ir::opcode_t::MUL;
+        case ast::binary_operator_token_t::DIVIDE:
+            return is_float ? ir::opcode_t::FDIV : (is_signed(type) ? ir::opcode_t::SDIV : ir::opcode_t::UDIV);
+        case ast::binary_operator_token_t::MODULO:
+            return is_signed(type) ? ir::opcode_t::SREM : ir::opcode_t::UREM;
+        case ast::binary_operator_token_t::PLUS:
+            return is_float ? ir::opcode_t::FADD : ir::opcode_t::ADD;
+        case ast::binary_operator_token_t::MINUS:
+            return is_float ? ir::opcode_t::FSUB : ir::opcode_t::SUB;
+        case ast::binary_operator_token_t::LEFT_BITSHIFT:
+            return ir::opcode_t::SHL;
+        case ast::binary_operator_token_t::RIGHT_BITSHIFT:
+            return is_signed(type) ? ir::opcode_t::ASHR : ir::opcode_t::LSHR;
+        case ast::binary_operator_token_t::BITWISE_AND:
+            return ir::opcode_t::AND;
+        case ast::binary_operator_token_t::BITWISE_XOR:
+            return ir::opcode_t::XOR;
+        case ast::binary_operator_token_t::BITWISE_OR:
+            return ir::opcode_t::OR;
+        default:
+            throw std::logic_error("Not an arithmetic operator.");
+    }
+}
+// `type` is the type of the operands
+ir::opcode_t get_comparison_opcode(const ast::binary_operator_token_t op, const ast::type_t& type) {
+    const bool is_float = is_floating(type);
+    const bool is_signed_int = is_signed(type);
+    switch(op) {
+        case ast::binary_operator_token_t::LESS_THAN:
+            return is_float ? ir::opcode_t::FLT : (is_signed_int ? ir::opcode_t::SLT : ir::opcode_t::ULT);
+        case ast::binary_operator_token_t::LESS_THAN_EQUAL:
+            return is_float ? ir::opcode_t::FLE : (is_signed_int ? ir::opcode_t::SLE : ir::opcode_t::ULE);
+        case ast::binary_operator_token_t::GREATER_THAN:
+            return is_float ? ir::opcode_t::FGT : (is_signed_int ? ir::opcode_t::SGT : ir::opcode_t::UGT);
+        case ast::binary_operator_token_t::GREATER_THAN_EQUAL:
+            return is_float ? ir::opcode_t::FGE : (is_signed_int ? ir::opcode_t::SGE : ir::opcode_t::UGE);
+        case ast::binary_operator_token_t::EQUAL:
+            return is_float ? ir::opcode_t::FEQ : ir::opcode_t::EQ;
+        case ast::binary_operator_token_t::NOT_EQUAL:
+            return is_float ? ir::opcode_t::FNE : ir::opcode_t::NE;
+        default:
+            throw std::logic_error("Not a comparison operator.");
+    }
+}
+
+// `&&` and `||`: the right operand is only evaluated if the left one doesn't decide the result
+ir::value_t lower_logical_operator(lowering_context_t& context, const ast::binary_expression_t& binary_exp) {
+    const bool is_and = (binary_exp.op == ast::binary_operator_token_t::LOGICAL_AND);
+    const ir::value_t left = emit_is_nonzero(context, lower_expression(context, binary_exp.left), resolve_type(context, binary_exp.left.type));
+    const ir::block_id_t left_block = context.current_block;
+    const ir::block_id_t right_block = context.function->add_block();
+    const ir::block_id_t end_block = context.function->add_block();
+    if(is_and) {
+        emit_branch(context, left, right_block, end_block);
+    } else {
+        emit_branch(context, left, end_block, right_block);
+    }
+
+    start_block(context, right_block);
+    const ir::value_t right = emit_is_nonzero(context, lower_expression(context, binary_exp.right), resolve_type(context, binary_exp.right.type));
+    const ir::block_id_t right_end_block = context.current_block;
+    emit_jump(context, end_block);
+
+    start_block(context, end_block);
+    return emit_phi(context, ir::type_t::I32, {left, right}, {left_block, right_end_block});
+}
+ir::value_t lower_binary_expression(lowering_context_t& context, const ast::binary_expression_t& binary_exp, const ast::expression_type_t& type) {
+    switch(binary_exp.op) {
+        case ast::binary_operator_token_t::LESS_THAN:
+        case ast::binary_operator_token_t::LESS_THAN_EQUAL:
+        case ast::binary_operator_token_t::GREATER_THAN:
+        case ast::binary_operator_token_t::GREATER_THAN_EQUAL:
+        case ast::binary_operator_token_t::EQUAL:
+        case ast::binary_operator_token_t::NOT_EQUAL: {
+            const ir::value_t left = lower_expression(context, binary_exp.left);
+            const ir::value_t right = convert(context, lower_expression(context, binary_exp.right), binary_exp.right.type, binary_exp.left.type);
+            return emit(context, get_comparison_opcode(binary_exp.op, resolve_type(context, binary_exp.left.type)), ir::type_t::I32, {left, right});
+        }
+        case ast::binary_operator_token_t::LOGICAL_AND:
+        case ast::binary_operator_token_t::LOGICAL_OR:
+            return lower_logical_operator(context, binary_exp);
+        case ast::binary_operator_token_t::ASSIGNMENT:
+            return lower_assignment(context, binary_exp).value;
+        case ast::binary_operator_token_t::COMMA:
+            lower_expression(context, binary_exp.left);
+            return lower_expression(context, binary_exp.right);
+        default: { // the arithmetic operators, whose operands the type checker converted to the type of the result (except for the shift amount)
+            const ir::value_t left = convert(context, lower_expression(context, binary_exp.left), binary_exp.left.type, type);
+            const ir::value_t right = convert(context, lower_expression(context, binary_exp.right), binary_exp.right.type, type);
+            const ast::type_t& resolved_type = resolve_type(context, type);
+            return emit(context, get_arithmetic_opcode(binary_exp.op, resolved_type), get_ir_type(resolved_type), {left, right});
+        }
+    }
+}
+ir::value_t lower_ternary_expression(lowering_context_t& context, const ast::ternary_expression_t& ternary_exp, const ast::expression_type_t& type) {
+    const ir::value_t condition = emit_is_nonzero(context, lower_expression(context, ternary_exp.condition), resolve_type(context, ternary_exp.condition.type));
+    const ir::block_id_t true_block = context.function->add_block();
+    const ir::block_id_t false_block = context.function->add_block();
+    const ir::block_id_t end_block = context.function->add_block();
+    emit_branch(context, condition, true_block, false_block);
+
+    start_block(context, true_block);
+    const ir::value_t if_true = convert(context, lower_expression(context, ternary_exp.if_true), ternary_exp.if_true.type, type);
+    const ir::block_id_t true_end_block = context.current_block;
+    emit_jump(context, end_block);
+
+    start_block(context, false_block);
+    const ir::value_t if_false = convert(context, lower_expression(context, ternary_exp.if_false), ternary_exp.if_false.type, type);
+    const ir::block_id_t false_end_block = context.current_block;
+    emit_jump(context, end_block);
+
+    start_block(context, end_block);
+    return emit_phi(context, get_ir_type(resolve_type(context, type)), {if_true, if_false}, {true_end_block, false_end_block});
+}
+ir::value_t lower_function_call(lowering_context_t& context, const ast::function_call_t& function_call, const ast::expression_type_t& type) {
+    const auto definition_iter = context.function_definitions.find(function_call.function_name);
+    const ast::function_definition_t *const definition = (definition_iter == std::end(context.function_definitions)) ? nullptr : definition_iter->second;
+
+    std::vector<ir::value_t> arguments;
+    std::vector<ir::struct_passing_t> struct_arguments;
+    for(std::size_t i = 0u; i < function_call.params.size(); ++i) {
+        const ast::expression_t& param = function_call.params[i];
+        ir::value_t argument = lower_expression(context, param);
+        if(definition != nullptr && i < definition->params.size()) {
+            argument = convert(context, argument, param.type.value(), definition->params[i].first.value());
+        }
+        const ast::type_t& param_type = resolve_type(context, param.type);
+        if(is_struct(param_type)) { // passed by pointer to a copy, so that the callee can't change the caller's struct
+            const ir::value_t copy = emit_struct_temporary(context, param_type);
+            emit_copy(context, copy, argument, param_type);
+            argument = copy;
+            struct_arguments.push_back(classify_struct(context, param_type));
+        } else {
+            struct_arguments.emplace_back();
+        }
+        arguments.push_back(argument);
+    }
+
+    ir::instruction_t call{ir::opcode_t::CALL, ir::type_t::VOID, {}, {}};
+    call.symbol = function_call.function_name;
+    const ast::type_t& return_type = resolve_type(context, type);
+    if(is_struct(return_type)) {
+        const ir::value_t return_address = emit_struct_temporary(context, return_type);
+        call.operands.push_back(return_address);
+        call.operands.insert(std::end(call.operands), std::begin(arguments), std::end(arguments));
+        struct_arguments.insert(std::begin(struct_arguments), ir::struct_passing_t{});
+        drop_if_no_structs(struct_arguments);
+        call.struct_arguments = std::move(struct_arguments);
+        call.struct_return = classify_struct(context, return_type);
+        emit(context, std::move(call));
+        return return_address;
+    }
+    call.type = get_ir_type(return_type);
+    call.operands = std::move(arguments);
+    drop_if_no_structs(struct_arguments);
+    call.struct_arguments = std::move(struct_arguments);
+    return emit(context, std::move(call));
+}
+
+ir::value_t lower_expression(lowering_context_t& context, const ast::expression_t& expression) {
+    return std::visit(overloaded{
+        [&context](const ast::node_handle_t<ast::grouping_t>& grouping) {
+            return lower_expression(context, grouping->expr);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::convert_t>& convert_exp) {
+            return convert(context, lower_expression(context, convert_exp->expr), convert_exp->expr.type, expression.type);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) {
+            return lower_unary_expression(context, *unary_exp, expression.type);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) {
+            return lower_binary_expression(context, *binary_exp, expression.type);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::ternary_expression_t>& ternary_exp) {
+            return lower_ternary_expression(context, *ternary_exp, expression.type);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::function_call_t>& function_call) {
+            return lower_function_call(context, *function_call, expression.type);
+        },
+        [&context, &expression](const ast::variable_access_t& variable_access) {
+            return emit_load(context, lower_variable_address(context, variable_access), resolve_type(context, expression.type));
+        },
+        [&context](const ast::constant_t& constant) {
+            return lower_constant(context, constant);
+        }
+    }, expression.expr);
+}
+
+
+void lower_compound_statement(lowering_context_t& context, const ast::compound_statement_t& compound_statement, const ast::type_t& return_type);
+
+void lower_return_statement(lowering_context_t& context, const ast::return_statement_t& return_statement, const ast::type_t& return_type) {
+    const ir::value_t value = convert(context, lower_expression(context, return_statement.expr), return_statement.expr.type.value(), return_type);
+    if(context.struct_return_address.has_value()) {
+        emit_copy(context, context.struct_return_address.value(), value, resolve_type(context, return_type));
+        emit(context, ir::opcode_t::RET, ir::type_t::VOID, {});
+    } else {
+        emit(context, ir::opcode_t::RET, ir::type_t::VOID, {value});
+    }
+    start_block(context, context.function->add_block()); // whatever follows is unreachable, and is removed once the function is lowered
+}
+void lower_statement(lowering_context_t& context, const ast::statement_t& statement, const ast::type_t& return_type) {
+    std::visit(overloaded{
+        [&context, &return_type](const ast::return_statement_t& return_statement) {
+            lower_return_statement(context, return_statement, return_type);
+        },
+        [&context](const ast::expression_statement_t& expression_statement) {
+            if(expression_statement.expr.has_value()) {
+                lower_expression(context, expression_statement.expr.value());
+            }
+        },
+        [&context, &return_type](const ast::node_handle_t<ast::if_statement_t>& if_statement) {
+            const ir::value_t condition = emit_is_nonzero(context, lower_expression(context, if_statement->if_exp), resolve_type(context, if_statement->if_exp.type));
+            const ir::block_id_t then_block = context.function->add_block();
+            const ir::block_id_t else_block = if_statement->else_body.has_value() ? context.function->add_block() : 0u;
+            const ir::block_id_t end_block = context.function->add_block();
+            emit_branch(context, condition, then_block, if_statement->else_body.has_value() ? else_block : end_block);
+
+            start_block(context, then_block);
+            lower_statement(context, if_statement->if_body, return_type);
+            emit_jump(context, end_block);
+            if(if_statement->else_body.has_value()) {
+                start_block(context, else_block);
+                lower_statement(context, if_statement->else_body.value(), return_type);
+                emit_jump(context, end_block);
+            }
+            start_block(context, end_block);
+        },
+        [&context, &return_type](const ast::node_handle_t<ast::compound_statement_t>& compound_statement) {
+            context.locals.enter_scope();
+            lower_compound_statement(context, *compound_statement, return_type);
+            context.locals.leave_scope();
+        }
+    }, statement);
+}
+void lower_declaration(lowering_context_t& context, const ast::declaration_t& declaration) {
+    const ast::type_t& type = resolve_type(context, declaration.type_name);
+    ir::value_t address;
+    if(const ir::value_t *const redeclared = context.locals.is_in_current_scope(declaration.var_name) ? context.locals.find(declaration.var_name) : nullptr) {
+        address = *redeclared; // the first declaration in a scope wins, as in `validation_variable_lookup_t`
+    } else {
+        address = emit_alloca(context, type);
+        context.locals.bind(declaration.var_name, address);
+    }
+    if(declaration.value.has_value()) {
+        const ir::value_t value = convert(context, lower_expression(context, declaration.value.value()), declaration.value.value().type.value(), type);
+        emit_store(context, value, address, type);
+    }
+}
+void lower_compound_statement(lowering_context_t& context, const ast::compound_statement_t& compound_statement, const ast::type_t& return_type) {
+    for(const auto& stmt : compound_statement.stmts) {
+        std::visit(overloaded{
+            [&context, &return_type](const ast::statement_t& statement) {
+                lower_statement(context, statement, return_type);
+            },
+            [&context](const ast::declaration_t& declaration) {
+                lower_declaration(context, declaration);
+            }
+        }, stmt);
+    }
+}
+
+ir::function_t lower_function_definition(lowering_context_t& context, const ast::function_definition_t& function_definition) {
+    ir::function_t function;
+    function.name = function_definition.function_name;
+    context.function = &function;
+    context.locals = utils::data_structures::scoped_symbol_table_t<ir::value_t>();
+    context.struct_return_address.reset();
+
+    const ir::block_id_t entry_block = function.add_block(); // parameters and allocas, then a jump to `body_block`
+    const ir::block_id_t body_block = function.add_block();
+    start_block(context, entry_block);
+
+    const ast::type_t& return_type = resolve_type(context, function_definition.return_type);
+    auto emit_param = [&context, &function](const ir::type_t type, const ir::struct_passing_t& passing) {
+        ir::instruction_t param{ir::opcode_t::PARAM, type, {}, {}};
+        param.immediate = function.param_types.size();
+        function.param_types.push_back(type);
+        function.param_structs.push_back(passing);
+        return emit(context, std::move(param));
+    };
+    if(is_struct(return_type)) {
+        function.return_type = ir::type_t::VOID;
+        function.struct_return = classify_struct(context, return_type);
+        context.struct_return_address = emit_param(ir::type_t::PTR, {});
+    } else {
+        function.return_type = get_ir_type(return_type);
+    }
+
+    context.locals.enter_scope();
+    for(const auto& [param_type, param_name] : function_definition.params) {
+        const ast::type_t& resolved_param_type = resolve_type(context, param_type);
+        const ir::value_t param = emit_param(get_ir_type(resolved_param_type), is_struct(resolved_param_type) ? classify_struct(context, resolved_param_type) : ir::struct_passing_t{});
+        if(!param_name.has_value()) {
+            continue;
+        }
+        if(is_struct(resolved_param_type)) {
+            context.locals.bind(param_name.value(), param); // already points to a copy of the caller's struct
+        } else {
+            const ir::value_t address = emit_alloca(context, resolved_param_type);
+            emit(context, ir::opcode_t::STORE, ir::type_t::VOID, {param, address});
+            context.locals.bind(param_name.value(), address);
+        }
+    }
+    drop_if_no_structs(function.param_structs);
+
+    start_block(context, body_block);
+    lower_compound_statement(context, function_definition.statements, function_definition.return_type); // the body shares the scope of the parameters
+    context.locals.leave_scope();
+    if(function.terminator(context.current_block) == nullptr) { // falling off the end of a function returns 0, `main()` is required to do so
+        if(function.return_type == ir::type_t::VOID) {
+            emit(context, ir::opcode_t::RET, ir::type_t::VOID, {});
+        } else {
+            emit(context, ir::opcode_t::RET, ir::type_t::VOID, {emit_constant(context, function.return_type, 0u)});
+        }
+    }
+    function.append(entry_block, ir::instruction_t{ir::opcode_t::JUMP, ir::type_t::VOID, {}, {body_block}});
+
+    context.function = nullptr;
+    ir::remove_unreachable_blocks(function);
+    return function;
+}
+
+ir::global_t lower_global_variable(lowering_context_t& context, const ast::global_variable_declaration_t& global_variable) {
+    const ast::type_t& type = resolve_type(context, global_variable.type_name);
+    ir::global_t global{global_variable.var_name, type.size.value(), type.alignment.value(), {}};
+    if(global_variable.value.has_value() && !is_constant_with_value_zero(global_variable.value.value())) {
+        const type_punned_constant_t constant = get_type_punned_constant(global_variable.value.value());
+        global.initializer.resize(global.size);
+        if(type.type_name == ast::primitive_type_names::LONG_DOUBLE) { // `long double` is lowered to `double`, its first 8 bytes hold a `double`
+            long double value;
+            std::memcpy(&value, constant.bytes.get(), sizeof(value));
+            const double double_value = static_cast<double>(value);
+            std::memcpy(global.initializer.data(), &double_value, sizeof(double_value));
+        } else {
+            std::memcpy(global.initializer.data(), constant.bytes.get(), std::min(global.size, constant.number_of_bytes));
+        }
+    }
+    return global;
+}
+}
+
+
+ir::module_t lower_to_ir(const ast::validated_program_t& program) {
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes);
+    lowering_context_t context(program.type_table);
+    for(const auto& top_level_declaration : program.top_level_declarations) {
+        std::visit(overloaded{
+            [&context](const ast::function_definition_t& function_definition) {
+                context.function_definitions.insert({function_definition.function_name, &function_definition});
+            },
+            [&context](const ast::global_variable_declaration_t& global_variable) {
+                context.global_variables.insert(global_variable.var_name);
+            }
+        }, top_level_declaration);
+    }
+
+    ir::module_t module;
+    for(const auto& top_level_declaration : program.top_level_declarations) {
+        std::visit(overloaded{
+            [&context, &module](const ast::function_definition_t& function_definition) {
+                module.functions.push_back(lower_function_definition(context, function_definition));
+            },
+            [&context, &module](const ast::global_variable_declaration_t& global_variable) {
+                module.globals.push_back(lower_global_variable(context, global_variable));
+            }
+        }, top_level_declaration);
+    }
+    return module;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <frontend/ast/ast.hpp>
+#include <middle_end/ir/ir.hpp>
+
+
+// Lowers a type checked program to IR (see `ir.hpp`).
+//  - Every local variable and parameter gets an `ALLOCA` in the entry block, `long double` is lowered to `F64`.
+//  - `&&`, `||` and `?:` branch and merge their results with a `PHI`.
+//  - Arguments are converted to the parameter types of the called function if it is defined in the program (the declarations of other functions don't
+//     make it into `ast::validated_program_t`).
+//  - Structs are passed by pointer to a copy made by the caller, and returned through a pointer to caller allocated memory passed as a hidden first
+//     parameter. This is NOT how the SysV ABI passes structs of up to 16 bytes, so such functions can't be called from or call code compiled elsewhere.
+// Blocks that can't be reached (e.g. the code after a `return`) are removed.
+ir::module_t lower_to_ir(const ast::validated_program_t& program);
@@ -0,0 +1,335 @@
+#include "verifier.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+
+namespace {
+constexpr std::uint32_t NOT_PLACED = std::numeric_limits<std::uint32_t>::max();
+
+struct verifier_t {
+    const ir::function_t& function;
+    utils::diagnostics_t& diagnostics;
+
+    std::vector<ir::block_id_t> definition_blocks; // of each value, `NOT_PLACED` if it isn't in any block
+    std::vector<std::uint32_t> definition_positions; // within its block
+    std::vector<std::vector<ir::block_id_t>> predecessors;
+    std::vector<ir::block_id_t> immediate_dominators; // `NOT_PLACED` for blocks that can't be reached
+
+    verifier_t(const ir::function_t& function, utils::diagnostics_t& diagnostics) : function(function), diagnostics(diagnostics) {}
+
+    utils::error_t error(const ir::value_t value, const std::string& message) {
+        return diagnostics.report("In function [" + function.name.str() + "], %" + std::to_string(value) + " (" + ir::get_opcode_name(function.get(value).opcode) + "): " + message);
+    }
+    utils::error_t error(const std::string& message) {
+        return diagnostics.report("In function [" + function.name.str() + "]: " + message);
+    }
+
+    ir::type_t operand_type(const ir::value_t value, const std::size_t operand) const {
+        return function.get(function.get(value).operands[operand]).type;
+    }
+    bool has_operand_types(const ir::value_t value, const std::initializer_list<ir::type_t> types) const {
+        const ir::instruction_t& instruction = function.get(value);
+        if(instruction.operands.size() != types.size()) {
+            return false;
+        }
+        std::size_t i = 0u;
+        for(const ir::type_t type : types) {
+            if(operand_type(value, i++) != type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm": iterate to a fixed point over the blocks in reverse postorder.
+    void compute_dominators() {
+        std::vector<ir::block_id_t> postorder;
+        std::vector<bool> is_visited(function.blocks.size(), false);
+        std::vector<std::pair<ir::block_id_t, std::size_t>> stack{{0u, 0u}}; // block, index of the next successor to visit
+        is_visited[0] = true;
+        while(!stack.empty()) {
+            auto& [block, next_successor] = stack.back();
+            const ir::instruction_t *const terminator = function.terminator(block);
+            if(terminator != nullptr && next_successor < terminator->targets.size()) {
+                const ir::block_id_t successor = terminator->targets[next_successor++];
+                if(!is_visited[successor]) {
+                    is_visited[successor] = true;
+                    stack.emplace_back(successor, 0u);
+                }
+            } else {
+                postorder.push_back(block);
+                stack.pop_back();
+            }
+        }
+        std::vector<std::uint32_t> postorder_numbers(function.blocks.size(), 0u);
+        for(std::uint32_t i = 0u; i < postorder.size(); ++i) {
+            postorder_numbers[postorder[i]] = i;
+        }
+
+        immediate_dominators.assign(function.blocks.size(), NOT_PLACED);
+        immediate_dominators[0] = 0u;
+        for(bool has_changed = true; has_changed;) {
+            has_changed = false;
+            for(auto block_iter = std::rbegin(postorder); block_iter != std::rend(postorder); ++block_iter) {
+                const ir::block_id_t block = *block_iter;
+                if(block == 0u) {
+                    continue;
+                }
+                ir::block_id_t new_dominator = NOT_PLACED;
+                for(const ir::block_id_t predecessor : predecessors[block]) {
+                    if(immediate_dominators[predecessor] == NOT_PLACED) {
+                        continue;
+                    }
+                    if(new_dominator == NOT_PLACED) {
+                        new_dominator = predecessor;
+                        continue;
+                    }
+                    ir::block_id_t lhs = predecessor;
+                    ir::block_id_t rhs = new_dominator;
+                    while(lhs != rhs) {
+                        while(postorder_numbers[lhs] < postorder_numbers[rhs]) {
+                            lhs = immediate_dominators[lhs];
+                        }
+                        while(postorder_numbers[rhs] < postorder_numbers[lhs]) {
+                            rhs = immediate_dominators[rhs];
+                        }
+                    }
+                    new_dominator = lhs;
+                }
+                if(immediate_dominators[block] != new_dominator) {
+                    immediate_dominators[block] = new_dominator;
+                    has_changed = true;
+                }
+            }
+        }
+    }
+    bool dominates(const ir::block_id_t dominator, ir::block_id_t block) const {
+        if(immediate_dominators[block] == NOT_PLACED) {
+            return true; // nothing is used in a block that never runs
+        }
+        while(block != dominator && block != 0u) {
+            block = immediate_dominators[block];
+        }
+        return block == dominator;
+    }
+
+    utils::result_t<void> verify_structure() {
+        if(function.blocks.empty()) {
+            return error("Function has no blocks.");
+        }
+        definition_blocks.assign(function.instructions.size(), NOT_PLACED);
+        definition_positions.assign(function.instructions.size(), 0u);
+        for(ir::block_id_t block = 0u; block < function.blocks.size(); ++block) {
+            const auto& instructions = function.blocks[block].instructions;
+            if(instructions.empty()) {
+                return error("bb" + std::to_string(block) + " is empty.");
+            }
+            bool are_phis_allowed = true;
+            for(std::uint32_t position = 0u; position < instructions.size(); ++position) {
+                const ir::value_t value = instructions[position];
+                if(value >= function.instructions.size()) {
+                    return error("bb" + std::to_string(block) + " refers to %" + std::to_string(value) + ", which doesn't exist.");
+                }
+                if(definition_blocks[value] != NOT_PLACED) {
+                    return error(value, "Is in more than one place.");
+                }
+                definition_blocks[value] = block;
+                definition_positions[value] = position;
+
+                const ir::instruction_t& instruction = function.get(value);
+                if(ir::is_terminator(instruction.opcode) != (position + 1u == instructions.size())) {
+                    return error(value, "Every block has to end in exactly one terminator.");
+                }
+                if(instruction.opcode == ir::opcode_t::PHI) {
+                    if(!are_phis_allowed) {
+                        return error(value, "Phis have to come first in their block.");
+                    }
+                } else {
+                    are_phis_allowed = false;
+                }
+                if((instruction.opcode == ir::opcode_t::PARAM || instruction.opcode == ir::opcode_t::ALLOCA) && block != 0u) {
+                    return error(value, "Only allowed in the entry block.");
+                }
+                for(const ir::block_id_t target : instruction.targets) {
+                    if(target >= function.blocks.size()) {
+                        return error(value, "Refers to bb" + std::to_string(target) + ", which doesn't exist.");
+                    }
+                }
+            }
+        }
+        for(ir::value_t value = 0u; value < function.instructions.size(); ++value) {
+            if(definition_blocks[value] == NOT_PLACED) {
+                continue; // not part of the function
+            }
+            for(const ir::value_t operand : function.get(value).operands) {
+                if(operand >= function.instructions.size() || definition_blocks[operand] == NOT_PLACED) {
+                    return error(value, "Uses %" + std::to_string(operand) + ", which isn't defined.");
+                }
+                if(function.get(operand).type == ir::type_t::VOID) {
+                    return error(value, "Uses %" + std::to_string(operand) + ", which has no value.");
+                }
+            }
+        }
+        predecessors = ir::compute_predecessors(function);
+        if(!predecessors[0].empty()) {
+            return error("The entry block can't be branched to.");
+        }
+        return {};
+    }
+
+    utils::result_t<void> verify_types(const ir::value_t value) {
+        const ir::instruction_t& instruction = function.get(value);
+        const ir::type_t type = instruction.type;
+        const auto expect = [this, value](const bool condition, const char *const message) -> utils::result_t<void> {
+            if(!condition) {
+                return error(value, message);
+            }
+            return {};
+        };
+        const auto is_target_count = [&instruction](const std::size_t count) {
+            return instruction.targets.size() == count;
+        };
+        switch(instruction.opcode) {
+            case ir::opcode_t::PARAM:
+                TRY(expect(instruction.immediate < function.param_types.size() && function.param_types[instruction.immediate] == type && instruction.operands.empty(),
+                    "Has to be of the type of the parameter it names."));
+                return expect(function.param_structs.empty() || (function.param_structs.size() == function.param_types.size() && (!function.param_structs[instruction.immediate].is_struct || type == ir::type_t::PTR)),
+                    "Has to be a `ptr` if it is a struct.");
+            case ir::opcode_t::CONST:
+                return expect((ir::is_integer(type) || ir::is_floating(type)) && instruction.operands.empty(), "Has to be an integer or floating point constant.");
+            case ir::opcode_t::ALLOCA:
+                return expect(type == ir::type_t::PTR && instruction.operands.empty() && instruction.alignment != 0u && (instruction.alignment & (instruction.alignment - 1u)) == 0u,
+                    "Has to be a `ptr`, aligned to a power of two.");
+            case ir::opcode_t::GLOBAL_ADDRESS:
+                return expect(type == ir::type_t::PTR && instruction.operands.empty(), "Has to be a `ptr`.");
+            case ir::opcode_t::PTR_OFFSET:
+                return expect(type == ir::type_t::PTR && has_operand_types(value, {ir::type_t::PTR}), "Has to offset a `ptr`.");
+            case ir::opcode_t::LOAD:
+                return expect(type != ir::type_t::VOID && has_operand_types(value, {ir::type_t::PTR}), "Has to load a value from a `ptr`.");
+            case ir::opcode_t::STORE:
+                return expect(type == ir::type_t::VOID && instruction.operands.size() == 2u && operand_type(value, 1u) == ir::type_t::PTR, "Has to store a value to a `ptr`.");
+            case ir::opcode_t::COPY:
+                return expect(type == ir::type_t::VOID && has_operand_types(value, {ir::type_t::PTR, ir::type_t::PTR}), "Has to copy from a `ptr` to a `ptr`.");
+
+            case ir::opcode_t::ADD: case ir::opcode_t::SUB: case ir::opcode_t::MUL:
+            case ir::opcode_t::SDIV: case ir::opcode_t::UDIV: case ir::opcode_t::SREM: case ir::opcode_t::UREM:
+            case ir::opcode_t::SHL: case ir::opcode_t::ASHR: case ir::opcode_t::LSHR:
+            case ir::opcode_t::AND: case ir::opcode_t::OR: case ir::opcode_t::XOR:
+                return expect(ir::is_integer(type) && has_operand_types(value, {type, type}), "Operands and result have to be integers of the same type.");
+            case ir::opcode_t::NEG:
+            case ir::opcode_t::NOT:
+                return expect(ir::is_integer(type) && has_operand_types(value, {type}), "Operand and result have to be integers of the same type.");
+            case ir::opcode_t::FADD: case ir::opcode_t::FSUB: case ir::opcode_t::FMUL: case ir::opcode_t::FDIV:
+                return expect(ir::is_floating(type) && has_operand_types(value, {type, type}), "Operands and result have to be floating point values of the same type.");
+            case ir::opcode_t::FNEG:
+                return expect(ir::is_floating(type) && has_operand_types(value, {type}), "Operand and result have to be floating point values of the same type.");
+
+            case ir::opcode_t::EQ: case ir::opcode_t::NE:
+            case ir::opcode_t::SLT: case ir::opcode_t::SLE: case ir::opcode_t::SGT: case ir::opcode_t::SGE:
+            case ir::opcode_t::ULT: case ir::opcode_t::ULE: case ir::opcode_t::UGT: case ir::opcode_t::UGE:
+                return expect(type == ir::type_t::I32 && instruction.operands.size() == 2u && ir::is_integer(operand_type(value, 0u)) && operand_type(value, 0u) == operand_type(value, 1u),
+                    "Has to compare integers of the same type to an `i32`.");
+            case ir::opcode_t::FEQ: case ir::opcode_t::FNE:
+            case ir::opcode_t::FLT: case ir::opcode_t::FLE: case ir::opcode_t::FGT: case ir::opcode_t::FGE:
+                return expect(type == ir::type_t::I32 && instruction.operands.size() == 2u && ir::is_floating(operand_type(value, 0u)) && operand_type(value, 0u) == operand_type(value, 1u),
+                    "Has to compare floating point values of the same type to an `i32`.");
+
+            case ir::opcode_t::SEXT:
+            case ir::opcode_t::ZEXT:
+                return expect(ir::is_integer(type) && instruction.operands.size() == 1u && ir::is_integer(operand_type(value, 0u)) && ir::get_size(operand_type(value, 0u)) < ir::get_size(type),
+                    "Has to widen an integer.");
+            case ir::opcode_t::TRUNC:
+                return expect(ir::is_integer(type) && instruction.operands.size() == 1u && ir::is_integer(operand_type(value, 0u)) && ir::get_size(operand_type(value, 0u)) > ir::get_size(type),
+                    "Has to narrow an integer.");
+            case ir::opcode_t::SITOFP:
+            case ir::opcode_t::UITOFP:
+                return expect(ir::is_floating(type) && instruction.operands.size() == 1u && ir::is_integer(operand_type(value, 0u)), "Has to convert an integer to floating point.");
+            case ir::opcode_t::FPTOSI:
+            case ir::opcode_t::FPTOUI:
+                return expect(ir::is_integer(type) && instruction.operands.size() == 1u && ir::is_floating(operand_type(value, 0u)), "Has to convert floating point to an integer.");
+            case ir::opcode_t::FPEXT:
+                return expect(type == ir::type_t::F64 && has_operand_types(value, {ir::type_t::F32}), "Has to convert an `f32` to an `f64`.");
+            case ir::opcode_t::FPTRUNC:
+                return expect(type == ir::type_t::F32 && has_operand_types(value, {ir::type_t::F64}), "Has to convert an `f64` to an `f32`.");
+
+            case ir::opcode_t::CALL:
+                TRY(expect(!instruction.symbol.empty(), "Has to name the function it calls."));
+                TRY(expect(instruction.struct_arguments.empty() || instruction.struct_arguments.size() == instruction.operands.size(), "Has to say how each argument is passed, if any is a struct."));
+                for(std::size_t i = 0u; i < instruction.struct_arguments.size(); ++i) {
+                    TRY(expect(!instruction.struct_arguments[i].is_struct || operand_type(value, i) == ir::type_t::PTR, "Struct arguments have to be `ptr`s."));
+                }
+                return expect(!instruction.struct_return.is_struct || (type == ir::type_t::VOID && !instruction.operands.empty() && operand_type(value, 0u) == ir::type_t::PTR),
+                    "Has to return a struct through the `ptr` that is its first operand.");
+            case ir::opcode_t::PHI: {
+                TRY(expect(type != ir::type_t::VOID && instruction.operands.size() == instruction.targets.size(), "Has to have one incoming block per value."));
+                for(std::size_t i = 0u; i < instruction.operands.size(); ++i) {
+                    TRY(expect(operand_type(value, i) == type, "Incoming values have to be of the type of the phi."));
+                }
+                std::vector<ir::block_id_t> incoming_blocks = instruction.targets;
+                std::vector<ir::block_id_t> block_predecessors = predecessors[definition_blocks[value]];
+                std::sort(std::begin(incoming_blocks), std::end(incoming_blocks));
+                std::sort(std::begin(block_predecessors), std::end(block_predecessors));
+                return expect(incoming_blocks == block_predecessors, "Has to have exactly one incoming value per predecessor of its block.");
+            }
+
+            case ir::opcode_t::JUMP:
+                return expect(type == ir::type_t::VOID && instruction.operands.empty() && is_target_count(1u), "Has to jump to a single block.");
+            case ir::opcode_t::BRANCH:
+                return expect(type == ir::type_t::VOID && instruction.operands.size() == 1u && ir::is_integer(operand_type(value, 0u)) && is_target_count(2u),
+                    "Has to branch on an integer to one of two blocks.");
+            case ir::opcode_t::RET:
+                if(function.return_type == ir::type_t::VOID) {
+                    return expect(type == ir::type_t::VOID && instruction.operands.empty(), "Can't return a value from a `void` function.");
+                }
+                return expect(type == ir::type_t::VOID && has_operand_types(value, {function.return_type}), "Has to return a value of the return type of the function.");
+        }
+        return error(value, "Invalid opcode.");
+    }
+
+    utils::result_t<void> verify_dominance(const ir::value_t value) {
+        const ir::instruction_t& instruction = function.get(value);
+        const ir::block_id_t block = definition_blocks[value];
+        for(std::size_t i = 0u; i < instruction.operands.size(); ++i) {
+            const ir::value_t operand = instruction.operands[i];
+            const ir::block_id_t operand_block = definition_blocks[operand];
+            bool is_dominated;
+            if(instruction.opcode == ir::opcode_t::PHI) { // has to be available at the end of the incoming block
+                is_dominated = dominates(operand_block, instruction.targets[i]);
+            } else if(operand_block == block) {
+                is_dominated = definition_positions[operand] < definition_positions[value];
+            } else {
+                is_dominated = dominates(operand_block, block);
+            }
+            if(!is_dominated) {
+                return error(value, "Uses %" + std::to_string(operand) + " where it may not have been defined.");
+            }
+        }
+        return {};
+    }
+
+    utils::result_t<void> verify() {
+        TRY(verify_structure());
+        compute_dominators();
+        for(const auto& block : function.blocks) {
+            for(const ir::value_t value : block.instructions) {
+                TRY(verify_types(value));
+                TRY(verify_dominance(value));
+            }
+        }
+        return {};
+    }
+};
+}
+
+
+utils::result_t<void> verify_function(const ir::function_t& function, utils::diagnostics_t& diagnostics) {
+    return verifier_t{function, diagnostics}.verify();
+}
+utils::result_t<void> verify_module(const ir::module_t& module, utils::diagnostics_t& diagnostics) {
+    for(const auto& function : module.functions) {
+        TRY(verify_function(function, diagnostics));
+    }
+    return {};
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <middle_end/ir/ir.hpp>
+#include <utils/result.hpp>
+
+
+// Checks that IR is well formed, i.e. what the passes after lowering can rely on:
+//  - every block ends in exactly one terminator, whose targets exist, and phis come first in their block
+//  - params and allocas are only in the entry block, which no block branches back to
+//  - operands are values of the types their instruction expects
+//  - every phi has exactly one incoming value per predecessor of its block
+//  - every value is defined before it is used, on every path (i.e. its definition dominates its uses; for phis, the end of the incoming block)
+// Problems are reported to `diagnostics`. Verification of a function stops at its first problem.
+utils::result_t<void> verify_function(const ir::function_t& function, utils::diagnostics_t& diagnostics);
+utils::result_t<void> verify_module(const ir::module_t& module, utils::diagnostics_t& diagnostics);
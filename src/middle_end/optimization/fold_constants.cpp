@@ -0,0 +1,306 @@
+#include "fold_constants.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <backend/interpreter/compile_time_evaluator.hpp>
+#include <utils/common.hpp>
+#include <utils/result.hpp>
+
+
+namespace {
+struct folding_context_t {
+    const ast::type_table_t& type_table;
+    // What can't be evaluated is left for the program to run into, so what the evaluator reports about it isn't an error of the program.
+    utils::diagnostics_t ignored_diagnostics;
+    // `get_expression_kind()` of the types it was asked about, indexed by their ids (the outer optional is empty until the type is resolved). Expressions
+    //  only have a handful of distinct types, so each is resolved once.
+    std::vector<std::optional<std::optional<constant_kind_t>>> kinds_by_type_id;
+
+    folding_context_t(const ast::type_table_t& type_table) : type_table(type_table) {}
+};
+
+// The kind of the values of an expression type, with typedefs resolved. `std::nullopt` unless it is a primitive type.
+std::optional<constant_kind_t> get_expression_kind(folding_context_t& context, const ast::expression_type_t& type) {
+    if(!type.has_value()) {
+        return std::nullopt;
+    }
+    const std::uint32_t index = type.id().index;
+    if(index >= context.kinds_by_type_id.size()) {
+        context.kinds_by_type_id.resize(index + 1u);
+    }
+    std::optional<std::optional<constant_kind_t>>& kind = context.kinds_by_type_id[index];
+    if(!kind.has_value()) {
+        const ast::type_t *const underlying_type = get_underlying_type(context.type_table, type.value());
+        kind = (underlying_type == nullptr) ? std::nullopt : get_constant_kind(*underlying_type);
+    }
+    return kind.value();
+}
+std::optional<constant_value_t> to_optional(utils::result_t<constant_value_t>&& result) {
+    if(!result.has_value()) {
+        return std::nullopt;
+    }
+    return result.value();
+}
+// `value` converted to the type of `expression`, if that is a primitive type and the conversion is defined
+std::optional<constant_value_t> convert_to_type_of(folding_context_t& context, const ast::expression_t& expression, const constant_value_t& value) {
+    const std::optional<constant_kind_t> kind = get_expression_kind(context, expression.type);
+    if(!kind.has_value()) {
+        return std::nullopt;
+    }
+    return to_optional(convert_constant_value(value, kind.value(), context.ignored_diagnostics));
+}
+
+bool is_comparison_operator(const ast::binary_operator_token_t op) {
+    switch(op) {
+        case ast::binary_operator_token_t::LESS_THAN:
+        case ast::binary_operator_token_t::LESS_THAN_EQUAL:
+        case ast::binary_operator_token_t::GREATER_THAN:
+        case ast::binary_operator_token_t::GREATER_THAN_EQUAL:
+        case ast::binary_operator_token_t::EQUAL:
+        case ast::binary_operator_token_t::NOT_EQUAL:
+            return true;
+        default:
+            return false;
+    }
+}
+// `INT_MIN / -1` (at the width of `type`) overflows, which traps
+bool is_overflowing_division(const ast::type_t& type, const constant_value_t& left, const constant_value_t& right) {
+    if(type.type_category != ast::type_category_t::INT) {
+        return false;
+    }
+    const unsigned unused_bits = 64u - static_cast<unsigned>(type.size.value()) * 8u;
+    return right.signed_value == -1 && left.signed_value == (std::numeric_limits<std::int64_t>::min() >> unused_bits);
+}
+
+
+// Folding works on `constant_value_t`s, so that a constant expression tree is converted from `ast::constant_t`s at its leaves and back to one at its root
+//  only, instead of at every operator. `fold_expression()` returns the value of an expression (converted to its type) if it is constant, and leaves it to
+//  the caller to either use the value or to replace the expression with it, see `replace_with_value()`.
+std::optional<constant_value_t> fold_expression(folding_context_t& context, ast::expression_t& expression);
+
+// Replaces `expression` with `value` if there is one, for when its parent can't be folded.
+void replace_with_value(ast::expression_t& expression, const std::optional<constant_value_t>& value) {
+    if(value.has_value() && !std::holds_alternative<ast::constant_t>(expression.expr)) {
+        expression.expr = to_constant(value.value());
+    }
+}
+// Folds an expression that nothing is folded into, e.g. the expression of a statement.
+void fold_root_expression(folding_context_t& context, ast::expression_t& expression) {
+    replace_with_value(expression, fold_expression(context, expression));
+}
+// Replaces `expression` with `operand`, a subexpression of it that is all that is left to evaluate, converted to the type of `expression`.
+void replace_with_operand(ast::expression_t& expression, ast::expression_t operand) {
+    if(operand.type == expression.type) {
+        expression = std::move(operand);
+    } else {
+        const ast::expression_type_t type = expression.type;
+        expression = make_convert_t(std::move(operand), type);
+    }
+}
+
+std::optional<constant_value_t> fold_unary_expression(folding_context_t& context, ast::expression_t& expression, ast::unary_expression_t& unary_exp) {
+    const std::optional<constant_value_t> operand = fold_expression(context, unary_exp.exp);
+    std::optional<constant_value_t> result;
+    if(operand.has_value() && unary_exp.op != ast::unary_operator_token_t::PLUS_PLUS && unary_exp.op != ast::unary_operator_token_t::MINUS_MINUS) {
+        if(unary_exp.op == ast::unary_operator_token_t::LOGICAL_NOT) {
+            result = convert_to_type_of(context, expression, constant_value_t{constant_kind_t::INT, {is_nonzero(operand.value()) ? 0 : 1}});
+        } else if(const std::optional<constant_value_t> converted_operand = convert_to_type_of(context, expression, operand.value()); converted_operand.has_value()) {
+            // `+`, `-` and `~` operate on their operand converted to the type of the result
+            const std::optional<constant_value_t> value = to_optional(evaluate_unary_operator(converted_operand.value(), unary_exp.op, context.ignored_diagnostics));
+            if(value.has_value()) {
+                result = convert_to_type_of(context, expression, value.value());
+            }
+        }
+    }
+    if(!result.has_value()) {
+        replace_with_value(unary_exp.exp, operand);
+    }
+    return result;
+}
+// The arithmetic operators and the comparisons.
+std::optional<constant_value_t> fold_binary_operator(folding_context_t& context, const ast::expression_t& expression, const ast::binary_expression_t& binary_exp,
+    const constant_value_t& left, const constant_value_t& right) {
+    // comparisons convert their right operand to the type of their left one, the arithmetic operators convert both operands to the type of the result
+    //  (the type checker doesn't convert the shift amount, the generated code does)
+    const ast::expression_t& operand_type_expression = is_comparison_operator(binary_exp.op) ? binary_exp.left : expression;
+    const std::optional<constant_value_t> converted_left = convert_to_type_of(context, operand_type_expression, left);
+    const std::optional<constant_value_t> converted_right = convert_to_type_of(context, operand_type_expression, right);
+    if(!converted_left.has_value() || !converted_right.has_value()) {
+        return std::nullopt;
+    }
+    if(binary_exp.op == ast::binary_operator_token_t::DIVIDE || binary_exp.op == ast::binary_operator_token_t::MODULO) {
+        // the operand type is a primitive type, or the operands wouldn't have been converted to it
+        const ast::type_t& operand_type = *get_underlying_type(context.type_table, operand_type_expression.type.value());
+        if(is_overflowing_division(operand_type, converted_left.value(), converted_right.value())) {
+            return std::nullopt;
+        }
+    }
+    // The operands have the same kind, so the evaluator computes in that kind (promoted) and wraps around to its width. It reports what is left to run into:
+    //  division by zero and shift amounts out of range of the width.
+    const std::optional<constant_value_t> result = to_optional(evaluate_binary_operator(converted_left.value(), converted_right.value(), binary_exp.op, context.ignored_diagnostics));
+    if(!result.has_value()) {
+        return std::nullopt;
+    }
+    return convert_to_type_of(context, expression, result.value());
+}
+std::optional<constant_value_t> fold_binary_expression(folding_context_t& context, ast::expression_t& expression, ast::binary_expression_t& binary_exp) {
+    const std::optional<constant_value_t> left = fold_expression(context, binary_exp.left);
+    const std::optional<constant_value_t> right = fold_expression(context, binary_exp.right);
+
+    std::optional<constant_value_t> result;
+    switch(binary_exp.op) {
+        case ast::binary_operator_token_t::ASSIGNMENT:
+            break;
+        case ast::binary_operator_token_t::COMMA:
+            if(left.has_value()) { // a constant has no side effects
+                replace_with_value(binary_exp.right, right);
+                ast::expression_t right_operand = binary_exp.right;
+                replace_with_operand(expression, std::move(right_operand));
+                return right.has_value() ? convert_to_type_of(context, expression, right.value()) : std::nullopt;
+            }
+            break;
+        case ast::binary_operator_token_t::LOGICAL_AND:
+        case ast::binary_operator_token_t::LOGICAL_OR: {
+            if(!left.has_value()) {
+                break;
+            }
+            const bool is_and = (binary_exp.op == ast::binary_operator_token_t::LOGICAL_AND);
+            if(is_nonzero(left.value()) != is_and) { // decided by the left operand, the right one is never evaluated
+                result = convert_to_type_of(context, expression, constant_value_t{constant_kind_t::INT, {is_and ? 0 : 1}});
+            } else if(right.has_value()) {
+                result = convert_to_type_of(context, expression, constant_value_t{constant_kind_t::INT, {is_nonzero(right.value()) ? 1 : 0}});
+            }
+            break;
+        }
+        default:
+            if(left.has_value() && right.has_value()) {
+                result = fold_binary_operator(context, expression, binary_exp, left.value(), right.value());
+            }
+            break;
+    }
+    if(!result.has_value()) {
+        replace_with_value(binary_exp.left, left);
+        replace_with_value(binary_exp.right, right);
+    }
+    return result;
+}
+std::optional<constant_value_t> fold_ternary_expression(folding_context_t& context, ast::expression_t& expression, ast::ternary_expression_t& ternary_exp) {
+    const std::optional<constant_value_t> condition = fold_expression(context, ternary_exp.condition);
+    const std::optional<constant_value_t> if_true = fold_expression(context, ternary_exp.if_true);
+    const std::optional<constant_value_t> if_false = fold_expression(context, ternary_exp.if_false);
+    if(!condition.has_value()) {
+        replace_with_value(ternary_exp.if_true, if_true);
+        replace_with_value(ternary_exp.if_false, if_false);
+        return std::nullopt;
+    }
+    // the arm that isn't taken is never evaluated
+    const bool is_true = is_nonzero(condition.value());
+    const std::optional<constant_value_t>& taken_value = is_true ? if_true : if_false;
+    if(taken_value.has_value()) {
+        if(const std::optional<constant_value_t> result = convert_to_type_of(context, expression, taken_value.value()); result.has_value()) {
+            return result;
+        }
+    }
+    ast::expression_t taken_arm = is_true ? ternary_exp.if_true : ternary_exp.if_false;
+    replace_with_value(taken_arm, taken_value);
+    replace_with_operand(expression, std::move(taken_arm));
+    return std::nullopt;
+}
+// `(x)` and conversions
+std::optional<constant_value_t> fold_operand_of(folding_context_t& context, ast::expression_t& expression, ast::expression_t& operand) {
+    const std::optional<constant_value_t> value = fold_expression(context, operand);
+    const std::optional<constant_value_t> result = value.has_value() ? convert_to_type_of(context, expression, value.value()) : std::nullopt;
+    if(!result.has_value()) {
+        replace_with_value(operand, value);
+    }
+    return result;
+}
+
+std::optional<constant_value_t> fold_expression(folding_context_t& context, ast::expression_t& expression) {
+    return std::visit(overloaded{
+        [&context, &expression](const ast::node_handle_t<ast::grouping_t>& grouping) {
+            return fold_operand_of(context, expression, grouping->expr);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::convert_t>& convert_exp) {
+            return fold_operand_of(context, expression, convert_exp->expr);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::unary_expression_t>& unary_exp) {
+            return fold_unary_expression(context, expression, *unary_exp);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::binary_expression_t>& binary_exp) {
+            return fold_binary_expression(context, expression, *binary_exp);
+        },
+        [&context, &expression](const ast::node_handle_t<ast::ternary_expression_t>& ternary_exp) {
+            return fold_ternary_expression(context, expression, *ternary_exp);
+        },
+        [&context](const ast::node_handle_t<ast::function_call_t>& function_call) -> std::optional<constant_value_t> {
+            for(auto& param : function_call->params) {
+                fold_root_expression(context, param);
+            }
+            return std::nullopt;
+        },
+        [](const ast::variable_access_t&) -> std::optional<constant_value_t> {
+            return std::nullopt;
+        },
+        [](const ast::constant_t& constant) -> std::optional<constant_value_t> {
+            return to_constant_value(constant);
+        }
+    }, expression.expr);
+}
+
+
+void fold_compound_statement(folding_context_t& context, ast::compound_statement_t& compound_statement);
+
+void fold_statement(folding_context_t& context, ast::statement_t& statement) {
+    std::visit(overloaded{
+        [&context](ast::return_statement_t& return_statement) {
+            fold_root_expression(context, return_statement.expr);
+        },
+        [&context](ast::expression_statement_t& expression_statement) {
+            if(expression_statement.expr.has_value()) {
+                fold_root_expression(context, expression_statement.expr.value());
+            }
+        },
+        [&context](const ast::node_handle_t<ast::if_statement_t>& if_statement) {
+            fold_root_expression(context, if_statement->if_exp);
+            fold_statement(context, if_statement->if_body);
+            if(if_statement->else_body.has_value()) {
+                fold_statement(context, if_statement->else_body.value());
+            }
+        },
+        [&context](const ast::node_handle_t<ast::compound_statement_t>& compound_statement) {
+            fold_compound_statement(context, *compound_statement);
+        }
+    }, statement);
+}
+void fold_compound_statement(folding_context_t& context, ast::compound_statement_t& compound_statement) {
+    for(auto& statement_or_declaration : compound_statement.stmts) {
+        std::visit(overloaded{
+            [&context](ast::statement_t& statement) {
+                fold_statement(context, statement);
+            },
+            [&context](ast::declaration_t& declaration) {
+                if(declaration.value.has_value()) {
+                    fold_root_expression(context, declaration.value.value());
+                }
+            }
+        }, statement_or_declaration);
+    }
+}
+}
+
+
+void fold_constants(ast::validated_program_t& program) {
+    const ast::node_pools_scope_t node_pools_scope(*program.nodes); // conversions of what is left of a `?:` or `,` are inserted as new nodes
+    folding_context_t context(program.type_table);
+    for(auto& top_level_declaration : program.top_level_declarations) {
+        if(auto *const function_definition = std::get_if<ast::function_definition_t>(&top_level_declaration); function_definition != nullptr) {
+            fold_compound_statement(context, function_definition->statements);
+        }
+    }
+}
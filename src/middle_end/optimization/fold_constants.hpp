@@ -0,0 +1,14 @@
+#pragma once
+
+
+#include <frontend/ast/ast.hpp>
+
+
+// Replaces every constant subexpression in the function bodies of a type checked program with its value, evaluated with `compile_time_evaluator.hpp`.
+//  - Values are computed the way the generated code would compute them: integers wrap around to the width of their type (signed ones as two's complement),
+//     and `long double` is computed as `double`, as that is what it is lowered to (see `lower_ast.hpp`). Each folded constant has its expression's type.
+//  - Nothing that has a side effect is removed: only operators whose operands are all constants are folded, except for `&&`, `||` and `?:` with a constant
+//     left operand or condition, whose other operands are then never evaluated, and `,` with a constant left operand.
+//  - Operations whose result is undefined (division by zero, signed division overflow, shifts by at least the width of the type, out of range floating point
+//     to integer conversions) are left for the program to run into.
+void fold_constants(ast::validated_program_t& program);
@@ -7,10 +7,11 @@
 #include <iterator>
 #include <functional>
 #include <string>
-#include <unordered_map>
+#include <optional>
 #include <variant>
 
 #include <frontend/ast/ast.hpp>
+#include <utils/data_structures/scoped_symbol_table.hpp>
 
 
 // TODO: support iterators
@@ -80,108 +81,39 @@ public:
     }
 };
 
-using rbp_offset_t = std::uint64_t;
-struct block_scope_t {
-    std::unordered_map<std::string, rbp_offset_t> variables;
-
-    // current offset from what the `rsp` was at the beginning/creation of the current block scope (i.e. how much to increment `rsp` by once this block scope ends).
-    std::uint64_t stack_size = 0u;
-};
-class backend_variable_lookup_t {
-    random_access_stack_t<block_scope_t> scopes;
-
-public:
-    backend_variable_lookup_t() = default;
-
-    bool contains_in_lowest_scope(const std::string& variable_name) const {
-        return scopes.peek().variables.find(variable_name) != scopes.peek().variables.end();
-    }
-    bool contains_in_accessible_scopes(const std::string& variable_name) {
-        for(std::uint32_t i = 0u; i < scopes.size(); ++i) {
-            if(scopes.at(i).variables.find(variable_name) != scopes.at(i).variables.end()) {
-                return true;
-            }
-        }
-        return false;
-    }
-    std::optional<rbp_offset_t> find_from_lowest_scope(const std::string& variable_name) {
-        for(std::uint32_t i = scopes.last_index(); i < scopes.size(); --i) { // iterate backwards so we start in lowest level scope and use `i < variables.size()` so we handle unsigned integer underflow for `i`.
-            auto it = scopes.at(i).variables.find(variable_name);
-            if(it != scopes.at(i).variables.end()) {
-                return it->second; // returns the variable rbp offset for the lowest scope level variable with this name. This means we properly handle variable shadowing.
-            }
-        }
-        return std::nullopt; // variable with this name not found in any accessible scope
-    }
-
-    void add_new_variable_in_current_scope(const ast::var_name_t& variable_name, const rbp_offset_t rbp_offset) {
-        scopes.peek().variables.insert({variable_name, rbp_offset});
-        scopes.peek().stack_size += sizeof(std::uint64_t); // TODO: we currently only support 64 bit integer type
-    }
-
-    const std::unordered_map<std::string, rbp_offset_t>& get_current_lowest_scope() const {
-        return scopes.peek().variables;
-    }
-    std::unordered_map<std::string, rbp_offset_t>& get_current_lowest_scope() {
-        return scopes.peek().variables;
-    }
-
-    void increment_current_block_stack_amount(const std::size_t incr) {
-        scopes.peek().stack_size += incr;
-    }
-
-    void create_new_scope() {
-        scopes.push(block_scope_t{});
-    }
-    std::uint64_t destroy_current_scope() {
-        return scopes.pop().stack_size;
-    }
-
-    std::uint64_t get_total_stack_size() const {
-        std::uint64_t ret = 0;
-        for(auto i = 0; i < scopes.size(); ++i) {
-            ret += scopes.at(i).stack_size;
-        }
-        return ret;
-    }
-};
 class validation_variable_lookup_t {
-    random_access_stack_t<std::unordered_map<ast::var_name_t, ast::type_t>> variables;
+    scoped_symbol_table_t<ast::type_t> variables;
 
 public:
     validation_variable_lookup_t() = default;
 
     bool contains_in_lowest_scope(const ast::var_name_t& variable_name) const {
-        return variables.peek().find(variable_name) != variables.peek().end();
+        return variables.is_in_current_scope(variable_name);
     }
     bool contains_in_accessible_scopes(const ast::var_name_t& variable_name) const {
-        for(std::uint32_t i = 0u; i < variables.size(); ++i) {
-            if(variables.at(i).find(variable_name) != variables.at(i).end()) {
-                return true;
-            }
-        }
-        return false;
+        return variables.is_in_scope(variable_name);
     }
 
-    ast::type_t find_in_accessible_scopes(const ast::var_name_t& variable_name) const {
-        for(std::uint32_t i = 0u; i < variables.size(); ++i) {
-            auto var_iter = variables.at(i).find(variable_name);
-            if(var_iter != variables.at(i).end()) {
-                return var_iter->second;
-            }
+    // The type of the innermost variable with this name. Invalidated by adding more variables.
+    const ast::type_t& find_in_accessible_scopes(const ast::var_name_t& variable_name) const {
+        const ast::type_t *const type = variables.find(variable_name);
+        if(type == nullptr) {
+            throw std::logic_error("Variable not found");
         }
-        throw std::logic_error("Variable not found");
+        return *type;
     }
 
     void add_new_variable_in_current_scope(const ast::var_name_t& variable_name, const ast::type_t& variable_type) {
-        variables.peek().insert({variable_name, variable_type});
+        if(!variables.is_in_current_scope(variable_name)) { // the first declaration in a scope wins, e.g. of parameters with the same name
+            variables.bind(variable_name, variable_type);
+        }
     }
 
     void create_new_scope() {
-        variables.push({});
+        variables.enter_scope();
     }
     void destroy_current_scope() {
-        variables.pop();
+        variables.leave_scope();
     }
 };
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <utils/symbol_interner.hpp>
+
+
+namespace utils::data_structures {
+// Maps names to the innermost of their bindings in nested block scopes.
+// Every name that was ever bound has one slot in an open addressing table, which points at the name's innermost binding, which in turn points at the binding it
+//  shadows. Bindings are kept in the order they were made, so they double as the undo log: leaving a scope pops the scope's bindings and points their
+//  slots back at what they shadowed.
+// Looking a name up is a single probe sequence no matter how deeply scopes nest, and entering or leaving a scope doesn't allocate (once the table has grown to
+//  fit the program).
+template<typename T>
+class scoped_symbol_table_t {
+    static constexpr std::uint32_t NO_BINDING = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t initial_slot_count = 64u;
+
+    struct slot_t {
+        symbol_t name; // the empty symbol marks an unused slot, as it can't be the name of anything
+        std::uint32_t innermost_binding = NO_BINDING; // `NO_BINDING` once all bindings of `name` went out of scope
+    };
+    struct binding_t {
+        T value;
+        std::uint32_t slot;
+        std::uint32_t shadowed_binding; // the binding of the same name in an outer scope, or `NO_BINDING`
+    };
+
+    std::vector<slot_t> slots = std::vector<slot_t>(initial_slot_count); // size is a power of two
+    std::uint32_t used_slot_count = 0u;
+    std::vector<binding_t> bindings;
+    std::vector<std::uint32_t> scope_starts; // index of the first binding of each open scope
+
+    std::uint32_t find_slot(const symbol_t name) const {
+        const std::uint32_t mask = static_cast<std::uint32_t>(slots.size()) - 1u;
+        for(std::uint32_t i = (name.get_id() * 0x9e3779b9u) & mask;; i = (i + 1u) & mask) {
+            if(slots[i].name == name || slots[i].name.empty()) {
+                return i;
+            }
+        }
+    }
+    // Doubles the table. Slots of names that have no binding left are dropped.
+    void grow() {
+        std::vector<slot_t> old_slots = std::exchange(slots, std::vector<slot_t>(slots.size() * 2u));
+        used_slot_count = 0u;
+        for(const auto& old_slot : old_slots) {
+            if(old_slot.innermost_binding != NO_BINDING) {
+                const std::uint32_t slot = find_slot(old_slot.name);
+                slots[slot] = old_slot;
+                ++used_slot_count;
+                for(std::uint32_t binding = old_slot.innermost_binding; binding != NO_BINDING; binding = bindings[binding].shadowed_binding) {
+                    bindings[binding].slot = slot;
+                }
+            }
+        }
+    }
+
+    const binding_t* find_binding(const symbol_t name) const {
+        const slot_t& slot = slots[find_slot(name)];
+        return (slot.name.empty() || slot.innermost_binding == NO_BINDING) ? nullptr : &bindings[slot.innermost_binding];
+    }
+
+public:
+    scoped_symbol_table_t() = default;
+
+    bool is_in_scope(const symbol_t name) const {
+        return find_binding(name) != nullptr;
+    }
+    bool is_in_current_scope(const symbol_t name) const {
+        const binding_t *const binding = find_binding(name);
+        return binding != nullptr && !scope_starts.empty() && static_cast<std::uint32_t>(binding - bindings.data()) >= scope_starts.back();
+    }
+    // The value of the innermost binding of `name`, or `nullptr` if it isn't in scope. Invalidated by binding more names.
+    const T* find(const symbol_t name) const {
+        const binding_t *const binding = find_binding(name);
+        return (binding == nullptr) ? nullptr : &binding->value;
+    }
+
+    // Binds `name` in the current scope, shadowing its binding in an outer scope, if any.
+    void bind(const symbol_t name, T value) {
+        if(scope_starts.empty()) {
+            throw std::logic_error("No scope to bind a name in.");
+        }
+        std::uint32_t slot = find_slot(name);
+        if(slots[slot].name.empty()) {
+            if((used_slot_count + 1u) * 4u > slots.size() * 3u) { // keep the load factor at or below 3/4
+                grow();
+                slot = find_slot(name);
+            }
+            slots[slot].name = name;
+            ++used_slot_count;
+        }
+        bindings.push_back(binding_t{std::move(value), slot, slots[slot].innermost_binding});
+        slots[slot].innermost_binding = static_cast<std::uint32_t>(bindings.size() - 1u);
+    }
+
+    void enter_scope() {
+        scope_starts.push_back(static_cast<std::uint32_t>(bindings.size()));
+    }
+    void leave_scope() {
+        if(scope_starts.empty()) {
+            throw std::logic_error("No scope to leave.");
+        }
+        for(std::uint32_t binding = static_cast<std::uint32_t>(bindings.size()); binding > scope_starts.back(); --binding) {
+            slots[bindings.back().slot].innermost_binding = bindings.back().shadowed_binding;
+            bindings.pop_back();
+        }
+        scope_starts.pop_back();
+    }
+    std::size_t scope_count() const {
+        return scope_starts.size();
+    }
+};
+}
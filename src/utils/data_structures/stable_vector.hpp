@@ -0,0 +1,83 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace utils::data_structures {
+// Append only sequence addressed by 32 bit indices, stored in fixed size chunks.
+// Unlike `std::vector`, growing never moves the elements, so references to them stay valid while more are appended.
+// Elements that are appended together sit next to each other in memory, so walking them in index order is (mostly) a linear scan.
+template<typename T>
+class stable_vector_t {
+public:
+    static constexpr std::uint32_t chunk_size = 256u;
+
+private:
+    static_assert((chunk_size & (chunk_size - 1u)) == 0u, "Chunk size must be a power of two.");
+    using storage_t = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    std::vector<std::unique_ptr<storage_t[]>> chunks;
+    std::uint32_t element_count = 0u;
+
+    T* get_pointer(const std::uint32_t index) const {
+        return std::launder(reinterpret_cast<T*>(&chunks[index / chunk_size][index % chunk_size]));
+    }
+
+public:
+    stable_vector_t() = default;
+    stable_vector_t(const stable_vector_t&) = delete;
+    stable_vector_t& operator=(const stable_vector_t&) = delete;
+    ~stable_vector_t() {
+        clear();
+    }
+
+    // returns the index of the new element
+    std::uint32_t push_back(T value) {
+        if(element_count == std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Stable vector is full.");
+        }
+        if(element_count == chunks.size() * chunk_size) {
+            chunks.emplace_back(new storage_t[chunk_size]); // not `std::make_unique()`, which would zero the whole chunk
+        }
+        new(get_pointer(element_count)) T(std::move(value));
+        return element_count++;
+    }
+
+    const T& operator[](const std::uint32_t index) const {
+        return *get_pointer(index);
+    }
+    T& operator[](const std::uint32_t index) {
+        return *get_pointer(index);
+    }
+
+    std::uint32_t size() const {
+        return element_count;
+    }
+    bool empty() const {
+        return element_count == 0u;
+    }
+    // bytes of the chunks, including the unused tail of the last one
+    std::size_t capacity_bytes() const {
+        return chunks.size() * chunk_size * sizeof(T);
+    }
+
+    void clear() {
+        if constexpr(!std::is_trivially_destructible_v<T>) {
+            for(std::uint32_t index = element_count; index > 0u; --index) {
+                get_pointer(index - 1u)->~T();
+            }
+        }
+        chunks.clear();
+        element_count = 0u;
+    }
+};
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace utils {
+struct diagnostic_t {
+    std::optional<std::uint32_t> offset; // source offset of what the diagnostic is about, if there is one
+    std::string message;
+};
+
+// Marks a `result_t` as failed. What went wrong isn't carried along with it, it was already reported to a `diagnostics_t`.
+struct error_t {};
+inline constexpr error_t error{};
+
+// Collects the diagnostics that a compilation reports, in the order they were reported.
+class diagnostics_t {
+    std::vector<diagnostic_t> diagnostics;
+
+public:
+    // Always returns `utils::error`, so that `return diagnostics.report(...);` both reports an error and fails.
+    error_t report(std::string message, const std::optional<std::uint32_t> offset = std::nullopt) {
+        diagnostics.push_back(diagnostic_t{offset, std::move(message)});
+        return error;
+    }
+
+    bool has_errors() const {
+        return !diagnostics.empty();
+    }
+    const std::vector<diagnostic_t>& get_diagnostics() const {
+        return diagnostics;
+    }
+};
+
+// Either a `T` or `utils::error`. Errors are passed back up to the caller as plain return values instead of being thrown, which keeps invalid programs as cheap to reject as valid ones are to accept.
+template<typename T>
+class [[nodiscard]] result_t {
+    std::optional<T> value_;
+
+public:
+    result_t(error_t) {}
+    template<typename U = T, std::enable_if_t<std::is_constructible_v<T, U&&> && !std::is_same_v<std::decay_t<U>, error_t> && !std::is_same_v<std::decay_t<U>, result_t>, int> = 0>
+    result_t(U&& value) : value_(std::forward<U>(value)) {}
+    // passes on the value or the error of a result of a type that converts to `T`, e.g. a statement of a more specific type
+    template<typename U, std::enable_if_t<std::is_constructible_v<T, U&&> && !std::is_same_v<U, T>, int> = 0>
+    result_t(result_t<U>&& other) {
+        if(other.has_value()) {
+            value_.emplace(std::move(other).value());
+        }
+    }
+
+    bool has_value() const {
+        return value_.has_value();
+    }
+    explicit operator bool() const {
+        return has_value();
+    }
+
+    // throws `std::bad_optional_access` on an error
+    T& value() & {
+        return value_.value();
+    }
+    const T& value() const& {
+        return value_.value();
+    }
+    T&& value() && {
+        return std::move(value_.value());
+    }
+};
+template<>
+class [[nodiscard]] result_t<void> {
+    bool has_value_ = true;
+
+public:
+    result_t() = default;
+    result_t(error_t) : has_value_(false) {}
+
+    bool has_value() const {
+        return has_value_;
+    }
+    explicit operator bool() const {
+        return has_value();
+    }
+};
+}
+
+
+#define UTILS_RESULT_CONCAT_IMPL(a, b) a##b
+#define UTILS_RESULT_CONCAT(a, b) UTILS_RESULT_CONCAT_IMPL(a, b)
+
+// Returns `utils::error` from the enclosing function if `expression` (a `result_t`) failed. Its value, if any, is discarded.
+#define TRY(expression) \
+    do { \
+        if(!(expression).has_value()) { \
+            return ::utils::error; \
+        } \
+    } while(false)
+
+// `declaration = value of expression;`, or returns `utils::error` from the enclosing function if `expression` (a `result_t`) failed.
+//  e.g. `TRY_ASSIGN(auto type, parse_and_validate_type(parser));` or `TRY_ASSIGN(lhs, parse_prefix_expression(parser));`
+#define TRY_ASSIGN(declaration, expression) \
+    auto UTILS_RESULT_CONCAT(try_assign_result_, __LINE__) = (expression); \
+    if(!UTILS_RESULT_CONCAT(try_assign_result_, __LINE__).has_value()) { \
+        return ::utils::error; \
+    } \
+    declaration = std::move(UTILS_RESULT_CONCAT(try_assign_result_, __LINE__)).value()
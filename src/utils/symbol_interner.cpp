@@ -0,0 +1,34 @@
+#include "symbol_interner.hpp"
+
+#include <array>
+
+
+namespace utils {
+symbol_interner_t& get_symbol_interner() {
+    static symbol_interner_t interner; // function local so it is constructed before any (static) symbol is interned
+    return interner;
+}
+
+symbol_t intern(const std::string_view text) {
+    struct cache_entry_t {
+        std::string_view text; // owned by the global interner
+        symbol_t symbol;
+    };
+    static constexpr std::size_t cache_size = 1024u;
+    static_assert((cache_size & (cache_size - 1u)) == 0u, "Symbol cache size must be a power of two.");
+    thread_local std::array<cache_entry_t, cache_size> cache{}; // every empty entry maps "" to the empty symbol, which is correct
+
+    auto& entry = cache[std::hash<std::string_view>{}(text) & (cache_size - 1u)];
+    if(entry.text != text) {
+        const auto [symbol, stored_text] = get_symbol_interner().intern_with_text(text);
+        entry = cache_entry_t{stored_text, symbol};
+    }
+    return entry.symbol;
+}
+
+symbol_t::symbol_t(const std::string_view text) : id(intern(text).get_id()) {}
+
+std::string_view symbol_t::text() const {
+    return get_symbol_interner().text(*this);
+}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace utils {
+// Dense 32 bit ID of an interned string (identifiers, type names, field names).
+// Two symbols are equal iff their texts are equal, so comparing and hashing them is an integer compare/hash instead of a string one.
+// The default constructed symbol is the empty string.
+class symbol_t {
+    std::uint32_t id = 0u;
+
+public:
+    constexpr symbol_t() = default;
+    constexpr explicit symbol_t(const std::uint32_t id) : id(id) {}
+    // interns `text` into the global symbol interner
+    explicit symbol_t(std::string_view text);
+
+    constexpr std::uint32_t get_id() const {
+        return id;
+    }
+    bool empty() const {
+        return id == 0u;
+    }
+
+    // The text is owned by the global symbol interner and stays valid for the lifetime of the program.
+    std::string_view text() const;
+    std::string str() const {
+        return std::string(text());
+    }
+
+    constexpr bool operator==(const symbol_t other) const {
+        return id == other.id;
+    }
+    constexpr bool operator!=(const symbol_t other) const {
+        return id != other.id;
+    }
+    // orders by interning order, not alphabetically
+    constexpr bool operator<(const symbol_t other) const {
+        return id < other.id;
+    }
+};
+inline std::ostream& operator<<(std::ostream& os, const symbol_t symbol) {
+    return os << symbol.text();
+}
+
+// Maps strings to `symbol_t`s and back. Symbol IDs are handed out densely in interning order, starting with `0` for the empty string.
+// Safe to use from multiple threads. Lookups of already interned strings only take a shared lock.
+class symbol_interner_t {
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> storage; // `std::deque` never moves its elements, so the views below stay valid as it grows
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    std::vector<std::string_view> texts; // indexed by symbol ID
+
+public:
+    symbol_interner_t() {
+        intern("");
+    }
+    symbol_interner_t(const symbol_interner_t&) = delete;
+    symbol_interner_t& operator=(const symbol_interner_t&) = delete;
+
+    symbol_t intern(const std::string_view text) {
+        return intern_with_text(text).first;
+    }
+    // Also returns the interner's own copy of the text, which stays valid for as long as the interner does.
+    std::pair<symbol_t, std::string_view> intern_with_text(const std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            const auto id_iter = ids.find(text);
+            if(id_iter != std::end(ids)) {
+                return {symbol_t{id_iter->second}, id_iter->first};
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        const auto id_iter = ids.find(text); // another thread may have interned it in between the locks
+        if(id_iter != std::end(ids)) {
+            return {symbol_t{id_iter->second}, id_iter->first};
+        }
+        const auto id = static_cast<std::uint32_t>(texts.size());
+        const std::string_view stored_text = storage.emplace_back(text);
+        ids.insert({stored_text, id});
+        texts.push_back(stored_text);
+        return {symbol_t{id}, stored_text};
+    }
+
+    std::string_view text(const symbol_t symbol) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return texts.at(symbol.get_id());
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return texts.size();
+    }
+};
+
+// The interner shared by every `symbol_t`.
+symbol_interner_t& get_symbol_interner();
+
+// Interns `text` into the global symbol interner.
+// Identifiers repeat a lot, so recently interned texts are cached per thread and hits don't have to take the interner's lock.
+symbol_t intern(std::string_view text);
+}
+
+namespace std {
+template<>
+struct hash<utils::symbol_t> {
+    std::size_t operator()(const utils::symbol_t symbol) const noexcept {
+        return symbol.get_id();
+    }
+};
+}
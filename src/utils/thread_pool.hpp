@@ -0,0 +1,90 @@
+#pragma once
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace utils {
+// Fixed size pool of worker threads that run tasks in FIFO order.
+// Tasks are `submit()`ted as callables and their results (or exceptions) are handed back through a `std::future`.
+// The destructor finishes all of the queued tasks before joining the workers.
+class thread_pool_t {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_available;
+    bool is_stopping = false;
+
+    void run_worker() {
+        for(;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(tasks_mutex);
+                tasks_available.wait(lock, [this]() { return is_stopping || !tasks.empty(); });
+                if(tasks.empty()) {
+                    return; // only reachable once we are stopping
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    // `0` threads uses one thread per hardware thread
+    explicit thread_pool_t(std::uint32_t thread_count = 0u) {
+        if(thread_count == 0u) {
+            thread_count = hardware_thread_count();
+        }
+        workers.reserve(thread_count);
+        for(std::uint32_t i = 0u; i < thread_count; ++i) {
+            workers.emplace_back([this]() { run_worker(); });
+        }
+    }
+    thread_pool_t(const thread_pool_t&) = delete;
+    thread_pool_t& operator=(const thread_pool_t&) = delete;
+    ~thread_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            is_stopping = true;
+        }
+        tasks_available.notify_all();
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    static std::uint32_t hardware_thread_count() {
+        const auto count = std::thread::hardware_concurrency();
+        return (count == 0u) ? 1u : count; // `0` means it is unknown
+    }
+
+    std::uint32_t thread_count() const {
+        return static_cast<std::uint32_t>(workers.size());
+    }
+
+    template<typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& function) {
+        // `std::function` must be copyable, `std::packaged_task` isn't, so it is shared instead
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<std::decay_t<F>>()>>(std::forward<F>(function));
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        tasks_available.notify_one();
+        return result;
+    }
+};
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <backend/x86_64/elf_writer.hpp>
+#include <utils/result.hpp>
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// Differential tests of the calling convention against gcc: an object file that `foo_cc` generated is linked with C that gcc compiled, and each calls the
+//  other with structs of every SysV class, which only works if both pass them the same way.
+namespace {
+
+// the structs both sides are compiled with, one of each way of passing a struct
+constexpr std::string_view STRUCTS =
+    "typedef struct ints_t { int a; int b; int c; } ints_t;\n" // 12 bytes, INTEGER INTEGER
+    "typedef struct chars_t { char a; char b; char c; } chars_t;\n" // 3 bytes, INTEGER
+    "typedef struct mixed_t { double d; long l; } mixed_t;\n" // SSE INTEGER
+    "typedef struct floats_t { float x; float y; double z; } floats_t;\n" // SSE SSE
+    "typedef struct nested_t { struct floats_t f; } nested_t;\n" // SSE SSE, the same as what it nests
+    "typedef struct big_t { long a; long b; long c; } big_t;\n"; // MEMORY
+
+// compiled by `foo_cc`: functions for the C to call, and a function that calls the C
+constexpr std::string_view FOO_CC_PROGRAM =
+    "mixed_t c_mixed(ints_t v, floats_t w);\n"
+    "big_t c_big(chars_t c, big_t b, nested_t n);\n"
+    "long c_many(long a, long b, long c, long d, long e, mixed_t v, long f);\n"
+    "ints_t foo_ints(ints_t v, int k) { v.a = v.a + k; v.c = v.c * k; return v; }\n"
+    "chars_t foo_chars(chars_t v) { v.b = v.a + v.c; return v; }\n"
+    "mixed_t foo_mixed(double x, mixed_t v) { v.d = v.d * x; v.l = v.l - 1; return v; }\n"
+    "floats_t foo_floats(floats_t v, nested_t n) { v.x = v.x + n.f.y; v.z = v.z + n.f.z; return v; }\n"
+    "big_t foo_big(big_t v, floats_t w) { v.a = v.a + v.c; v.b = w.z; return v; }\n"
+    // with 5 integer registers taken, only 1 is left, so `v` goes on the stack and `f` takes the last register
+    "long foo_many(long a, long b, long c, long d, long e, ints_t v, long f) { return a + b + c + d + e + v.a + v.b + v.c + f; }\n"
+    "long foo_calls_c() {\n"
+    "    ints_t i; i.a = 1; i.b = 2; i.c = 3;\n"
+    "    floats_t f; f.x = 1.5; f.y = 2.5; f.z = 4.0;\n"
+    "    mixed_t m = c_mixed(i, f);\n"
+    "    if(m.d != 10.0) { return 1; }\n"
+    "    if(m.l != 6) { return 2; }\n"
+    "    chars_t c; c.a = 1; c.b = 2; c.c = 3;\n"
+    "    big_t b; b.a = 10; b.b = 20; b.c = 30;\n"
+    "    nested_t n; n.f.x = 1.5; n.f.y = 2.5; n.f.z = 4.0;\n"
+    "    big_t r = c_big(c, b, n);\n"
+    "    if(r.a != 16) { return 3; }\n"
+    "    if(r.b != 21) { return 4; }\n"
+    "    if(r.c != 34) { return 5; }\n"
+    "    mixed_t v; v.d = 0.5; v.l = 100;\n"
+    "    if(c_many(1, 2, 3, 4, 5, v, 6) != 121) { return 6; }\n"
+    "    return 0;\n"
+    "}\n";
+
+// compiled by gcc: the functions `foo_cc` calls, and `main()`, which calls `foo_cc` and exits with the number of the first check that failed
+constexpr std::string_view C_PROGRAM =
+    "mixed_t c_mixed(ints_t v, floats_t w) { mixed_t m = {w.x + w.y + w.z + 2.0, v.a + v.b + v.c}; return m; }\n"
+    "big_t c_big(chars_t c, big_t b, nested_t n) { big_t r = {b.a + c.a + c.b + c.c, b.b + c.a, b.c + (long)n.f.z}; return r; }\n"
+    "long c_many(long a, long b, long c, long d, long e, mixed_t v, long f) { return a + b + c + d + e + f + v.l; }\n"
+    "ints_t foo_ints(ints_t v, int k);\n"
+    "chars_t foo_chars(chars_t v);\n"
+    "mixed_t foo_mixed(double x, mixed_t v);\n"
+    "floats_t foo_floats(floats_t v, nested_t n);\n"
+    "big_t foo_big(big_t v, floats_t w);\n"
+    "long foo_many(long a, long b, long c, long d, long e, ints_t v, long f);\n"
+    "long foo_calls_c(void);\n"
+    "int main(void) {\n"
+    "    ints_t i = foo_ints((ints_t){1, 2, 3}, 5);\n"
+    "    if(i.a != 6 || i.b != 2 || i.c != 15) return 11;\n"
+    "    chars_t c = foo_chars((chars_t){1, 2, 3});\n"
+    "    if(c.a != 1 || c.b != 4 || c.c != 3) return 12;\n"
+    "    mixed_t m = foo_mixed(3.0, (mixed_t){1.5, 7});\n"
+    "    if(m.d != 4.5 || m.l != 6) return 13;\n"
+    "    floats_t f = foo_floats((floats_t){1.0f, 2.0f, 3.0}, (nested_t){{4.0f, 5.0f, 6.0}});\n"
+    "    if(f.x != 6.0f || f.y != 2.0f || f.z != 9.0) return 14;\n"
+    "    big_t b = foo_big((big_t){1, 2, 3}, (floats_t){0.0f, 0.0f, 8.0});\n"
+    "    if(b.a != 4 || b.b != 8 || b.c != 3) return 15;\n"
+    "    if(foo_many(1, 2, 3, 4, 5, (ints_t){10, 20, 30}, 40) != 115) return 16;\n"
+    "    return (int)foo_calls_c();\n"
+    "}\n";
+
+std::string compile_to_object(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    return generate_object(lower_to_ir(program.value()));
+}
+
+
+TEST(calling_convention, structs_are_passed_as_gcc_passes_them) {
+    if(std::system("gcc --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "no gcc to compare with";
+    }
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("calling_convention_test_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path object_path = directory / "foo_cc.o";
+    const std::filesystem::path c_path = directory / "main.c";
+    const std::filesystem::path executable_path = directory / "main";
+    std::ofstream(object_path, std::ios::binary) << compile_to_object(std::string(STRUCTS) + std::string(FOO_CC_PROGRAM));
+    std::ofstream(c_path) << STRUCTS << C_PROGRAM;
+
+    const std::string link_command = "gcc -o " + executable_path.string() + " " + c_path.string() + " " + object_path.string();
+    ASSERT_EQ(std::system(link_command.c_str()), 0);
+    const int status = std::system(executable_path.string().c_str());
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0); // 1 to 6: a call from `foo_cc` to gcc went wrong, 11 to 16: a call from gcc to `foo_cc`
+    std::filesystem::remove_all(directory);
+}
+
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include <backend/interpreter/compile_time_evaluator.hpp>
+#include <frontend/ast/ast.hpp>
+#include <utils/result.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <variant>
+
+namespace {
+
+template<typename T>
+T evaluate_binary(const ast::constant_t& left, const ast::constant_t& right, const ast::binary_operator_token_t operator_token) {
+    utils::diagnostics_t diagnostics;
+    const auto result = evaluate_binary_expression(left, right, operator_token, diagnostics);
+    EXPECT_TRUE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<T>(result.value().value));
+    return std::get<T>(result.value().value);
+}
+
+
+TEST(compile_time_evaluator, converts_operands_to_their_common_type) {
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{char{100}}, ast::constant_t{char{100}}, ast::binary_operator_token_t::PLUS), 200); // promoted to `int`
+    EXPECT_EQ(evaluate_binary<unsigned int>(ast::constant_t{-1}, ast::constant_t{1u}, ast::binary_operator_token_t::PLUS), 0u);
+    EXPECT_EQ(evaluate_binary<long>(ast::constant_t{-1L}, ast::constant_t{1u}, ast::binary_operator_token_t::PLUS), 0L);
+    EXPECT_EQ(evaluate_binary<unsigned long long>(ast::constant_t{-1LL}, ast::constant_t{1UL}, ast::binary_operator_token_t::MINUS), std::numeric_limits<unsigned long long>::max() - 1u);
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{-1}, ast::constant_t{1u}, ast::binary_operator_token_t::LESS_THAN), 0); // `-1` becomes `UINT_MAX`
+    EXPECT_EQ(evaluate_binary<float>(ast::constant_t{3}, ast::constant_t{0.5f}, ast::binary_operator_token_t::MULTIPLY), 1.5f);
+    EXPECT_EQ(evaluate_binary<double>(ast::constant_t{1.0f}, ast::constant_t{0.25}, ast::binary_operator_token_t::DIVIDE), 4.0);
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{0.5}, ast::constant_t{2}, ast::binary_operator_token_t::LOGICAL_AND), 1);
+    EXPECT_EQ(evaluate_binary<double>(ast::constant_t{1}, ast::constant_t{2.5}, ast::binary_operator_token_t::COMMA), 2.5);
+}
+
+TEST(compile_time_evaluator, wraps_around_to_the_width_of_the_result) {
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{std::numeric_limits<int>::max()}, ast::constant_t{1}, ast::binary_operator_token_t::PLUS), std::numeric_limits<int>::min());
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{std::numeric_limits<int>::min()}, ast::constant_t{-1}, ast::binary_operator_token_t::DIVIDE), std::numeric_limits<int>::min());
+    EXPECT_EQ(evaluate_binary<long>(ast::constant_t{std::numeric_limits<long>::min()}, ast::constant_t{-1L}, ast::binary_operator_token_t::MODULO), 0L);
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{1}, ast::constant_t{31}, ast::binary_operator_token_t::LEFT_BITSHIFT), std::numeric_limits<int>::min());
+    EXPECT_EQ(evaluate_binary<int>(ast::constant_t{-16}, ast::constant_t{2L}, ast::binary_operator_token_t::RIGHT_BITSHIFT), -4); // the type of the left operand
+    EXPECT_EQ(evaluate_binary<unsigned int>(ast::constant_t{0x80000000u}, ast::constant_t{31}, ast::binary_operator_token_t::RIGHT_BITSHIFT), 1u);
+
+    utils::diagnostics_t diagnostics;
+    const auto negated = evaluate_unary_expression(ast::constant_t{std::numeric_limits<long long>::min()}, ast::unary_operator_token_t::MINUS, diagnostics);
+    ASSERT_TRUE(negated.has_value());
+    EXPECT_EQ(std::get<long long>(negated.value().value), std::numeric_limits<long long>::min());
+    const auto complemented = evaluate_unary_expression(ast::constant_t{static_cast<unsigned char>(0u)}, ast::unary_operator_token_t::BITWISE_NOT, diagnostics);
+    ASSERT_TRUE(complemented.has_value());
+    EXPECT_EQ(std::get<int>(complemented.value().value), -1);
+}
+
+TEST(compile_time_evaluator, reports_undefined_operations) {
+    utils::diagnostics_t diagnostics;
+    EXPECT_FALSE(evaluate_binary_expression(ast::constant_t{1}, ast::constant_t{0}, ast::binary_operator_token_t::DIVIDE, diagnostics).has_value());
+    EXPECT_FALSE(evaluate_binary_expression(ast::constant_t{1.0}, ast::constant_t{0}, ast::binary_operator_token_t::DIVIDE, diagnostics).has_value());
+    EXPECT_FALSE(evaluate_binary_expression(ast::constant_t{1}, ast::constant_t{32}, ast::binary_operator_token_t::LEFT_BITSHIFT, diagnostics).has_value());
+    EXPECT_FALSE(evaluate_binary_expression(ast::constant_t{1}, ast::constant_t{-1}, ast::binary_operator_token_t::RIGHT_BITSHIFT, diagnostics).has_value());
+    EXPECT_FALSE(evaluate_binary_expression(ast::constant_t{1.0}, ast::constant_t{1}, ast::binary_operator_token_t::MODULO, diagnostics).has_value());
+    EXPECT_FALSE(evaluate_unary_expression(ast::constant_t{1.0f}, ast::unary_operator_token_t::BITWISE_NOT, diagnostics).has_value());
+    EXPECT_EQ(diagnostics.get_diagnostics().size(), 6u);
+}
+
+TEST(compile_time_evaluator, converts_constants_to_primitive_types) {
+    utils::diagnostics_t diagnostics;
+    const auto to_type = [&diagnostics](const ast::constant_t& constant, const ast::type_name_t& type_name) {
+        return evaluate_convert_expression(constant, make_primitive_type_t(ast::type_category_t::INT, type_name, 0u, 0u), diagnostics);
+    };
+    EXPECT_EQ(std::get<char>(to_type(ast::constant_t{300}, ast::primitive_type_names::CHAR).value().value), char{44});
+    EXPECT_EQ(std::get<unsigned short>(to_type(ast::constant_t{-1}, ast::primitive_type_names::UNSIGNED_SHORT).value().value), 65535u);
+    EXPECT_EQ(std::get<long>(to_type(ast::constant_t{-3.9}, ast::primitive_type_names::LONG).value().value), -3L);
+    EXPECT_EQ(std::get<float>(to_type(ast::constant_t{16777217LL}, ast::primitive_type_names::FLOAT).value().value), 16777216.0f);
+    EXPECT_EQ(std::get<unsigned long>(to_type(ast::constant_t{18446744073709549568.0}, ast::primitive_type_names::UNSIGNED_LONG).value().value), 18446744073709549568u);
+
+    EXPECT_FALSE(to_type(ast::constant_t{256.0}, ast::primitive_type_names::UNSIGNED_CHAR).has_value());
+    EXPECT_FALSE(to_type(ast::constant_t{-1.0}, ast::primitive_type_names::UNSIGNED_INT).has_value());
+    EXPECT_FALSE(to_type(ast::constant_t{std::numeric_limits<double>::quiet_NaN()}, ast::primitive_type_names::INT).has_value());
+    EXPECT_TRUE(to_type(ast::constant_t{-0.5}, ast::primitive_type_names::UNSIGNED_INT).has_value());
+}
+
+TEST(compile_time_evaluator, evaluates_expression_trees_in_tagged_values) {
+    // `((char)100 + (char)100) * 0.5f == 100L`, converted from `ast::constant_t` at the leaves and back at the root only
+    utils::diagnostics_t diagnostics;
+    const constant_value_t sum = evaluate_binary_operator(to_constant_value(ast::constant_t{char{100}}), to_constant_value(ast::constant_t{char{100}}), ast::binary_operator_token_t::PLUS, diagnostics).value();
+    EXPECT_EQ(sum.kind, constant_kind_t::INT);
+    const constant_value_t product = evaluate_binary_operator(sum, to_constant_value(ast::constant_t{0.5f}), ast::binary_operator_token_t::MULTIPLY, diagnostics).value();
+    EXPECT_EQ(product.kind, constant_kind_t::FLOAT);
+    const constant_value_t comparison = evaluate_binary_operator(product, to_constant_value(ast::constant_t{100L}), ast::binary_operator_token_t::EQUAL, diagnostics).value();
+    EXPECT_EQ(std::get<int>(to_constant(comparison).value), 1);
+
+    EXPECT_EQ(std::get<unsigned char>(to_constant(convert_constant_value(sum, constant_kind_t::UNSIGNED_CHAR, diagnostics).value()).value), 200u);
+    EXPECT_FALSE(convert_constant_value(to_constant_value(ast::constant_t{1e10}), constant_kind_t::INT, diagnostics).has_value());
+    EXPECT_EQ(diagnostics.get_diagnostics().size(), 1u);
+}
+
+}
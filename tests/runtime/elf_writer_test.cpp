@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <backend/x86_64/elf_writer.hpp>
+#include <utils/result.hpp>
+
+#include <elf.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace {
+
+std::string compile(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    return generate_object(lower_to_ir(program.value()));
+}
+
+template<typename T>
+T read(const std::string& object, const std::size_t offset) {
+    T value;
+    std::memcpy(&value, object.data() + offset, sizeof(value));
+    return value;
+}
+Elf64_Shdr get_section(const std::string& object, const std::size_t index) {
+    const auto header = read<Elf64_Ehdr>(object, 0u);
+    return read<Elf64_Shdr>(object, header.e_shoff + index * sizeof(Elf64_Shdr));
+}
+const char* get_string(const std::string& object, const Elf64_Shdr& string_table, const Elf64_Word offset) {
+    return object.data() + string_table.sh_offset + offset;
+}
+
+
+TEST(elf_writer, writes_a_relocatable_object) {
+    const std::string object = compile(
+        "int putchar(int c);\n"
+        "long counter = 7;\n"
+        "int zero;\n"
+        "long zero_too;\n"
+        "int f() { return putchar(counter); }\n"
+        "int main() { return f(); }\n");
+
+    const auto header = read<Elf64_Ehdr>(object, 0u);
+    ASSERT_EQ(std::memcmp(header.e_ident, ELFMAG, SELFMAG), 0);
+    EXPECT_EQ(header.e_ident[EI_CLASS], ELFCLASS64);
+    EXPECT_EQ(header.e_type, ET_REL);
+    EXPECT_EQ(header.e_machine, EM_X86_64);
+    ASSERT_EQ(header.e_shoff + header.e_shnum * sizeof(Elf64_Shdr), object.size());
+
+    std::map<std::string, Elf64_Shdr> sections;
+    const Elf64_Shdr section_names = get_section(object, header.e_shstrndx);
+    for(std::size_t i = 1u; i < header.e_shnum; ++i) {
+        const Elf64_Shdr section = get_section(object, i);
+        sections[get_string(object, section_names, section.sh_name)] = section;
+    }
+    for(const char *const name : {".text", ".data", ".bss", ".rodata", ".rela.text", ".symtab", ".strtab", ".note.GNU-stack"}) {
+        EXPECT_EQ(sections.count(name), 1u) << name;
+    }
+    EXPECT_EQ(sections[".text"].sh_flags, static_cast<Elf64_Xword>(SHF_ALLOC | SHF_EXECINSTR));
+    EXPECT_EQ(sections[".data"].sh_size, 8u);
+    EXPECT_EQ(read<long>(object, sections[".data"].sh_offset), 7);
+    EXPECT_EQ(sections[".bss"].sh_type, static_cast<Elf64_Word>(SHT_NOBITS));
+    EXPECT_EQ(sections[".bss"].sh_size, 16u); // `zero_too` is 8 byte aligned
+
+    // name, section index (or `SHN_UNDEF`)
+    std::map<std::string, Elf64_Section> symbols;
+    const Elf64_Shdr& symbol_table = sections[".symtab"];
+    for(std::size_t offset = sizeof(Elf64_Sym); offset < symbol_table.sh_size; offset += sizeof(Elf64_Sym)) {
+        const auto symbol = read<Elf64_Sym>(object, symbol_table.sh_offset + offset);
+        EXPECT_EQ(ELF64_ST_BIND(symbol.st_info), STB_GLOBAL);
+        symbols[get_string(object, sections[".strtab"], symbol.st_name)] = symbol.st_shndx;
+    }
+    EXPECT_EQ(symbols.size(), 6u);
+    EXPECT_EQ(get_section(object, symbols["main"]).sh_offset, sections[".text"].sh_offset);
+    EXPECT_EQ(get_section(object, symbols["counter"]).sh_offset, sections[".data"].sh_offset);
+    EXPECT_EQ(get_section(object, symbols["zero_too"]).sh_type, static_cast<Elf64_Word>(SHT_NOBITS));
+    EXPECT_EQ(symbols["putchar"], SHN_UNDEF);
+
+    // `putchar()`, `counter` and `f()`
+    const Elf64_Shdr& relocations = sections[".rela.text"];
+    ASSERT_EQ(relocations.sh_size, 3u * sizeof(Elf64_Rela));
+    std::map<Elf64_Xword, int> relocation_types;
+    for(std::size_t offset = 0u; offset < relocations.sh_size; offset += sizeof(Elf64_Rela)) {
+        const auto relocation = read<Elf64_Rela>(object, relocations.sh_offset + offset);
+        EXPECT_EQ(relocation.r_addend, -4);
+        ++relocation_types[ELF64_R_TYPE(relocation.r_info)];
+    }
+    EXPECT_EQ(relocation_types[R_X86_64_PLT32], 2);
+    EXPECT_EQ(relocation_types[R_X86_64_PC32], 1);
+}
+
+}
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <middle_end/optimization/fold_constants.hpp>
+#include <middle_end/ir/ir.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <middle_end/ir/verifier.hpp>
+#include <utils/result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace {
+
+// the program's IR after folding, which is easier to check than the AST
+ir::module_t fold_and_lower(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    fold_constants(program.value());
+    ir::module_t module = lower_to_ir(program.value());
+    EXPECT_TRUE(verify_module(module, diagnostics).has_value());
+    return module;
+}
+const ir::function_t& find_function(const ir::module_t& module, const std::string_view name) {
+    return *std::find_if(std::begin(module.functions), std::end(module.functions), [name](const ir::function_t& function) { return function.name.text() == name; });
+}
+std::size_t count_opcode(const ir::function_t& function, const ir::opcode_t opcode) {
+    std::size_t count = 0u;
+    for(const auto& block : function.blocks) {
+        for(const ir::value_t value : block.instructions) {
+            count += (function.get(value).opcode == opcode) ? 1u : 0u;
+        }
+    }
+    return count;
+}
+bool has_constant(const ir::function_t& function, const ir::type_t type, const std::uint64_t bits) {
+    for(const auto& block : function.blocks) {
+        for(const ir::value_t value : block.instructions) {
+            const ir::instruction_t& instruction = function.get(value);
+            if(instruction.opcode == ir::opcode_t::CONST && instruction.type == type && instruction.immediate == bits) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+TEST(fold_constants, folds_constant_subexpressions_around_variables) {
+    const ir::module_t module = fold_and_lower("int main() { int x = 1; return 3 * 4 + x - (2 - 1 == 1); }\n");
+    const ir::function_t& main_function = module.functions.front();
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::MUL), 0u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::EQ), 0u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::ADD), 1u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::SUB), 1u);
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::I32, 12u));
+}
+
+TEST(fold_constants, wraps_around_to_the_width_of_the_type) {
+    const ir::module_t module = fold_and_lower(
+        "int main() { char c = 300; unsigned char u = -1; int i = 2147483647 + 1; long l = 2147483647 + 1; float f = 1 / 4.0; return 0; }\n");
+    const ir::function_t& main_function = module.functions.front();
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::TRUNC), 0u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::SEXT), 0u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::ADD), 0u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::FDIV), 0u);
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::I8, 44u));
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::I8, 255u));
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::I32, 0xffffffff80000000u)); // the immediates of signed constants are sign extended
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::I64, 0xffffffff80000000u)); // the `int` sum wraps before it is widened
+    EXPECT_TRUE(has_constant(main_function, ir::type_t::F32, 0x3e800000u)); // 0.25f
+}
+
+TEST(fold_constants, keeps_side_effects) {
+    const ir::module_t module = fold_and_lower(
+        "int g = 0;\n"
+        "int f() { g = g + 1; return 2; }\n"
+        "int main() { int a = (f(), 1); int b = 0 && f(); int c = 1 ? 2 : f(); int d = 1 && f(); return a + b + c + d; }\n");
+    const ir::function_t& main_function = find_function(module, "main");
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::CALL), 2u); // the `,` and the `&&` whose left operand doesn't decide it
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::PHI), 1u);
+}
+
+TEST(fold_constants, leaves_undefined_operations_to_run) {
+    const ir::module_t module = fold_and_lower("int main() { int a = 1 / 0; int b = (-2147483647 - 1) / -1; int c = 1 << 40; return a + b + c; }\n");
+    const ir::function_t& main_function = module.functions.front();
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::SDIV), 2u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::SHL), 1u);
+}
+
+}
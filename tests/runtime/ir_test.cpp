@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <middle_end/ir/ir.hpp>
+#include <middle_end/ir/ir_printer.hpp>
+#include <middle_end/ir/lower_ast.hpp>
+#include <middle_end/ir/verifier.hpp>
+#include <utils/result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace {
+
+ir::module_t lower(const std::string_view text) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    return lower_to_ir(program.value());
+}
+const ir::function_t& find_function(const ir::module_t& module, const std::string_view name) {
+    return *std::find_if(std::begin(module.functions), std::end(module.functions), [name](const ir::function_t& function) { return function.name.text() == name; });
+}
+std::size_t count_opcode(const ir::function_t& function, const ir::opcode_t opcode) {
+    std::size_t count = 0u;
+    for(const auto& block : function.blocks) {
+        for(const ir::value_t value : block.instructions) {
+            count += (function.get(value).opcode == opcode) ? 1u : 0u;
+        }
+    }
+    return count;
+}
+bool verifies(const ir::function_t& function) {
+    utils::diagnostics_t diagnostics;
+    return verify_function(function, diagnostics).has_value();
+}
+
+TEST(ir_lowering, locals_are_allocas_with_explicit_loads_and_stores) {
+    const ir::module_t module = lower("int main() { int a = 2; { long a = 3; } return a; }\n");
+    ASSERT_EQ(module.functions.size(), 1u);
+    const ir::function_t& main_function = module.functions.front();
+    EXPECT_TRUE(verifies(main_function));
+    EXPECT_EQ(main_function.return_type, ir::type_t::I32);
+
+    // both `a`s get their own alloca in the entry block
+    std::size_t entry_allocas = 0u;
+    for(const ir::value_t value : main_function.blocks[0].instructions) {
+        entry_allocas += (main_function.get(value).opcode == ir::opcode_t::ALLOCA) ? 1u : 0u;
+    }
+    EXPECT_EQ(entry_allocas, 2u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::ALLOCA), 2u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::STORE), 2u);
+
+    // `return a` loads the outer `a`, an `i32`
+    const ir::instruction_t& ret = *main_function.terminator(static_cast<ir::block_id_t>(main_function.blocks.size() - 1u));
+    ASSERT_EQ(ret.opcode, ir::opcode_t::RET);
+    const ir::instruction_t& load = main_function.get(ret.operands[0]);
+    EXPECT_EQ(load.opcode, ir::opcode_t::LOAD);
+    EXPECT_EQ(load.type, ir::type_t::I32);
+    EXPECT_EQ(main_function.get(load.operands[0]).immediate, 4u);
+}
+
+TEST(ir_lowering, control_flow_merges_values_with_phis) {
+    const ir::module_t module = lower(
+        "long g = 3;\n"
+        "int f(int a, int b) { int c = a > b ? a : b; if(c) { return c && g; } return c || b; }\n"
+        "int main() { return f(1, 2); }\n");
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(verify_module(module, diagnostics).has_value());
+
+    const ir::function_t& f = find_function(module, "f");
+    EXPECT_EQ(count_opcode(f, ir::opcode_t::PHI), 3u);
+    EXPECT_EQ(count_opcode(f, ir::opcode_t::RET), 2u);
+    EXPECT_EQ(f.param_types, (std::vector<ir::type_t>{ir::type_t::I32, ir::type_t::I32}));
+    EXPECT_EQ(count_opcode(f, ir::opcode_t::GLOBAL_ADDRESS), 1u);
+
+    ASSERT_EQ(module.globals.size(), 1u);
+    EXPECT_EQ(module.globals[0].size, 8u);
+    EXPECT_EQ(module.globals[0].initializer, (std::vector<std::byte>{std::byte{3}, std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0}}));
+}
+
+TEST(ir_lowering, code_after_return_is_removed) {
+    const ir::module_t module = lower("int main() { return 1; int a = 2; a = a + 1; return a; }\n");
+    const ir::function_t& main_function = module.functions.front();
+    EXPECT_TRUE(verifies(main_function));
+    EXPECT_EQ(main_function.blocks.size(), 2u); // the entry block and the body up to the first return
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::RET), 1u);
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::ADD), 0u);
+}
+
+TEST(ir_lowering, structs_are_passed_and_returned_through_pointers) {
+    const ir::module_t module = lower(
+        "typedef struct point_t { int x; long y; } point_t;\n"
+        "point_t flip(point_t p) { long x = p.x; p.x = p.y; p.y = x; return p; }\n"
+        "int main() { point_t p; p.x = 1; p.y = 2; point_t q = flip(p); return q.x; }\n");
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(verify_module(module, diagnostics).has_value());
+
+    const ir::function_t& flip = find_function(module, "flip");
+    EXPECT_EQ(flip.return_type, ir::type_t::VOID);
+    EXPECT_EQ(flip.param_types, (std::vector<ir::type_t>{ir::type_t::PTR, ir::type_t::PTR})); // where to return to, then the argument
+    EXPECT_EQ(count_opcode(flip, ir::opcode_t::COPY), 1u);
+    EXPECT_EQ(count_opcode(flip, ir::opcode_t::SEXT), 1u);
+    EXPECT_EQ(count_opcode(flip, ir::opcode_t::TRUNC), 1u);
+
+    const ir::function_t& main_function = find_function(module, "main");
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::COPY), 2u); // the copy of the argument, and `q = `
+    EXPECT_EQ(count_opcode(main_function, ir::opcode_t::PTR_OFFSET), 1u); // only `p.y`, `x` is at offset 0
+}
+
+TEST(ir_lowering, structs_are_classified_as_the_sysv_abi_passes_them) {
+    const ir::module_t module = lower(
+        "typedef struct mixed_t { float x; float y; int z; } mixed_t;\n"
+        "typedef struct big_t { double a; double b; double c; } big_t;\n"
+        "typedef struct wide_t { long double d; } wide_t;\n"
+        "big_t f(mixed_t m, int i, wide_t w) { big_t b; b.a = m.x; return b; }\n"
+        "int main() { mixed_t m; wide_t w; big_t b = f(m, 1, w); return 0; }\n");
+    utils::diagnostics_t diagnostics;
+    EXPECT_TRUE(verify_module(module, diagnostics).has_value());
+
+    const ir::function_t& f = find_function(module, "f");
+    EXPECT_TRUE(f.struct_return.is_in_memory); // more than 16 bytes
+    ASSERT_EQ(f.param_structs.size(), 4u); // where to return to, then the arguments
+    EXPECT_FALSE(f.param_structs[0].is_struct);
+    const ir::struct_passing_t& mixed = f.param_structs[1];
+    EXPECT_TRUE(mixed.is_struct && !mixed.is_in_memory);
+    EXPECT_EQ(mixed.eightbyte_count, 2u);
+    EXPECT_TRUE(mixed.is_sse[0]); // `x` and `y`
+    EXPECT_FALSE(mixed.is_sse[1]); // `z`
+    EXPECT_FALSE(f.param_structs[2].is_struct);
+    EXPECT_TRUE(f.param_structs[3].is_in_memory); // has a `long double` in it
+
+    const ir::function_t& main_function = find_function(module, "main");
+    ASSERT_EQ(count_opcode(main_function, ir::opcode_t::CALL), 1u);
+    for(const ir::instruction_t& instruction : main_function.instructions) {
+        if(instruction.opcode == ir::opcode_t::CALL) { // the call is classified as the function is
+            EXPECT_TRUE(instruction.struct_return.is_in_memory);
+            ASSERT_EQ(instruction.struct_arguments.size(), 4u);
+            EXPECT_EQ(instruction.struct_arguments[1].eightbyte_count, 2u);
+            EXPECT_TRUE(instruction.struct_arguments[3].is_in_memory);
+        }
+    }
+}
+
+TEST(ir_printer, prints_blocks_and_typed_values) {
+    const ir::module_t module = lower("int main() { int a = 2; return a ? a : 3; }\n");
+    testing::internal::CaptureStdout();
+    print_ir_module(module);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+        "function i32 @main() {\n"
+        "bb0:\n"
+        "  %0 = alloca ptr 4, align 4\n"
+        "  jump bb1\n"
+        "bb1:\n"
+        "  %2 = const i32 2\n"
+        "  store %2, %0\n"
+        "  %4 = load i32 %0\n"
+        "  %5 = const i32 0\n"
+        "  %6 = ne i32 %4, %5\n"
+        "  branch %6, bb2, bb3\n"
+        "bb2:\n"
+        "  %8 = load i32 %0\n"
+        "  jump bb4\n"
+        "bb3:\n"
+        "  %10 = const i32 3\n"
+        "  jump bb4\n"
+        "bb4:\n"
+        "  %12 = phi i32 [%8, bb2], [%10, bb3]\n"
+        "  ret %12\n"
+        "}\n");
+}
+
+// bb0: `%0 = const i32 1`, `branch %0, bb1, bb2`
+// bb1: `%2 = const i32 2`, `jump bb3`
+// bb2: `jump bb3`
+// bb3: `%5 = phi i32 [%2, bb1], [%0, bb2]`, `ret %5`
+// which the tests below break in different ways.
+ir::function_t make_diamond() {
+    ir::function_t function;
+    function.name = utils::symbol_t{"diamond"};
+    function.return_type = ir::type_t::I32;
+    for(int i = 0; i < 4; ++i) {
+        function.add_block();
+    }
+    ir::instruction_t one{ir::opcode_t::CONST, ir::type_t::I32, {}, {}};
+    one.immediate = 1u;
+    function.append(0u, one);
+    function.append(0u, ir::instruction_t{ir::opcode_t::BRANCH, ir::type_t::VOID, {0u}, {1u, 2u}});
+    ir::instruction_t two{ir::opcode_t::CONST, ir::type_t::I32, {}, {}};
+    two.immediate = 2u;
+    function.append(1u, two);
+    function.append(1u, ir::instruction_t{ir::opcode_t::JUMP, ir::type_t::VOID, {}, {3u}});
+    function.append(2u, ir::instruction_t{ir::opcode_t::JUMP, ir::type_t::VOID, {}, {3u}});
+    function.append(3u, ir::instruction_t{ir::opcode_t::PHI, ir::type_t::I32, {2u, 0u}, {1u, 2u}});
+    function.append(3u, ir::instruction_t{ir::opcode_t::RET, ir::type_t::VOID, {5u}, {}});
+    return function;
+}
+
+TEST(ir_verifier, accepts_well_formed_functions) {
+    EXPECT_TRUE(verifies(make_diamond()));
+}
+
+TEST(ir_verifier, rejects_uses_that_their_definition_does_not_dominate) {
+    ir::function_t function = make_diamond();
+    function.instructions[6].operands = {2u}; // `%2` is only defined if control went through bb1
+    EXPECT_FALSE(verifies(function));
+
+    ir::function_t missing_incoming_value = make_diamond();
+    missing_incoming_value.instructions[5].operands.pop_back();
+    missing_incoming_value.instructions[5].targets.pop_back();
+    EXPECT_FALSE(verifies(missing_incoming_value));
+}
+
+TEST(ir_verifier, rejects_malformed_blocks_and_mistyped_operands) {
+    ir::function_t missing_terminator = make_diamond();
+    missing_terminator.blocks[1].instructions.pop_back();
+    EXPECT_FALSE(verifies(missing_terminator));
+
+    ir::function_t phi_after_instruction = make_diamond();
+    std::swap(phi_after_instruction.blocks[3].instructions[0], phi_after_instruction.blocks[3].instructions[1]);
+    EXPECT_FALSE(verifies(phi_after_instruction));
+
+    ir::function_t wrong_return_type = make_diamond();
+    wrong_return_type.return_type = ir::type_t::I64;
+    EXPECT_FALSE(verifies(wrong_return_type));
+
+    ir::function_t mistyped_add = make_diamond();
+    ir::instruction_t wide{ir::opcode_t::CONST, ir::type_t::I64, {}, {}};
+    mistyped_add.append(1u, wide);
+    mistyped_add.append(1u, ir::instruction_t{ir::opcode_t::ADD, ir::type_t::I32, {2u, 7u}, {}});
+    auto& instructions = mistyped_add.blocks[1].instructions;
+    std::rotate(std::begin(instructions) + 1, std::begin(instructions) + 2, std::end(instructions)); // move the jump back to the end
+    EXPECT_FALSE(verifies(mistyped_add));
+    mistyped_add.instructions[7].type = ir::type_t::I32;
+    EXPECT_TRUE(verifies(mistyped_add));
+}
+
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <backend/x86_64/encoder.hpp>
+#include <backend/x86_64/jit.hpp>
+#include <utils/result.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+utils::result_t<int> run(const std::string_view text, utils::diagnostics_t& diagnostics) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    return run_program_natively(program.value(), diagnostics);
+}
+int run(const std::string_view text) {
+    utils::diagnostics_t diagnostics;
+    const auto exit_code = run(text, diagnostics);
+    EXPECT_TRUE(exit_code.has_value());
+    return exit_code.has_value() ? exit_code.value() : -1;
+}
+
+std::vector<std::uint8_t> encode(const std::vector<x86_64::instruction_t>& instructions) {
+    return encode_function(x86_64::function_t{utils::symbol_t("f"), 1u, instructions}).code;
+}
+
+
+TEST(jit, encodes_instructions_as_gas_does) {
+    const x86_64::operand_t rax = x86_64::make_register(x86_64::register_t::RAX);
+    const x86_64::operand_t r9 = x86_64::make_register(x86_64::register_t::R9);
+    const x86_64::operand_t xmm1 = x86_64::make_register(x86_64::register_t::XMM1);
+    const x86_64::operand_t slot = x86_64::make_memory(x86_64::register_t::RBP, -24);
+    EXPECT_EQ(encode({{x86_64::opcode_t::MOV, 8u, x86_64::condition_t::E, 2u, {slot, r9}}}), (std::vector<std::uint8_t>{0x4c, 0x8b, 0x4d, 0xe8})); // movq -24(%rbp), %r9
+    EXPECT_EQ(encode({{x86_64::opcode_t::MOVQ, 8u, x86_64::condition_t::E, 2u, {xmm1, slot}}}), (std::vector<std::uint8_t>{0x66, 0x0f, 0xd6, 0x4d, 0xe8})); // movq %xmm1, -24(%rbp)
+    EXPECT_EQ(encode({{x86_64::opcode_t::MOVZX, 2u, x86_64::condition_t::E, 2u, {x86_64::make_memory(x86_64::register_t::RAX), x86_64::make_register(x86_64::register_t::RAX, 4u)}}}),
+        (std::vector<std::uint8_t>{0x0f, 0xb7, 0x00})); // movzwl (%rax), %eax
+    EXPECT_EQ(encode({{x86_64::opcode_t::SUB, 8u, x86_64::condition_t::E, 2u, {x86_64::make_immediate(4096), x86_64::make_register(x86_64::register_t::RSP)}}}),
+        (std::vector<std::uint8_t>{0x48, 0x81, 0xec, 0x00, 0x10, 0x00, 0x00})); // subq $4096, %rsp
+    EXPECT_EQ(encode({{x86_64::opcode_t::CVTTF2SI, 4u, x86_64::condition_t::E, 2u, {xmm1, rax}}}), (std::vector<std::uint8_t>{0xf3, 0x48, 0x0f, 0x2c, 0xc1})); // cvttss2siq %xmm1, %rax
+    // jne .Lf_0; .Lf_0:
+    EXPECT_EQ(encode({{x86_64::opcode_t::JCC, 1u, x86_64::condition_t::NE, 1u, {x86_64::make_label(0u)}}, {x86_64::opcode_t::LABEL, 8u, x86_64::condition_t::E, 1u, {x86_64::make_label(0u)}}}),
+        (std::vector<std::uint8_t>{0x0f, 0x85, 0x00, 0x00, 0x00, 0x00}));
+
+    const auto call = encode_function(x86_64::function_t{utils::symbol_t("f"), 0u, {{x86_64::opcode_t::CALL, 8u, x86_64::condition_t::E, 1u, {x86_64::make_function(utils::symbol_t("g"))}}}});
+    ASSERT_EQ(call.relocations.size(), 1u);
+    EXPECT_EQ(call.relocations[0].offset, 1u);
+    EXPECT_EQ(call.relocations[0].addend, -4);
+    EXPECT_EQ(call.relocations[0].symbol, utils::symbol_t("g"));
+}
+
+TEST(jit, runs_main_and_returns_its_exit_code) {
+    EXPECT_EQ(run("int main() { return 42; }\n"), 42);
+    EXPECT_EQ(run(
+        "typedef struct { int x; long y; char c; } point_t;\n"
+        "long g = 5;\n"
+        "unsigned char uc = 200;\n"
+        "float gf = 0.5f;\n"
+        "long area(point_t p) { long a = p.x * p.y; p.x = 1000; return a * g; }\n"
+        "point_t make(int x, long y) { point_t p; p.x = x; p.y = y; p.c = 'q'; return p; }\n"
+        "long many(long a, long b, long c, long d, long e, long f, long h, long i) { return a - b + c - d + e - f + h * i; }\n"
+        "double mixed(int a, double b, long c, float d) { return a + b + c + d; }\n"
+        "int main() {\n"
+        "    point_t p; p.x = 3; p.y = 4;\n"
+        "    if(area(p) != 60 || p.x != 3) { return 1; }\n"
+        "    point_t q = make(7, 9);\n"
+        "    if(q.x + q.y != 16 || q.c != 'q') { return 2; }\n"
+        "    if(many(1, 2, 3, 4, 5, 6, 7, 8) != 53) { return 3; }\n"
+        "    signed char sc = -7;\n"
+        "    if(sc / 2 != -3 || sc % 2 != -1 || (sc >> 1) != -4) { return 4; }\n"
+        "    unsigned int u = 4000000000u;\n"
+        "    if(u / 3u != 1333333333u || (u >> 31) != 1u || u < 1) { return 5; }\n"
+        "    if(uc + 100 != 300) { return 6; }\n"
+        "    short sh = 30000; sh = sh + sh;\n"
+        "    if(sh != -5536) { return 7; }\n"
+        "    double d = 18446744073709551615UL;\n"
+        "    unsigned long back = 17000000000000000000.0;\n"
+        "    if(d < 18000000000000000000.0 || back != 17000000000000000000UL) { return 8; }\n"
+        "    int i = gf * 7;\n"
+        "    if(i != 3 || -gf > 0.0f) { return 9; }\n"
+        "    if(mixed(1, 0.5, 2, 0.25f) != 3.75) { return 10; }\n"
+        "    return 42;\n"
+        "}\n"), 42);
+}
+
+TEST(jit, calls_functions_recursively_and_in_the_process) {
+    EXPECT_EQ(run(
+        "int fibonacci(int n) { return n < 2 ? n : (fibonacci(n - 1) + fibonacci(n - 2)); }\n"
+        "int main() { return fibonacci(20) == 6765; }\n"), 1);
+
+    testing::internal::CaptureStdout();
+    const int exit_code = run("int putchar(int c);\nint main() { putchar(104); putchar(105); return putchar(10); }\n");
+    std::fflush(stdout);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "hi\n");
+    EXPECT_EQ(exit_code, 10);
+}
+
+TEST(jit, reports_what_it_cannot_run) {
+    utils::diagnostics_t diagnostics;
+    EXPECT_FALSE(run("int not_a_libc_function(int n);\nint main() { return not_a_libc_function(1); }\n", diagnostics).has_value());
+    EXPECT_FALSE(run("int f() { return 0; }\n", diagnostics).has_value());
+    ASSERT_EQ(diagnostics.get_diagnostics().size(), 2u);
+    EXPECT_NE(diagnostics.get_diagnostics()[0].message.find("not_a_libc_function"), std::string::npos);
+    EXPECT_NE(diagnostics.get_diagnostics()[1].message.find("No [main] function to run."), std::string::npos);
+}
+
+}
@@ -0,0 +1,339 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/lexeme_tables.hpp>
+#include <frontend/lexing/parallel_lexer.hpp>
+#include <frontend/lexing/scan_kernels.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <io/source_buffer.hpp>
+#include <io/source_manager.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+std::vector<token_type_t> scan_token_types(std::string_view text) {
+    lexer_t lexer(text);
+    const auto tokens = scan_all_tokens(lexer);
+    std::vector<token_type_t> types;
+    for(token_index_t token = 0u; token < tokens.size(); ++token) {
+        types.push_back(tokens.type(token));
+    }
+    return types;
+}
+
+
+TEST(lexer_bounds, empty_input) {
+    EXPECT_EQ(scan_token_types(""), std::vector<token_type_t>{token_type_t::EOF_TOK});
+}
+TEST(lexer_bounds, stops_at_end_without_null_terminator) {
+    // only lex `int x` out of the larger buffer
+    const char text[] = {'i', 'n', 't', ' ', 'x', ';', '}'};
+    lexer_t lexer(text, text + 5);
+    const auto tokens = scan_all_tokens(lexer);
+    ASSERT_EQ(tokens.size(), 3u);
+    EXPECT_EQ(tokens.type(0u), token_type_t::INT_KEYWORD);
+    EXPECT_EQ(tokens.type(1u), token_type_t::IDENTIFIER);
+    EXPECT_EQ(tokens.text(1u), "x");
+    EXPECT_EQ(tokens.offset(1u), 4u);
+    EXPECT_EQ(tokens.type(2u), token_type_t::EOF_TOK);
+}
+TEST(lexer_bounds, two_character_lexeme_at_end) {
+    EXPECT_EQ(scan_token_types("a <"), (std::vector<token_type_t>{token_type_t::IDENTIFIER, token_type_t::LESS_THAN, token_type_t::EOF_TOK}));
+    EXPECT_EQ(scan_token_types("a <="), (std::vector<token_type_t>{token_type_t::IDENTIFIER, token_type_t::LESS_THAN_EQUAL, token_type_t::EOF_TOK}));
+}
+TEST(lexer_bounds, unterminated_comment_at_end) {
+    EXPECT_EQ(scan_token_types("x /* abc *"), (std::vector<token_type_t>{token_type_t::IDENTIFIER, token_type_t::ERROR, token_type_t::EOF_TOK}));
+}
+
+
+
+
+TEST(token_stream, merges_type_specifiers) {
+    EXPECT_EQ(scan_token_types("unsigned long long int x; long y; short int z;"), (std::vector<token_type_t>{
+        token_type_t::UNSIGNED_LONG_LONG_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::LONG_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::SHORT_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::EOF_TOK
+    }));
+}
+TEST(token_stream, merges_type_specifiers_in_any_order) {
+    EXPECT_EQ(scan_token_types("long unsigned int a; int long long b; char signed c; double long d; int short unsigned e; signed f;"), (std::vector<token_type_t>{
+        token_type_t::UNSIGNED_LONG_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::LONG_LONG_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::SIGNED_CHAR_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::LONG_DOUBLE_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::UNSIGNED_SHORT_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::INT_KEYWORD, token_type_t::IDENTIFIER, token_type_t::SEMICOLON,
+        token_type_t::EOF_TOK
+    }));
+    const auto tokens = scan_all_tokens(lexer_t{"long /* comment */ unsigned\nint x"});
+    EXPECT_EQ(tokens.type(0u), token_type_t::UNSIGNED_LONG_KEYWORD);
+    EXPECT_EQ(tokens.text(0u), "long /* comment */ unsigned\nint");
+}
+TEST(token_stream, invalid_type_specifier_combinations_are_not_merged) {
+    EXPECT_EQ(scan_token_types("long char short long int long long long unsigned signed float double"), (std::vector<token_type_t>{
+        token_type_t::LONG_KEYWORD, token_type_t::CHAR_KEYWORD, token_type_t::SHORT_KEYWORD, token_type_t::LONG_LONG_KEYWORD, // `long int long`
+        token_type_t::UNSIGNED_LONG_LONG_KEYWORD, token_type_t::INT_KEYWORD,
+        token_type_t::FLOAT_KEYWORD, token_type_t::DOUBLE_KEYWORD,
+        token_type_t::EOF_TOK
+    }));
+}
+TEST(token_stream, interns_identifiers) {
+    token_stream_t token_stream(lexer_t{"int x = x + y;"});
+    EXPECT_TRUE(token_stream.token_symbol(token_stream.advance_token()).empty()); // `int`
+    const auto x = token_stream.token_symbol(token_stream.advance_token());
+    EXPECT_EQ(x.text(), "x");
+    token_stream.advance_token(); // `=`
+    EXPECT_EQ(token_stream.token_symbol(token_stream.advance_token()), x);
+    token_stream.advance_token(); // `+`
+    EXPECT_NE(token_stream.token_symbol(token_stream.advance_token()), x);
+}
+TEST(token_stream, lookahead_and_lookbehind_window) {
+    token_stream_t token_stream(lexer_t{"a b c d e f"});
+    EXPECT_EQ(token_stream.token_text(token_stream.peek_token_n(3u)), "d");
+    EXPECT_THROW(token_stream.peek_token_n(token_stream_t::max_lookahead), std::logic_error);
+    EXPECT_FALSE(token_stream.has_lookbehind_n(1u));
+
+    for(const char *const expected : {"a", "b", "c", "d", "e"}) {
+        EXPECT_EQ(token_stream.token_text(token_stream.advance_token()), expected);
+    }
+    EXPECT_EQ(token_stream.token_text(token_stream.peek_token()), "f");
+    EXPECT_EQ(token_stream.token_text(token_stream.peek_back_n(1u)), "e");
+    EXPECT_EQ(token_stream.token_text(token_stream.peek_back_n(token_stream_t::max_lookbehind)), "b");
+    EXPECT_THROW(token_stream.peek_back_n(token_stream_t::max_lookbehind + 1u), std::logic_error);
+    EXPECT_THROW(token_stream.token_type(0u), std::logic_error); // `a` has left the window
+
+    token_stream.advance_token();
+    EXPECT_TRUE(token_stream.is_eof());
+    EXPECT_EQ(token_stream.token_type(token_stream.advance_token()), token_type_t::EOF_TOK);
+    EXPECT_EQ(token_stream.token_type(token_stream.advance_token()), token_type_t::EOF_TOK);
+}
+TEST(token_table, merged_token_spans_its_keywords) {
+    const auto tokens = scan_all_tokens(lexer_t{"unsigned  long int x;"});
+    ASSERT_EQ(tokens.size(), 4u);
+    EXPECT_EQ(tokens.type(0u), token_type_t::UNSIGNED_LONG_KEYWORD);
+    EXPECT_EQ(tokens.text(0u), "unsigned  long int");
+    EXPECT_EQ(tokens.text(1u), "x");
+    EXPECT_EQ(token_table_t::bytes_per_token, 9u);
+}
+
+TEST(lexeme_tables, every_lexeme_is_scanned) {
+    for(const auto& lexeme : punctuator_table) {
+        EXPECT_EQ(scan_token_types(std::string("a ") + std::string(lexeme.text) + " b"),
+            (std::vector<token_type_t>{token_type_t::IDENTIFIER, lexeme.token_type, token_type_t::IDENTIFIER, token_type_t::EOF_TOK})) << lexeme.text;
+    }
+    for(const auto& lexeme : keyword_table) {
+        const auto token_type = scan_token_types(lexeme.text).front(); // `signed`, `short` etc. go through the type specifier merging, but come out as themselves
+        EXPECT_EQ(token_type, (lexeme.token_type == token_type_t::UNSIGNED_KEYWORD) ? token_type_t::UNSIGNED_INT_KEYWORD
+                            : (lexeme.token_type == token_type_t::SIGNED_KEYWORD) ? token_type_t::INT_KEYWORD : lexeme.token_type) << lexeme.text;
+    }
+}
+TEST(lexeme_tables, keyword_prefixes_and_extensions_are_identifiers) {
+    for(const std::string_view text : {"i", "in", "integer", "ifx", "structs", "unsigne", "_int", "Int"}) {
+        EXPECT_EQ(classify_identifier(text), token_type_t::IDENTIFIER) << text;
+    }
+    EXPECT_EQ(scan_token_types("a<<=b>>c"), (std::vector<token_type_t>{token_type_t::IDENTIFIER, token_type_t::LEFT_SHIFT_EQUALS, token_type_t::IDENTIFIER,
+        token_type_t::BITWISE_RIGHT_SHIFT, token_type_t::IDENTIFIER, token_type_t::EOF_TOK}));
+}
+
+// random text made mostly out of the characters the kernels look for, so that runs of whitespace and `*/` land on every SIMD lane boundary
+std::string make_scan_kernel_input(std::mt19937& rng, std::size_t length) {
+    static constexpr char alphabet[] = {' ', ' ', ' ', '\t', '\r', '\n', '\n', '*', '*', '/', '/', 'a', ';'};
+    std::uniform_int_distribution<std::size_t> pick(0u, sizeof(alphabet) - 1u);
+    std::string text;
+    for(std::size_t i = 0u; i < length; ++i) {
+        text += alphabet[pick(rng)];
+    }
+    return text;
+}
+
+TEST(scan_kernels, simd_matches_scalar) {
+    const auto original_implementation = get_scan_implementation();
+    std::mt19937 rng(1234u);
+
+    for(std::size_t length = 0u; length < 100u; ++length) {
+        for(std::size_t trial = 0u; trial < 20u; ++trial) {
+            const std::string text = make_scan_kernel_input(rng, length);
+            const char *const begin = text.data();
+            const char *const end = text.data() + text.size();
+
+            for(std::size_t offset = 0u; offset <= text.size(); offset += 7u) {
+                set_scan_implementation(scan_implementation_t::SCALAR);
+                const char *const expected_whitespace_end = skip_whitespace_run(begin + offset, end);
+                const char *const expected_comment_close = find_block_comment_close(begin + offset, end);
+                const char *const expected_line_end = find_line_end(begin + offset, end);
+                std::vector<std::uint32_t> expected_line_starts;
+                find_line_starts(begin + offset, end, expected_line_starts);
+
+                for(const auto implementation : {scan_implementation_t::SSE2, scan_implementation_t::AVX2}) {
+                    if(!is_scan_implementation_supported(implementation)) {
+                        continue;
+                    }
+                    set_scan_implementation(implementation);
+                    EXPECT_EQ(skip_whitespace_run(begin + offset, end), expected_whitespace_end);
+                    EXPECT_EQ(find_block_comment_close(begin + offset, end), expected_comment_close);
+                    EXPECT_EQ(find_line_end(begin + offset, end), expected_line_end);
+                    std::vector<std::uint32_t> line_starts;
+                    find_line_starts(begin + offset, end, line_starts);
+                    EXPECT_EQ(line_starts, expected_line_starts);
+                }
+            }
+        }
+    }
+
+    set_scan_implementation(original_implementation);
+}
+TEST(scan_kernels, scalar_is_always_supported) {
+    EXPECT_TRUE(is_scan_implementation_supported(scan_implementation_t::SCALAR));
+    EXPECT_TRUE(is_scan_implementation_supported(get_scan_implementation()));
+}
+TEST(scan_kernels, comment_spanning_simd_blocks) {
+    const std::string text = "a /*" + std::string(40u, '\n') + std::string(30u, '*') + "*/ b // " + std::string(50u, 'c') + "\nd";
+    const source_manager_t source_manager(text);
+    lexer_t lexer(text);
+    scan_token(lexer);
+    const auto b = scan_token(lexer);
+    EXPECT_EQ(b.token_text, "b");
+    const auto b_location = source_manager.get_location(static_cast<std::uint32_t>(b.token_text.data() - text.data()));
+    EXPECT_EQ(b_location.line, 41u);
+    EXPECT_EQ(b_location.column, 34u);
+    const auto d = scan_token(lexer);
+    EXPECT_EQ(d.token_text, "d");
+    const auto d_location = source_manager.get_location(static_cast<std::uint32_t>(d.token_text.data() - text.data()));
+    EXPECT_EQ(d_location.line, 42u);
+    EXPECT_EQ(d_location.column, 1u);
+    EXPECT_EQ(scan_token(lexer).token_type, token_type_t::EOF_TOK);
+}
+
+TEST(source_manager, resolves_offsets_to_lines_and_columns) {
+    const source_manager_t source_manager("ab\n\ncd\ne");
+    EXPECT_EQ(source_manager.line_count(), 4u);
+    const std::pair<std::uint32_t, std::pair<std::uint32_t, std::uint32_t>> expected_locations[] = {
+        {0u, {1u, 1u}}, {1u, {1u, 2u}}, {2u, {1u, 3u}}, // the `\n` belongs to the line it ends
+        {3u, {2u, 1u}},
+        {4u, {3u, 1u}}, {5u, {3u, 2u}}, {6u, {3u, 3u}},
+        {7u, {4u, 1u}}, {8u, {4u, 2u}}, // one past the end is still on the last line
+    };
+    for(const auto& [offset, expected_location] : expected_locations) {
+        const auto location = source_manager.get_location(offset);
+        EXPECT_EQ(location.line, expected_location.first) << "offset " << offset;
+        EXPECT_EQ(location.column, expected_location.second) << "offset " << offset;
+    }
+}
+TEST(source_manager, empty_text_and_trailing_newline) {
+    const source_manager_t empty_source_manager("");
+    EXPECT_EQ(empty_source_manager.line_count(), 1u);
+    EXPECT_EQ(empty_source_manager.get_location(0u).line, 1u);
+    EXPECT_EQ(empty_source_manager.get_location(0u).column, 1u);
+
+    const source_manager_t source_manager("a\n");
+    EXPECT_EQ(source_manager.line_count(), 2u);
+    EXPECT_EQ(source_manager.get_location(2u).line, 2u);
+    EXPECT_EQ(source_manager.get_location(2u).column, 1u);
+}
+
+// random program text with block comments spanning many lines (and many chunks), type specifiers split over lines and comment markers inside of comments
+std::string make_parallel_lexer_input(std::mt19937& rng, const std::size_t length) {
+    static constexpr const char* pieces[] = {
+        "int", "x", "unsigned", "long", "short", "char", "signed", "=", "<<=", ";", "(", ")", "{", "}", "'a'", "1.5f", "42ul",
+        "\n", "\n", "\n", "// line comment /* not a block comment\n", "/* short block comment */", "*/", "/",
+    };
+    std::uniform_int_distribution<std::size_t> pick(0u, std::size(pieces) - 1u);
+    std::uniform_int_distribution<std::uint32_t> percent(0u, 99u);
+    std::string text;
+    while(text.size() < length) {
+        if(percent(rng) == 0u) { // long block comment, up to a couple of chunks
+            text += "/*";
+            const std::size_t comment_length = std::uniform_int_distribution<std::size_t>(0u, 3u * min_parallel_lexing_chunk_size)(rng);
+            for(const std::size_t comment_end = text.size() + comment_length; text.size() < comment_end;) {
+                const std::uint32_t roll = percent(rng);
+                text += (roll < 3u) ? "\n int x; /*\n" : (roll < 8u) ? "\n x = 1;\n" : (roll < 13u) ? " // hides the end of the comment from a chunk that starts in it" : " long";
+            }
+            text += "*/";
+        }
+        text += pieces[pick(rng)];
+        text += (percent(rng) < 50u) ? " " : "";
+    }
+    return text;
+}
+
+TEST(parallel_lexer, matches_serial_lexer) {
+    std::mt19937 rng(7u);
+    utils::thread_pool_t thread_pool(4u);
+    for(std::uint32_t i = 0u; i < 20u; ++i) {
+        const std::string text = make_parallel_lexer_input(rng, 8u * min_parallel_lexing_chunk_size);
+        const auto serial_tokens = scan_all_tokens(lexer_t(text));
+        const auto parallel_tokens = scan_all_tokens_parallel(text.data(), text.data() + text.size(), thread_pool);
+        ASSERT_EQ(serial_tokens.size(), parallel_tokens.size());
+        for(token_index_t token = 0u; token < serial_tokens.size(); ++token) {
+            ASSERT_EQ(serial_tokens.type(token), parallel_tokens.type(token)) << "token " << token;
+            ASSERT_EQ(serial_tokens.offset(token), parallel_tokens.offset(token)) << "token " << token;
+            ASSERT_EQ(serial_tokens.length(token), parallel_tokens.length(token)) << "token " << token;
+        }
+    }
+}
+TEST(parallel_lexer, chunk_starting_inside_block_comment_is_relexed) {
+    // a chunk that starts inside of the comment sees the `//` as a line comment, which hides the tokens right after the real end of the block comment
+    std::string text = "int a;\n/*";
+    while(text.size() < 4u * min_parallel_lexing_chunk_size) {
+        text += "\n x = 1; long long long long long long long long long long";
+    }
+    text += " // */ int y = 2; float z;\n";
+    while(text.size() < 6u * min_parallel_lexing_chunk_size) {
+        text += "int q;\n";
+    }
+    utils::thread_pool_t thread_pool(4u);
+    const auto serial_tokens = scan_all_tokens(lexer_t(text));
+    const auto parallel_tokens = scan_all_tokens_parallel(text.data(), text.data() + text.size(), thread_pool);
+    ASSERT_EQ(serial_tokens.size(), parallel_tokens.size());
+    EXPECT_EQ(parallel_tokens.text(3u), "int");
+    EXPECT_EQ(parallel_tokens.text(4u), "y");
+    for(token_index_t token = 0u; token < serial_tokens.size(); ++token) {
+        ASSERT_EQ(serial_tokens.offset(token), parallel_tokens.offset(token)) << "token " << token;
+    }
+}
+TEST(parallel_lexer, small_text_is_lexed_serially) {
+    utils::thread_pool_t thread_pool(2u);
+    const std::string_view text = "unsigned long x;";
+    const auto tokens = scan_all_tokens_parallel(text.data(), text.data() + text.size(), thread_pool);
+    ASSERT_EQ(tokens.size(), 4u);
+    EXPECT_EQ(tokens.type(0u), token_type_t::UNSIGNED_LONG_KEYWORD);
+}
+
+TEST(source_buffer, maps_regular_file) {
+    const std::string contents = "int main() {\n    return 0;\n}\n";
+    char filename[] = "/tmp/foo_cc_source_buffer_XXXXXX";
+    const int fd = mkstemp(filename);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    close(fd);
+
+    {
+        const source_buffer_t source = load_source_file(filename);
+        EXPECT_EQ(source.view(), contents);
+    }
+    std::remove(filename);
+}
+TEST(source_buffer, empty_file) {
+    char filename[] = "/tmp/foo_cc_source_buffer_XXXXXX";
+    const int fd = mkstemp(filename);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    {
+        const source_buffer_t source = load_source_file(filename);
+        EXPECT_EQ(source.size(), 0u);
+    }
+    std::remove(filename);
+}
+
+}
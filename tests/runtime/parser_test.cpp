@@ -0,0 +1,320 @@
+#include "gtest/gtest.h"
+
+#include <frontend/ast/ast.hpp>
+#include <frontend/ast/ast_printer.hpp>
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <utils/thread_pool.hpp>
+#include <utils/result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+
+struct parse_result_t {
+    std::string output; // what parsing and then printing the AST wrote to `std::cout`
+    std::string error; // empty if it parsed
+    std::uint32_t diagnostic_offset = 0u;
+};
+
+template<typename F>
+parse_result_t parse_and_print(const std::string_view text, F&& parse_function) {
+    parse_result_t result;
+    parser_t parser(token_stream_t{lexer_t(text)});
+    testing::internal::CaptureStdout();
+    const auto program = parse_function(parser);
+    if(program.has_value()) {
+        print_validated_ast(program.value());
+    } else {
+        const utils::diagnostic_t& diagnostic = parser.diagnostics.get_diagnostics().front();
+        result.error = diagnostic.message;
+        result.diagnostic_offset = diagnostic.offset.value();
+    }
+    result.output = testing::internal::GetCapturedStdout();
+    return result;
+}
+
+void expect_same_as_serial_parse(const std::string_view text) {
+    utils::thread_pool_t thread_pool(4u);
+    const auto serial = parse_and_print(text, [](parser_t& parser) { return parse(parser); });
+    const auto parallel = parse_and_print(text, [&thread_pool](parser_t& parser) { return parse_in_parallel(parser, thread_pool); });
+    EXPECT_EQ(parallel.output, serial.output);
+    EXPECT_EQ(parallel.error, serial.error);
+    EXPECT_EQ(parallel.diagnostic_offset, serial.diagnostic_offset);
+}
+
+
+TEST(parallel_parser, matches_serial_parser) {
+    expect_same_as_serial_parse(
+        "typedef struct point_t { int x; long y; } point_t;\n"
+        "long scale = 3;\n"
+        "long area(point_t p);\n"
+        "int is_even(unsigned int n);\n"
+        "int is_odd(unsigned int n) { if(n == 0) { return 0; } return is_even(n - 1); }\n"
+        "int is_even(unsigned int n) { if(n == 0) { return 1; } return is_odd(n - 1); }\n"
+        "long area(point_t p) { long a = p.x * p.y; { long b = a * scale; a = b; } return a ? a : -1; }\n"
+        "int main() { point_t p; p.x = 2; p.y = 3; area(p); }\n");
+}
+TEST(parallel_parser, empty_program) {
+    expect_same_as_serial_parse("");
+}
+TEST(parallel_parser, error_in_body_is_reported_like_serial_parser) {
+    expect_same_as_serial_parse(
+        "int f(int a) { return a; }\n"
+        "int g(int a) { return a +; }\n"
+        "int h(int a) { return b; }\n");
+}
+TEST(parallel_parser, error_after_body_with_error_is_reported_like_serial_parser) {
+    // the later top level error is seen first, but the body's error comes first in the source
+    expect_same_as_serial_parse(
+        "int f(int a) { return b; }\n"
+        "int g = ;\n");
+}
+TEST(parallel_parser, global_declared_after_body_is_not_visible) {
+    expect_same_as_serial_parse(
+        "int f() { return g; }\n"
+        "int g = 1;\n");
+}
+TEST(parallel_parser, struct_completed_after_body_is_not_visible) {
+    expect_same_as_serial_parse(
+        "struct s;\n"
+        "typedef struct s s_t;\n"
+        "int f() { s_t x; return 0; }\n"
+        "struct s { int a; };\n");
+}
+TEST(parallel_parser, unbalanced_braces) {
+    expect_same_as_serial_parse("int f() { if(1) { return 1; }\n");
+}
+TEST(parallel_parser, prints_debug_output_to_the_parsers_stream) {
+    const std::string_view text =
+        "struct s { int a; };\n"
+        "int f() { return 1; }\n"
+        "struct t { long b; };\n"
+        "int main() { return f(); }\n";
+    const auto parse_to_stream = [text](auto&& parse_function) {
+        std::ostringstream debug_output;
+        parser_t parser(token_stream_t{lexer_t(text)});
+        parser.set_debug_output(debug_output);
+        testing::internal::CaptureStdout();
+        EXPECT_TRUE(parse_function(parser).has_value());
+        EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+        return debug_output.str();
+    };
+    utils::thread_pool_t thread_pool(4u);
+    const std::string serial = parse_to_stream([](parser_t& parser) { return parse(parser); });
+    EXPECT_NE(serial, "");
+    EXPECT_EQ(parse_to_stream([&thread_pool](parser_t& parser) { return parse_in_parallel(parser, thread_pool); }), serial);
+    EXPECT_EQ(parse_to_stream([](parser_t& parser) { return parse_lazily(parser, false); }), serial);
+}
+// what a parse that fails in the lexer prints, where the parallel and lazy parsers start over with a serial parse
+template<typename F>
+std::string parse_with_lexer_error_to_stream(const std::string_view text, F&& parse_function) {
+    std::ostringstream debug_output;
+    parser_t parser(token_stream_t{lexer_t(text)});
+    parser.set_debug_output(debug_output);
+    testing::internal::CaptureStdout();
+    EXPECT_FALSE(parse_function(parser).has_value());
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+    return debug_output.str();
+}
+std::size_t count_occurrences(const std::string_view text, const std::string_view pattern) {
+    std::size_t count = 0u;
+    for(auto position = text.find(pattern); position != std::string_view::npos; position = text.find(pattern, position + 1u)) {
+        ++count;
+    }
+    return count;
+}
+TEST(parallel_parser, prints_lexer_errors_once_when_starting_over) {
+    const std::string_view text = "int f() { return 1; }\nint x = 3 @ 4;\nint main() { return f(); }\n";
+    utils::thread_pool_t thread_pool(4u);
+    const std::string output = parse_with_lexer_error_to_stream(text, [&thread_pool](parser_t& parser) { return parse_in_parallel(parser, thread_pool); });
+    EXPECT_EQ(count_occurrences(output, "Unrecognized token: '@'"), 1u);
+    EXPECT_EQ(count_occurrences(output, "Error token emited"), 1u);
+}
+TEST(lazy_parser, prints_lexer_errors_once_when_starting_over) {
+    const std::string_view text = "int f() { return 1; }\nint x = 3 @ 4;\nint main() { return f(); }\n";
+    const std::string output = parse_with_lexer_error_to_stream(text, [](parser_t& parser) { return parse_lazily(parser, false); });
+    EXPECT_EQ(count_occurrences(output, "Unrecognized token: '@'"), 1u);
+    EXPECT_EQ(count_occurrences(output, "Error token emited"), 1u);
+}
+
+
+TEST(lazy_parser, only_parses_functions_needed_by_main_of_a_whole_program) {
+    const std::string_view needed_functions =
+        "int g(int a) { return a * 2; }\n"
+        "int f(int a) { return g(a) + 1; }\n";
+    const std::string_view unused_function = "int h(int a) { return undeclared; }\n";
+    const std::string_view main_function = "int main() { return f(1); }\n";
+
+    const auto serial = parse_and_print(std::string(needed_functions) + std::string(main_function), [](parser_t& parser) { return parse(parser); });
+    const auto lazy = parse_and_print(std::string(needed_functions) + std::string(unused_function) + std::string(main_function), [](parser_t& parser) { return parse_lazily(parser, true); });
+    EXPECT_EQ(serial.error, "");
+    EXPECT_EQ(lazy.error, "");
+    EXPECT_EQ(lazy.output, serial.output);
+}
+TEST(lazy_parser, keeps_functions_not_called_from_main) {
+    // other translation units can call `h`, as every function has external linkage
+    const std::string_view text =
+        "int h(int a) { return a * 2; }\n"
+        "int main() { return 0; }\n";
+    const auto serial = parse_and_print(text, [](parser_t& parser) { return parse(parser); });
+    const auto lazy = parse_and_print(text, [](parser_t& parser) { return parse_lazily(parser, false); });
+    EXPECT_EQ(lazy.error, "");
+    EXPECT_NE(lazy.output.find("h("), std::string::npos);
+    EXPECT_EQ(lazy.output, serial.output);
+}
+TEST(lazy_parser, parses_everything_without_main) {
+    const std::string_view text =
+        "int f(int a) { return a; }\n"
+        "int g(int a) { return f(a) - 1; }\n";
+    const auto serial = parse_and_print(text, [](parser_t& parser) { return parse(parser); });
+    const auto lazy = parse_and_print(text, [](parser_t& parser) { return parse_lazily(parser, true); });
+    EXPECT_EQ(lazy.output, serial.output);
+}
+TEST(lazy_parser, reports_errors_in_needed_functions) {
+    const std::string_view text =
+        "int f(int a) { return b; }\n"
+        "int main() { return f(1); }\n";
+    const auto serial = parse_and_print(text, [](parser_t& parser) { return parse(parser); });
+    const auto lazy = parse_and_print(text, [](parser_t& parser) { return parse_lazily(parser, true); });
+    EXPECT_NE(lazy.error, "");
+    EXPECT_EQ(lazy.error, serial.error);
+    EXPECT_EQ(lazy.diagnostic_offset, serial.diagnostic_offset);
+}
+
+
+
+TEST(parser_diagnostics, reports_first_error_at_its_token) {
+    const std::string_view text =
+        "int f(int a) { return a; }\n"
+        "int g(int a) { return b + c; }\n";
+    parser_t parser(token_stream_t{lexer_t(text)});
+    testing::internal::CaptureStdout();
+    const auto program = parse(parser);
+    testing::internal::GetCapturedStdout();
+    EXPECT_FALSE(program.has_value());
+    ASSERT_EQ(parser.diagnostics.get_diagnostics().size(), 1u);
+    EXPECT_EQ(parser.diagnostics.get_diagnostics()[0].message, "Variable [b] is not declared in currently accessible scopes.");
+    EXPECT_EQ(parser.diagnostics.get_diagnostics()[0].offset, std::optional<std::uint32_t>{static_cast<std::uint32_t>(text.find('b'))});
+}
+
+
+TEST(struct_layout, pads_fields_and_tail_as_the_sysv_abi_does) {
+    const ast::type_t char_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::CHAR, sizeof(char), alignof(char));
+    const ast::type_t short_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::SHORT, sizeof(std::int16_t), alignof(std::int16_t));
+    const ast::type_t int_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t));
+    const ast::type_t long_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::LONG, sizeof(std::int64_t), alignof(std::int64_t));
+
+    struct char_int_char_t { char a; std::int32_t b; char c; };
+    const auto char_int_char = layout_struct_fields({char_type, int_type, char_type});
+    ASSERT_TRUE(char_int_char.has_value());
+    EXPECT_EQ(char_int_char->field_offsets, (std::vector<std::size_t>{offsetof(char_int_char_t, a), offsetof(char_int_char_t, b), offsetof(char_int_char_t, c)}));
+    EXPECT_EQ(char_int_char->size, sizeof(char_int_char_t));
+    EXPECT_EQ(char_int_char->alignment, alignof(char_int_char_t));
+
+    struct short_long_char_t { std::int16_t a; std::int64_t b; char c; };
+    const auto short_long_char = layout_struct_fields({short_type, long_type, char_type});
+    ASSERT_TRUE(short_long_char.has_value());
+    EXPECT_EQ(short_long_char->field_offsets, (std::vector<std::size_t>{offsetof(short_long_char_t, a), offsetof(short_long_char_t, b), offsetof(short_long_char_t, c)}));
+    EXPECT_EQ(short_long_char->size, sizeof(short_long_char_t));
+
+    // nested structs are aligned as their most aligned field
+    struct nested_t { char a; short_long_char_t b; };
+    const auto nested = layout_struct_fields({char_type, make_struct_definition_type_t(ast::type_table_t{}, ast::type_name_t{"s"}, {short_type, long_type, char_type}, {ast::var_name_t{"a"}, ast::var_name_t{"b"}, ast::var_name_t{"c"}}).value()});
+    ASSERT_TRUE(nested.has_value());
+    EXPECT_EQ(nested->field_offsets, (std::vector<std::size_t>{offsetof(nested_t, a), offsetof(nested_t, b)}));
+    EXPECT_EQ(nested->size, sizeof(nested_t));
+
+    EXPECT_FALSE(layout_struct_fields({char_type, make_struct_forward_decl_type_t(ast::type_name_t{"s"})}).has_value());
+}
+TEST(struct_layout, member_access_is_resolved_to_field_indices_and_offset) {
+    const std::string_view text =
+        "struct inner_t { char c; long l; };\n"
+        "struct outer_t { int i; struct inner_t in; };\n"
+        "int main() { struct outer_t o; o.in.l = 1; return 0; }\n";
+    parser_t parser(token_stream_t{lexer_t(text)});
+    testing::internal::CaptureStdout();
+    const auto program = parse(parser);
+    testing::internal::GetCapturedStdout();
+    ASSERT_TRUE(program.has_value());
+
+    const ast::node_pools_scope_t scope(*program.value().nodes);
+    const auto& main_function = std::get<ast::function_definition_t>(program.value().top_level_declarations.back());
+    const auto& statement = std::get<ast::expression_statement_t>(std::get<ast::statement_t>(main_function.statements.stmts.at(1)));
+    const auto& assignment = std::get<ast::node_handle_t<ast::binary_expression_t>>(statement.expr.value().expr);
+    const auto& member_access = std::get<ast::variable_access_t>(assignment->left.expr);
+    ASSERT_EQ(member_access.member_accesses.size(), 2u);
+    EXPECT_EQ(member_access.member_accesses[0].field_index, 1u);
+    EXPECT_EQ(member_access.member_accesses[1].field_index, 1u);
+    EXPECT_EQ(member_access.member_offset, 8u + 8u); // `in` is at 8 (aligned to `long`), `l` is at 8 inside it
+}
+TEST(typedef_resolution, chains_resolve_to_the_end_of_the_chain) {
+    const std::string_view text =
+        "typedef long a_t;\n"
+        "typedef a_t b_t;\n"
+        "typedef b_t c_t;\n"
+        "typedef struct s s_t;\n"
+        "typedef s_t t_t;\n"
+        "struct s { int x; };\n"
+        "c_t g;\n";
+    parser_t parser(token_stream_t{lexer_t(text)});
+    testing::internal::CaptureStdout();
+    const auto program = parse(parser);
+    testing::internal::GetCapturedStdout();
+    ASSERT_TRUE(program.has_value());
+    const ast::type_table_t& type_table = program.value().type_table;
+
+    const ast::type_t *const long_type = get_aliased_type_name(type_table, ast::type_name_t{"c_t"});
+    ASSERT_NE(long_type, nullptr);
+    EXPECT_EQ(long_type, &type_table.at(static_cast<std::uint32_t>(ast::type_category_t::INT)).at(ast::primitive_type_names::LONG));
+
+    // the struct was only forward declared when the typedefs were made
+    const ast::type_t& t_t = type_table.at(static_cast<std::uint32_t>(ast::type_category_t::TYPEDEF)).at(ast::type_name_t{"t_t"});
+    const ast::type_t *const struct_type = get_underlying_type(type_table, t_t);
+    ASSERT_NE(struct_type, nullptr);
+    EXPECT_EQ(struct_type->type_name, ast::type_name_t{"s"});
+    EXPECT_EQ(struct_type->size, std::optional<std::size_t>{sizeof(std::int32_t)});
+}
+TEST(type_context, interns_equal_types_once) {
+    ast::type_context_t types;
+    const ast::type_id_t int_id = types.intern(make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t)));
+    const ast::type_id_t long_id = types.intern(make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::LONG, sizeof(std::int64_t), alignof(std::int64_t)));
+    EXPECT_NE(int_id, long_id);
+    EXPECT_EQ(types.intern(make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t))), int_id);
+    EXPECT_EQ(types.get(int_id).type_name, ast::primitive_type_names::INT);
+
+    // a forward declaration and the definition of a struct have the same name, but aren't the same type
+    const ast::type_id_t forward_declaration_id = types.intern(make_struct_forward_decl_type_t(ast::type_name_t{"s"}));
+    const ast::type_id_t definition_id = types.intern(make_struct_definition_type_t(ast::type_table_t{}, ast::type_name_t{"s"}, {types.get(int_id)}, {ast::var_name_t{"a"}}).value());
+    EXPECT_NE(forward_declaration_id, definition_id);
+    EXPECT_EQ(types.size(), 4u);
+}
+TEST(type_context, appending_pools_reuses_their_types) {
+    ast::node_pools_t pools;
+    ast::node_pools_t other_pools;
+    ast::expression_type_t int_type;
+    ast::expression_type_t other_int_type;
+    ast::expression_type_t other_long_type;
+    {
+        const ast::node_pools_scope_t scope(pools);
+        int_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t));
+    }
+    {
+        const ast::node_pools_scope_t scope(other_pools);
+        other_long_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::LONG, sizeof(std::int64_t), alignof(std::int64_t));
+        other_int_type = make_primitive_type_t(ast::type_category_t::INT, ast::primitive_type_names::INT, sizeof(std::int32_t), alignof(std::int32_t));
+    }
+    const ast::node_offsets_t offsets = pools.append(std::move(other_pools));
+    other_int_type.remap_id(offsets.type_ids);
+    other_long_type.remap_id(offsets.type_ids);
+    EXPECT_EQ(other_int_type, int_type);
+    EXPECT_NE(other_long_type, int_type);
+    EXPECT_EQ(pools.get_types().size(), 2u);
+}
+
+}
@@ -1,6 +1,16 @@
 #include "gtest/gtest.h"
 
 #include <utils/common.hpp>
+#include <utils/symbol_interner.hpp>
+#include <utils/data_structures/stable_vector.hpp>
+#include <utils/data_structures/scoped_symbol_table.hpp>
+#include <utils/result.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace {
 
@@ -103,4 +113,144 @@ TEST(contains, does_not_contain_key) {
     EXPECT_FALSE(utils::contains(unordered_map, 2));
 }
 
+
+
+TEST(symbol_interner, equal_texts_get_the_same_symbol) {
+    const auto symbol = utils::intern("symbol_interner_test_name");
+    EXPECT_EQ(utils::intern(std::string("symbol_interner_test_") + "name"), symbol);
+    EXPECT_NE(utils::intern("symbol_interner_test_other_name"), symbol);
+    EXPECT_EQ(symbol.text(), "symbol_interner_test_name");
+}
+TEST(symbol_interner, empty_text_is_the_default_symbol) {
+    EXPECT_EQ(utils::intern(""), utils::symbol_t{});
+    EXPECT_TRUE(utils::symbol_t{}.empty());
+    EXPECT_EQ(utils::symbol_t{}.text(), "");
+}
+TEST(symbol_interner, ids_are_dense) {
+    utils::symbol_interner_t interner;
+    EXPECT_EQ(interner.intern("a").get_id(), 1u);
+    EXPECT_EQ(interner.intern("b").get_id(), 2u);
+    EXPECT_EQ(interner.intern("a").get_id(), 1u);
+    EXPECT_EQ(interner.size(), 3u);
+}
+TEST(symbol_interner, concurrent_interning) {
+    utils::symbol_interner_t interner;
+    std::vector<std::vector<utils::symbol_t>> symbols(4u);
+    std::vector<std::thread> threads;
+    for(auto& thread_symbols : symbols) {
+        threads.emplace_back([&interner, &thread_symbols]() {
+            for(int i = 0; i < 1000; ++i) {
+                thread_symbols.push_back(interner.intern("name" + std::to_string(i)));
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    for(const auto& thread_symbols : symbols) {
+        EXPECT_EQ(thread_symbols, symbols.front());
+    }
+    EXPECT_EQ(interner.size(), 1001u);
+    EXPECT_EQ(interner.text(symbols.front().at(42)), "name42");
+}
+
+TEST(stable_vector, indices_are_dense_and_references_stay_valid) {
+    utils::data_structures::stable_vector_t<std::string> strings;
+    const std::uint32_t count = 3u * utils::data_structures::stable_vector_t<std::string>::chunk_size + 1u; // spans several chunks
+    EXPECT_EQ(strings.push_back("first"), 0u);
+    const std::string& first = strings[0u];
+    for(std::uint32_t i = 1u; i < count; ++i) {
+        EXPECT_EQ(strings.push_back(std::to_string(i)), i);
+    }
+    EXPECT_EQ(&first, &strings[0u]);
+    EXPECT_EQ(first, "first");
+    EXPECT_EQ(strings[count - 1u], std::to_string(count - 1u));
+    EXPECT_EQ(strings.size(), count);
+}
+TEST(stable_vector, destroys_elements_in_reverse_order) {
+    std::vector<int> destroyed;
+    struct tracked_t {
+        std::vector<int>* destroyed;
+        int id;
+        tracked_t(std::vector<int>* destroyed, int id) : destroyed(destroyed), id(id) {}
+        tracked_t(tracked_t&& other) noexcept : destroyed(std::exchange(other.destroyed, nullptr)), id(other.id) {}
+        ~tracked_t() {
+            if(destroyed != nullptr) {
+                destroyed->push_back(id);
+            }
+        }
+    };
+    {
+        utils::data_structures::stable_vector_t<tracked_t> tracked;
+        tracked.push_back(tracked_t{&destroyed, 1});
+        tracked.push_back(tracked_t{&destroyed, 2});
+        EXPECT_TRUE(destroyed.empty());
+    }
+    EXPECT_EQ(destroyed, (std::vector<int>{2, 1}));
+}
+
+TEST(scoped_symbol_table, inner_scopes_shadow_outer_ones) {
+    utils::data_structures::scoped_symbol_table_t<int> table;
+    const utils::symbol_t a{"a"};
+    const utils::symbol_t b{"b"};
+    table.enter_scope();
+    table.bind(a, 1);
+    table.enter_scope();
+    EXPECT_TRUE(table.is_in_scope(a));
+    EXPECT_FALSE(table.is_in_current_scope(a));
+    table.bind(a, 2);
+    table.bind(b, 3);
+    EXPECT_TRUE(table.is_in_current_scope(a));
+    EXPECT_EQ(*table.find(a), 2);
+    table.leave_scope();
+    EXPECT_EQ(*table.find(a), 1);
+    EXPECT_EQ(table.find(b), nullptr);
+    table.leave_scope();
+    EXPECT_FALSE(table.is_in_scope(a));
+    EXPECT_EQ(table.scope_count(), 0u);
+}
+TEST(scoped_symbol_table, keeps_bindings_while_growing) {
+    utils::data_structures::scoped_symbol_table_t<int> table;
+    const utils::symbol_t shadowed{"shadowed"};
+    table.enter_scope();
+    table.bind(shadowed, -1);
+    table.enter_scope();
+    table.bind(shadowed, -2);
+    for(int i = 0; i < 1000; ++i) {
+        table.bind(utils::symbol_t{"name" + std::to_string(i)}, i);
+    }
+    EXPECT_EQ(*table.find(utils::symbol_t{"name42"}), 42);
+    EXPECT_EQ(*table.find(shadowed), -2);
+    table.leave_scope();
+    EXPECT_EQ(*table.find(shadowed), -1);
+    EXPECT_EQ(table.find(utils::symbol_t{"name42"}), nullptr);
+}
+
+
+
+utils::result_t<int> halve(const int value, utils::diagnostics_t& diagnostics) {
+    if(value % 2 != 0) {
+        return diagnostics.report("odd", static_cast<std::uint32_t>(value));
+    }
+    return value / 2;
+}
+utils::result_t<int> quarter(const int value, utils::diagnostics_t& diagnostics) {
+    TRY_ASSIGN(const int half, halve(value, diagnostics));
+    return halve(half, diagnostics);
+}
+TEST(result, passes_values_through) {
+    utils::diagnostics_t diagnostics;
+    const auto result = quarter(12, diagnostics);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result.value(), 3);
+    EXPECT_FALSE(diagnostics.has_errors());
+}
+TEST(result, stops_at_first_error) {
+    utils::diagnostics_t diagnostics;
+    EXPECT_FALSE(quarter(6, diagnostics).has_value());
+    ASSERT_EQ(diagnostics.get_diagnostics().size(), 1u);
+    EXPECT_EQ(diagnostics.get_diagnostics()[0].message, "odd");
+    EXPECT_EQ(diagnostics.get_diagnostics()[0].offset, std::optional<std::uint32_t>{3u});
+}
+
 }
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <frontend/lexing/lexer.hpp>
+#include <frontend/lexing/token_stream.hpp>
+#include <frontend/parsing/parser.hpp>
+#include <middle_end/typing/type_checker.hpp>
+#include <backend/interpreter/virtual_machine.hpp>
+#include <utils/result.hpp>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace {
+
+utils::result_t<int> run(const std::string_view text, utils::diagnostics_t& diagnostics) {
+    parser_t parser(token_stream_t{lexer_t(text)});
+    auto program = parse(parser);
+    EXPECT_TRUE(program.has_value());
+    EXPECT_TRUE(type_check(program.value(), diagnostics).has_value());
+    return run_program(program.value(), diagnostics);
+}
+int run(const std::string_view text) {
+    utils::diagnostics_t diagnostics;
+    const auto exit_code = run(text, diagnostics);
+    EXPECT_TRUE(exit_code.has_value());
+    return exit_code.has_value() ? exit_code.value() : -1;
+}
+
+
+TEST(virtual_machine, runs_main_and_returns_its_exit_code) {
+    EXPECT_EQ(run("int main() { return 42; }\n"), 42);
+    EXPECT_EQ(run("int main() { }\n"), 0);
+    EXPECT_EQ(run("int main() { return -1; }\n"), -1);
+    EXPECT_EQ(run(
+        "typedef struct { int x; long y; char c; } point_t;\n"
+        "long g = 5;\n"
+        "unsigned char uc = 200;\n"
+        "float gf = 0.5f;\n"
+        "long area(point_t p) { long a = p.x * p.y; p.x = 1000; return a * g; }\n"
+        "point_t make(int x, long y) { point_t p; p.x = x; p.y = y; p.c = 'q'; return p; }\n"
+        "long many(long a, long b, long c, long d, long e, long f, long h, long i) { return a - b + c - d + e - f + h * i; }\n"
+        "int main() {\n"
+        "    point_t p; p.x = 3; p.y = 4;\n"
+        "    if(area(p) != 60 || p.x != 3) { return 1; }\n"
+        "    point_t q = make(7, 9);\n"
+        "    if(q.x + q.y != 16 || q.c != 'q') { return 2; }\n"
+        "    if(many(1, 2, 3, 4, 5, 6, 7, 8) != 53) { return 3; }\n"
+        "    signed char sc = -7;\n"
+        "    if(sc / 2 != -3 || sc % 2 != -1 || (sc >> 1) != -4) { return 4; }\n"
+        "    unsigned int u = 4000000000u;\n"
+        "    if(u / 3u != 1333333333u || (u >> 31) != 1u || u < 1) { return 5; }\n"
+        "    if(uc + 100 != 300) { return 6; }\n"
+        "    short sh = 30000; sh = sh + sh;\n"
+        "    if(sh != -5536) { return 7; }\n"
+        "    double d = 18446744073709551615UL;\n"
+        "    unsigned long back = 17000000000000000000.0;\n"
+        "    if(d < 18000000000000000000.0 || back != 17000000000000000000UL) { return 8; }\n"
+        "    int i = gf * 7;\n"
+        "    if(i != 3 || -gf > 0.0f) { return 9; }\n"
+        "    int zero = 0;\n"
+        "    int t = (zero && (g = 99)) || g == 5 ? 100 : 200;\n"
+        "    if(t != 100 || g != 5) { return 10; }\n"
+        "    return 42;\n"
+        "}\n"), 42);
+}
+
+TEST(virtual_machine, calls_functions_recursively) {
+    EXPECT_EQ(run(
+        "int fibonacci(int n) { return n < 2 ? n : (fibonacci(n - 1) + fibonacci(n - 2)); }\n"
+        "int is_even(unsigned int n);\n"
+        "int is_odd(unsigned int n) { return n == 0 ? 0 : is_even(n - 1); }\n"
+        "int is_even(unsigned int n) { return n == 0 ? 1 : is_odd(n - 1); }\n"
+        "int main() { return fibonacci(20) == 6765 && is_odd(10001); }\n"), 1);
+}
+
+TEST(virtual_machine, calls_host_functions) {
+    testing::internal::CaptureStdout();
+    const int exit_code = run("int putchar(int c);\nint main() { putchar(104); putchar(105); return putchar(10); }\n");
+    std::fflush(stdout);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "hi\n");
+    EXPECT_EQ(exit_code, 10);
+}
+
+TEST(virtual_machine, reports_what_it_cannot_run) {
+    utils::diagnostics_t diagnostics;
+    EXPECT_FALSE(run("int main() { int zero = 0; return 1 / zero; }\n", diagnostics).has_value());
+    EXPECT_FALSE(run("int f(int n) { return f(n + 1); }\nint main() { return f(0); }\n", diagnostics).has_value());
+    EXPECT_FALSE(run("int g(int n);\nint main() { return g(1); }\n", diagnostics).has_value());
+    EXPECT_FALSE(run("int f() { return 0; }\n", diagnostics).has_value());
+    ASSERT_EQ(diagnostics.get_diagnostics().size(), 4u);
+    EXPECT_NE(diagnostics.get_diagnostics()[0].message.find("Division by zero."), std::string::npos);
+    EXPECT_NE(diagnostics.get_diagnostics()[1].message.find("Stack overflow."), std::string::npos);
+}
+
+}